@@ -6,8 +6,7 @@ string(REPLACE "\"" "" NODE_ADDON_API_DIR ${NODE_ADDON_API_DIR})
 
 add_library(node::node-addon-api INTERFACE IMPORTED)
 set_target_properties(node::node-addon-api PROPERTIES
-	INTERFACE_COMPILE_DEFINITIONS NAPI_VERSION=5
-	INTERFACE_COMPILE_DEFINITIONS NAPI_CPP_EXCEPTIONS
+	INTERFACE_COMPILE_DEFINITIONS "NAPI_VERSION=7;NAPI_CPP_EXCEPTIONS"
 	INTERFACE_INCLUDE_DIRECTORIES "${NODE_ADDON_API_DIR}")
 
 if(WIN32)
@@ -15,6 +15,7 @@
 #include "Common/Swap.h"
 #include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
+#include "Core/Turbo.h"
 
 static u32 DPL2QualityToFrameBlockSize(AudioCommon::DPL2Quality quality)
 {
@@ -149,6 +150,10 @@ unsigned int Mixer::Mix(short* samples, unsigned int num_samples)
 
   memset(samples, 0, num_samples * 2 * sizeof(short));
 
+  // Nothing is pushed in turbo mode, so play silence rather than padding with the last sample.
+  if (Turbo::IsEnabled())
+    return num_samples;
+
   if (SConfig::GetInstance().m_audio_stretch)
   {
     unsigned int available_samples =
@@ -205,6 +210,9 @@ unsigned int Mixer::MixSurround(float* samples, unsigned int num_samples)
 
 void Mixer::MixerFifo::PushSamples(const short* samples, unsigned int num_samples)
 {
+  if (Turbo::IsEnabled())
+    return;
+
   // Cache access in non-volatile variable
   // indexR isn't allowed to cache in the audio throttling loop as it
   // needs to get updates to not deadlock.
@@ -0,0 +1,161 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+namespace Common
+{
+// Hash map with open addressing and linear probing. All entries are stored in a single array, so
+// a lookup is a hash and a few adjacent memory accesses rather than a walk over a tree. Erasing
+// moves the following entries of the same probe sequence back instead of leaving tombstones.
+//
+// Insertions and erasures move entries around: pointers and references to the values stored in
+// the map are only valid until the next call that modifies the map.
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class FlatHashMap
+{
+public:
+  size_t Size() const { return m_size; }
+  bool Empty() const { return m_size == 0; }
+
+  Value* Find(const Key& key)
+  {
+    if (m_slots.empty())
+      return nullptr;
+
+    for (size_t i = IndexFor(key);; i = (i + 1) & m_mask)
+    {
+      Slot& slot = m_slots[i];
+      if (!slot.occupied)
+        return nullptr;
+      if (slot.key == key)
+        return &slot.value;
+    }
+  }
+
+  // Returns the value for key, inserting a default-constructed one if there is none.
+  Value& operator[](const Key& key)
+  {
+    if ((m_size + 1) * 2 > m_slots.size())
+      Grow();
+
+    size_t i = IndexFor(key);
+    for (; m_slots[i].occupied; i = (i + 1) & m_mask)
+    {
+      if (m_slots[i].key == key)
+        return m_slots[i].value;
+    }
+
+    Slot& slot = m_slots[i];
+    slot.key = key;
+    slot.value = Value{};
+    slot.occupied = true;
+    ++m_size;
+    return slot.value;
+  }
+
+  bool Erase(const Key& key)
+  {
+    if (m_slots.empty())
+      return false;
+
+    size_t hole = IndexFor(key);
+    for (;; hole = (hole + 1) & m_mask)
+    {
+      if (!m_slots[hole].occupied)
+        return false;
+      if (m_slots[hole].key == key)
+        break;
+    }
+
+    // Move back every following entry whose ideal slot isn't between the hole and itself, as it
+    // would become unreachable otherwise.
+    for (size_t i = (hole + 1) & m_mask; m_slots[i].occupied; i = (i + 1) & m_mask)
+    {
+      const size_t ideal = IndexFor(m_slots[i].key);
+      if (((i - ideal) & m_mask) >= ((i - hole) & m_mask))
+      {
+        m_slots[hole] = std::move(m_slots[i]);
+        hole = i;
+      }
+    }
+
+    m_slots[hole].occupied = false;
+    m_slots[hole].value = Value{};
+    --m_size;
+    return true;
+  }
+
+  void Clear()
+  {
+    m_slots.clear();
+    m_slots.shrink_to_fit();
+    m_mask = 0;
+    m_shift = 64;
+    m_size = 0;
+  }
+
+  // Calls f(key, value) for every entry. f must not modify the map.
+  template <typename F>
+  void ForEach(F f)
+  {
+    for (Slot& slot : m_slots)
+    {
+      if (slot.occupied)
+        f(static_cast<const Key&>(slot.key), slot.value);
+    }
+  }
+
+private:
+  static constexpr size_t INITIAL_CAPACITY = 64;
+
+  struct Slot
+  {
+    Key key{};
+    Value value{};
+    bool occupied = false;
+  };
+
+  size_t IndexFor(const Key& key) const
+  {
+    // Fibonacci hashing: the multiplication spreads the input over the high bits, which makes
+    // hashes that only differ in their low bits (such as aligned addresses) land far apart.
+    const u64 hash = static_cast<u64>(Hash{}(key)) * 0x9E3779B97F4A7C15ULL;
+    return static_cast<size_t>(hash >> m_shift);
+  }
+
+  void Grow()
+  {
+    const size_t capacity = m_slots.empty() ? INITIAL_CAPACITY : m_slots.size() * 2;
+    std::vector<Slot> old_slots = std::exchange(m_slots, std::vector<Slot>(capacity));
+    m_mask = m_slots.size() - 1;
+    m_shift = 64;
+    for (size_t i = capacity; i > 1; i >>= 1)
+      --m_shift;
+
+    for (Slot& old_slot : old_slots)
+    {
+      if (!old_slot.occupied)
+        continue;
+
+      size_t i = IndexFor(old_slot.key);
+      while (m_slots[i].occupied)
+        i = (i + 1) & m_mask;
+      m_slots[i] = std::move(old_slot);
+    }
+  }
+
+  std::vector<Slot> m_slots;
+  size_t m_mask = 0;
+  u32 m_shift = 64;
+  size_t m_size = 0;
+};
+}  // namespace Common
@@ -0,0 +1,171 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <atomic>
+#include <optional>
+
+#include "Common/CommonTypes.h"
+#include "Common/Event.h"
+
+namespace Common
+{
+// Hands a request from a thread that parks until it has been served (the parked thread) to the
+// thread that serves it (the handling thread), while other threads may cancel it.
+//
+// The whole handshake lives in a single atomic word holding the ticket of the latest request, a
+// suspended bit and the request's state (idle, pending or handling). Every transition is a
+// compare-exchange against the exact ticket and state it expects, so claiming a request and
+// cancelling it cannot both succeed, and a late completion of an old ticket changes nothing.
+// The parked thread also checks its own ticket after every wake-up, so a stale Set() of the
+// shared event cannot release it early.
+class ParkingHandoff
+{
+public:
+  // Called by the parked thread. Returns the ticket of the new pending request, or nothing while
+  // suspended or while an earlier request is still active.
+  std::optional<u64> Post()
+  {
+    u64 word = m_word.load();
+    do
+    {
+      if ((word & SUSPENDED_BIT) || StateOf(word) != State::Idle)
+        return std::nullopt;
+    } while (!m_word.compare_exchange_weak(word, Make(TicketOf(word) + 1, State::Pending, false)));
+
+    return TicketOf(word) + 1;
+  }
+
+  // Called by the parked thread. Blocks until the request has been completed or cancelled.
+  void Wait(u64 ticket)
+  {
+    while (IsActive(ticket))
+      m_done.Wait();
+  }
+
+  // Takes back a request nobody has claimed yet, e.g. when it could not be delivered.
+  bool Withdraw(u64 ticket) { return Transition(ticket, State::Pending, State::Idle); }
+
+  // Called by the handling thread. Fails if the request was cancelled or is already handled.
+  bool Claim(u64 ticket) { return Transition(ticket, State::Pending, State::Handling); }
+
+  // Called by the handling thread to claim whichever request is pending, if any.
+  std::optional<u64> ClaimPending()
+  {
+    const u64 word = m_word.load();
+    if (StateOf(word) != State::Pending || !Claim(TicketOf(word)))
+      return std::nullopt;
+
+    return TicketOf(word);
+  }
+
+  // Called by the handling thread once it is done with a claimed request.
+  void Complete(u64 ticket)
+  {
+    if (Transition(ticket, State::Handling, State::Idle))
+    {
+      m_done.Set();
+      m_handled.Set();
+    }
+  }
+
+  // Cancels the pending request. Returns false if the request is being handled, in which case the
+  // parked thread is released once the handling thread completes it.
+  bool Cancel() { return CancelAndSuspend(false); }
+
+  // Cancels the pending request and refuses new ones until Resume() is called. Returns false if a
+  // request is still being handled.
+  bool Suspend() { return CancelAndSuspend(true); }
+
+  void Resume() { m_word.fetch_and(~SUSPENDED_BIT); }
+
+  // Releases the parked thread even if the handling thread is still working on its request. That
+  // request's completion is then ignored.
+  void Release()
+  {
+    u64 word = m_word.load();
+    do
+    {
+      if (StateOf(word) == State::Idle)
+        return;
+    } while (!m_word.compare_exchange_weak(word, (word & ~STATE_MASK) | u64(State::Idle)));
+
+    m_done.Set();
+    if (StateOf(word) == State::Handling)
+      m_handled.Set();
+  }
+
+  bool IsPending() const { return StateOf(m_word.load()) == State::Pending; }
+  bool IsHandling() const { return StateOf(m_word.load()) == State::Handling; }
+
+  // Blocks until the request being handled, if any, has been completed or released. Only one
+  // thread may wait at a time, e.g. the one that failed to Cancel() or Suspend().
+  void WaitWhileHandling()
+  {
+    while (IsHandling())
+      m_handled.Wait();
+  }
+
+private:
+  enum class State : u64
+  {
+    Idle,
+    Pending,
+    Handling,
+  };
+
+  static constexpr u64 STATE_MASK = 3;
+  static constexpr u64 SUSPENDED_BIT = 4;
+  static constexpr u32 TICKET_SHIFT = 3;
+
+  static constexpr u64 Make(u64 ticket, State state, bool suspended)
+  {
+    return (ticket << TICKET_SHIFT) | (suspended ? SUSPENDED_BIT : 0) | u64(state);
+  }
+  static constexpr u64 TicketOf(u64 word) { return word >> TICKET_SHIFT; }
+  static constexpr State StateOf(u64 word) { return State(word & STATE_MASK); }
+
+  bool IsActive(u64 ticket) const
+  {
+    const u64 word = m_word.load();
+    return TicketOf(word) == ticket && StateOf(word) != State::Idle;
+  }
+
+  bool Transition(u64 ticket, State from, State to)
+  {
+    u64 word = m_word.load();
+    do
+    {
+      if (TicketOf(word) != ticket || StateOf(word) != from)
+        return false;
+    } while (!m_word.compare_exchange_weak(word, Make(ticket, to, word & SUSPENDED_BIT)));
+
+    return true;
+  }
+
+  bool CancelAndSuspend(bool suspend)
+  {
+    u64 word = m_word.load();
+    u64 new_word;
+    do
+    {
+      new_word = word | (suspend ? SUSPENDED_BIT : 0);
+      if (StateOf(word) == State::Pending)
+        new_word = (new_word & ~STATE_MASK) | u64(State::Idle);
+      else if (new_word == word)
+        break;
+    } while (!m_word.compare_exchange_weak(word, new_word));
+
+    if (StateOf(word) == State::Pending)
+      m_done.Set();
+
+    return StateOf(word) != State::Handling;
+  }
+
+  std::atomic<u64> m_word{Make(0, State::Idle, false)};
+  Event m_done;
+  Event m_handled;
+};
+}  // namespace Common
@@ -42,6 +42,7 @@ namespace fs = std::filesystem;
 #include "Core/ConfigManager.h"
 #include "Core/FifoPlayer/FifoPlayer.h"
 #include "Core/HLE/HLE.h"
+#include "Core/HLE/HLE_SDK.h"
 #include "Core/HW/DVD/DVDInterface.h"
 #include "Core/HW/EXI/EXI_DeviceIPL.h"
 #include "Core/HW/Memmap.h"
@@ -429,7 +430,8 @@ bool CBoot::BootUp(std::unique_ptr<BootParameters> boot)
 
       // Try to load the symbol map if there is one, and then scan it for
       // and eventually replace code
-      if (LoadMapFromFilename())
+      const bool map_loaded = LoadMapFromFilename();
+      if (HLE_SDK::FindFunctions() || map_loaded)
         HLE::PatchFunctions();
 
       return true;
@@ -475,7 +477,8 @@ bool CBoot::BootUp(std::unique_ptr<BootParameters> boot)
 
       PC = executable.reader->GetEntryPoint();
 
-      if (executable.reader->LoadSymbols() || LoadMapFromFilename())
+      const bool map_loaded = executable.reader->LoadSymbols() || LoadMapFromFilename();
+      if (HLE_SDK::FindFunctions() || map_loaded)
       {
         UpdateDebugger_MapLoaded();
         HLE::PatchFunctions();
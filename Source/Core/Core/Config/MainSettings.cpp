@@ -25,6 +25,22 @@ const Info<PowerPC::CPUCore> MAIN_CPU_CORE{{System::Main, "Core", "CPUCore"},
                                            PowerPC::DefaultCPUCore()};
 const Info<bool> MAIN_JIT_FOLLOW_BRANCH{{System::Main, "Core", "JITFollowBranch"}, true};
 const Info<bool> MAIN_FASTMEM{{System::Main, "Core", "Fastmem"}, true};
+const Info<bool> MAIN_JIT_DISK_CACHE{{System::Main, "Core", "JITDiskCache"}, false};
+const Info<bool> MAIN_JIT_TIERED_COMPILATION{{System::Main, "Core", "JITTieredCompilation"},
+                                             false};
+const Info<u32> MAIN_JIT_TIER_UP_THRESHOLD{{System::Main, "Core", "JITTierUpThreshold"}, 32};
+const Info<bool> MAIN_JIT_BACKGROUND_COMPILATION{
+    {System::Main, "Core", "JITBackgroundCompilation"}, false};
+const Info<bool> MAIN_JIT_REGION_COMPILATION{{System::Main, "Core", "JITRegionCompilation"},
+                                             false};
+const Info<bool> MAIN_JIT_ENTRY_HINTS{{System::Main, "Core", "JITEntryHints"}, false};
+const Info<bool> MAIN_HLE_SDK_FUNCTIONS{{System::Main, "Core", "HLESDKFunctions"}, false};
+const Info<bool> MAIN_HLE_MEMCPY{{System::Main, "Core", "HLEMemcpy"}, true};
+const Info<bool> MAIN_HLE_MEMSET{{System::Main, "Core", "HLEMemset"}, true};
+const Info<bool> MAIN_HLE_DC_FLUSH_RANGE{{System::Main, "Core", "HLEDCFlushRange"}, true};
+const Info<bool> MAIN_HLE_DC_STORE_RANGE{{System::Main, "Core", "HLEDCStoreRange"}, true};
+const Info<bool> MAIN_HLE_PSMTX_CONCAT{{System::Main, "Core", "HLEPSMTXConcat"}, true};
+const Info<bool> MAIN_HLE_PSMTX_IDENTITY{{System::Main, "Core", "HLEPSMTXIdentity"}, true};
 const Info<bool> MAIN_DSP_HLE{{System::Main, "Core", "DSPHLE"}, true};
 const Info<int> MAIN_TIMING_VARIANCE{{System::Main, "Core", "TimingVariance"}, 40};
 const Info<bool> MAIN_CPU_THREAD{{System::Main, "Core", "CPUThread"}, true};
@@ -112,6 +128,14 @@ const Info<DiscIO::Region> MAIN_FALLBACK_REGION{{System::Main, "Core", "Fallback
 const Info<bool> MAIN_AUTO_DISC_CHANGE{{System::Main, "Core", "AutoDiscChange"}, false};
 const Info<bool> MAIN_ALLOW_SD_WRITES{{System::Main, "Core", "WiiSDCardAllowWrites"}, true};
 const Info<bool> MAIN_ENABLE_SAVESTATES{{System::Main, "Core", "EnableSaveStates"}, false};
+const Info<bool> MAIN_REWIND_ENABLE{{System::Main, "Core", "RewindEnable"}, false};
+// In frames.
+const Info<u32> MAIN_REWIND_INTERVAL{{System::Main, "Core", "RewindInterval"}, 10};
+// In MiB.
+const Info<u32> MAIN_REWIND_MEMORY_BUDGET{{System::Main, "Core", "RewindMemoryBudget"}, 256};
+const Info<bool> MAIN_TURBO_MODE{{System::Main, "Core", "TurboMode"}, false};
+// In frames.
+const Info<u32> MAIN_TURBO_PRESENT_INTERVAL{{System::Main, "Core", "TurboPresentInterval"}, 60};
 
 // Main.Display
 
@@ -28,6 +28,25 @@ extern const Info<bool> MAIN_LOAD_IPL_DUMP;
 extern const Info<PowerPC::CPUCore> MAIN_CPU_CORE;
 extern const Info<bool> MAIN_JIT_FOLLOW_BRANCH;
 extern const Info<bool> MAIN_FASTMEM;
+// Keeps a per-game list of the blocks Jit64 compiled, and compiles them again before the guest
+// reaches them in later sessions. No generated code is stored.
+extern const Info<bool> MAIN_JIT_DISK_CACHE;
+extern const Info<bool> MAIN_JIT_TIERED_COMPILATION;
+// Number of times a block runs in the cached interpreter before Jit64 compiles it.
+extern const Info<u32> MAIN_JIT_TIER_UP_THRESHOLD;
+extern const Info<bool> MAIN_JIT_BACKGROUND_COMPILATION;
+extern const Info<bool> MAIN_JIT_REGION_COMPILATION;
+// Specializes blocks for the register state the code around them suggests, see
+// PPCAnalyzer::ComputeEntryHints.
+extern const Info<bool> MAIN_JIT_ENTRY_HINTS;
+// Replaces SDK functions found at boot with native implementations, see HLE_SDK.
+extern const Info<bool> MAIN_HLE_SDK_FUNCTIONS;
+extern const Info<bool> MAIN_HLE_MEMCPY;
+extern const Info<bool> MAIN_HLE_MEMSET;
+extern const Info<bool> MAIN_HLE_DC_FLUSH_RANGE;
+extern const Info<bool> MAIN_HLE_DC_STORE_RANGE;
+extern const Info<bool> MAIN_HLE_PSMTX_CONCAT;
+extern const Info<bool> MAIN_HLE_PSMTX_IDENTITY;
 // Should really be in the DSP section, but we're kind of stuck with bad decisions made in the past.
 extern const Info<bool> MAIN_DSP_HLE;
 extern const Info<int> MAIN_TIMING_VARIANCE;
@@ -89,6 +108,11 @@ extern const Info<u32> MAIN_CUSTOM_RTC_VALUE;
 extern const Info<bool> MAIN_AUTO_DISC_CHANGE;
 extern const Info<bool> MAIN_ALLOW_SD_WRITES;
 extern const Info<bool> MAIN_ENABLE_SAVESTATES;
+extern const Info<bool> MAIN_REWIND_ENABLE;
+extern const Info<u32> MAIN_REWIND_INTERVAL;
+extern const Info<u32> MAIN_REWIND_MEMORY_BUDGET;
+extern const Info<bool> MAIN_TURBO_MODE;
+extern const Info<u32> MAIN_TURBO_PRESENT_INTERVAL;
 extern const Info<DiscIO::Region> MAIN_FALLBACK_REGION;
 
 // Main.DSP
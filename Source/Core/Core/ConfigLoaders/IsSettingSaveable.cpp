@@ -33,7 +33,7 @@ bool IsSettingSaveable(const Config::Location& config_location)
     }
   }
 
-  static constexpr std::array<const Config::Location*, 17> s_setting_saveable = {
+  static constexpr std::array<const Config::Location*, 33> s_setting_saveable = {
       // Main.Core
 
       &Config::MAIN_DEFAULT_ISO.location,
@@ -48,6 +48,22 @@ bool IsSettingSaveable(const Config::Location& config_location)
       &Config::MAIN_MEM2_SIZE.location,
       &Config::MAIN_GFX_BACKEND.location,
       &Config::MAIN_ENABLE_SAVESTATES.location,
+      &Config::MAIN_JIT_DISK_CACHE.location,
+      &Config::MAIN_JIT_TIERED_COMPILATION.location,
+      &Config::MAIN_JIT_TIER_UP_THRESHOLD.location,
+      &Config::MAIN_JIT_BACKGROUND_COMPILATION.location,
+      &Config::MAIN_JIT_REGION_COMPILATION.location,
+      &Config::MAIN_JIT_ENTRY_HINTS.location,
+      &Config::MAIN_HLE_SDK_FUNCTIONS.location,
+      &Config::MAIN_HLE_MEMCPY.location,
+      &Config::MAIN_HLE_MEMSET.location,
+      &Config::MAIN_HLE_DC_FLUSH_RANGE.location,
+      &Config::MAIN_HLE_DC_STORE_RANGE.location,
+      &Config::MAIN_HLE_PSMTX_CONCAT.location,
+      &Config::MAIN_HLE_PSMTX_IDENTITY.location,
+      &Config::MAIN_REWIND_ENABLE.location,
+      &Config::MAIN_REWIND_INTERVAL.location,
+      &Config::MAIN_REWIND_MEMORY_BUDGET.location,
       &Config::MAIN_FALLBACK_REGION.location,
 
       // Main.Interface
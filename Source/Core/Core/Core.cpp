@@ -62,7 +62,10 @@
 #include "Core/PatchEngine.h"
 #include "Core/PowerPC/JitInterface.h"
 #include "Core/PowerPC/PowerPC.h"
+#include "Core/PowerPC/SamplingProfiler.h"
+#include "Core/Rewind.h"
 #include "Core/State.h"
+#include "Core/Turbo.h"
 #include "Core/WiiRoot.h"
 
 #ifdef USE_GDBSTUB
@@ -92,6 +95,7 @@
 namespace JsCallbacks {
 
 std::function<void()> on_tick;
+std::function<void()> on_frame_end;
 std::function<void()> on_state_change_begin;
 std::function<void()> on_state_change_end;
 
@@ -104,6 +108,15 @@ inline void CallOnTick() {
     on_tick();
 }
 
+void SetOnFrameEnd(std::function<void()> function) {
+  on_frame_end = function;
+}
+
+inline void CallOnFrameEnd() {
+  if (on_frame_end)
+    on_frame_end();
+}
+
 void SetOnStateChangeBegin(std::function<void()> function) {
   on_state_change_begin = function;
 }
@@ -186,7 +199,15 @@ void OnFrameEnd()
     s_memory_watcher->Step();
 #endif
 
+  SamplingProfiler::OnFrameEnd();
+
   JsCallbacks::CallOnTick();
+  JsCallbacks::CallOnFrameEnd();
+
+  // After the frame end callbacks, so that states queued by them are taken before a rewind step.
+  Rewind::OnFrameEnd();
+
+  Turbo::OnFrameEnd();
 }
 
 // Display messages and return values
@@ -391,6 +412,7 @@ static void CpuThread(const std::optional<std::string>& savestate_path, bool del
 
   s_is_started = true;
   CPUSetInitialExecutionState();
+  SamplingProfiler::OnCPUThreadStart();
 
 #ifdef USE_GDBSTUB
 #ifndef _WIN32
@@ -412,6 +434,8 @@ static void CpuThread(const std::optional<std::string>& savestate_path, bool del
   // Enter CPU run loop. When we leave it - we are done.
   CPU::Run();
 
+  SamplingProfiler::OnCPUThreadStop();
+
 #ifdef USE_MEMORYWATCHER
   s_memory_watcher.reset();
 #endif
@@ -853,6 +877,7 @@ void RunOnCPUThread(std::function<void()> function, bool wait_for_completion)
   if (!IsRunning() || IsCPUThread())
   {
     function();
+    JsCallbacks::CallOnStateChangeEnd();
     return;
   }
 
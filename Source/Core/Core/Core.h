@@ -23,6 +23,7 @@ struct WindowSystemInfo;
 namespace JsCallbacks {
 
 void SetOnTick(std::function<void()> function);
+void SetOnFrameEnd(std::function<void()> function);
 void SetOnStateChangeBegin(std::function<void()> function);
 void SetOnStateChangeEnd(std::function<void()> function);
 
@@ -74,6 +74,9 @@ static u64 s_fake_dec_start_ticks;
 // Are we in a function that has been called from Advance()
 static bool s_is_global_timer_sane;
 
+// Only accessed from the CPU thread.
+static std::vector<std::function<void()>> s_between_slices_jobs;
+
 Globals g;
 
 static EventType* s_ev_lost = nullptr;
@@ -145,6 +148,7 @@ void Shutdown()
   MoveEvents();
   ClearPendingEvents();
   UnregisterAllEvents();
+  s_between_slices_jobs.clear();
 }
 
 void DoState(PointerWrap& p)
@@ -347,6 +351,21 @@ void Advance()
   // until the next slice:
   //        Pokemon Box refuses to boot if the first exception from the audio DMA is received late
   PowerPC::CheckExternalExceptions();
+
+  // The queue is consistent again, so this is the same point the CPU thread pauses at. A job may
+  // load a state, replacing the queue, the slice length and the PC the dispatcher continues at.
+  if (!s_between_slices_jobs.empty())
+  {
+    std::vector<std::function<void()>> jobs;
+    jobs.swap(s_between_slices_jobs);
+    for (const auto& job : jobs)
+      job();
+  }
+}
+
+void RunBetweenSlices(std::function<void()> function)
+{
+  s_between_slices_jobs.push_back(std::move(function));
 }
 
 void LogPendingEvents()
@@ -14,6 +14,7 @@
 #include "Core/GeckoCode.h"
 #include "Core/HLE/HLE_Misc.h"
 #include "Core/HLE/HLE_OS.h"
+#include "Core/HLE/HLE_SDK.h"
 #include "Core/HW/Memmap.h"
 #include "Core/IOS/ES/ES.h"
 #include "Core/PowerPC/PPCSymbolDB.h"
@@ -25,7 +26,7 @@ namespace HLE
 static std::map<u32, u32> s_hooked_addresses;
 
 // clang-format off
-constexpr std::array<Hook, 23> os_patches{{
+constexpr std::array<Hook, 29> os_patches{{
     // Placeholder, os_patches[0] is the "non-existent function" index
     {"FAKE_TO_SKIP_0",               HLE_Misc::UnimplementedFunction,       HookType::Replace, HookFlag::Generic},
 
@@ -55,6 +56,14 @@ constexpr std::array<Hook, 23> os_patches{{
     {"___blank",                     HLE_OS::HLE_GeneralDebugPrint,         HookType::Start,   HookFlag::Debug}, // used for early init things (normally)
     {"__write_console",              HLE_OS::HLE_write_console,             HookType::Start,   HookFlag::Debug}, // used by sysmenu (+more?)
 
+    // Hot SDK functions
+    {"memcpy",                       HLE_SDK::Memcpy,                       HookType::Replace, HookFlag::SDK},
+    {"__fill_mem",                   HLE_SDK::FillMem,                      HookType::Replace, HookFlag::SDK},
+    {"DCFlushRange",                 HLE_SDK::DCFlushRange,                 HookType::Replace, HookFlag::SDK},
+    {"DCStoreRange",                 HLE_SDK::DCStoreRange,                 HookType::Replace, HookFlag::SDK},
+    {"PSMTXConcat",                  HLE_SDK::PSMTXConcat,                  HookType::Replace, HookFlag::SDK},
+    {"PSMTXIdentity",                HLE_SDK::PSMTXIdentity,                HookType::Replace, HookFlag::SDK},
+
     {"GeckoCodehandler",             HLE_Misc::GeckoCodeHandlerICacheFlush, HookType::Start,   HookFlag::Fixed},
     {"GeckoHandlerReturnTrampoline", HLE_Misc::GeckoReturnTrampoline,       HookType::Replace, HookFlag::Fixed},
     {"AppLoaderReport",              HLE_OS::HLE_GeneralDebugPrint,         HookType::Replace, HookFlag::Fixed} // apploader needs OSReport-like function
@@ -116,6 +125,9 @@ void PatchFunctions()
 
     for (const auto& symbol : g_symbolDB.GetSymbolsFromName(os_patches[i].name))
     {
+      if (os_patches[i].flags == HookFlag::SDK && !HLE_SDK::CanReplace(*symbol))
+        continue;
+
       for (u32 addr = symbol->address; addr < symbol->address + symbol->size; addr += 4)
       {
         s_hooked_addresses[addr] = i;
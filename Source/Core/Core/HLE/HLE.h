@@ -24,6 +24,7 @@ enum class HookFlag
   Generic,  // Miscellaneous function
   Debug,    // Debug output function
   Fixed,    // An arbitrary hook mapped to a fixed address instead of a symbol
+  SDK,      // Native implementation of an SDK function, only for the versions it was written for
 };
 
 struct Hook
@@ -0,0 +1,357 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "Core/HLE/HLE_SDK.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <optional>
+#include <string_view>
+
+#include "Common/BitUtils.h"
+#include "Common/CommonPaths.h"
+#include "Common/CommonTypes.h"
+#include "Common/Config/Config.h"
+#include "Common/FileUtil.h"
+#include "Common/Logging/Log.h"
+#include "Common/SymbolDB.h"
+#include "Core/Config/MainSettings.h"
+#include "Core/HW/Memmap.h"
+#include "Core/PowerPC/Interpreter/Interpreter_FPUtils.h"
+#include "Core/PowerPC/JitInterface.h"
+#include "Core/PowerPC/MMU.h"
+#include "Core/PowerPC/PPCAnalyst.h"
+#include "Core/PowerPC/PPCSymbolDB.h"
+#include "Core/PowerPC/PowerPC.h"
+#include "Core/PowerPC/SignatureDB/SignatureDB.h"
+
+namespace HLE_SDK
+{
+struct KnownVersion
+{
+  u32 size;
+  // As computed by HashSignatureDB::ComputeCodeChecksum, and stored in the signature database.
+  u32 checksum;
+};
+
+struct Replacement
+{
+  std::string_view name;
+  const Config::Info<bool>& setting;
+  std::array<std::optional<KnownVersion>, 2> versions;
+};
+
+// The names must match the ones in HLE.cpp.
+static const std::array<Replacement, 6> s_replacements{{
+    {"memcpy", Config::MAIN_HLE_MEMCPY, {KnownVersion{80, 0xc0437c6b}}},
+    {"__fill_mem",
+     Config::MAIN_HLE_MEMSET,
+     {KnownVersion{184, 0x6135bf56}, KnownVersion{180, 0x7d3b05ae}}},
+    {"DCFlushRange", Config::MAIN_HLE_DC_FLUSH_RANGE, {KnownVersion{48, 0xf93836a7}}},
+    {"DCStoreRange", Config::MAIN_HLE_DC_STORE_RANGE, {KnownVersion{48, 0xf9383aa7}}},
+    {"PSMTXConcat", Config::MAIN_HLE_PSMTX_CONCAT, {KnownVersion{204, 0xb43f37f8}}},
+    {"PSMTXIdentity", Config::MAIN_HLE_PSMTX_IDENTITY, {KnownVersion{44, 0x918c27e0}}},
+}};
+
+constexpr u32 PAGE_SIZE = 0x1000;
+constexpr u32 CACHE_LINE_SIZE = 32;
+
+// Returns a host pointer to size bytes of RAM at the effective address, or nullptr if the range
+// isn't plain RAM. The range must not cross a page boundary, as pages may not be contiguous.
+static u8* GetRAMPointer(u32 address, u32 size)
+{
+  if (PowerPC::memchecks.HasAny())
+    return nullptr;
+
+  u32 physical_address = address;
+  if (MSR.DR)
+  {
+    const std::optional<u32> translated = PowerPC::GetTranslatedAddress(address);
+    if (!translated)
+      return nullptr;
+    physical_address = *translated;
+  }
+
+  return Memory::TryGetPointer(physical_address, size);
+}
+
+// Copies in the same direction as the guest code, which matters when the ranges overlap.
+static void CopyRange(u32 dest, u32 src, u32 size, bool backwards)
+{
+  while (size != 0)
+  {
+    u32 chunk;
+    u32 chunk_dest;
+    u32 chunk_src;
+    if (backwards)
+    {
+      const u32 dest_end = dest + size;
+      const u32 src_end = src + size;
+      chunk = std::min({size, (dest_end - 1) % PAGE_SIZE + 1, (src_end - 1) % PAGE_SIZE + 1});
+      chunk_dest = dest_end - chunk;
+      chunk_src = src_end - chunk;
+    }
+    else
+    {
+      chunk = std::min({size, PAGE_SIZE - dest % PAGE_SIZE, PAGE_SIZE - src % PAGE_SIZE});
+      chunk_dest = dest;
+      chunk_src = src;
+      dest += chunk;
+      src += chunk;
+    }
+    size -= chunk;
+
+    u8* const dest_ptr = GetRAMPointer(chunk_dest, chunk);
+    const u8* const src_ptr = GetRAMPointer(chunk_src, chunk);
+    if (dest_ptr && src_ptr)
+    {
+      std::memmove(dest_ptr, src_ptr, chunk);
+    }
+    else if (backwards)
+    {
+      for (u32 i = chunk; i > 0; --i)
+        PowerPC::HostWrite_U8(PowerPC::HostRead_U8(chunk_src + i - 1), chunk_dest + i - 1);
+    }
+    else
+    {
+      for (u32 i = 0; i < chunk; ++i)
+        PowerPC::HostWrite_U8(PowerPC::HostRead_U8(chunk_src + i), chunk_dest + i);
+    }
+  }
+}
+
+static void FillRange(u32 dest, u8 value, u32 size)
+{
+  while (size != 0)
+  {
+    const u32 chunk = std::min(size, PAGE_SIZE - dest % PAGE_SIZE);
+
+    u8* const dest_ptr = GetRAMPointer(dest, chunk);
+    if (dest_ptr)
+    {
+      std::memset(dest_ptr, value, chunk);
+    }
+    else
+    {
+      for (u32 i = 0; i < chunk; ++i)
+        PowerPC::HostWrite_U8(value, dest + i);
+    }
+
+    dest += chunk;
+    size -= chunk;
+  }
+}
+
+// void* memcpy(void* dest, const void* src, size_t n)
+// This version copies byte by byte, backwards if src is below dest, so overlapping ranges work.
+void Memcpy()
+{
+  const u32 dest = GPR(3);
+  const u32 src = GPR(4);
+  const u32 size = GPR(5);
+
+  CopyRange(dest, src, size, src < dest);
+
+  // r3 already holds the return value.
+  NPC = LR;
+}
+
+// void __fill_mem(void* dest, int value, size_t n), called by memset.
+void FillMem()
+{
+  FillRange(GPR(3), static_cast<u8>(GPR(4)), GPR(5));
+  NPC = LR;
+}
+
+// Both run dcbf or dcbst on every cache line of the range, then sc to synchronize. The system call
+// handler of the OS has no visible effect, so it is skipped.
+static void InvalidateCacheLines(u32 address, u32 size)
+{
+  if (size == 0)
+    return;
+
+  const u32 line_count =
+      (address % CACHE_LINE_SIZE + size + CACHE_LINE_SIZE - 1) / CACHE_LINE_SIZE;
+  // Like the interpreter's dcbf and dcbst, invalidate the JIT cache as a heuristic.
+  JitInterface::InvalidateICache(address & ~(CACHE_LINE_SIZE - 1), line_count * CACHE_LINE_SIZE,
+                                 false);
+}
+
+// void DCFlushRange(void* start, u32 size)
+void DCFlushRange()
+{
+  InvalidateCacheLines(GPR(3), GPR(4));
+  NPC = LR;
+}
+
+// void DCStoreRange(void* start, u32 size)
+void DCStoreRange()
+{
+  InvalidateCacheLines(GPR(3), GPR(4));
+  NPC = LR;
+}
+
+// The matrix functions use psq_l and psq_st with GQR0, which the SDK reserves for unscaled
+// floats, so the matrices are read and written as plain singles.
+static double ReadSingle(u32 address)
+{
+  return Common::BitCast<double>(ConvertToDouble(PowerPC::HostRead_U32(address)));
+}
+
+static void WriteSingle(double value, u32 address)
+{
+  PowerPC::HostWrite_U32(ConvertToSingleFTZ(Common::BitCast<u64>(value)), address);
+}
+
+// The same arithmetic as the interpreter's ps_muls and ps_madds.
+static double MulSingle(double a, double c)
+{
+  return ForceSingle(FPSCR, NI_mul(&FPSCR, a, Force25Bit(c)).value);
+}
+
+static double MaddSingle(double a, double c, double b)
+{
+  return ForceSingle(FPSCR, NI_madd(&FPSCR, a, Force25Bit(c), b).value);
+}
+
+using Mtx = std::array<std::array<double, 4>, 3>;
+
+static Mtx ReadMtx(u32 address)
+{
+  Mtx m;
+  for (u32 i = 0; i < 3; ++i)
+  {
+    for (u32 j = 0; j < 4; ++j)
+      m[i][j] = ReadSingle(address + (i * 4 + j) * sizeof(u32));
+  }
+  return m;
+}
+
+static void WriteMtx(const Mtx& m, u32 address)
+{
+  for (u32 i = 0; i < 3; ++i)
+  {
+    for (u32 j = 0; j < 4; ++j)
+      WriteSingle(m[i][j], address + (i * 4 + j) * sizeof(u32));
+  }
+}
+
+// void PSMTXConcat(const Mtx a, const Mtx b, Mtx ab)
+// Both inputs are read before ab is written, so ab may be the same matrix as a or b.
+void PSMTXConcat()
+{
+  const Mtx a = ReadMtx(GPR(3));
+  const Mtx b = ReadMtx(GPR(4));
+
+  // The last two columns are computed as a pair, which also adds a[i][3] times (0, 1).
+  static constexpr std::array<double, 4> last_row{0.0, 0.0, 0.0, 1.0};
+
+  Mtx ab;
+  for (u32 i = 0; i < 3; ++i)
+  {
+    for (u32 j = 0; j < 4; ++j)
+    {
+      double sum = MulSingle(b[0][j], a[i][0]);
+      sum = MaddSingle(b[1][j], a[i][1], sum);
+      sum = MaddSingle(b[2][j], a[i][2], sum);
+      if (j >= 2)
+        sum = MaddSingle(last_row[j], a[i][3], sum);
+      ab[i][j] = sum;
+    }
+  }
+
+  // The SDK's code ends with the ps_madds1 that computes ab[2][2] and ab[2][3], which sets FPRF
+  // from the first of the pair.
+  PowerPC::UpdateFPRF(ab[2][2]);
+
+  WriteMtx(ab, GPR(5));
+  NPC = LR;
+}
+
+// void PSMTXIdentity(Mtx m)
+void PSMTXIdentity()
+{
+  const u32 address = GPR(3);
+  for (u32 i = 0; i < 3; ++i)
+  {
+    for (u32 j = 0; j < 4; ++j)
+      WriteSingle(i == j ? 1.0 : 0.0, address + (i * 4 + j) * sizeof(u32));
+  }
+  NPC = LR;
+}
+
+static const Replacement* FindReplacement(std::string_view name)
+{
+  const auto it = std::find_if(s_replacements.begin(), s_replacements.end(),
+                               [name](const Replacement& r) { return r.name == name; });
+  return it != s_replacements.end() ? &*it : nullptr;
+}
+
+bool FindFunctions()
+{
+  if (!Config::Get(Config::MAIN_HLE_SDK_FUNCTIONS))
+    return false;
+
+  const bool all_named =
+      std::all_of(s_replacements.begin(), s_replacements.end(), [](const Replacement& r) {
+        return !g_symbolDB.GetSymbolsFromName(r.name).empty();
+      });
+  if (all_named)
+    return false;
+
+  SignatureDB db(SignatureDB::HandlerType::DSY);
+  if (!db.Load(File::GetSysDirectory() + TOTALDB))
+  {
+    WARN_LOG_FMT(OSHLE, "Couldn't load {}, SDK functions won't be replaced", TOTALDB);
+    return false;
+  }
+
+  // Scan into a separate database, so that the debugger's symbols only gain the functions that
+  // are replaced rather than every function in memory.
+  PPCSymbolDB scanned;
+  PPCAnalyst::FindFunctions(Memory::MEM1_BASE_ADDR,
+                            Memory::MEM1_BASE_ADDR + Memory::GetRamSizeReal(), &scanned);
+  db.Apply(&scanned);
+
+  bool found = false;
+  for (const Replacement& replacement : s_replacements)
+  {
+    if (!g_symbolDB.GetSymbolsFromName(replacement.name).empty())
+      continue;
+
+    for (const Common::Symbol* symbol : scanned.GetSymbolsFromName(replacement.name))
+    {
+      g_symbolDB.AddKnownSymbol(symbol->address, symbol->size, symbol->name);
+      found = true;
+    }
+  }
+
+  if (found)
+    g_symbolDB.Index();
+  return found;
+}
+
+bool CanReplace(const Common::Symbol& symbol)
+{
+  if (!Config::Get(Config::MAIN_HLE_SDK_FUNCTIONS))
+    return false;
+
+  const Replacement* replacement = FindReplacement(symbol.name);
+  if (!replacement || !Config::Get(replacement->setting))
+    return false;
+
+  const u32 checksum =
+      HashSignatureDB::ComputeCodeChecksum(symbol.address, symbol.address + symbol.size - 4);
+  for (const std::optional<KnownVersion>& version : replacement->versions)
+  {
+    if (version && version->size == symbol.size && version->checksum == checksum)
+      return true;
+  }
+
+  WARN_LOG_FMT(OSHLE, "Not replacing {} at {:08x}: unknown version (size {}, checksum {:08x})",
+               symbol.name, symbol.address, symbol.size, checksum);
+  return false;
+}
+}  // namespace HLE_SDK
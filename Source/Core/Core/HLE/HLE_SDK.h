@@ -0,0 +1,33 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+namespace Common
+{
+struct Symbol;
+}
+
+// Native implementations of SDK functions that games spend a lot of time in.
+//
+// A replacement has to do exactly what the guest code does, so each one is tied to the versions
+// of the function it was written from, identified by the size and signature database checksum of
+// their code. Functions with a matching name but different code are left alone.
+namespace HLE_SDK
+{
+void Memcpy();
+void FillMem();
+void DCFlushRange();
+void DCStoreRange();
+void PSMTXConcat();
+void PSMTXIdentity();
+
+// Uses the signature database to name the replaceable functions that don't already have a
+// symbol, for example from a map file. Does nothing unless SDK function replacement is enabled.
+// Returns whether any symbol was added.
+bool FindFunctions();
+
+// Whether the replacement of the function is enabled and implements this version of it.
+bool CanReplace(const Common::Symbol& symbol);
+}  // namespace HLE_SDK
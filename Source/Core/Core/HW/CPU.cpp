@@ -118,6 +118,7 @@ void Run()
 
       // Enter a fast runloop
       PowerPC::RunLoop();
+      Fifo::CPUThreadStopped();
 
       state_lock.lock();
       s_state_cpu_thread_active = false;
@@ -24,7 +24,9 @@
 #include "Core/HW/VideoInterface.h"
 #include "Core/HW/WII_IPC.h"
 #include "Core/IOS/IOS.h"
+#include "Core/Rewind.h"
 #include "Core/State.h"
+#include "Core/Turbo.h"
 #include "Core/WiiRoot.h"
 
 namespace HW
@@ -35,6 +37,8 @@ void Init()
   SystemTimers::PreInit();
 
   State::Init();
+  Rewind::Init();
+  Turbo::Init();
 
   // Init the whole Hardware
   AudioInterface::Init();
@@ -75,6 +79,8 @@ void Shutdown()
   SerialInterface::Shutdown();
   AudioInterface::Shutdown();
 
+  Turbo::Shutdown();
+  Rewind::Shutdown();
   State::Shutdown();
   CoreTiming::Shutdown();
 }
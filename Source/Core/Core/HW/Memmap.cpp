@@ -389,6 +389,31 @@ void UpdateLogicalMemory(const PowerPC::BatTable& dbat_table)
   }
 }
 
+u8* CreateHostView(u32 physical_address, u32 size)
+{
+  if (!m_IsInitialized)
+    return nullptr;
+
+  u32 flags = GetFlags();
+  for (PhysicalMemoryRegion& region : physical_regions)
+  {
+    if ((flags & region.flags) != region.flags)
+      continue;
+
+    if (region.physical_address != physical_address || size > region.size)
+      continue;
+
+    return static_cast<u8*>(g_arena.CreateView(region.shm_position, size));
+  }
+
+  return nullptr;
+}
+
+void ReleaseHostView(u8* view, u32 size)
+{
+  g_arena.ReleaseView(view, size);
+}
+
 void DoState(PointerWrap& p)
 {
   bool wii = SConfig::GetInstance().bWii;
@@ -551,6 +576,22 @@ u8* GetPointer(u32 address)
   return nullptr;
 }
 
+u8* TryGetPointer(u32 address, u32 size)
+{
+  address &= 0x3FFFFFFF;
+  if (m_pRAM && address < GetRamSizeReal() && size <= GetRamSizeReal() - address)
+    return m_pRAM + address;
+
+  if (m_pEXRAM && (address >> 28) == 0x1)
+  {
+    address &= 0x0FFFFFFF;
+    if (address < GetExRamSizeReal() && size <= GetExRamSizeReal() - address)
+      return m_pEXRAM + address;
+  }
+
+  return nullptr;
+}
+
 u8 Read_U8(u32 address)
 {
   return *GetPointer(address);
@@ -69,12 +69,22 @@ void DoState(PointerWrap& p);
 
 void UpdateLogicalMemory(const PowerPC::BatTable& dbat_table);
 
+// Maps an additional host view of the physical memory region starting at physical_address
+// (0x00000000 for MEM1, 0x10000000 for MEM2). The view aliases the same backing memory as
+// m_pRAM/m_pEXRAM, but it is owned by the caller and stays mapped after Shutdown(), so it
+// must be released with ReleaseHostView() using the same size.
+u8* CreateHostView(u32 physical_address, u32 size);
+void ReleaseHostView(u8* view, u32 size);
+
 void Clear();
 
 // Routines to access physically addressed memory, designed for use by
 // emulated hardware outside the CPU. Use "Device_" prefix.
 std::string GetString(u32 em_address, size_t size = 0);
 u8* GetPointer(u32 address);
+// Like GetPointer, but returns nullptr instead of raising a panic alert when
+// [address, address + size) is not entirely backed by MEM1 or MEM2.
+u8* TryGetPointer(u32 address, u32 size);
 void CopyFromEmu(void* data, u32 address, size_t size);
 void CopyToEmu(u32 address, const void* data, size_t size);
 void Memset(u32 address, u8 value, size_t size);
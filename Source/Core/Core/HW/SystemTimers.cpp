@@ -65,6 +65,7 @@ IPC_HLE_PERIOD: For the Wii Remote this is the call schedule:
 #include "Core/IOS/IOS.h"
 #include "Core/PatchEngine.h"
 #include "Core/PowerPC/PowerPC.h"
+#include "Core/Turbo.h"
 #include "VideoCommon/Fifo.h"
 
 namespace SystemTimers
@@ -175,7 +176,8 @@ void ThrottleCallback(u64 last_time, s64 cyclesLate)
 
   s64 diff = last_time - time;
   const SConfig& config = SConfig::GetInstance();
-  bool frame_limiter = config.m_EmulationSpeed > 0.0f && !Core::GetIsThrottlerTempDisabled();
+  bool frame_limiter = config.m_EmulationSpeed > 0.0f && !Core::GetIsThrottlerTempDisabled() &&
+                       !Turbo::IsEnabled();
   u32 next_event = GetTicksPerSecond() / 1000;
 
   {
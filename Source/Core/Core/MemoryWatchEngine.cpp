@@ -0,0 +1,193 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "Core/MemoryWatchEngine.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "Common/BitSet.h"
+#include "Common/Intrinsics.h"
+#include "Common/Swap.h"
+#include "Core/HW/Memmap.h"
+
+// Differences separated by fewer equal bytes than this are reported as a single change.
+constexpr u32 MERGE_DISTANCE = 16;
+
+// Returns the index of the first byte at or after pos where a and b differ, or size if none.
+static u32 NextDifference(const u8* a, const u8* b, u32 pos, u32 size)
+{
+#ifdef _M_X86
+  for (; size - pos >= 16; pos += 16)
+  {
+    const __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + pos));
+    const __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + pos));
+    const u32 equal_mask = static_cast<u32>(_mm_movemask_epi8(_mm_cmpeq_epi8(va, vb)));
+    if (equal_mask != 0xFFFF)
+      return pos + Common::LeastSignificantSetBit(~equal_mask & 0xFFFF);
+  }
+#else
+  for (; size - pos >= 8; pos += 8)
+  {
+    u64 va, vb;
+    std::memcpy(&va, a + pos, sizeof(va));
+    std::memcpy(&vb, b + pos, sizeof(vb));
+    if (va != vb)
+      break;
+  }
+#endif
+
+  while (pos < size && a[pos] == b[pos])
+    ++pos;
+
+  return pos;
+}
+
+u32 MemoryWatchEngine::AddWatch(u32 address, u32 size, const std::vector<u32>& ptr_chain)
+{
+  Watch watch;
+  watch.id = m_next_id++;
+  watch.address = address;
+  watch.size = size;
+  watch.ptr_chain_begin = static_cast<u32>(m_ptr_chains.size());
+  watch.ptr_chain_size = static_cast<u32>(ptr_chain.size());
+  watch.snapshot_offset = static_cast<u32>(m_snapshot.size());
+  watch.resolved_address = 0;
+  watch.resolved = false;
+
+  m_ptr_chains.insert(m_ptr_chains.end(), ptr_chain.begin(), ptr_chain.end());
+  m_snapshot.resize(m_snapshot.size() + size);
+  m_watches.push_back(watch);
+
+  return watch.id;
+}
+
+void MemoryWatchEngine::RemoveWatch(u32 watch_id)
+{
+  const auto it = std::find_if(m_watches.begin(), m_watches.end(),
+                               [watch_id](const Watch& watch) { return watch.id == watch_id; });
+  if (it == m_watches.end())
+    return;
+
+  const Watch removed = *it;
+  m_watches.erase(it);
+
+  // Compact the flat arrays so they stay contiguous for the next Step().
+  m_ptr_chains.erase(m_ptr_chains.begin() + removed.ptr_chain_begin,
+                     m_ptr_chains.begin() + removed.ptr_chain_begin + removed.ptr_chain_size);
+  m_snapshot.erase(m_snapshot.begin() + removed.snapshot_offset,
+                   m_snapshot.begin() + removed.snapshot_offset + removed.size);
+
+  for (Watch& watch : m_watches)
+  {
+    if (watch.ptr_chain_begin > removed.ptr_chain_begin)
+      watch.ptr_chain_begin -= removed.ptr_chain_size;
+    if (watch.snapshot_offset > removed.snapshot_offset)
+      watch.snapshot_offset -= removed.size;
+  }
+}
+
+void MemoryWatchEngine::Clear()
+{
+  m_watches.clear();
+  m_ptr_chains.clear();
+  m_snapshot.clear();
+  m_changes.clear();
+}
+
+bool MemoryWatchEngine::IsEmpty() const
+{
+  return m_watches.empty();
+}
+
+const MemoryWatchEngine::Watch* MemoryWatchEngine::FindWatch(u32 watch_id) const
+{
+  const auto it = std::find_if(m_watches.begin(), m_watches.end(),
+                               [watch_id](const Watch& watch) { return watch.id == watch_id; });
+  return it != m_watches.end() ? &*it : nullptr;
+}
+
+const u8* MemoryWatchEngine::GetSnapshot(u32 watch_id) const
+{
+  const Watch* watch = FindWatch(watch_id);
+  return watch ? m_snapshot.data() + watch->snapshot_offset : nullptr;
+}
+
+u32 MemoryWatchEngine::GetResolvedAddress(u32 watch_id) const
+{
+  const Watch* watch = FindWatch(watch_id);
+  return watch ? watch->resolved_address : 0;
+}
+
+bool MemoryWatchEngine::Resolve(const Watch& watch, u32* address) const
+{
+  u32 current = watch.address;
+  for (u32 i = 0; i < watch.ptr_chain_size; ++i)
+  {
+    const u8* pointer = Memory::TryGetPointer(current, sizeof(u32));
+    if (!pointer)
+      return false;
+
+    current = Common::swap32(pointer) + m_ptr_chains[watch.ptr_chain_begin + i];
+  }
+
+  *address = current;
+  return true;
+}
+
+void MemoryWatchEngine::Diff(Watch& watch, const u8* current)
+{
+  u8* snapshot = m_snapshot.data() + watch.snapshot_offset;
+
+  u32 pos = NextDifference(current, snapshot, 0, watch.size);
+  while (pos < watch.size)
+  {
+    const u32 begin = pos;
+    u32 end = pos + 1;
+
+    while (true)
+    {
+      pos = NextDifference(current, snapshot, end, watch.size);
+      if (pos == watch.size || pos - end >= MERGE_DISTANCE)
+        break;
+
+      end = pos + 1;
+    }
+
+    std::memcpy(snapshot + begin, current + begin, end - begin);
+    m_changes.push_back({watch.id, begin, end - begin});
+  }
+}
+
+const std::vector<MemoryWatchEngine::Change>& MemoryWatchEngine::Step()
+{
+  m_changes.clear();
+
+  for (Watch& watch : m_watches)
+  {
+    u32 address;
+    const u8* current = nullptr;
+    if (Resolve(watch, &address))
+      current = Memory::TryGetPointer(address, watch.size);
+
+    if (!current)
+    {
+      watch.resolved = false;
+      continue;
+    }
+
+    if (!watch.resolved || watch.resolved_address != address)
+    {
+      watch.resolved = true;
+      watch.resolved_address = address;
+      std::memcpy(m_snapshot.data() + watch.snapshot_offset, current, watch.size);
+      m_changes.push_back({watch.id, 0, watch.size});
+      continue;
+    }
+
+    Diff(watch, current);
+  }
+
+  return m_changes;
+}
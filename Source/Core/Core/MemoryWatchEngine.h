@@ -0,0 +1,68 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+// MemoryWatchEngine tracks a set of guest memory ranges and reports which bytes changed since the
+// previous Step(). Pointer chains are parsed once into flat offset arrays and re-followed every
+// step, and each range is compared 16 bytes at a time against a flat snapshot buffer.
+//
+// A range whose resolved address changes (including the first time it resolves) is reported as
+// changed in its entirety. Ranges that cannot be resolved are skipped until they can.
+//
+// The engine is not thread-safe; Step() is meant to be called on the CPU thread.
+class MemoryWatchEngine final
+{
+public:
+  struct Change
+  {
+    u32 watch_id;
+    // Offset of the first changed byte within the watched range.
+    u32 offset;
+    u32 size;
+  };
+
+  // Follows ptr_chain the same way as Memmap.readPtr*: each step reads the u32 at the current
+  // address and adds the next offset.
+  u32 AddWatch(u32 address, u32 size, const std::vector<u32>& ptr_chain = {});
+  void RemoveWatch(u32 watch_id);
+  void Clear();
+  bool IsEmpty() const;
+
+  // Compares every range against its snapshot and updates the snapshot. The returned changes stay
+  // valid until the next call to Step().
+  const std::vector<Change>& Step();
+
+  // Returns the snapshot bytes of a watch (guest byte order), as of the last Step().
+  const u8* GetSnapshot(u32 watch_id) const;
+  // Returns the guest address a watch resolved to during the last Step().
+  u32 GetResolvedAddress(u32 watch_id) const;
+
+private:
+  struct Watch
+  {
+    u32 id;
+    u32 address;
+    u32 size;
+    u32 ptr_chain_begin;
+    u32 ptr_chain_size;
+    u32 snapshot_offset;
+    u32 resolved_address;
+    bool resolved;
+  };
+
+  const Watch* FindWatch(u32 watch_id) const;
+  bool Resolve(const Watch& watch, u32* address) const;
+  void Diff(Watch& watch, const u8* current);
+
+  u32 m_next_id = 0;
+  std::vector<Watch> m_watches;
+  std::vector<u32> m_ptr_chains;
+  std::vector<u8> m_snapshot;
+  std::vector<Change> m_changes;
+};
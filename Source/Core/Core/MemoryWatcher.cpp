@@ -4,6 +4,7 @@
 
 #include <fstream>
 #include <iostream>
+#include <set>
 #include <sstream>
 #include <unistd.h>
 
@@ -38,23 +39,30 @@ bool MemoryWatcher::LoadAddresses(const std::string& path)
   if (!locations)
     return false;
 
+  // Each distinct line is watched once, and the values are reported in the order of the lines.
+  std::set<std::string> lines;
   std::string line;
   while (std::getline(locations, line))
-    ParseLine(line);
+    lines.insert(line);
 
-  return !m_values.empty();
+  for (const std::string& unique_line : lines)
+    ParseLine(unique_line);
+
+  return !m_watches.empty();
 }
 
 void MemoryWatcher::ParseLine(const std::string& line)
 {
-  m_values[line] = 0;
-  m_addresses[line] = std::vector<u32>();
+  const u32 offsets_begin = static_cast<u32>(m_offsets.size());
 
   std::istringstream offsets(line);
   offsets >> std::hex;
   u32 offset;
   while (offsets >> offset)
-    m_addresses[line].push_back(offset);
+    m_offsets.push_back(offset);
+
+  m_lines.push_back(line);
+  m_watches.push_back({offsets_begin, static_cast<u32>(m_offsets.size()) - offsets_begin, 0});
 }
 
 bool MemoryWatcher::OpenSocket(const std::string& path)
@@ -66,12 +74,14 @@ bool MemoryWatcher::OpenSocket(const std::string& path)
   return m_fd >= 0;
 }
 
-u32 MemoryWatcher::ChasePointer(const std::string& line)
+u32 MemoryWatcher::ChasePointer(size_t index) const
 {
+  const Watch& watch = m_watches[index];
+
   u32 value = 0;
-  for (u32 offset : m_addresses[line])
+  for (u32 i = watch.offsets_begin; i < watch.offsets_begin + watch.offsets_size; ++i)
   {
-    value = Memory::Read_U32(value + offset);
+    value = Memory::Read_U32(value + m_offsets[i]);
     if (!PowerPC::HostIsRAMAddress(value))
       break;
   }
@@ -83,17 +93,14 @@ std::string MemoryWatcher::ComposeMessages()
   std::ostringstream message_stream;
   message_stream << std::hex;
 
-  for (auto& entry : m_values)
+  for (size_t i = 0; i < m_watches.size(); ++i)
   {
-    std::string address = entry.first;
-    u32& current_value = entry.second;
-
-    u32 new_value = ChasePointer(address);
-    if (new_value != current_value)
+    const u32 new_value = ChasePointer(i);
+    if (new_value != m_watches[i].value)
     {
       // Update the value
-      current_value = new_value;
-      message_stream << address << '\n' << new_value << '\n';
+      m_watches[i].value = new_value;
+      message_stream << m_lines[i] << '\n' << new_value << '\n';
     }
   }
 
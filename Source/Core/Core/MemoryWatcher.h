@@ -4,11 +4,13 @@
 
 #pragma once
 
-#include <map>
+#include <string>
 #include <sys/socket.h>
 #include <sys/un.h>
 #include <vector>
 
+#include "Common/CommonTypes.h"
+
 // MemoryWatcher reads a file containing in-game memory addresses and outputs
 // changes to those memory addresses to a unix domain socket as the game runs.
 //
@@ -29,7 +31,7 @@ private:
   bool OpenSocket(const std::string& path);
 
   void ParseLine(const std::string& line);
-  u32 ChasePointer(const std::string& line);
+  u32 ChasePointer(size_t index) const;
   std::string ComposeMessages();
 
   bool m_running = false;
@@ -37,8 +39,17 @@ private:
   int m_fd;
   sockaddr_un m_addr{};
 
-  // Address as stored in the file -> list of offsets to follow
-  std::map<std::string, std::vector<u32>> m_addresses;
-  // Address as stored in the file -> current value
-  std::map<std::string, u32> m_values;
+  struct Watch
+  {
+    u32 offsets_begin;
+    u32 offsets_size;
+    // Current value, reported whenever it changes
+    u32 value;
+  };
+
+  // Address as stored in the file, indexed like m_watches
+  std::vector<std::string> m_lines;
+  std::vector<Watch> m_watches;
+  // Offsets to follow for every watch, stored back to back
+  std::vector<u32> m_offsets;
 };
@@ -15,39 +15,6 @@
 #include "Core/PowerPC/PPCAnalyst.h"
 #include "Core/PowerPC/PowerPC.h"
 
-struct CachedInterpreter::Instruction
-{
-  using CommonCallback = void (*)(UGeckoInstruction);
-  using ConditionalCallback = bool (*)(u32);
-
-  Instruction() {}
-  Instruction(const CommonCallback c, UGeckoInstruction i)
-      : common_callback(c), data(i.hex), type(Type::Common)
-  {
-  }
-
-  Instruction(const ConditionalCallback c, u32 d)
-      : conditional_callback(c), data(d), type(Type::Conditional)
-  {
-  }
-
-  enum class Type
-  {
-    Abort,
-    Common,
-    Conditional,
-  };
-
-  union
-  {
-    const CommonCallback common_callback;
-    const ConditionalCallback conditional_callback;
-  };
-
-  u32 data = 0;
-  Type type = Type::Abort;
-};
-
 CachedInterpreter::CachedInterpreter() = default;
 
 CachedInterpreter::~CachedInterpreter() = default;
@@ -85,8 +52,11 @@ void CachedInterpreter::ExecuteOneBlock()
     return;
   }
 
-  const Instruction* code = reinterpret_cast<const Instruction*>(normal_entry);
+  ExecuteBlock(reinterpret_cast<const Instruction*>(normal_entry));
+}
 
+void CachedInterpreter::ExecuteBlock(const Instruction* code)
+{
   for (; code->type != Instruction::Type::Abort; ++code)
   {
     switch (code->type)
@@ -190,17 +160,18 @@ static bool CheckIdle(u32 idle_pc)
   return false;
 }
 
-bool CachedInterpreter::HandleFunctionHooking(u32 address)
+bool CachedInterpreter::HandleFunctionHooking(std::vector<Instruction>& code, const JitState& js,
+                                              u32 address)
 {
   return HLE::ReplaceFunctionIfPossible(address, [&](u32 hook_index, HLE::HookType type) {
-    m_code.emplace_back(WritePC, address);
-    m_code.emplace_back(Interpreter::HLEFunction, hook_index);
+    code.emplace_back(WritePC, address);
+    code.emplace_back(Interpreter::HLEFunction, hook_index);
 
     if (type != HLE::HookType::Replace)
       return false;
 
-    m_code.emplace_back(EndBlock, js.downcountAmount);
-    m_code.emplace_back();
+    code.emplace_back(EndBlock, js.downcountAmount);
+    code.emplace_back();
     return true;
   });
 }
@@ -225,23 +196,36 @@ void CachedInterpreter::Jit(u32 address)
   }
 
   JitBlock* b = m_block_cache.AllocateBlock(PC);
-
-  js.blockStart = PC;
-  js.firstFPInstructionFound = false;
-  js.fifoBytesSinceCheck = 0;
-  js.downcountAmount = 0;
   js.curBlock = b;
 
   b->checkedEntry = GetCodePtr();
   b->normalEntry = GetCodePtr();
 
+  CompileBlock(m_code, js, jo, code_block, m_code_buffer, PC, nextPC);
+
+  b->codeSize = (u32)(GetCodePtr() - b->checkedEntry);
+  b->originalSize = code_block.m_num_instructions;
+
+  m_block_cache.FinalizeBlock(*b, jo.enableBlocklink, code_block.m_physical_addresses);
+}
+
+void CachedInterpreter::CompileBlock(std::vector<Instruction>& code, JitState& js,
+                                     const JitOptions& jo, const PPCAnalyst::CodeBlock& code_block,
+                                     const PPCAnalyst::CodeBuffer& code_buffer, u32 address,
+                                     u32 nextPC)
+{
+  js.blockStart = address;
+  js.firstFPInstructionFound = false;
+  js.fifoBytesSinceCheck = 0;
+  js.downcountAmount = 0;
+
   for (u32 i = 0; i < code_block.m_num_instructions; i++)
   {
-    PPCAnalyst::CodeOp& op = m_code_buffer[i];
+    const PPCAnalyst::CodeOp& op = code_buffer[i];
 
     js.downcountAmount += op.opinfo->numCycles;
 
-    if (HandleFunctionHooking(op.address))
+    if (HandleFunctionHooking(code, js, op.address))
       break;
 
     if (!op.skip)
@@ -255,39 +239,34 @@ void CachedInterpreter::Jit(u32 address)
 
       if (breakpoint)
       {
-        m_code.emplace_back(WritePC, op.address);
-        m_code.emplace_back(CheckBreakpoint, js.downcountAmount);
+        code.emplace_back(WritePC, op.address);
+        code.emplace_back(CheckBreakpoint, js.downcountAmount);
       }
 
       if (check_fpu)
       {
-        m_code.emplace_back(WritePC, op.address);
-        m_code.emplace_back(CheckFPU, js.downcountAmount);
+        code.emplace_back(WritePC, op.address);
+        code.emplace_back(CheckFPU, js.downcountAmount);
         js.firstFPInstructionFound = true;
       }
 
       if (endblock || memcheck)
-        m_code.emplace_back(WritePC, op.address);
-      m_code.emplace_back(PPCTables::GetInterpreterOp(op.inst), op.inst);
+        code.emplace_back(WritePC, op.address);
+      code.emplace_back(PPCTables::GetInterpreterOp(op.inst), op.inst);
       if (memcheck)
-        m_code.emplace_back(CheckDSI, js.downcountAmount);
+        code.emplace_back(CheckDSI, js.downcountAmount);
       if (idle_loop)
-        m_code.emplace_back(CheckIdle, js.blockStart);
+        code.emplace_back(CheckIdle, js.blockStart);
       if (endblock)
-        m_code.emplace_back(EndBlock, js.downcountAmount);
+        code.emplace_back(EndBlock, js.downcountAmount);
     }
   }
   if (code_block.m_broken)
   {
-    m_code.emplace_back(WriteBrokenBlockNPC, nextPC);
-    m_code.emplace_back(EndBlock, js.downcountAmount);
+    code.emplace_back(WriteBrokenBlockNPC, nextPC);
+    code.emplace_back(EndBlock, js.downcountAmount);
   }
-  m_code.emplace_back();
-
-  b->codeSize = (u32)(GetCodePtr() - b->checkedEntry);
-  b->originalSize = code_block.m_num_instructions;
-
-  m_block_cache.FinalizeBlock(*b, jo.enableBlocklink, code_block.m_physical_addresses);
+  code.emplace_back();
 }
 
 void CachedInterpreter::ClearCache()
@@ -14,6 +14,39 @@
 class CachedInterpreter : public JitBase
 {
 public:
+  struct Instruction
+  {
+    using CommonCallback = void (*)(UGeckoInstruction);
+    using ConditionalCallback = bool (*)(u32);
+
+    Instruction() {}
+    Instruction(const CommonCallback c, UGeckoInstruction i)
+        : common_callback(c), data(i.hex), type(Type::Common)
+    {
+    }
+
+    Instruction(const ConditionalCallback c, u32 d)
+        : conditional_callback(c), data(d), type(Type::Conditional)
+    {
+    }
+
+    enum class Type
+    {
+      Abort,
+      Common,
+      Conditional,
+    };
+
+    union
+    {
+      const CommonCallback common_callback;
+      const ConditionalCallback conditional_callback;
+    };
+
+    u32 data = 0;
+    Type type = Type::Abort;
+  };
+
   CachedInterpreter();
   ~CachedInterpreter();
 
@@ -32,13 +65,20 @@ public:
   const char* GetName() const override { return "Cached Interpreter"; }
   const CommonAsmRoutinesBase* GetAsmRoutines() override { return nullptr; }
 
-private:
-  struct Instruction;
+  // Appends the instructions interpreting the block analyzed into code_block and code_buffer,
+  // followed by an Abort. Also used by Jit64 for blocks that are not worth compiling yet.
+  static void CompileBlock(std::vector<Instruction>& code, JitState& js, const JitOptions& jo,
+                           const PPCAnalyst::CodeBlock& code_block,
+                           const PPCAnalyst::CodeBuffer& code_buffer, u32 address, u32 nextPC);
+  // Runs instructions appended by CompileBlock until the end of the block.
+  static void ExecuteBlock(const Instruction* code);
 
+private:
   u8* GetCodePtr();
   void ExecuteOneBlock();
 
-  bool HandleFunctionHooking(u32 address);
+  static bool HandleFunctionHooking(std::vector<Instruction>& code, const JitState& js,
+                                    u32 address);
 
   BlockCache m_block_cache{*this};
   std::vector<Instruction> m_code;
@@ -4,20 +4,30 @@
 
 #include "Core/PowerPC/Jit64/Jit.h"
 
+#include <array>
+#include <iterator>
+#include <limits>
 #include <map>
+#include <optional>
+#include <set>
 #include <sstream>
 #include <string>
+#include <vector>
 
 #include <disasm.h>
 #include <fmt/format.h>
+#include <xxhash.h>
 
 // for the PROFILER stuff
 #ifdef _WIN32
 #include <windows.h>
 #endif
 
+#include "Common/BitUtils.h"
 #include "Common/CommonTypes.h"
+#include "Common/Config/Config.h"
 #include "Common/File.h"
+#include "Common/FileUtil.h"
 #include "Common/GekkoDisassembler.h"
 #include "Common/Logging/Log.h"
 #include "Common/MemoryUtil.h"
@@ -25,6 +35,7 @@
 #include "Common/StringUtil.h"
 #include "Common/Swap.h"
 #include "Common/x64ABI.h"
+#include "Core/Config/MainSettings.h"
 #include "Core/Core.h"
 #include "Core/CoreTiming.h"
 #include "Core/HLE/HLE.h"
@@ -34,6 +45,7 @@
 #include "Core/HW/ProcessorInterface.h"
 #include "Core/MachineContext.h"
 #include "Core/PatchEngine.h"
+#include "Core/PowerPC/Interpreter/Interpreter.h"
 #include "Core/PowerPC/Jit64/JitAsm.h"
 #include "Core/PowerPC/Jit64/RegCache/JitRegCache.h"
 #include "Core/PowerPC/Jit64Common/FarCodeCache.h"
@@ -155,6 +167,13 @@ enum
   GUARD_OFFSET = STACK_SIZE - SAFE_STACK_SIZE - GUARD_SIZE,
 };
 
+// Number of cached interpreter instructions allocated at a time for interpreted blocks.
+constexpr size_t INTERPRETED_CODE_CHUNK_SIZE = 16 * 1024;
+
+// Number of backward branches taken by the loops of a block before they are compiled as native
+// loops.
+constexpr u32 LOOP_PROMOTION_THRESHOLD = 64;
+
 Jit64::Jit64() : QuantizedMemoryRoutines(*this)
 {
 }
@@ -243,7 +262,8 @@ bool Jit64::BackPatch(u32 emAddress, SContext* ctx)
 {
   u8* codePtr = reinterpret_cast<u8*>(ctx->CTX_PC);
 
-  if (!IsInSpace(codePtr))
+  // Blocks generated on the compiler thread are in its code space.
+  if (!IsInSpace(codePtr) && !(m_compiler && m_compiler->IsInSpace(codePtr)))
     return false;  // this will become a regular crash real soon after this
 
   auto it = m_back_patch_info.find(codePtr);
@@ -343,15 +363,33 @@ void Jit64::Init()
   gpr.SetEmitter(this);
   fpr.SetEmitter(this);
 
+  m_disk_cache_enabled = Config::Get(Config::MAIN_JIT_DISK_CACHE) &&
+                         !SConfig::GetInstance().bEnableDebugging &&
+                         !SConfig::GetInstance().bJITNoBlockCache;
+  m_background_compilation = Config::Get(Config::MAIN_JIT_BACKGROUND_COMPILATION) &&
+                             !SConfig::GetInstance().bEnableDebugging &&
+                             !SConfig::GetInstance().bJITNoBlockCache;
+  // Blocks from the disk cache are always compiled on the compiler thread.
+  if (m_background_compilation || m_disk_cache_enabled)
+    m_compiler = std::make_unique<Jit64>();
+
   const size_t routines_size = asm_routines.CODE_SIZE;
   const size_t trampolines_size = jo.memcheck ? TRAMPOLINE_CODE_SIZE_MMU : TRAMPOLINE_CODE_SIZE;
   const size_t farcode_size = jo.memcheck ? FARCODE_SIZE_MMU : FARCODE_SIZE;
   const size_t constpool_size = m_const_pool.CONST_POOL_SIZE;
-  AllocCodeSpace(CODE_SIZE + routines_size + trampolines_size + farcode_size + constpool_size);
+  const size_t compiler_size = m_compiler ? CODE_SIZE + farcode_size + constpool_size : 0;
+  AllocCodeSpace(CODE_SIZE + routines_size + trampolines_size + farcode_size + constpool_size +
+                 compiler_size);
   AddChildCodeSpace(&asm_routines, routines_size);
   AddChildCodeSpace(&trampolines, trampolines_size);
   AddChildCodeSpace(&m_far_code, farcode_size);
   m_const_pool.Init(AllocChildCodeSpace(constpool_size), constpool_size);
+  if (m_compiler)
+  {
+    AddChildCodeSpace(m_compiler.get(), CODE_SIZE);
+    AddChildCodeSpace(&m_compiler->m_far_code, farcode_size);
+    m_compiler->m_const_pool.Init(AllocChildCodeSpace(constpool_size), constpool_size);
+  }
   ResetCodePtr();
 
   // BLR optimization has the same consequences as block linking, as well as
@@ -379,10 +417,72 @@ void Jit64::Init()
   EnableOptimization();
 
   ResetFreeMemoryRanges();
+
+  // Tiered compilation relies on blocks being kept around long enough to count their runs.
+  m_tiered_compilation = Config::Get(Config::MAIN_JIT_TIERED_COMPILATION) &&
+                         !SConfig::GetInstance().bEnableDebugging &&
+                         !SConfig::GetInstance().bJITNoBlockCache;
+  m_tier_up_threshold = std::max(Config::Get(Config::MAIN_JIT_TIER_UP_THRESHOLD), 1u);
+  m_interpreted_code.clear();
+  m_promoted_blocks.clear();
+  m_pending_promotions.clear();
+
+  m_region_compilation = Config::Get(Config::MAIN_JIT_REGION_COMPILATION) &&
+                         !SConfig::GetInstance().bEnableDebugging &&
+                         !SConfig::GetInstance().bJITNoBlockCache;
+  m_loop_counters.clear();
+  m_hot_loop_blocks.clear();
+
+  m_compile_generation = 0;
+  m_queued_blocks.clear();
+  m_entry_hints = Config::Get(Config::MAIN_JIT_ENTRY_HINTS);
+  if (m_compiler)
+  {
+    m_compiler->InitCompiler(*this);
+    m_compile_queue.Reset(
+        [this](CompileRequest request) { CompileInBackground(std::move(request)); });
+  }
+}
+
+void Jit64::InitCompiler(Jit64& owner)
+{
+  m_owner = &owner;
+  jo = owner.jo;
+  m_enable_blr_optimization = owner.m_enable_blr_optimization;
+  m_region_compilation = owner.m_region_compilation;
+  js.fastmemLoadStore = nullptr;
+  js.compilerPC = 0;
+
+  gpr.SetEmitter(this);
+  fpr.SetEmitter(this);
+
+  // The code space was set up by the owner, which also generated the routines the blocks use.
+  asm_routines.Init(owner.asm_routines);
+  m_far_code.Init();
+  Clear();
+
+  code_block.m_stats = &js.st;
+  code_block.m_gpa = &js.gpa;
+  code_block.m_fpa = &js.fpa;
+  analyzer = owner.analyzer;
+
+  ResetFreeMemoryRanges();
 }
 
 void Jit64::ClearCache()
 {
+  if (m_compiler)
+  {
+    // Drop the queued blocks, and have the compiler thread start over once it is done with the
+    // block it is working on. What it generated before the clear is dropped when it is published.
+    m_compile_queue.Clear();
+    m_queued_blocks.clear();
+    CompileRequest request;
+    request.type = CompileRequest::Type::ClearCodeSpace;
+    request.generation = ++m_compile_generation;
+    m_compile_queue.EmplaceItem(std::move(request));
+  }
+
   blocks.Clear();
   blocks.ClearRangesToFree();
   trampolines.ClearCodeSpace();
@@ -392,6 +492,12 @@ void Jit64::ClearCache()
   Clear();
   UpdateMemoryOptions();
   ResetFreeMemoryRanges();
+  m_interpreted_code.clear();
+  m_loop_counters.clear();
+
+  // Everything known from the disk cache can be compiled ahead of time again, e.g. after a
+  // savestate was loaded.
+  m_disk_cache.MarkAllPending();
 }
 
 void Jit64::ResetFreeMemoryRanges()
@@ -405,11 +511,27 @@ void Jit64::ResetFreeMemoryRanges()
 
 void Jit64::Shutdown()
 {
+  if (m_compiler)
+    m_compile_queue.Cancel();
+  m_queued_blocks.clear();
+  m_compiled_blocks.Clear();
+
   FreeStack();
   FreeCodeSpace();
+  // The code space of the compiler was freed along with this JIT's.
+  m_compiler.reset();
 
   Memory::ShutdownFastmemArena();
 
+  m_disk_cache.Close();
+  m_disk_cache_game_id.clear();
+
+  m_interpreted_code.clear();
+  m_promoted_blocks.clear();
+  m_pending_promotions.clear();
+  m_loop_counters.clear();
+  m_hot_loop_blocks.clear();
+
   blocks.Shutdown();
   m_far_code.Shutdown();
   m_const_pool.Shutdown();
@@ -504,7 +626,7 @@ bool Jit64::Cleanup()
   }
 
   // SPEED HACK: MMCR0/MMCR1 should be checked at run-time, not at compile time.
-  if (MMCR0.Hex || MMCR1.Hex)
+  if (m_guest_state.mmcr0 || m_guest_state.mmcr1)
   {
     ABI_PushRegistersAndAdjustStack({}, 0);
     ABI_CallFunctionCCC(PowerPC::UpdatePerformanceMonitor, js.downcountAmount, js.numLoadStoreInst,
@@ -674,6 +796,65 @@ void Jit64::WriteIdleExit(u32 destination)
   WriteExceptionExit();
 }
 
+void Jit64::WriteLoopBranch(u32 destination)
+{
+  const auto header =
+      std::find_if(m_loop_headers.begin(), m_loop_headers.end(),
+                   [destination](const LoopHeader& loop) { return loop.address == destination; });
+  if (header == m_loop_headers.end())
+  {
+    gpr.Flush();
+    fpr.Flush();
+
+    // Count the iterations of the loops of the block, and have it compiled again with native
+    // loops once they have run often enough.
+    if (m_region_compilation && !jo.profile_blocks &&
+        !analyzer.HasOption(PPCAnalyst::PPCAnalyzer::OPTION_COMPLEX_BLOCK))
+    {
+      u32& counter =
+          m_loop_counters.try_emplace(js.blockStart, LOOP_PROMOTION_THRESHOLD).first->second;
+      MOV(64, R(RSCRATCH), ImmPtr(&counter));
+      SUB(32, MatR(RSCRATCH), Imm8(1));
+      FixupBranch promote = J_CC(CC_Z, true);
+      SwitchToFarCode();
+      SetJumpTarget(promote);
+      ABI_PushRegistersAndAdjustStack({}, 0);
+      ABI_CallFunctionPC(PromoteLoops, m_owner, js.blockStart);
+      ABI_PopRegistersAndAdjustStack({}, 0);
+      // Leave through the dispatcher, which invalidates this block once it no longer runs.
+      Cleanup();
+      SUB(32, PPCSTATE(downcount), Imm32(js.downcountAmount));
+      MOV(32, PPCSTATE(pc), Imm32(destination));
+      JMP(asm_routines.dispatcher_promote, true);
+      SwitchToNearCode();
+    }
+
+    WriteExit(destination);
+    return;
+  }
+
+  // Put the registers back where the loop expects them, instead of flushing them.
+  gpr.RestoreLoopState(header->gpr);
+  fpr.RestoreLoopState(header->fpr);
+
+  if (jo.optimizeGatherPipe && js.fifoBytesSinceCheck > 0)
+  {
+    BitSet32 registersInUse = CallerSavedRegistersInUse();
+    ABI_PushRegistersAndAdjustStack(registersInUse, 0);
+    ABI_CallFunction(GPFifo::FastCheckGatherPipe);
+    ABI_PopRegistersAndAdjustStack(registersInUse, 0);
+  }
+
+  SUB(32, PPCSTATE(downcount), Imm32(js.downcountAmount));
+  J_CC(CC_G, header->code);
+
+  // Out of cycles, leave the loop so that the scheduled events can run.
+  gpr.Flush();
+  fpr.Flush();
+  MOV(32, PPCSTATE(pc), Imm32(destination));
+  JMP(asm_routines.do_timing, true);
+}
+
 void Jit64::WriteExceptionExit()
 {
   Cleanup();
@@ -737,6 +918,19 @@ void Jit64::Trace()
 
 void Jit64::Jit(u32 em_address)
 {
+  if (m_compiler)
+  {
+    PublishCompiledBlocks();
+    if (blocks.GetBlockFromStartAddress(em_address, MSR.Hex))
+      return;
+  }
+
+  if (m_background_compilation && !jo.profile_blocks && !m_cleanup_after_stackfault)
+  {
+    JitInBackground(em_address);
+    return;
+  }
+
   Jit(em_address, true);
 }
 
@@ -752,22 +946,9 @@ void Jit64::Jit(u32 em_address, bool clear_cache_and_retry_on_failure)
 #endif
   }
 
-  if (trampolines.IsAlmostFull() || SConfig::GetInstance().bJITNoBlockCache)
-  {
-    if (!SConfig::GetInstance().bJITNoBlockCache)
-    {
-      WARN_LOG_FMT(POWERPC, "flushing trampoline code cache, please report if this happens a lot");
-    }
-    ClearCache();
-  }
-
-  // Check if any code blocks have been freed in the block cache and transfer this information to
-  // the local rangesets to allow overwriting them with new code.
-  for (auto range : blocks.GetRangesToFreeNear())
-    m_free_ranges_near.insert(range.first, range.second);
-  for (auto range : blocks.GetRangesToFreeFar())
-    m_free_ranges_far.insert(range.first, range.second);
-  blocks.ClearRangesToFree();
+  PrepareCodeSpace();
+  UpdateDiskCache();
+  CompileCachedRegion(em_address);
 
   std::size_t block_size = m_code_buffer.size();
 
@@ -799,7 +980,9 @@ void Jit64::Jit(u32 em_address, bool clear_cache_and_retry_on_failure)
   // Analyze the block, collect all instructions it is made of (including inlining,
   // if that is enabled), reorder instructions for optimal performance, and join joinable
   // instructions.
-  const u32 nextPC = analyzer.Analyze(em_address, &code_block, &m_code_buffer, block_size);
+  m_guest_state = CaptureGuestState();
+  const u32 nextPC = AnalyzeBlock(em_address, m_guest_state, &code_block, block_size);
+  m_function_hooks = GetFunctionHooks(code_block, m_code_buffer);
 
   if (code_block.m_memory_exception)
   {
@@ -811,42 +994,21 @@ void Jit64::Jit(u32 em_address, bool clear_cache_and_retry_on_failure)
     return;
   }
 
-  if (SetEmitterStateToFreeCodeRegion())
+  const bool interpreted = UsesInterpretedTier(em_address);
+  if (EmitBlock(em_address, nextPC, interpreted))
   {
-    u8* near_start = GetWritableCodePtr();
-    u8* far_start = m_far_code.GetWritableCodePtr();
-
-    JitBlock* b = blocks.AllocateBlock(em_address);
-    if (DoJit(em_address, b, nextPC))
-    {
-      // Code generation succeeded.
-
-      // Mark the memory regions that this code block uses as used in the local rangesets.
-      u8* near_end = GetWritableCodePtr();
-      if (near_start != near_end)
-        m_free_ranges_near.erase(near_start, near_end);
-      u8* far_end = m_far_code.GetWritableCodePtr();
-      if (far_start != far_end)
-        m_free_ranges_far.erase(far_start, far_end);
-
-      // Store the used memory regions in the block so we know what to mark as unused when the
-      // block gets invalidated.
-      b->near_begin = near_start;
-      b->near_end = near_end;
-      b->far_begin = far_start;
-      b->far_end = far_end;
-
-      blocks.FinalizeBlock(*b, jo.enableBlocklink, code_block.m_physical_addresses);
-      return;
-    }
+    if (!interpreted)
+      RecordBlock(em_address, nextPC);
+    return;
   }
 
   if (clear_cache_and_retry_on_failure)
   {
     // Code generation failed due to not enough free space in either the near or far code regions.
-    // Clear the entire JIT cache and retry.
+    // Clear the entire JIT cache and retry. Don't refill the cache from the disk cache right away.
     WARN_LOG_FMT(POWERPC, "flushing code caches, please report if this happens a lot");
     ClearCache();
+    m_disk_cache.ClearPending();
     Jit(em_address, false);
     return;
   }
@@ -857,6 +1019,280 @@ void Jit64::Jit(u32 em_address, bool clear_cache_and_retry_on_failure)
   std::exit(-1);
 }
 
+void Jit64::PrepareCodeSpace()
+{
+  if (trampolines.IsAlmostFull() || SConfig::GetInstance().bJITNoBlockCache)
+  {
+    if (!SConfig::GetInstance().bJITNoBlockCache)
+    {
+      WARN_LOG_FMT(POWERPC, "flushing trampoline code cache, please report if this happens a lot");
+    }
+    ClearCache();
+    m_disk_cache.ClearPending();
+  }
+
+  // Check if any code blocks have been freed in the block cache and transfer this information to
+  // the local rangesets to allow overwriting them with new code. The code space of blocks generated
+  // on the compiler thread goes back to it.
+  CompileRequest release;
+  release.type = CompileRequest::Type::ReleaseCodeSpace;
+  release.generation = m_compile_generation;
+  for (auto range : blocks.GetRangesToFreeNear())
+  {
+    if (m_compiler && m_compiler->IsInSpace(range.first))
+      release.near_ranges.push_back(range);
+    else
+      m_free_ranges_near.insert(range.first, range.second);
+  }
+  for (auto range : blocks.GetRangesToFreeFar())
+  {
+    if (m_compiler && m_compiler->m_far_code.IsInSpace(range.first))
+      release.far_ranges.push_back(range);
+    else
+      m_free_ranges_far.insert(range.first, range.second);
+  }
+  blocks.ClearRangesToFree();
+
+  if (!release.near_ranges.empty() || !release.far_ranges.empty())
+    m_compile_queue.EmplaceItem(std::move(release));
+}
+
+bool Jit64::EmitBlock(u32 em_address, u32 nextPC, bool interpreted)
+{
+  if (!SetEmitterStateToFreeCodeRegion())
+    return false;
+
+  JitBlock* b = blocks.AllocateBlock(em_address);
+  if (!GenerateBlock(em_address, b, nextPC, interpreted))
+    return false;
+
+  blocks.FinalizeBlock(*b, jo.enableBlocklink, code_block.m_physical_addresses);
+  return true;
+}
+
+bool Jit64::GenerateBlock(u32 em_address, JitBlock* b, u32 nextPC, bool interpreted)
+{
+  u8* near_start = GetWritableCodePtr();
+  u8* far_start = m_far_code.GetWritableCodePtr();
+
+  if (interpreted ? !DoInterpretedJit(em_address, b, nextPC) : !DoJit(em_address, b, nextPC))
+    return false;
+
+  // Code generation succeeded.
+
+  // Mark the memory regions that this code block uses as used in the local rangesets.
+  u8* near_end = GetWritableCodePtr();
+  if (near_start != near_end)
+    m_free_ranges_near.erase(near_start, near_end);
+  u8* far_end = m_far_code.GetWritableCodePtr();
+  if (far_start != far_end)
+    m_free_ranges_far.erase(far_start, far_end);
+
+  // Store the used memory regions in the block so we know what to mark as unused when the
+  // block gets invalidated.
+  b->near_begin = near_start;
+  b->near_end = near_end;
+  b->far_begin = far_start;
+  b->far_end = far_end;
+
+  return true;
+}
+
+void Jit64::UpdateDiskCache()
+{
+  const std::string& game_id = SConfig::GetInstance().GetGameID();
+  if (!m_disk_cache_enabled || game_id.empty())
+  {
+    m_disk_cache.Close();
+    m_disk_cache_game_id.clear();
+    return;
+  }
+
+  if (m_disk_cache.IsOpen() && game_id == m_disk_cache_game_id)
+    return;
+
+  const std::string& cache_dir = File::GetUserPath(D_CACHE_IDX);
+  if (!File::IsDirectory(cache_dir))
+    File::CreateFullPath(cache_dir);
+
+  m_disk_cache_game_id = game_id;
+  m_disk_cache.Open(cache_dir + "JIT64-" + game_id + ".jitcache");
+}
+
+u64 Jit64::GetDiskCacheOptionsHash() const
+{
+  const SConfig& config = SConfig::GetInstance();
+  const std::array<bool, 25> options{
+      jo.enableBlocklink,
+      jo.optimizeGatherPipe,
+      jo.accurateSinglePrecision,
+      jo.fastmem,
+      jo.fastmem_arena,
+      jo.memcheck,
+      jo.profile_blocks,
+      m_enable_blr_optimization,
+      config.bJITFollowBranch,
+      config.bJITOff,
+      config.bJITLoadStoreOff,
+      config.bJITLoadStorelXzOff,
+      config.bJITLoadStorelwzOff,
+      config.bJITLoadStorelbzxOff,
+      config.bJITLoadStoreFloatingOff,
+      config.bJITLoadStorePairedOff,
+      config.bJITFloatingPointOff,
+      config.bJITIntegerOff,
+      config.bJITPairedOff,
+      config.bJITSystemRegistersOff,
+      config.bJITBranchOff,
+      config.bJITRegisterCacheOff,
+      config.bFPRF,
+      config.bAccurateNaNs,
+      config.bLowDCBZHack,
+  };
+
+  return XXH64(options.data(), sizeof(options), 0);
+}
+
+u64 Jit64::GetCodeHash(const PPCAnalyst::CodeBlock& block, const PPCAnalyst::CodeBuffer& buffer,
+                        u32 nextPC)
+{
+  std::vector<u32> words;
+  words.reserve(block.m_num_instructions * 2 + 1);
+  for (u32 i = 0; i < block.m_num_instructions; i++)
+  {
+    words.push_back(buffer[i].address);
+    words.push_back(buffer[i].inst.hex);
+  }
+  words.push_back(nextPC);
+
+  return XXH64(words.data(), words.size() * sizeof(u32), 0);
+}
+
+void Jit64::RecordBlock(u32 em_address, u32 nextPC)
+{
+  if (!m_disk_cache.IsOpen())
+    return;
+
+  const JitDiskCache::Entry entry =
+      GetDiskCacheEntry(em_address, m_guest_state, code_block, m_code_buffer, nextPC);
+  m_disk_cache.Record(entry.key, entry.assumptions);
+}
+
+JitDiskCache::Entry Jit64::GetDiskCacheEntry(u32 em_address, const GuestState& state,
+                                             const PPCAnalyst::CodeBlock& block,
+                                             const PPCAnalyst::CodeBuffer& buffer,
+                                             u32 nextPC) const
+{
+  // Store the guest state the block was specialized for by ComputeStaticGQRs and
+  // IntializeSpeculativeConstants, so that compiling it ahead of time next session makes the same
+  // guesses instead of ones based on whatever state the guest happens to be in then. The other
+  // input registers don't affect the code, and keying on them would record the block again
+  // whenever it is recompiled with different values in them.
+  JitDiskCache::Entry entry;
+  JitDiskCache::Assumptions& assumptions = entry.assumptions;
+  assumptions.speculative_constants_exception =
+      js.noSpeculativeConstantsAddresses.count(em_address) != 0;
+  if (!assumptions.speculative_constants_exception)
+  {
+    for (int i : block.m_gpr_inputs)
+    {
+      const u32 value = state.gpr[i];
+      if (!IsSpeculativeConstant(value))
+        continue;
+
+      assumptions.gpr_inputs |= 1u << i;
+      assumptions.gpr[i] = value;
+    }
+  }
+
+  const BitSet8 static_gqrs = ComputeStaticGQRs(block);
+  assumptions.static_gqrs = static_gqrs.m_val;
+  for (int i : static_gqrs)
+    assumptions.gqr[i] = state.gqr[i];
+
+  assumptions.paired_quantize_exception = js.pairedQuantizeAddresses.count(em_address) != 0;
+  assumptions.speculative_constants_exception =
+      js.noSpeculativeConstantsAddresses.count(em_address) != 0;
+  assumptions.entry_hints_exception = js.noEntryHintsAddresses.count(em_address) != 0;
+
+  for (u32 i = 0; i < block.m_num_instructions; i++)
+  {
+    if (js.fifoWriteAddresses.count(buffer[i].address) != 0)
+      assumptions.fifo_write_addresses.push_back(buffer[i].address);
+  }
+
+  entry.key = {em_address, state.msr.Hex & JitBaseBlockCache::JIT_CACHE_MSR_MASK,
+               GetCodeHash(block, buffer, nextPC), GetDiskCacheOptionsHash()};
+  return entry;
+}
+
+void Jit64::CompileCachedRegion(u32 em_address)
+{
+  if (!m_disk_cache.IsOpen())
+    return;
+
+  // The blocks are generated on the compiler thread, so the CPU thread only pays for analyzing
+  // them.
+  const std::vector<JitDiskCache::Entry> entries =
+      m_disk_cache.TakePendingRegion(em_address, std::numeric_limits<size_t>::max());
+  if (entries.empty())
+    return;
+
+  const u32 msr_bits = MSR.Hex & JitBaseBlockCache::JIT_CACHE_MSR_MASK;
+  const u64 options_hash = GetDiskCacheOptionsHash();
+  const GuestState state = CaptureGuestState();
+
+  for (const JitDiskCache::Entry& entry : entries)
+  {
+    if (entry.key.msr_bits != msr_bits || entry.key.options_hash != options_hash)
+      continue;
+
+    RestoreExceptionAddresses(entry);
+
+    // The block was hot in a previous session, so it skips the interpreted tier.
+    if (m_tiered_compilation)
+      m_promoted_blocks.insert(entry.key.effective_address);
+
+    // The requested block is compiled by the caller as usual.
+    if (entry.key.effective_address == em_address ||
+        blocks.GetBlockFromStartAddress(entry.key.effective_address, MSR.Hex))
+    {
+      continue;
+    }
+
+    // Generate the block for the guest state it was specialized for, rather than the one the
+    // guest happens to be in now.
+    GuestState entry_state = state;
+    ApplyAssumptions(entry.assumptions, &entry_state);
+    QueueCompilation(entry.key.effective_address, entry_state, entry.key.code_hash);
+  }
+
+  DEBUG_LOG_FMT(DYNA_REC, "Queued {} cached blocks near {:08x}", entries.size(), em_address);
+}
+
+void Jit64::RestoreExceptionAddresses(const JitDiskCache::Entry& entry)
+{
+  // Restore what was learned about the block the last time it was compiled.
+  const JitDiskCache::Assumptions& assumptions = entry.assumptions;
+  if (assumptions.paired_quantize_exception)
+    js.pairedQuantizeAddresses.insert(entry.key.effective_address);
+  if (assumptions.speculative_constants_exception)
+    js.noSpeculativeConstantsAddresses.insert(entry.key.effective_address);
+  if (assumptions.entry_hints_exception)
+    js.noEntryHintsAddresses.insert(entry.key.effective_address);
+  js.fifoWriteAddresses.insert(assumptions.fifo_write_addresses.begin(),
+                               assumptions.fifo_write_addresses.end());
+}
+
+void Jit64::ApplyAssumptions(const JitDiskCache::Assumptions& assumptions, GuestState* state)
+{
+  // The block checks on entry that these guesses hold, so they only affect performance.
+  for (int i : BitSet32(assumptions.gpr_inputs))
+    state->gpr[i] = assumptions.gpr[i];
+  for (int i : BitSet32(assumptions.static_gqrs & 0xFF))
+    state->gqr[i] = assumptions.gqr[i];
+}
+
 bool Jit64::SetEmitterStateToFreeCodeRegion()
 {
   // Find the largest free memory blocks and set code emitters to point at them.
@@ -929,6 +1365,7 @@ bool Jit64::DoJit(u32 em_address, JitBlock* b, u32 nextPC)
   js.carryFlagSet = false;
   js.carryFlagInverted = false;
   js.constantGqr.clear();
+  m_loop_headers.clear();
 
   // Assume that GQR values don't change often at runtime. Many paired-heavy games use largely float
   // loads and stores,
@@ -954,7 +1391,7 @@ bool Jit64::DoJit(u32 em_address, JitBlock* b, u32 nextPC)
       // the start of the block in case our guess turns out wrong.
       for (int gqr : gqr_static)
       {
-        u32 value = GQR(gqr);
+        u32 value = m_guest_state.gqr[gqr];
         js.constantGqr[gqr] = value;
         CMP_or_TEST(32, PPCSTATE(spr[SPR_GQR0 + gqr]), Imm32(value));
         J_CC(CC_NZ, target);
@@ -968,6 +1405,9 @@ bool Jit64::DoJit(u32 em_address, JitBlock* b, u32 nextPC)
     IntializeSpeculativeConstants();
   }
 
+  if (js.noEntryHintsAddresses.find(js.blockStart) == js.noEntryHintsAddresses.end())
+    CheckEntryHints();
+
   // Translate instructions
   for (u32 i = 0; i < code_block.m_num_instructions; i++)
   {
@@ -978,6 +1418,10 @@ bool Jit64::DoJit(u32 em_address, JitBlock* b, u32 nextPC)
     js.instructionNumber = i;
     js.instructionsLeft = (code_block.m_num_instructions - 1) - i;
     const GekkoOPInfo* opinfo = op.opinfo;
+
+    if (op.isBranchTarget)
+      WriteLoopHeader(i);
+
     js.downcountAmount += opinfo->numCycles;
     js.fastmemLoadStore = nullptr;
     js.fixupExceptionHandler = false;
@@ -1201,6 +1645,463 @@ bool Jit64::DoJit(u32 em_address, JitBlock* b, u32 nextPC)
   return true;
 }
 
+bool Jit64::DoInterpretedJit(u32 em_address, JitBlock* b, u32 nextPC)
+{
+  js.curBlock = b;
+
+  std::vector<CachedInterpreter::Instruction> block_code;
+  CachedInterpreter::CompileBlock(block_code, js, jo, code_block, m_code_buffer, em_address, nextPC);
+
+  // Blocks point into the chunks, so a chunk never grows past the capacity it was allocated with.
+  if (m_interpreted_code.empty() ||
+      m_interpreted_code.back().capacity() - m_interpreted_code.back().size() < block_code.size())
+  {
+    m_interpreted_code.emplace_back();
+    m_interpreted_code.back().reserve(std::max(INTERPRETED_CODE_CHUNK_SIZE, block_code.size()));
+  }
+
+  std::vector<CachedInterpreter::Instruction>& chunk = m_interpreted_code.back();
+  const CachedInterpreter::Instruction* const instructions = chunk.data() + chunk.size();
+  for (const CachedInterpreter::Instruction& instruction : block_code)
+    chunk.push_back(instruction);
+
+  u8* const start = AlignCode4();
+  b->checkedEntry = start;
+  b->normalEntry = start;
+  b->runs_until_promotion = m_tier_up_threshold;
+
+  // Count the runs of the block, and have it compiled once it has run often enough.
+  MOV(64, R(RSCRATCH), ImmPtr(&b->runs_until_promotion));
+  SUB(32, MatR(RSCRATCH), Imm8(1));
+  FixupBranch promote = J_CC(CC_Z, true);
+  SwitchToFarCode();
+  SetJumpTarget(promote);
+  MOV(32, PPCSTATE(pc), Imm32(em_address));
+  ABI_PushRegistersAndAdjustStack({}, 0);
+  ABI_CallFunctionPC(PromoteBlock, this, em_address);
+  ABI_PopRegistersAndAdjustStack({}, 0);
+  JMP(asm_routines.dispatcher_promote, true);
+  SwitchToNearCode();
+
+  ABI_PushRegistersAndAdjustStack({}, 0);
+  MOV(64, R(ABI_PARAM1), ImmPtr(instructions));
+  ABI_CallFunction(CachedInterpreter::ExecuteBlock);
+  ABI_PopRegistersAndAdjustStack({}, 0);
+
+  // The interpreted block has already written PC and updated the downcount. Set the flags the
+  // dispatcher and the code following a linked call expect from the downcount update.
+  const UGeckoInstruction last_inst = m_code_buffer[code_block.m_num_instructions - 1].inst;
+  if (m_enable_blr_optimization && !code_block.m_broken && last_inst.OPCD == 19 &&
+      last_inst.SUBOP10 == 16)
+  {
+    // Return to the block that called this function, as in WriteBLRExit.
+    MOV(32, R(RSCRATCH), PPCSTATE(pc));
+    MOV(32, R(RSCRATCH2), Imm32(0));
+    CMP(64, R(RSCRATCH), MDisp(RSP, 8));
+    J_CC(CC_NE, asm_routines.dispatcher_mispredicted_blr);
+    CMP(32, PPCSTATE(downcount), Imm8(0));
+    RET();
+  }
+  else
+  {
+    CMP(32, PPCSTATE(downcount), Imm8(0));
+    JMP(asm_routines.dispatcher, true);
+  }
+
+  if (HasWriteFailed() || m_far_code.HasWriteFailed())
+  {
+    if (HasWriteFailed())
+      WARN_LOG_FMT(POWERPC, "JIT ran out of space in near code region during code generation.");
+    if (m_far_code.HasWriteFailed())
+      WARN_LOG_FMT(POWERPC, "JIT ran out of space in far code region during code generation.");
+
+    return false;
+  }
+
+  b->codeSize = (u32)(GetCodePtr() - start);
+  b->originalSize = code_block.m_num_instructions;
+
+  return true;
+}
+
+u32 Jit64::AnalyzeBlock(u32 em_address, const GuestState& state, PPCAnalyst::CodeBlock* block,
+                        std::size_t block_size)
+{
+  // The performance monitor and block profiling count cycles per exit, so they disable loops.
+  const bool hot_loops = m_region_compilation && !jo.profile_blocks &&
+                         !(state.mmcr0 || state.mmcr1) && m_hot_loop_blocks.count(em_address) != 0;
+  if (hot_loops)
+    analyzer.SetOption(PPCAnalyst::PPCAnalyzer::OPTION_COMPLEX_BLOCK);
+  else
+    analyzer.ClearOption(PPCAnalyst::PPCAnalyzer::OPTION_COMPLEX_BLOCK);
+
+  PPCAnalyst::EntryHints hints;
+  if (m_entry_hints && js.noEntryHintsAddresses.count(em_address) == 0)
+    hints = GetEntryHints(em_address, state);
+  analyzer.SetEntryHints(hints);
+
+  return analyzer.Analyze(em_address, block, &m_code_buffer, block_size);
+}
+
+PPCAnalyst::EntryHints Jit64::GetEntryHints(u32 em_address, const GuestState& state)
+{
+  PPCAnalyst::EntryHints hints = analyzer.ComputeEntryHints(em_address);
+
+  // Blocks are usually compiled right before they run, so don't make guesses that the guest state
+  // already contradicts. Blocks generated on the compiler thread still check them on entry.
+  for (int i : hints.constant_gprs)
+  {
+    if (state.gpr[i] != hints.gpr_values[i])
+    {
+      hints.constant_gprs[i] = false;
+      hints.gpr_values[i] = 0;
+    }
+  }
+
+  const auto is_single = [](u64 value) {
+    const double d = Common::BitCast<double>(value);
+    return Common::BitCast<u64>(static_cast<double>(static_cast<float>(d))) == value;
+  };
+  for (int i : hints.single_fprs)
+  {
+    const PowerPC::PairedSingle& ps = state.ps[i];
+    if (!is_single(ps.PS0AsU64()) || !is_single(ps.PS1AsU64()))
+      hints.single_fprs[i] = false;
+    if (!hints.single_fprs[i] || ps.PS0AsU64() != ps.PS1AsU64())
+      hints.duplicated_fprs[i] = false;
+  }
+
+  return hints;
+}
+
+void Jit64::WriteLoopHeader(u32 index)
+{
+  const u32 address = m_code_buffer[index].address;
+
+  u32 last = index;
+  for (u32 i = index; i < code_block.m_num_instructions; i++)
+  {
+    if (m_code_buffer[i].branchIsLoop && m_code_buffer[i].branchTo == address)
+      last = i;
+  }
+
+  BitSet32 gprs, fprs;
+  for (u32 i = index; i <= last; i++)
+  {
+    gprs |= m_code_buffer[i].regsIn;
+    fprs |= m_code_buffer[i].fregsIn;
+  }
+
+  // The code before the loop only runs once: account for it here, so that the branch back to the
+  // start of the loop only has to subtract the cycles of the loop itself.
+  gpr.Flush();
+  fpr.Flush();
+  Cleanup();
+  js.fifoBytesSinceCheck = 0;
+  if (js.downcountAmount != 0)
+    SUB(32, PPCSTATE(downcount), Imm32(js.downcountAmount));
+  js.downcountAmount = 0;
+
+  LoopHeader header;
+  header.address = address;
+  header.gpr = gpr.BindForLoop(gprs);
+  header.fpr = fpr.BindForLoop(fprs);
+  header.code = GetCodePtr();
+  m_loop_headers.push_back(header);
+}
+
+void Jit64::PromoteLoops(Jit64* jit, u32 em_address)
+{
+  jit->m_hot_loop_blocks.insert(em_address);
+
+  // The block is still running, so leave invalidating it to the dispatcher.
+  jit->m_pending_promotions.push_back(em_address);
+}
+
+void Jit64::PromoteBlock(Jit64* jit, u32 em_address)
+{
+  jit->m_promoted_blocks.insert(em_address);
+  jit->m_pending_promotions.push_back(em_address);
+}
+
+void Jit64::ApplyPromotions(Jit64& jit)
+{
+  // The code space of the destroyed blocks is handed back by the next PrepareCodeSpace, so this
+  // doesn't touch anything the compiler thread uses.
+  for (const u32 em_address : jit.m_pending_promotions)
+    jit.blocks.InvalidateICache(em_address, 4, true);
+  jit.m_pending_promotions.clear();
+}
+
+bool Jit64::UsesInterpretedTier(u32 em_address) const
+{
+  // Blocks start out interpreted and are compiled once they have run often enough.
+  return m_tiered_compilation && !jo.profile_blocks && m_promoted_blocks.count(em_address) == 0;
+}
+
+Jit64::GuestState Jit64::CaptureGuestState()
+{
+  GuestState state;
+  state.msr = MSR;
+  state.mmcr0 = MMCR0.Hex;
+  state.mmcr1 = MMCR1.Hex;
+  std::copy(std::begin(PowerPC::ppcState.gpr), std::end(PowerPC::ppcState.gpr), state.gpr.begin());
+  std::copy(std::begin(PowerPC::ppcState.ps), std::end(PowerPC::ppcState.ps), state.ps.begin());
+  for (u32 i = 0; i < state.gqr.size(); i++)
+    state.gqr[i] = GQR(i);
+  return state;
+}
+
+void Jit64::JitInBackground(u32 em_address)
+{
+  // Interpreted blocks are cheap enough to generate right away.
+  if (UsesInterpretedTier(em_address))
+  {
+    Jit(em_address, true);
+    return;
+  }
+
+  PrepareCodeSpace();
+  UpdateDiskCache();
+  CompileCachedRegion(em_address);
+  QueueCompilation(em_address, CaptureGuestState());
+
+  // Never wait for the compiler thread. The block is interpreted until it has been generated.
+  InterpretBlock();
+}
+
+void Jit64::QueueCompilation(u32 em_address, const GuestState& state,
+                             std::optional<u64> code_hash)
+{
+  if (m_queued_blocks.count(em_address) != 0)
+    return;
+
+  // The block is analyzed here rather than on the compiler thread, since the analysis reads guest
+  // memory through the MMU and the symbol database.
+  CompileRequest request;
+  request.effective_address = em_address;
+  request.jo = jo;
+  request.enable_blr_optimization = m_enable_blr_optimization;
+  request.state = state;
+  request.code_block.m_stats = &request.stats;
+  request.code_block.m_gpa = &request.gpa;
+  request.code_block.m_fpa = &request.fpa;
+  request.next_pc = AnalyzeBlock(em_address, state, &request.code_block, m_code_buffer.size());
+  request.analyzer = analyzer;
+
+  // The interpreter raises the ISI.
+  if (request.code_block.m_memory_exception)
+    return;
+  if (code_hash && GetCodeHash(request.code_block, m_code_buffer, request.next_pc) != *code_hash)
+    return;
+
+  request.function_hooks = GetFunctionHooks(request.code_block, m_code_buffer);
+  request.paired_quantize_exception = js.pairedQuantizeAddresses.count(em_address) != 0;
+  request.speculative_constants_exception =
+      js.noSpeculativeConstantsAddresses.count(em_address) != 0;
+  for (u32 i = 0; i < request.code_block.m_num_instructions; i++)
+  {
+    if (js.fifoWriteAddresses.count(m_code_buffer[i].address) != 0)
+      request.fifo_write_addresses.push_back(m_code_buffer[i].address);
+  }
+  if (m_disk_cache.IsOpen())
+  {
+    request.disk_cache_entry =
+        GetDiskCacheEntry(em_address, state, request.code_block, m_code_buffer, request.next_pc);
+  }
+  request.code.assign(m_code_buffer.begin(),
+                      m_code_buffer.begin() + request.code_block.m_num_instructions);
+
+  m_queued_blocks.insert(em_address);
+  m_compile_queue.EmplaceItem(std::move(request));
+}
+
+void Jit64::CompileInBackground(CompileRequest request)
+{
+  Jit64& compiler = *m_compiler;
+
+  switch (request.type)
+  {
+  case CompileRequest::Type::Compile:
+    m_compiled_blocks.Push(compiler.GenerateInBackground(request));
+    break;
+
+  case CompileRequest::Type::ReleaseCodeSpace:
+    // The space was already reset if the cache was cleared since.
+    if (request.generation != compiler.m_compile_generation)
+      break;
+    for (const auto& range : request.near_ranges)
+      compiler.m_free_ranges_near.insert(range.first, range.second);
+    for (const auto& range : request.far_ranges)
+      compiler.m_free_ranges_far.insert(range.first, range.second);
+    break;
+
+  case CompileRequest::Type::ClearCodeSpace:
+    compiler.m_compile_generation = request.generation;
+    compiler.m_far_code.ClearCodeSpace();
+    compiler.m_const_pool.Clear();
+    compiler.ClearCodeSpace();
+    compiler.Clear();
+    compiler.ResetFreeMemoryRanges();
+    compiler.m_loop_counters.clear();
+    break;
+  }
+}
+
+Jit64::CompiledBlock Jit64::GenerateInBackground(CompileRequest& request)
+{
+  const u32 em_address = request.effective_address;
+
+  CompiledBlock compiled;
+  compiled.generation = m_compile_generation;
+  compiled.effective_address = em_address;
+  compiled.msr_bits = request.state.msr.Hex & JitBaseBlockCache::JIT_CACHE_MSR_MASK;
+  compiled.disk_cache_entry = std::move(request.disk_cache_entry);
+
+  // Only the request is read here. Before publishing the block, the CPU thread checks that the
+  // code and the address translation bits of MSR still match, and the block checks its guesses
+  // about the registers on entry.
+  jo = request.jo;
+  m_enable_blr_optimization = request.enable_blr_optimization;
+  m_guest_state = request.state;
+  m_function_hooks = std::move(request.function_hooks);
+  analyzer = request.analyzer;
+
+  js.pairedQuantizeAddresses.clear();
+  if (request.paired_quantize_exception)
+    js.pairedQuantizeAddresses.insert(em_address);
+  js.noSpeculativeConstantsAddresses.clear();
+  if (request.speculative_constants_exception)
+    js.noSpeculativeConstantsAddresses.insert(em_address);
+  js.fifoWriteAddresses.clear();
+  js.fifoWriteAddresses.insert(request.fifo_write_addresses.begin(),
+                               request.fifo_write_addresses.end());
+
+  js.st = request.stats;
+  js.gpa = request.gpa;
+  js.fpa = request.fpa;
+  code_block = request.code_block;
+  code_block.m_stats = &js.st;
+  code_block.m_gpa = &js.gpa;
+  code_block.m_fpa = &js.fpa;
+  std::copy(request.code.begin(), request.code.end(), m_code_buffer.begin());
+
+  if (!SetEmitterStateToFreeCodeRegion() ||
+      !GenerateBlock(em_address, &compiled.block, request.next_pc, false))
+  {
+    compiled.status = CompiledBlock::Status::OutOfSpace;
+    Clear();
+    return compiled;
+  }
+
+  compiled.physical_addresses = code_block.m_physical_addresses;
+  compiled.instructions.reserve(code_block.m_num_instructions);
+  for (u32 i = 0; i < code_block.m_num_instructions; i++)
+    compiled.instructions.emplace_back(m_code_buffer[i].address, m_code_buffer[i].inst.hex);
+
+  // The CPU thread looks these up when the block's fastmem accesses fault.
+  compiled.back_patch_info.swap(m_back_patch_info);
+  compiled.exception_handler_at_loc.swap(m_exception_handler_at_loc);
+  return compiled;
+}
+
+void Jit64::PublishCompiledBlocks()
+{
+  CompiledBlock compiled;
+  while (m_compiled_blocks.Pop(compiled))
+  {
+    // The code space of blocks generated before a cache clear has been reset.
+    if (compiled.generation != m_compile_generation)
+      continue;
+
+    const u32 em_address = compiled.effective_address;
+    m_queued_blocks.erase(em_address);
+
+    if (compiled.status == CompiledBlock::Status::OutOfSpace)
+    {
+      // This also drops the rest of the blocks, which were generated before the clear.
+      WARN_LOG_FMT(POWERPC, "flushing code caches, please report if this happens a lot");
+      ClearCache();
+      m_disk_cache.ClearPending();
+      continue;
+    }
+
+    // The guest may have changed the code, or compiled the block through another path, while
+    // the compiler thread was busy.
+    if (!MatchesGuestCode(compiled) || blocks.GetBlockFromStartAddress(em_address, MSR.Hex))
+    {
+      ReleaseCodeSpace(compiled.block);
+      continue;
+    }
+
+    for (auto& [location, info] : compiled.back_patch_info)
+      m_back_patch_info.insert_or_assign(location, info);
+    for (auto& [location, handler] : compiled.exception_handler_at_loc)
+      m_exception_handler_at_loc.insert_or_assign(location, handler);
+
+    JitBlock* b = blocks.AllocateBlock(em_address);
+    b->checkedEntry = compiled.block.checkedEntry;
+    b->normalEntry = compiled.block.normalEntry;
+    b->codeSize = compiled.block.codeSize;
+    b->originalSize = compiled.block.originalSize;
+    b->near_begin = compiled.block.near_begin;
+    b->near_end = compiled.block.near_end;
+    b->far_begin = compiled.block.far_begin;
+    b->far_end = compiled.block.far_end;
+    b->linkData = std::move(compiled.block.linkData);
+
+    // Links to and from the block are patched here, on the CPU thread, like for any other block.
+    blocks.FinalizeBlock(*b, jo.enableBlocklink, compiled.physical_addresses);
+
+    if (compiled.disk_cache_entry && m_disk_cache.IsOpen())
+      m_disk_cache.Record(compiled.disk_cache_entry->key, compiled.disk_cache_entry->assumptions);
+  }
+}
+
+bool Jit64::MatchesGuestCode(const CompiledBlock& compiled) const
+{
+  if ((MSR.Hex & JitBaseBlockCache::JIT_CACHE_MSR_MASK) != compiled.msr_bits)
+    return false;
+
+  std::set<u32> physical_addresses;
+  for (const auto& [address, hex] : compiled.instructions)
+  {
+    const PowerPC::TryReadInstResult result = PowerPC::TryReadInstruction(address);
+    if (!result.valid || result.hex != hex)
+      return false;
+
+    physical_addresses.insert(result.physical_address);
+  }
+
+  return physical_addresses == compiled.physical_addresses;
+}
+
+void Jit64::ReleaseCodeSpace(const JitBlock& block)
+{
+  CompileRequest release;
+  release.type = CompileRequest::Type::ReleaseCodeSpace;
+  release.generation = m_compile_generation;
+  if (block.near_begin != block.near_end)
+    release.near_ranges.emplace_back(block.near_begin, block.near_end);
+  if (block.far_begin != block.far_end)
+    release.far_ranges.emplace_back(block.far_begin, block.far_end);
+  m_compile_queue.EmplaceItem(std::move(release));
+}
+
+void Jit64::InterpretBlock()
+{
+  // Stop where the straight-line code ends, which is where the dispatcher looks up blocks, or
+  // when the time slice runs out. The dispatcher handles the timing after Jit returns.
+  Interpreter& interpreter = *Interpreter::getInstance();
+  do
+  {
+    const u32 pc = PC;
+    PowerPC::ppcState.downcount -= interpreter.SingleStepInner();
+    if (PC != pc + 4)
+      break;
+  } while (PowerPC::ppcState.downcount > 0);
+}
+
 BitSet8 Jit64::ComputeStaticGQRs(const PPCAnalyst::CodeBlock& cb) const
 {
   return cb.m_gqr_used & ~cb.m_gqr_modified;
@@ -1228,6 +2129,12 @@ void Jit64::EnableOptimization()
   analyzer.SetOption(PPCAnalyst::PPCAnalyzer::OPTION_BRANCH_FOLLOW);
 }
 
+bool Jit64::IsSpeculativeConstant(u32 value)
+{
+  return PowerPC::IsOptimizableGatherPipeWrite(value) ||
+         PowerPC::IsOptimizableGatherPipeWrite(value - 0x8000) || value == 0xCC000000;
+}
+
 void Jit64::IntializeSpeculativeConstants()
 {
   // If the block depends on an input register which looks like a gather pipe or MMIO related
@@ -1239,10 +2146,8 @@ void Jit64::IntializeSpeculativeConstants()
   const u8* target = nullptr;
   for (auto i : code_block.m_gpr_inputs)
   {
-    u32 compileTimeValue = PowerPC::ppcState.gpr[i];
-    if (PowerPC::IsOptimizableGatherPipeWrite(compileTimeValue) ||
-        PowerPC::IsOptimizableGatherPipeWrite(compileTimeValue - 0x8000) ||
-        compileTimeValue == 0xCC000000)
+    u32 compileTimeValue = m_guest_state.gpr[i];
+    if (IsSpeculativeConstant(compileTimeValue))
     {
       if (!target)
       {
@@ -1263,19 +2168,89 @@ void Jit64::IntializeSpeculativeConstants()
   }
 }
 
+Jit64::FunctionHooks Jit64::GetFunctionHooks(const PPCAnalyst::CodeBlock& block,
+                                             const PPCAnalyst::CodeBuffer& buffer)
+{
+  // Finding the hooks reads the symbol database, so code generation doesn't do it.
+  FunctionHooks function_hooks;
+  for (u32 i = 0; i < block.m_num_instructions; i++)
+  {
+    const u32 address = buffer[i].address;
+    HLE::ReplaceFunctionIfPossible(address, [&](u32 hook_index, HLE::HookType) {
+      function_hooks.emplace_back(address, hook_index);
+      return true;
+    });
+  }
+  return function_hooks;
+}
+
+void Jit64::CheckEntryHints()
+{
+  // PPCAnalyzer::ComputeEntryHints guessed these from the code around the block. They save loads
+  // of constants and conversions to single precision, but the block may be reached from code the
+  // analysis didn't see, so check them like the speculative constants.
+  const PPCAnalyst::EntryHints& hints = code_block.m_entry_hints;
+  if (!hints.constant_gprs && !hints.single_fprs)
+    return;
+
+  SwitchToFarCode();
+  const u8* target = GetCodePtr();
+  MOV(32, PPCSTATE(pc), Imm32(js.blockStart));
+  ABI_PushRegistersAndAdjustStack({}, 0);
+  ABI_CallFunctionC(JitInterface::CompileExceptionCheck,
+                    static_cast<u32>(JitInterface::ExceptionType::EntryHints));
+  ABI_PopRegistersAndAdjustStack({}, 0);
+  JMP(asm_routines.dispatcher, true);
+  SwitchToNearCode();
+
+  for (int i : hints.constant_gprs)
+  {
+    // Already specialized by IntializeSpeculativeConstants.
+    if (gpr.IsImm(i))
+      continue;
+
+    CMP(32, PPCSTATE(gpr[i]), Imm32(hints.gpr_values[i]));
+    J_CC(CC_NZ, target);
+    gpr.SetImmediate32(i, hints.gpr_values[i], false);
+  }
+
+  for (int i : hints.single_fprs)
+  {
+    // Rounding both halves to single precision and back only keeps every bit if they are singles.
+    MOVAPD(XMM0, PPCSTATE(ps[i].ps0));
+    CVTPD2PS(XMM1, R(XMM0));
+    CVTPS2PD(XMM1, R(XMM1));
+    PCMPEQD(XMM1, R(XMM0));
+    PMOVMSKB(RSCRATCH, R(XMM1));
+    CMP(32, R(RSCRATCH), Imm32(0xFFFF));
+    J_CC(CC_NZ, target);
+
+    if (hints.duplicated_fprs[i])
+    {
+      MOV(64, R(RSCRATCH), PPCSTATE(ps[i].ps0));
+      CMP(64, R(RSCRATCH), PPCSTATE(ps[i].ps1));
+      J_CC(CC_NZ, target);
+    }
+  }
+}
+
 bool Jit64::HandleFunctionHooking(u32 address)
 {
-  return HLE::ReplaceFunctionIfPossible(address, [&](u32 hook_index, HLE::HookType type) {
-    HLEFunction(hook_index);
+  const auto hook = std::find_if(m_function_hooks.begin(), m_function_hooks.end(),
+                                 [address](const auto& entry) { return entry.first == address; });
+  if (hook == m_function_hooks.end())
+    return false;
 
-    if (type != HLE::HookType::Replace)
-      return false;
+  const u32 hook_index = hook->second;
+  HLEFunction(hook_index);
 
-    MOV(32, R(RSCRATCH), PPCSTATE(npc));
-    js.downcountAmount += js.st.numCycles;
-    WriteExitDestInRSCRATCH();
-    return true;
-  });
+  if (HLE::GetHookTypeByIndex(hook_index) != HLE::HookType::Replace)
+    return false;
+
+  MOV(32, R(RSCRATCH), PPCSTATE(npc));
+  js.downcountAmount += js.st.numCycles;
+  WriteExitDestInRSCRATCH();
+  return true;
 }
 
 void LogGeneratedX86(size_t size, const PPCAnalyst::CodeBuffer& code_buffer, const u8* normalEntry,
@@ -18,11 +18,24 @@
 // ----------
 #pragma once
 
+#include <array>
+#include <memory>
+#include <optional>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
 #include <rangeset/rangesizeset.h>
 
 #include "Common/CommonTypes.h"
+#include "Common/SPSCQueue.h"
+#include "Common/WorkQueueThread.h"
 #include "Common/x64ABI.h"
 #include "Common/x64Emitter.h"
+#include "Core/PowerPC/CachedInterpreter/CachedInterpreter.h"
 #include "Core/PowerPC/Jit64/JitAsm.h"
 #include "Core/PowerPC/Jit64/RegCache/FPURegCache.h"
 #include "Core/PowerPC/Jit64/RegCache/GPRRegCache.h"
@@ -32,16 +45,25 @@
 #include "Core/PowerPC/Jit64Common/TrampolineCache.h"
 #include "Core/PowerPC/JitCommon/JitBase.h"
 #include "Core/PowerPC/JitCommon/JitCache.h"
-
-namespace PPCAnalyst
-{
-struct CodeBlock;
-struct CodeOp;
-}  // namespace PPCAnalyst
+#include "Core/PowerPC/JitCommon/JitDiskCache.h"
+#include "Core/PowerPC/PPCAnalyst.h"
+#include "Core/PowerPC/PowerPC.h"
 
 class Jit64 : public JitBase, public QuantizedMemoryRoutines
 {
 public:
+  // The guest state a block is compiled for. Analysis and code generation read it instead of
+  // PowerPC::ppcState, which the CPU thread keeps changing while the compiler thread is busy.
+  struct GuestState
+  {
+    UReg_MSR msr;
+    u32 mmcr0;
+    u32 mmcr1;
+    std::array<u32, 32> gpr;
+    std::array<PowerPC::PairedSingle, 32> ps;
+    std::array<u32, 8> gqr;
+  };
+
   Jit64();
   ~Jit64() override;
 
@@ -60,6 +82,15 @@ public:
   void Jit(u32 em_address) override;
   void Jit(u32 em_address, bool clear_cache_and_retry_on_failure);
   bool DoJit(u32 em_address, JitBlock* b, u32 nextPC);
+  // Generates a block that runs code_block through the cached interpreter until it has run
+  // often enough to be worth compiling.
+  bool DoInterpretedJit(u32 em_address, JitBlock* b, u32 nextPC);
+  // Generates and finalizes the block that was just analyzed into code_block.
+  // Returns false if the code regions are out of space.
+  bool EmitBlock(u32 em_address, u32 nextPC, bool interpreted = false);
+  // Generates the code of b from code_block and marks the memory it uses as used. The emitters
+  // must point to a free region.
+  bool GenerateBlock(u32 em_address, JitBlock* b, u32 nextPC, bool interpreted);
 
   // Finds a free memory region and sets the near and far code emitters to point at that region.
   // Returns false if no free memory region can be found for either of the two.
@@ -68,9 +99,17 @@ public:
   BitSet32 CallerSavedRegistersInUse() const;
   BitSet8 ComputeStaticGQRs(const PPCAnalyst::CodeBlock&) const;
 
+  // Whether IntializeSpeculativeConstants specializes a block for an input register holding value.
+  static bool IsSpeculativeConstant(u32 value);
   void IntializeSpeculativeConstants();
+  void CheckEntryHints();
+
+  // Invalidates the blocks promoted since the last call, so that they are compiled again. Called
+  // by the dispatcher, where none of them is running.
+  static void ApplyPromotions(Jit64& jit);
 
   JitBlockCache* GetBlockCache() override { return &blocks; }
+  const GuestState& GetGuestState() const { return m_guest_state; }
   void Trace();
 
   void ClearCache() override;
@@ -92,6 +131,8 @@ public:
   void WriteExternalExceptionExit();
   void WriteRfiExitDestInRSCRATCH();
   void WriteIdleExit(u32 destination);
+  // Jumps back to the start of a loop in the block, or exits to it if it isn't compiled as one.
+  void WriteLoopBranch(u32 destination);
   bool Cleanup();
 
   void GenerateConstantOverflow(bool overflow);
@@ -243,10 +284,136 @@ public:
   void eieio(UGeckoInstruction inst);
 
 private:
+  // HLE hooks of the instructions of a block, as pairs of address and hook index.
+  using FunctionHooks = std::vector<std::pair<u32, u32>>;
+
+  // A request for the compiler thread. Blocks are analyzed by the CPU thread when they are queued,
+  // and the request carries everything code generation reads, so that the compiler thread never
+  // looks at the guest state or at this JIT's state.
+  struct CompileRequest
+  {
+    enum class Type
+    {
+      Compile,
+      // Makes the code space of blocks the CPU thread dropped available to the compiler again.
+      ReleaseCodeSpace,
+      // Drops everything generated before a cache clear.
+      ClearCodeSpace,
+    };
+
+    Type type = Type::Compile;
+    u32 generation = 0;
+
+    u32 effective_address = 0;
+    u32 next_pc = 0;
+    JitOptions jo{};
+    bool enable_blr_optimization = false;
+    GuestState state{};
+    PPCAnalyst::PPCAnalyzer analyzer;
+    FunctionHooks function_hooks;
+    // What earlier versions of the block found out at run time, from the exception address sets.
+    bool paired_quantize_exception = false;
+    bool speculative_constants_exception = false;
+    std::vector<u32> fifo_write_addresses;
+    // The stats pointers of code_block don't point into the request once it has been moved.
+    PPCAnalyst::CodeBlock code_block{};
+    PPCAnalyst::BlockStats stats{};
+    PPCAnalyst::BlockRegStats gpa{};
+    PPCAnalyst::BlockRegStats fpa{};
+    PPCAnalyst::CodeBuffer code;
+    // Recorded in the disk cache once the block is published.
+    std::optional<JitDiskCache::Entry> disk_cache_entry;
+
+    std::vector<std::pair<u8*, u8*>> near_ranges;
+    std::vector<std::pair<u8*, u8*>> far_ranges;
+  };
+
+  // A block generated by the compiler thread, waiting for the CPU thread to publish it.
+  struct CompiledBlock
+  {
+    enum class Status
+    {
+      Compiled,
+      OutOfSpace,
+    };
+
+    u32 generation = 0;
+    u32 effective_address = 0;
+    u32 msr_bits = 0;
+    Status status = Status::Compiled;
+    // Only the code of the block is filled in.
+    JitBlock block{};
+    std::set<u32> physical_addresses;
+    // Address and value of every guest instruction the block was generated from.
+    std::vector<std::pair<u32, u32>> instructions;
+    std::unordered_map<u8*, TrampolineInfo> back_patch_info;
+    std::unordered_map<u8*, u8*> exception_handler_at_loc;
+    std::optional<JitDiskCache::Entry> disk_cache_entry;
+  };
+
   void CompileInstruction(PPCAnalyst::CodeOp& op);
 
+  static FunctionHooks GetFunctionHooks(const PPCAnalyst::CodeBlock& block,
+                                        const PPCAnalyst::CodeBuffer& buffer);
   bool HandleFunctionHooking(u32 address);
 
+  // Opens or closes the disk cache to match the settings and the running game.
+  void UpdateDiskCache();
+  u64 GetDiskCacheOptionsHash() const;
+  static u64 GetCodeHash(const PPCAnalyst::CodeBlock& block, const PPCAnalyst::CodeBuffer& buffer,
+                         u32 nextPC);
+  JitDiskCache::Entry GetDiskCacheEntry(u32 em_address, const GuestState& state,
+                                        const PPCAnalyst::CodeBlock& block,
+                                        const PPCAnalyst::CodeBuffer& buffer, u32 nextPC) const;
+  void RecordBlock(u32 em_address, u32 nextPC);
+  // Queues the blocks known from the disk cache in the region of em_address for the compiler
+  // thread.
+  void CompileCachedRegion(u32 em_address);
+  void RestoreExceptionAddresses(const JitDiskCache::Entry& entry);
+  // Puts the registers the block was specialized for into state.
+  static void ApplyAssumptions(const JitDiskCache::Assumptions& assumptions, GuestState* state);
+
+  // Called by an interpreted block that has run MAIN_JIT_TIER_UP_THRESHOLD times. The block then
+  // exits to asm_routines.dispatcher_promote.
+  static void PromoteBlock(Jit64* jit, u32 em_address);
+  bool UsesInterpretedTier(u32 em_address) const;
+
+  static GuestState CaptureGuestState();
+  // Analyzes the block at em_address into block and m_code_buffer, compiling its loops as native
+  // loops if they are hot.
+  u32 AnalyzeBlock(u32 em_address, const GuestState& state, PPCAnalyst::CodeBlock* block,
+                   std::size_t block_size);
+  // Guesses the register state on entry to the block from the code around it.
+  PPCAnalyst::EntryHints GetEntryHints(u32 em_address, const GuestState& state);
+  // Flushes the registers and binds the ones used by the loop starting at the given instruction.
+  void WriteLoopHeader(u32 index);
+  // Called by a block whose loops have branched back LOOP_PROMOTION_THRESHOLD times. The block
+  // then exits to asm_routines.dispatcher_promote.
+  static void PromoteLoops(Jit64* jit, u32 em_address);
+
+  // Clears the cache if the trampolines are almost full, and makes the code space of destroyed
+  // blocks available again.
+  void PrepareCodeSpace();
+
+  // Handles a dispatcher miss without waiting for the compiler thread.
+  void JitInBackground(u32 em_address);
+  // Drops the block if code_hash is given and doesn't match the analyzed guest code.
+  void QueueCompilation(u32 em_address, const GuestState& state,
+                        std::optional<u64> code_hash = std::nullopt);
+  // Sets up m_compiler to generate code for the blocks of owner.
+  void InitCompiler(Jit64& owner);
+  // Runs on the compiler thread, and only touches m_compiler and m_compiled_blocks.
+  void CompileInBackground(CompileRequest request);
+  // Called on m_compiler.
+  CompiledBlock GenerateInBackground(CompileRequest& request);
+  // Moves the blocks generated by the compiler thread into the block cache.
+  void PublishCompiledBlocks();
+  bool MatchesGuestCode(const CompiledBlock& compiled) const;
+  // Hands the code space of a block generated by the compiler thread back to it.
+  void ReleaseCodeSpace(const JitBlock& block);
+  // Runs the interpreter until the end of the straight-line code at PC.
+  void InterpretBlock();
+
   void AllocStack();
   void FreeStack();
 
@@ -266,6 +433,59 @@ private:
 
   HyoutaUtilities::RangeSizeSet<u8*> m_free_ranges_near;
   HyoutaUtilities::RangeSizeSet<u8*> m_free_ranges_far;
+
+  GuestState m_guest_state{};
+  // The HLE hooks of the block being compiled, looked up when it was analyzed.
+  FunctionHooks m_function_hooks;
+  // The JIT whose block cache the generated code uses. Only differs for m_compiler.
+  Jit64* m_owner = this;
+
+  JitDiskCache m_disk_cache;
+  bool m_disk_cache_enabled = false;
+  std::string m_disk_cache_game_id;
+
+  bool m_tiered_compilation = false;
+  u32 m_tier_up_threshold = 0;
+  // Instructions of the interpreted blocks, allocated in chunks as blocks are interpreted. Blocks
+  // point into the chunks, so they are only freed when the cache is cleared.
+  std::vector<std::vector<CachedInterpreter::Instruction>> m_interpreted_code;
+  // Blocks that have run often enough to be compiled instead of interpreted.
+  std::unordered_set<u32> m_promoted_blocks;
+  // Blocks promoted by the generated code, waiting for the dispatcher to invalidate them.
+  std::vector<u32> m_pending_promotions;
+
+  struct LoopHeader
+  {
+    u32 address;
+    const u8* code;
+    RegCache::LoopState gpr;
+    RegCache::LoopState fpr;
+  };
+
+  bool m_region_compilation = false;
+  // Loops of the block being compiled, in the order of their first instruction.
+  std::vector<LoopHeader> m_loop_headers;
+  // Backward branches left in a block before its loops are compiled as native loops. The
+  // generated code decrements them, so their addresses must not change.
+  std::unordered_map<u32, u32> m_loop_counters;
+  // Blocks compiled with native loops. Only used by the CPU thread.
+  std::unordered_set<u32> m_hot_loop_blocks;
+
+  bool m_background_compilation = false;
+  // Generates blocks on the compiler thread, with emitters, register caches, JIT state and code
+  // space of its own. The code space is carved out of the end of this JIT's.
+  std::unique_ptr<Jit64> m_compiler;
+  Common::WorkQueueThread<CompileRequest> m_compile_queue;
+  // Incremented by every cache clear, so that blocks generated before it are dropped. m_compiler
+  // holds the generation it generates blocks for.
+  u32 m_compile_generation = 0;
+  // Addresses requested from the compiler thread and not yet published. Only used by the CPU
+  // thread.
+  std::unordered_set<u32> m_queued_blocks;
+  // Polled by the CPU thread, so that it never waits for the compiler thread.
+  Common::SPSCQueue<CompiledBlock, false> m_compiled_blocks;
+
+  bool m_entry_hints = false;
 };
 
 void LogGeneratedX86(size_t size, const PPCAnalyst::CodeBuffer& code_buffer, const u8* normalEntry,
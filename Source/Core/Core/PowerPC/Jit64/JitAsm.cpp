@@ -32,6 +32,12 @@ void Jit64AsmRoutineManager::Init(u8* stack_top)
   WriteProtect();
 }
 
+void Jit64AsmRoutineManager::Init(const Jit64AsmRoutineManager& other)
+{
+  static_cast<CommonAsmRoutinesBase&>(*this) = other;
+  m_stack_top = other.m_stack_top;
+}
+
 // PLAN: no more block numbers - crazy opcodes just contain offset within
 // dynarec buffer
 // At this offset - 4, there is an int specifying the block number.
@@ -190,9 +196,22 @@ void Jit64AsmRoutineManager::Generate()
   ABI_CallFunction(JitTrampoline);
   ABI_PopRegistersAndAdjustStack({}, 0);
 
+  // With background compilation, Jit may have interpreted the block instead, using up cycles.
+  CMP(32, PPCSTATE(downcount), Imm8(0));
+  FixupBranch interpreted_bail = J_CC(CC_LE, true);
   JMP(dispatcher_no_check, true);
 
+  // Blocks that promote themselves exit here instead of invalidating themselves while they run.
+  dispatcher_promote = GetCodePtr();
+  ABI_PushRegistersAndAdjustStack({}, 0);
+  MOV(64, R(ABI_PARAM1), Imm64(reinterpret_cast<u64>(&static_cast<Jit64&>(m_jit))));
+  ABI_CallFunction(Jit64::ApplyPromotions);
+  ABI_PopRegistersAndAdjustStack({}, 0);
+  CMP(32, PPCSTATE(downcount), Imm8(0));
+  JMP(dispatcher, true);
+
   SetJumpTarget(bail);
+  SetJumpTarget(interpreted_bail);
   do_timing = GetCodePtr();
 
   // make sure npc contains the next pc (needed for exception checking in CoreTiming::Advance)
@@ -38,6 +38,8 @@ public:
   explicit Jit64AsmRoutineManager(Jit64& jit);
 
   void Init(u8* stack_top);
+  // Uses the routines generated by other, for a JIT that generates blocks in the same code space.
+  void Init(const Jit64AsmRoutineManager& other);
 
   void ResetStack(Gen::X64CodeBlock& emitter);
 
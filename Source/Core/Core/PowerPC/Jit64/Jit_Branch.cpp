@@ -150,16 +150,21 @@ void Jit64::bcx(UGeckoInstruction inst)
   {
     RCForkGuard gpr_guard = gpr.Fork();
     RCForkGuard fpr_guard = fpr.Fork();
-    gpr.Flush();
-    fpr.Flush();
 
-    if (js.op->branchIsIdleLoop)
+    if (js.op->branchIsLoop)
     {
-      WriteIdleExit(js.op->branchTo);
+      // Flushes the registers only if the loop isn't compiled as a native loop.
+      WriteLoopBranch(js.op->branchTo);
     }
     else
     {
-      WriteExit(js.op->branchTo, inst.LK, js.compilerPC + 4);
+      gpr.Flush();
+      fpr.Flush();
+
+      if (js.op->branchIsIdleLoop)
+        WriteIdleExit(js.op->branchTo);
+      else
+        WriteExit(js.op->branchTo, inst.LK, js.compilerPC + 4);
     }
   }
 
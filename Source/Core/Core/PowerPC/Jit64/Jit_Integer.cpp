@@ -363,6 +363,16 @@ void Jit64::DoMergedBranch()
   const UGeckoInstruction& next = js.op[1].inst;
   const u32 nextPC = js.op[1].address;
 
+  if (js.op[1].branchIsLoop)
+  {
+    // Flushes the registers only if the loop isn't compiled as a native loop.
+    WriteLoopBranch(js.op[1].branchTo);
+    return;
+  }
+
+  gpr.Flush();
+  fpr.Flush();
+
   if (js.op[1].branchIsIdleLoop)
   {
     if (next.LK)
@@ -430,9 +440,6 @@ void Jit64::DoMergedBranchCondition()
     RCForkGuard gpr_guard = gpr.Fork();
     RCForkGuard fpr_guard = fpr.Fork();
 
-    gpr.Flush();
-    fpr.Flush();
-
     DoMergedBranch();
   }
 
@@ -469,8 +476,6 @@ void Jit64::DoMergedBranchImmediate(s64 val)
 
   if (branch)
   {
-    gpr.Flush();
-    fpr.Flush();
     DoMergedBranch();
   }
   else if (!analyzer.HasOption(PPCAnalyst::PPCAnalyzer::OPTION_CONDITIONAL_CONTINUE))
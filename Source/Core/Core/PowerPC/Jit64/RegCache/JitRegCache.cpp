@@ -449,6 +449,58 @@ void RegCache::PreloadRegisters(BitSet32 to_preload)
   }
 }
 
+RegCache::LoopState RegCache::BindForLoop(BitSet32 pregs)
+{
+  Flush();
+
+  LoopState state;
+  state.fill(INVALID_REG);
+  for (preg_t preg : pregs)
+  {
+    // Like PreloadRegisters, leave a register for the outputs of the instructions in the loop.
+    if (NumFreeRegisters() < 2)
+      break;
+
+    // The loop may modify any of them, so they have to be stored when leaving it.
+    BindToRegister(preg, true, true);
+    state[preg] = RX(preg);
+  }
+  return state;
+}
+
+void RegCache::RestoreLoopState(const LoopState& state)
+{
+  ASSERT(IsAllUnlocked());
+
+  // Store everything that isn't bound to the host register it had at the start of the loop. This
+  // also frees the host registers that are needed below.
+  BitSet32 to_flush;
+  for (preg_t i = 0; i < m_regs.size(); i++)
+  {
+    if (state[i] == INVALID_REG || !m_regs[i].IsBound() || RX(i) != state[i])
+      to_flush[i] = true;
+  }
+  Flush(to_flush);
+
+  for (preg_t i = 0; i < m_regs.size(); i++)
+  {
+    const X64Reg xr = state[i];
+    if (xr == INVALID_REG)
+      continue;
+
+    if (m_regs[i].IsBound())
+    {
+      m_xregs[xr].MakeDirty();
+      continue;
+    }
+
+    ASSERT_MSG(DYNA_REC, m_xregs[xr].IsFree(), "Xreg %i is still in use", xr);
+    m_xregs[xr].SetBoundTo(i, true);
+    LoadRegister(i, xr);
+    m_regs[i].SetBoundTo(xr);
+  }
+}
+
 BitSet32 RegCache::RegistersInUse() const
 {
   BitSet32 result;
@@ -176,6 +176,15 @@ public:
   bool IsAllUnlocked() const;
 
   void PreloadRegisters(BitSet32 pregs);
+
+  // Where each guest register is kept while a loop runs: the host register it is bound to, or
+  // INVALID_REG if it is in its default location.
+  using LoopState = std::array<Gen::X64Reg, 32>;
+  // Flushes all registers, then binds as many of pregs as possible for the duration of a loop.
+  LoopState BindForLoop(BitSet32 pregs);
+  // Puts every register back where it was at the start of the loop, so that the loop can jump
+  // back to its first instruction.
+  void RestoreLoopState(const LoopState& state);
   BitSet32 RegistersInUse() const;
 
 protected:
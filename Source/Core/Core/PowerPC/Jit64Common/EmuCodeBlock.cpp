@@ -4,8 +4,11 @@
 
 #include "Core/PowerPC/Jit64Common/EmuCodeBlock.h"
 
+#include <array>
+#include <cstddef>
 #include <functional>
 #include <limits>
+#include <optional>
 
 #include "Common/Assert.h"
 #include "Common/CPUDetect.h"
@@ -121,6 +124,87 @@ FixupBranch EmuCodeBlock::CheckIfSafeAddress(const OpArg& reg_value, X64Reg reg_
   return J_CC(CC_Z, m_far_code.Enabled());
 }
 
+FixupBranch EmuCodeBlock::AccessThroughHostTLB(bool write, const OpArg& reg_value,
+                                               X64Reg reg_addr, int accessSize, bool signExtend,
+                                               bool swap, BitSet32 registers_in_use)
+{
+  // Find two registers other than the address and the value. RSI and RDI may be callee saved
+  // registers holding guest state, which registers_in_use doesn't include, so they are always
+  // saved.
+  std::array<X64Reg, 2> temps;
+  size_t num_temps = 0;
+  for (X64Reg reg : {RSCRATCH, RSCRATCH2, RSCRATCH_EXTRA, RSI, RDI})
+  {
+    if (num_temps < temps.size() && reg != reg_addr && !reg_value.IsSimpleReg(reg))
+      temps[num_temps++] = reg;
+  }
+  const X64Reg entry = temps[0];
+  const X64Reg page = temps[1];
+
+  BitSet32 saved;
+  for (X64Reg reg : temps)
+  {
+    if (registers_in_use[reg] || (reg != RSCRATCH && reg != RSCRATCH2 && reg != RSCRATCH_EXTRA))
+      saved[reg] = true;
+  }
+  const auto push = [&] {
+    for (int reg : saved)
+      PUSH(static_cast<X64Reg>(reg));
+  };
+  const auto pop = [&] {
+    for (int reg = 15; reg >= 0; --reg)
+    {
+      if (saved[reg])
+        POP(static_cast<X64Reg>(reg));
+    }
+  };
+
+  const size_t table = write ? PowerPC::HOST_TLB_WRITE : PowerPC::HOST_TLB_READ;
+  const auto& first = PowerPC::ppcState.host_tlb[table][0];
+  const int tag_offset = static_cast<int>(reinterpret_cast<const char*>(&first.tag) -
+                                          reinterpret_cast<const char*>(&PowerPC::ppcState)) -
+                         0x80;
+  const int offset_offset = tag_offset + static_cast<int>(offsetof(PowerPC::HostTLBEntry, offset));
+
+  push();
+
+  // The entry is chosen by the page of the first byte, and the tag is compared with the page of
+  // the last byte, so that accesses crossing into the next page miss.
+  MOV(32, R(entry), R(reg_addr));
+  SHR(32, R(entry), Imm8(PowerPC::HOST_TLB_PAGE_SHIFT - 4));
+  AND(32, R(entry), Imm32((PowerPC::HOST_TLB_SIZE - 1) * sizeof(PowerPC::HostTLBEntry)));
+  LEA(32, page, MDisp(reg_addr, accessSize / 8 - 1));
+  AND(32, R(page), Imm32(~(PowerPC::HOST_TLB_PAGE_SIZE - 1)));
+  CMP(32, R(page), MComplex(RPPCSTATE, entry, SCALE_1, tag_offset));
+  FixupBranch miss = J_CC(CC_NE);
+
+  MOV(64, R(entry), MComplex(RPPCSTATE, entry, SCALE_1, offset_offset));
+  const OpArg host_address = MComplex(entry, reg_addr, SCALE_1, 0);
+  if (!write)
+  {
+    LoadAndSwap(accessSize, reg_value.GetSimpleReg(), host_address, signExtend);
+  }
+  else if (reg_value.IsImm())
+  {
+    MOV(accessSize, host_address, swap ? SwapImmediate(accessSize, reg_value) : reg_value);
+  }
+  else if (swap)
+  {
+    SwapAndStore(accessSize, host_address, reg_value.GetSimpleReg());
+  }
+  else
+  {
+    MOV(accessSize, host_address, reg_value);
+  }
+
+  pop();
+  FixupBranch hit = J(true);
+
+  SetJumpTarget(miss);
+  pop();
+  return hit;
+}
+
 void EmuCodeBlock::UnsafeLoadRegToReg(X64Reg reg_addr, X64Reg reg_value, int accessSize, s32 offset,
                                       bool signExtend)
 {
@@ -373,7 +457,7 @@ void EmuCodeBlock::SafeLoadToReg(X64Reg reg_value, const Gen::OpArg& opAddress,
   }
 
   FixupBranch exit;
-  const bool dr_set = (flags & SAFE_LOADSTORE_DR_ON) || MSR.DR;
+  const bool dr_set = (flags & SAFE_LOADSTORE_DR_ON) || IsDataTranslationEnabled();
   const bool fast_check_address = !slowmem && dr_set && m_jit.jo.fastmem_arena;
   if (fast_check_address)
   {
@@ -386,6 +470,13 @@ void EmuCodeBlock::SafeLoadToReg(X64Reg reg_value, const Gen::OpArg& opAddress,
     SetJumpTarget(slow);
   }
 
+  std::optional<FixupBranch> host_tlb_hit;
+  if (dr_set && m_jit.jo.host_tlb)
+  {
+    host_tlb_hit = AccessThroughHostTLB(false, R(reg_value), reg_addr, accessSize, signExtend,
+                                        true, registersInUse);
+  }
+
   // Helps external systems know which instruction triggered the read.
   // Invalid for calls from Jit64AsmCommon routines
   if (!(flags & SAFE_LOADSTORE_NO_UPDATE_PC))
@@ -423,6 +514,9 @@ void EmuCodeBlock::SafeLoadToReg(X64Reg reg_value, const Gen::OpArg& opAddress,
     MOVZX(64, accessSize, reg_value, R(ABI_RETURN));
   }
 
+  if (host_tlb_hit)
+    SetJumpTarget(*host_tlb_hit);
+
   if (fast_check_address)
   {
     if (m_far_code.Enabled())
@@ -438,14 +532,16 @@ void EmuCodeBlock::SafeLoadToRegImmediate(X64Reg reg_value, u32 address, int acc
                                           BitSet32 registersInUse, bool signExtend)
 {
   // If the address is known to be RAM, just load it directly.
-  if (m_jit.jo.fastmem_arena && PowerPC::IsOptimizableRAMAddress(address))
+  if (m_jit.jo.fastmem_arena && IsDataTranslationEnabled() &&
+      PowerPC::IsOptimizableRAMAddress(address))
   {
     UnsafeLoadToReg(reg_value, Imm32(address), accessSize, 0, signExtend);
     return;
   }
 
   // If the address maps to an MMIO register, inline MMIO read code.
-  u32 mmioAddress = PowerPC::IsOptimizableMMIOAccess(address, accessSize);
+  u32 mmioAddress =
+      IsDataTranslationEnabled() ? PowerPC::IsOptimizableMMIOAccess(address, accessSize) : 0;
   if (accessSize != 64 && mmioAddress)
   {
     MMIOLoadToReg(Memory::mmio_mapping.get(), reg_value, registersInUse, mmioAddress, accessSize,
@@ -541,7 +637,7 @@ void EmuCodeBlock::SafeWriteRegToReg(OpArg reg_value, X64Reg reg_addr, int acces
   }
 
   FixupBranch exit;
-  const bool dr_set = (flags & SAFE_LOADSTORE_DR_ON) || MSR.DR;
+  const bool dr_set = (flags & SAFE_LOADSTORE_DR_ON) || IsDataTranslationEnabled();
   const bool fast_check_address = !slowmem && dr_set && m_jit.jo.fastmem_arena;
   if (fast_check_address)
   {
@@ -554,6 +650,13 @@ void EmuCodeBlock::SafeWriteRegToReg(OpArg reg_value, X64Reg reg_addr, int acces
     SetJumpTarget(slow);
   }
 
+  std::optional<FixupBranch> host_tlb_hit;
+  if (dr_set && m_jit.jo.host_tlb)
+  {
+    host_tlb_hit =
+        AccessThroughHostTLB(true, reg_value, reg_addr, accessSize, false, swap, registersInUse);
+  }
+
   // PC is used by memory watchpoints (if enabled) or to print accurate PC locations in debug logs
   // Invalid for calls from Jit64AsmCommon routines
   if (!(flags & SAFE_LOADSTORE_NO_UPDATE_PC))
@@ -595,6 +698,9 @@ void EmuCodeBlock::SafeWriteRegToReg(OpArg reg_value, X64Reg reg_addr, int acces
 
   MemoryExceptionCheck();
 
+  if (host_tlb_hit)
+    SetJumpTarget(*host_tlb_hit);
+
   if (fast_check_address)
   {
     if (m_far_code.Enabled())
@@ -624,7 +730,8 @@ bool EmuCodeBlock::WriteToConstAddress(int accessSize, OpArg arg, u32 address,
 
   // If we already know the address through constant folding, we can do some
   // fun tricks...
-  if (m_jit.jo.optimizeGatherPipe && PowerPC::IsOptimizableGatherPipeWrite(address))
+  if (m_jit.jo.optimizeGatherPipe && IsDataTranslationEnabled() &&
+      PowerPC::IsOptimizableGatherPipeWrite(address))
   {
     X64Reg arg_reg = RSCRATCH;
 
@@ -644,7 +751,8 @@ bool EmuCodeBlock::WriteToConstAddress(int accessSize, OpArg arg, u32 address,
     m_jit.js.fifoBytesSinceCheck += accessSize >> 3;
     return false;
   }
-  else if (m_jit.jo.fastmem_arena && PowerPC::IsOptimizableRAMAddress(address))
+  else if (m_jit.jo.fastmem_arena && IsDataTranslationEnabled() &&
+           PowerPC::IsOptimizableRAMAddress(address))
   {
     WriteToConstRamAddress(accessSize, arg, address);
     return false;
@@ -1013,6 +1121,14 @@ void EmuCodeBlock::SetFPRF(Gen::X64Reg xmm)
   OR(32, PPCSTATE(fpscr), R(RSCRATCH));
 }
 
+bool EmuCodeBlock::IsDataTranslationEnabled() const
+{
+  // Trampolines are generated by the CPU thread while the guest is running, for the current MSR.
+  // The MMU checks used with this still read the current MSR and BATs, which can only make them
+  // more conservative.
+  return m_jit.js.generatingTrampoline ? MSR.DR : m_jit.GetGuestState().msr.DR;
+}
+
 void EmuCodeBlock::Clear()
 {
   m_back_patch_info.clear();
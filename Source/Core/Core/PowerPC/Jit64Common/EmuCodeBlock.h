@@ -52,6 +52,12 @@ public:
 
   Gen::FixupBranch CheckIfSafeAddress(const Gen::OpArg& reg_value, Gen::X64Reg reg_addr,
                                       BitSet32 registers_in_use);
+  // Looks up the page of the effective address in reg_addr in the host TLB, and accesses memory
+  // through it on a hit. Returns the branch taken after a hit, which should skip the slow path
+  // emitted next. Only valid with MSR.DR set.
+  Gen::FixupBranch AccessThroughHostTLB(bool write, const Gen::OpArg& reg_value,
+                                        Gen::X64Reg reg_addr, int accessSize, bool signExtend,
+                                        bool swap, BitSet32 registers_in_use);
   void UnsafeLoadRegToReg(Gen::X64Reg reg_addr, Gen::X64Reg reg_value, int accessSize,
                           s32 offset = 0, bool signExtend = false);
   void UnsafeLoadRegToRegNoSwap(Gen::X64Reg reg_addr, Gen::X64Reg reg_value, int accessSize,
@@ -128,6 +134,9 @@ public:
   void Clear();
 
 protected:
+  // MSR.DR of the guest state the code is generated for.
+  bool IsDataTranslationEnabled() const;
+
   Jit64& m_jit;
   ConstantPool m_const_pool;
   FarCodeCache m_far_code;
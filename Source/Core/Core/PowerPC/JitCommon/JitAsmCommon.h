@@ -19,6 +19,9 @@ struct CommonAsmRoutinesBase
   const u8* dispatcher_mispredicted_blr;
   const u8* dispatcher;
   const u8* dispatcher_no_check;
+  // Invalidates the blocks that were promoted by the code that just exited, then dispatches
+  // to PC. Only generated by Jit64.
+  const u8* dispatcher_promote;
 
   const u8* do_timing;
 
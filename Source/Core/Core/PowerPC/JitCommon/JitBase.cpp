@@ -47,4 +47,5 @@ void JitBase::UpdateMemoryOptions()
   bool any_watchpoints = PowerPC::memchecks.HasAny();
   jo.fastmem = SConfig::GetInstance().bFastmem && jo.fastmem_arena && (MSR.DR || !any_watchpoints);
   jo.memcheck = SConfig::GetInstance().bMMU || any_watchpoints;
+  jo.host_tlb = SConfig::GetInstance().bMMU && !any_watchpoints;
 }
@@ -50,6 +50,7 @@ protected:
     bool fastmem;
     bool fastmem_arena;
     bool memcheck;
+    bool host_tlb;
     bool profile_blocks;
   };
   struct JitState
@@ -92,6 +93,7 @@ protected:
     std::unordered_set<u32> fifoWriteAddresses;
     std::unordered_set<u32> pairedQuantizeAddresses;
     std::unordered_set<u32> noSpeculativeConstantsAddresses;
+    std::unordered_set<u32> noEntryHintsAddresses;
   };
 
   PPCAnalyst::CodeBlock code_block;
@@ -13,9 +13,10 @@
 #include <array>
 #include <cstring>
 #include <functional>
-#include <map>
+#include <memory>
 #include <set>
 #include <utility>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 #include "Common/JitRegister.h"
@@ -65,13 +66,14 @@ void JitBaseBlockCache::Clear()
 #endif
   m_jit.js.fifoWriteAddresses.clear();
   m_jit.js.pairedQuantizeAddresses.clear();
-  for (auto& e : block_map)
-  {
-    DestroyBlock(e.second);
-  }
-  block_map.clear();
-  links_to.clear();
-  block_range_map.clear();
+  m_jit.js.noEntryHintsAddresses.clear();
+  block_map.ForEach([this](const BlockKey&, std::unique_ptr<JitBlock>& block) {
+    DestroyBlock(*block);
+  });
+  block_map.Clear();
+  links_to.Clear();
+  for (auto& level : page_map)
+    level.reset();
 
   valid_block.ClearAll();
 
@@ -91,20 +93,26 @@ JitBlock** JitBaseBlockCache::GetFastBlockMap()
 
 void JitBaseBlockCache::RunOnBlocks(std::function<void(const JitBlock&)> f)
 {
-  for (const auto& e : block_map)
-    f(e.second);
+  block_map.ForEach(
+      [&f](const BlockKey&, const std::unique_ptr<JitBlock>& block) { f(*block); });
 }
 
 JitBlock* JitBaseBlockCache::AllocateBlock(u32 em_address)
 {
   u32 physicalAddress = PowerPC::JitCache_TranslateAddress(em_address).address;
-  JitBlock& b = block_map.emplace(physicalAddress, JitBlock())->second;
-  b.effectiveAddress = em_address;
-  b.physicalAddress = physicalAddress;
-  b.msrBits = MSR.Hex & JIT_CACHE_MSR_MASK;
-  b.linkData.clear();
-  b.fast_block_map_index = 0;
-  return &b;
+  const BlockKey key{em_address, physicalAddress, MSR.Hex & JIT_CACHE_MSR_MASK};
+
+  // A block which is compiled again replaces the previous one.
+  if (std::unique_ptr<JitBlock>* old_block = block_map.Find(key))
+    EraseBlock(**old_block);
+
+  std::unique_ptr<JitBlock>& b = block_map[key];
+  b = std::make_unique<JitBlock>();
+  b->effectiveAddress = em_address;
+  b->physicalAddress = physicalAddress;
+  b->msrBits = key.msr_bits;
+  b->fast_block_map_index = 0;
+  return b.get();
 }
 
 void JitBaseBlockCache::FinalizeBlock(JitBlock& block, bool block_link,
@@ -116,20 +124,25 @@ void JitBaseBlockCache::FinalizeBlock(JitBlock& block, bool block_link,
 
   block.physical_addresses = physical_addresses;
 
-  u32 range_mask = ~(BLOCK_RANGE_MAP_ELEMENTS - 1);
+  // The addresses are sorted, so each page only has to be compared with the previous one.
+  u32 last_page = 0;
+  bool has_page = false;
   for (u32 addr : physical_addresses)
   {
     valid_block.Set(addr / 32);
-    block_range_map[addr & range_mask].insert(&block);
+
+    const u32 page = addr >> PAGE_SHIFT;
+    if (has_page && page == last_page)
+      continue;
+
+    GetPageBlocks(page).push_back(&block);
+    last_page = page;
+    has_page = true;
   }
 
   if (block_link)
   {
-    for (const auto& e : block.linkData)
-    {
-      links_to.emplace(e.exitAddress, &block);
-    }
-
+    AddLinks(block);
     LinkBlock(block);
   }
 
@@ -160,15 +173,9 @@ JitBlock* JitBaseBlockCache::GetBlockFromStartAddress(u32 addr, u32 msr)
     translated_addr = translated.address;
   }
 
-  auto iter = block_map.equal_range(translated_addr);
-  for (; iter.first != iter.second; iter.first++)
-  {
-    JitBlock& b = iter.first->second;
-    if (b.effectiveAddress == addr && b.msrBits == (msr & JIT_CACHE_MSR_MASK))
-      return &b;
-  }
-
-  return nullptr;
+  std::unique_ptr<JitBlock>* block =
+      block_map.Find(BlockKey{addr, translated_addr, msr & JIT_CACHE_MSR_MASK});
+  return block ? block->get() : nullptr;
 }
 
 const u8* JitBaseBlockCache::Dispatch()
@@ -216,6 +223,7 @@ void JitBaseBlockCache::InvalidateICache(u32 address, u32 length, bool forced)
       {
         m_jit.js.fifoWriteAddresses.erase(i);
         m_jit.js.pairedQuantizeAddresses.erase(i);
+        m_jit.js.noEntryHintsAddresses.erase(i);
       }
     }
   }
@@ -223,51 +231,70 @@ void JitBaseBlockCache::InvalidateICache(u32 address, u32 length, bool forced)
 
 void JitBaseBlockCache::ErasePhysicalRange(u32 address, u32 length)
 {
-  // Iterate over all macro blocks which overlap the given range.
-  u32 range_mask = ~(BLOCK_RANGE_MAP_ELEMENTS - 1);
-  auto start = block_range_map.lower_bound(address & range_mask);
-  auto end = block_range_map.lower_bound(address + length);
-  while (start != end)
+  if (length == 0)
+    return;
+
+  // Iterate over all pages which overlap the given range.
+  const u32 first_page = address >> PAGE_SHIFT;
+  const u32 last_page = static_cast<u32>((u64{address} + length - 1) >> PAGE_SHIFT);
+  for (u32 page = first_page; page <= last_page; page++)
   {
-    // Iterate over all blocks in the macro block.
-    auto iter = start->second.begin();
-    while (iter != start->second.end())
+    PageMapLevel* level = page_map[page >> PAGE_MAP_LEVEL_BITS].get();
+    if (!level)
     {
-      JitBlock* block = *iter;
-      if (block->OverlapsPhysicalRange(address, length))
-      {
-        // If the block overlaps, also remove all other occupied slots in the other macro blocks.
-        // This will leak empty macro blocks, but they may be reused or cleared later on.
-        for (u32 addr : block->physical_addresses)
-          if ((addr & range_mask) != start->first)
-            block_range_map[addr & range_mask].erase(block);
-
-        // And remove the block.
-        DestroyBlock(*block);
-        auto block_map_iter = block_map.equal_range(block->physicalAddress);
-        while (block_map_iter.first != block_map_iter.second)
-        {
-          if (&block_map_iter.first->second == block)
-          {
-            block_map.erase(block_map_iter.first);
-            break;
-          }
-          block_map_iter.first++;
-        }
-        iter = start->second.erase(iter);
-      }
+      // Skip to the last page covered by this (unallocated) level.
+      page |= PAGE_MAP_LEVEL_MASK;
+      continue;
+    }
+
+    // Iterate over all blocks in the page. Erasing a block replaces it with the last block of the
+    // page, so the index only advances past blocks which are kept.
+    std::vector<JitBlock*>& blocks = (*level)[page & PAGE_MAP_LEVEL_MASK];
+    size_t i = 0;
+    while (i < blocks.size())
+    {
+      if (blocks[i]->OverlapsPhysicalRange(address, length))
+        EraseBlock(*blocks[i]);
       else
-      {
-        iter++;
-      }
+        i++;
     }
+  }
+}
 
-    // If the macro block is empty, drop it.
-    if (start->second.empty())
-      start = block_range_map.erase(start);
-    else
-      start++;
+std::vector<JitBlock*>& JitBaseBlockCache::GetPageBlocks(u32 page)
+{
+  std::unique_ptr<PageMapLevel>& level = page_map[page >> PAGE_MAP_LEVEL_BITS];
+  if (!level)
+    level = std::make_unique<PageMapLevel>();
+  return (*level)[page & PAGE_MAP_LEVEL_MASK];
+}
+
+void JitBaseBlockCache::EraseBlock(JitBlock& block)
+{
+  DestroyBlock(block);
+
+  u32 last_page = 0;
+  bool has_page = false;
+  for (u32 addr : block.physical_addresses)
+  {
+    const u32 page = addr >> PAGE_SHIFT;
+    if (has_page && page == last_page)
+      continue;
+
+    std::vector<JitBlock*>& blocks = GetPageBlocks(page);
+    const auto it = std::find(blocks.begin(), blocks.end(), &block);
+    if (it != blocks.end())
+    {
+      *it = blocks.back();
+      blocks.pop_back();
+    }
+
+    last_page = page;
+    has_page = true;
   }
+
+  // This frees the block.
+  block_map.Erase(BlockKey{block.effectiveAddress, block.physicalAddress, block.msrBits});
 }
 
 u32* JitBaseBlockCache::GetBlockBitSet() const
@@ -304,13 +331,16 @@ void JitBaseBlockCache::LinkBlockExits(JitBlock& block)
 void JitBaseBlockCache::LinkBlock(JitBlock& block)
 {
   LinkBlockExits(block);
-  auto ppp = links_to.equal_range(block.effectiveAddress);
 
-  for (auto iter = ppp.first; iter != ppp.second; ++iter)
+  // Link all exits of other blocks which point to this block
+  JitBlock::LinkData** head = links_to.Find(block.effectiveAddress);
+  for (JitBlock::LinkData* e = head ? *head : nullptr; e; e = e->next_to_same_address)
   {
-    JitBlock& b2 = *iter->second;
-    if (block.msrBits == b2.msrBits)
-      LinkBlockExits(b2);
+    if (!e->linkStatus && e->block->msrBits == block.msrBits)
+    {
+      WriteLinkBlock(*e, &block);
+      e->linkStatus = true;
+    }
   }
 }
 
@@ -323,24 +353,54 @@ void JitBaseBlockCache::UnlinkBlock(const JitBlock& block)
   }
 
   // Unlink all exits of other blocks which points to this block
-  auto ppp = links_to.equal_range(block.effectiveAddress);
-  for (auto iter = ppp.first; iter != ppp.second; ++iter)
+  JitBlock::LinkData** head = links_to.Find(block.effectiveAddress);
+  for (JitBlock::LinkData* e = head ? *head : nullptr; e; e = e->next_to_same_address)
   {
-    JitBlock& sourceBlock = *iter->second;
-    if (sourceBlock.msrBits != block.msrBits)
-      continue;
-
-    for (auto& e : sourceBlock.linkData)
+    if (e->block->msrBits == block.msrBits)
     {
-      if (e.exitAddress == block.effectiveAddress)
-      {
-        WriteLinkBlock(e, nullptr);
-        e.linkStatus = false;
-      }
+      WriteLinkBlock(*e, nullptr);
+      e->linkStatus = false;
     }
   }
 }
 
+void JitBaseBlockCache::AddLinks(JitBlock& block)
+{
+  for (auto& e : block.linkData)
+  {
+    JitBlock::LinkData*& head = links_to[e.exitAddress];
+    e.block = &block;
+    e.prev_to_same_address = nullptr;
+    e.next_to_same_address = head;
+    if (head)
+      head->prev_to_same_address = &e;
+    head = &e;
+  }
+}
+
+void JitBaseBlockCache::RemoveLinks(JitBlock& block)
+{
+  for (auto& e : block.linkData)
+  {
+    if (!e.block)
+      continue;
+
+    if (e.next_to_same_address)
+      e.next_to_same_address->prev_to_same_address = e.prev_to_same_address;
+
+    if (e.prev_to_same_address)
+      e.prev_to_same_address->next_to_same_address = e.next_to_same_address;
+    else if (e.next_to_same_address)
+      *links_to.Find(e.exitAddress) = e.next_to_same_address;
+    else
+      links_to.Erase(e.exitAddress);
+
+    e.block = nullptr;
+    e.prev_to_same_address = nullptr;
+    e.next_to_same_address = nullptr;
+  }
+}
+
 void JitBaseBlockCache::DestroyBlock(JitBlock& block)
 {
   if (fast_block_map[block.fast_block_map_index] == &block)
@@ -349,17 +409,7 @@ void JitBaseBlockCache::DestroyBlock(JitBlock& block)
   UnlinkBlock(block);
 
   // Delete linking addresses
-  for (const auto& e : block.linkData)
-  {
-    auto it = links_to.equal_range(e.exitAddress);
-    while (it.first != it.second)
-    {
-      if (it.first->second == &block)
-        it.first = links_to.erase(it.first);
-      else
-        it.first++;
-    }
-  }
+  RemoveLinks(block);
 
   // Raise an signal if we are going to call this block again
   WriteDestroyBlock(block);
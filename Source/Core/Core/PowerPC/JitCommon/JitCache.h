@@ -8,13 +8,13 @@
 #include <bitset>
 #include <cstring>
 #include <functional>
-#include <map>
 #include <memory>
 #include <set>
 #include <type_traits>
 #include <vector>
 
 #include "Common/CommonTypes.h"
+#include "Common/FlatHashMap.h"
 
 class JitBase;
 
@@ -74,6 +74,12 @@ struct JitBlock : public JitBlockData
     u32 exitAddress;
     bool linkStatus;  // is it already linked?
     bool call;
+
+    // While the block is in the cache, every exit is part of the list of the exits to the same
+    // address; see JitBaseBlockCache::links_to.
+    JitBlock* block = nullptr;
+    LinkData* prev_to_same_address = nullptr;
+    LinkData* next_to_same_address = nullptr;
   };
   std::vector<LinkData> linkData;
 
@@ -89,6 +95,10 @@ struct JitBlock : public JitBlockData
     u64 ticStart;
     u64 ticStop;
   } profile_data = {};
+
+  // Used by Jit64 when tiered compilation is enabled: the number of runs left before an
+  // interpreted block gets compiled.
+  u32 runs_until_promotion = 0;
 };
 
 typedef void (*CompiledCode)();
@@ -176,25 +186,57 @@ private:
   void LinkBlockExits(JitBlock& block);
   void LinkBlock(JitBlock& block);
   void UnlinkBlock(const JitBlock& block);
+  void AddLinks(JitBlock& block);
+  void RemoveLinks(JitBlock& block);
+
+  std::vector<JitBlock*>& GetPageBlocks(u32 page);
+  // Destroys the block and removes it from all lookup structures.
+  void EraseBlock(JitBlock& block);
 
   JitBlock* MoveBlockIntoFastCache(u32 em_address, u32 msr);
 
   // Fast but risky block lookup based on fast_block_map.
   size_t FastLookupIndexForAddress(u32 address);
 
-  // links_to hold all exit points of all valid blocks in a reverse way.
-  // It is used to query all blocks which links to an address.
-  std::multimap<u32, JitBlock*> links_to;  // destination_PC -> number
+  struct BlockKey
+  {
+    bool operator==(const BlockKey& other) const
+    {
+      return effective_address == other.effective_address &&
+             physical_address == other.physical_address && msr_bits == other.msr_bits;
+    }
+
+    u32 effective_address;
+    u32 physical_address;
+    u32 msr_bits;
+  };
 
-  // Map indexed by the physical address of the entry point.
-  // This is used to query the block based on the current PC in a slow way.
-  std::multimap<u32, JitBlock> block_map;  // start_addr -> block
+  struct BlockKeyHash
+  {
+    size_t operator()(const BlockKey& key) const
+    {
+      // Effective and physical addresses usually share their low bits, so don't let them cancel.
+      const u32 rotated_physical = key.physical_address << 16 | key.physical_address >> 16;
+      return key.effective_address ^ rotated_physical ^ key.msr_bits;
+    }
+  };
 
-  // Range of overlapping code indexed by a masked physical address.
-  // This is used for invalidation of memory regions. The range is grouped
-  // in macro blocks of each 0x100 bytes.
-  static constexpr u32 BLOCK_RANGE_MAP_ELEMENTS = 0x100;
-  std::map<u32, std::set<JitBlock*>> block_range_map;
+  // links_to holds the heads of intrusive lists of all exit points of all valid blocks, indexed
+  // by their destination. It is used to find all blocks which link to an address.
+  Common::FlatHashMap<u32, JitBlock::LinkData*> links_to;  // destination_PC -> first exit
+
+  // All blocks, owned by this map. This is used to query the block based on the current PC in a
+  // slow way. Blocks are allocated separately, so their addresses stay stable.
+  Common::FlatHashMap<BlockKey, std::unique_ptr<JitBlock>, BlockKeyHash> block_map;
+
+  // Blocks overlapping each 4 KiB page of physical memory. This is used for invalidation of
+  // memory regions. The first level is indexed by the top bits of the address, and the second
+  // level is only allocated for memory which contains code.
+  static constexpr u32 PAGE_SHIFT = 12;
+  static constexpr u32 PAGE_MAP_LEVEL_BITS = 10;
+  static constexpr u32 PAGE_MAP_LEVEL_MASK = (1 << PAGE_MAP_LEVEL_BITS) - 1;
+  using PageMapLevel = std::array<std::vector<JitBlock*>, 1 << PAGE_MAP_LEVEL_BITS>;
+  std::array<std::unique_ptr<PageMapLevel>, 1 << PAGE_MAP_LEVEL_BITS> page_map;
 
   // This bitsets shows which cachelines overlap with any blocks.
   // It is used to provide a fast way to query if no icache invalidation is needed.
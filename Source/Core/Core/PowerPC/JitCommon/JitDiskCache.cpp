@@ -0,0 +1,225 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "Core/PowerPC/JitCommon/JitDiskCache.h"
+
+#include <cstring>
+#include <utility>
+
+#include "Common/BitSet.h"
+#include "Common/FileUtil.h"
+#include "Common/Logging/Log.h"
+
+// On disk, the assumptions of a block are a sequence of u32s:
+// gpr_inputs, static_gqrs, flags, fifo write count,
+// the values of the registers in gpr_inputs, the values of the GQRs in static_gqrs,
+// the fifo write addresses.
+enum AssumptionFlags : u32
+{
+  FLAG_PAIRED_QUANTIZE_EXCEPTION = 1 << 0,
+  FLAG_SPECULATIVE_CONSTANTS_EXCEPTION = 1 << 1,
+  FLAG_ENTRY_HINTS_EXCEPTION = 1 << 2,
+};
+
+constexpr size_t ASSUMPTIONS_HEADER_WORDS = 4;
+
+static std::vector<u32> SerializeAssumptions(const JitDiskCache::Assumptions& assumptions)
+{
+  u32 flags = 0;
+  if (assumptions.paired_quantize_exception)
+    flags |= FLAG_PAIRED_QUANTIZE_EXCEPTION;
+  if (assumptions.speculative_constants_exception)
+    flags |= FLAG_SPECULATIVE_CONSTANTS_EXCEPTION;
+  if (assumptions.entry_hints_exception)
+    flags |= FLAG_ENTRY_HINTS_EXCEPTION;
+
+  std::vector<u32> words{assumptions.gpr_inputs, assumptions.static_gqrs, flags,
+                         static_cast<u32>(assumptions.fifo_write_addresses.size())};
+
+  for (int i : BitSet32(assumptions.gpr_inputs))
+    words.push_back(assumptions.gpr[i]);
+  for (int i : BitSet32(assumptions.static_gqrs & 0xFF))
+    words.push_back(assumptions.gqr[i]);
+  words.insert(words.end(), assumptions.fifo_write_addresses.begin(),
+               assumptions.fifo_write_addresses.end());
+
+  return words;
+}
+
+static bool DeserializeAssumptions(const u8* data, u32 size, JitDiskCache::Assumptions* assumptions)
+{
+  if (size % sizeof(u32) != 0 || size < ASSUMPTIONS_HEADER_WORDS * sizeof(u32))
+    return false;
+
+  std::vector<u32> words(size / sizeof(u32));
+  std::memcpy(words.data(), data, size);
+
+  const BitSet32 gpr_inputs(words[0]);
+  const BitSet32 static_gqrs(words[1] & 0xFF);
+  const u32 flags = words[2];
+  const size_t fifo_write_count = words[3];
+
+  if (words.size() != ASSUMPTIONS_HEADER_WORDS + gpr_inputs.Count() + static_gqrs.Count() +
+                          fifo_write_count)
+  {
+    return false;
+  }
+
+  auto it = words.begin() + ASSUMPTIONS_HEADER_WORDS;
+
+  assumptions->gpr_inputs = gpr_inputs.m_val;
+  for (int i : gpr_inputs)
+    assumptions->gpr[i] = *it++;
+
+  assumptions->static_gqrs = static_gqrs.m_val;
+  for (int i : static_gqrs)
+    assumptions->gqr[i] = *it++;
+
+  assumptions->paired_quantize_exception = (flags & FLAG_PAIRED_QUANTIZE_EXCEPTION) != 0;
+  assumptions->speculative_constants_exception =
+      (flags & FLAG_SPECULATIVE_CONSTANTS_EXCEPTION) != 0;
+  assumptions->entry_hints_exception = (flags & FLAG_ENTRY_HINTS_EXCEPTION) != 0;
+  assumptions->fifo_write_addresses.assign(it, words.end());
+
+  return true;
+}
+
+bool JitDiskCache::Assumptions::operator==(const Assumptions& other) const
+{
+  return gpr_inputs == other.gpr_inputs && gpr == other.gpr && static_gqrs == other.static_gqrs &&
+         gqr == other.gqr && paired_quantize_exception == other.paired_quantize_exception &&
+         speculative_constants_exception == other.speculative_constants_exception &&
+         entry_hints_exception == other.entry_hints_exception &&
+         fifo_write_addresses == other.fifo_write_addresses;
+}
+
+JitDiskCache::EntryId JitDiskCache::GetEntryId(const Key& key)
+{
+  return {key.effective_address, key.msr_bits, key.code_hash};
+}
+
+void JitDiskCache::Open(const std::string& filename)
+{
+  class CacheReader : public LinearDiskCacheReader<Key, u8>
+  {
+  public:
+    explicit CacheReader(std::map<EntryId, Entry>& entries_) : entries(entries_) {}
+    void Read(const Key& key, const u8* value, u32 value_size) override
+    {
+      Entry entry{key, {}};
+      if (!DeserializeAssumptions(value, value_size, &entry.assumptions))
+        return;
+
+      // Later entries are more recent compilations of the same block.
+      entries[GetEntryId(key)] = std::move(entry);
+    }
+
+  private:
+    std::map<EntryId, Entry>& entries;
+  };
+
+  Close();
+
+  CacheReader reader(m_entries);
+  const u32 count = m_file.OpenAndRead(filename, reader);
+  INFO_LOG_FMT(DYNA_REC, "Loaded {} JIT block entries from {}", count, filename);
+
+  if (count != m_entries.size())
+    Compact(filename);
+
+  m_open = true;
+  MarkAllPending();
+}
+
+void JitDiskCache::Compact(const std::string& filename)
+{
+  class NullReader : public LinearDiskCacheReader<Key, u8>
+  {
+  public:
+    void Read(const Key&, const u8*, u32) override {}
+  };
+
+  m_file.Close();
+  File::Delete(filename);
+
+  NullReader reader;
+  m_file.OpenAndRead(filename, reader);
+  for (const auto& [id, entry] : m_entries)
+  {
+    const std::vector<u32> words = SerializeAssumptions(entry.assumptions);
+    m_file.Append(entry.key, reinterpret_cast<const u8*>(words.data()),
+                  static_cast<u32>(words.size() * sizeof(u32)));
+  }
+  m_file.Sync();
+
+  INFO_LOG_FMT(DYNA_REC, "Compacted {} to {} JIT block entries", filename, m_entries.size());
+}
+
+void JitDiskCache::Close()
+{
+  if (!m_open)
+    return;
+
+  m_file.Sync();
+  m_file.Close();
+  m_open = false;
+
+  m_entries.clear();
+  m_pending_regions.clear();
+}
+
+void JitDiskCache::Record(const Key& key, const Assumptions& assumptions)
+{
+  if (!m_open)
+    return;
+
+  auto [it, inserted] = m_entries.try_emplace(GetEntryId(key), Entry{key, assumptions});
+  if (!inserted)
+  {
+    if (it->second.key.options_hash == key.options_hash && it->second.assumptions == assumptions)
+      return;
+
+    it->second = Entry{key, assumptions};
+  }
+
+  const std::vector<u32> words = SerializeAssumptions(assumptions);
+  m_file.Append(key, reinterpret_cast<const u8*>(words.data()),
+                static_cast<u32>(words.size() * sizeof(u32)));
+}
+
+void JitDiskCache::MarkAllPending()
+{
+  m_pending_regions.clear();
+  for (const auto& [id, entry] : m_entries)
+    m_pending_regions[entry.key.effective_address / REGION_SIZE].push_back(id);
+}
+
+void JitDiskCache::ClearPending()
+{
+  m_pending_regions.clear();
+}
+
+std::vector<JitDiskCache::Entry> JitDiskCache::TakePendingRegion(u32 address, size_t max_count)
+{
+  std::vector<Entry> entries;
+
+  const auto region = m_pending_regions.find(address / REGION_SIZE);
+  if (region == m_pending_regions.end())
+    return entries;
+
+  // Hand out the entries from the back, so the rest stay pending without moving them.
+  std::vector<EntryId>& ids = region->second;
+  while (!ids.empty() && entries.size() < max_count)
+  {
+    const auto it = m_entries.find(ids.back());
+    if (it != m_entries.end())
+      entries.push_back(it->second);
+    ids.pop_back();
+  }
+
+  if (ids.empty())
+    m_pending_regions.erase(region);
+
+  return entries;
+}
@@ -0,0 +1,100 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <array>
+#include <map>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/LinearDiskCache.h"
+
+// A per-game pre-compile hot block list: the blocks a JIT has compiled, kept on disk between
+// sessions. Despite the name, no generated code is stored, and every listed block is compiled again
+// each session.
+//
+// The generated host code can't be reused: it embeds absolute addresses of host functions, of
+// JitBlock structures and of the constant pool, and the block linker patches its exits at runtime.
+// What is stored instead is where each block starts, a hash of the guest instructions it was made
+// of, a hash of the JIT options, and the guest state the block was specialized for. When the guest
+// first runs code in a region, the listed blocks of that region whose guest code is unchanged are
+// compiled with those assumptions before the guest reaches them.
+class JitDiskCache
+{
+public:
+  // Blocks are compiled ahead of time per region of this many bytes of effective address space.
+  static constexpr u32 REGION_SIZE = 0x10000;
+
+  struct Key
+  {
+    u32 effective_address;
+    u32 msr_bits;
+    // Hash of the guest instructions the analyzer collected for the block.
+    u64 code_hash;
+    // Hash of the options the JIT compiled the block with.
+    u64 options_hash;
+  };
+
+  // The guest state the JIT specialized a block for, and what it had learned about it.
+  struct Assumptions
+  {
+    bool operator==(const Assumptions& other) const;
+    bool operator!=(const Assumptions& other) const { return !(*this == other); }
+
+    // Registers whose values the block was specialized for as speculative constants. Values of the
+    // other registers are zero.
+    u32 gpr_inputs = 0;
+    std::array<u32, 32> gpr{};
+    // GQRs the block assumed to stay constant. Values of the other GQRs are zero.
+    u32 static_gqrs = 0;
+    std::array<u32, 8> gqr{};
+
+    // The block was compiled without speculation after a previous guess turned out wrong.
+    bool paired_quantize_exception = false;
+    bool speculative_constants_exception = false;
+    bool entry_hints_exception = false;
+
+    // Instructions in the block found to write to the gather pipe through a register.
+    std::vector<u32> fifo_write_addresses;
+  };
+
+  struct Entry
+  {
+    Key key;
+    Assumptions assumptions;
+  };
+
+  // Loads the cache stored in filename, creating it if needed. Entries superseded by later ones are
+  // dropped from the file.
+  void Open(const std::string& filename);
+  void Close();
+  bool IsOpen() const { return m_open; }
+
+  // Stores a compiled block, unless an identical entry is already known.
+  void Record(const Key& key, const Assumptions& assumptions);
+
+  // Makes every known block eligible to be handed out again.
+  void MarkAllPending();
+  void ClearPending();
+
+  // Returns up to max_count of the known blocks in the region containing address that have not
+  // been handed out since the last MarkAllPending.
+  std::vector<Entry> TakePendingRegion(u32 address, size_t max_count);
+
+private:
+  using EntryId = std::tuple<u32, u32, u64>;
+
+  static EntryId GetEntryId(const Key& key);
+
+  void Compact(const std::string& filename);
+
+  LinearDiskCache<Key, u8> m_file;
+  bool m_open = false;
+
+  std::map<EntryId, Entry> m_entries;
+  std::map<u32, std::vector<EntryId>> m_pending_regions;
+};
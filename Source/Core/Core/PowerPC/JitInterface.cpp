@@ -153,6 +153,12 @@ void GetProfileResults(Profiler::ProfileStats* prof_stats)
     Core::SetState(Core::State::Running);
 }
 
+void RunOnBlocks(const std::function<void(const JitBlock&)>& f)
+{
+  if (g_jit)
+    g_jit->GetBlockCache()->RunOnBlocks(f);
+}
+
 int GetHostCode(u32* address, const u8** code, u32* code_size)
 {
   if (!g_jit)
@@ -248,6 +254,9 @@ void CompileExceptionCheck(ExceptionType type)
   case ExceptionType::SpeculativeConstants:
     exception_addresses = &g_jit->js.noSpeculativeConstantsAddresses;
     break;
+  case ExceptionType::EntryHints:
+    exception_addresses = &g_jit->js.noEntryHintsAddresses;
+    break;
   }
 
   if (PC != 0 && (exception_addresses->find(PC)) == (exception_addresses->end()))
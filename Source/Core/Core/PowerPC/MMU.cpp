@@ -166,6 +166,37 @@ BatTable dbat_table;
 
 static void GenerateDSIException(u32 effective_address, bool write);
 
+// Returns the host address of a physical page of RAM, or nullptr for anything else.
+static u8* GetHostPage(u32 physical_page)
+{
+  if ((physical_page & 0xF8000000) == 0x00000000)
+    return &Memory::m_pRAM[physical_page & Memory::GetRamMask()];
+
+  if (Memory::m_pEXRAM && (physical_page >> 28) == 0x1 &&
+      (physical_page & 0x0FFFFFFF) < Memory::GetExRamSizeReal())
+  {
+    return &Memory::m_pEXRAM[physical_page & 0x0FFFFFFF];
+  }
+
+  return nullptr;
+}
+
+static void UpdateHostTLBEntry(size_t host_tlb, u32 effective_address, u32 physical_address)
+{
+  // Memory checks need every access to go through the slow path.
+  if (memchecks.HasAny())
+    return;
+
+  u8* const host_page = GetHostPage(physical_address & ~(HOST_TLB_PAGE_SIZE - 1));
+  if (!host_page)
+    return;
+
+  const u32 page = effective_address & ~(HOST_TLB_PAGE_SIZE - 1);
+  HostTLBEntry& entry = ppcState.host_tlb[host_tlb][(page >> HOST_TLB_PAGE_SHIFT) % HOST_TLB_SIZE];
+  entry.tag = page;
+  entry.offset = reinterpret_cast<uintptr_t>(host_page) - page;
+}
+
 template <XCheckTLBFlag flag, typename T, bool never_translate = false>
 static T ReadFromHardware(u32 em_address)
 {
@@ -202,6 +233,11 @@ static T ReadFromHardware(u32 em_address)
       }
       return var;
     }
+    if (flag == XCheckTLBFlag::Read &&
+        translated_addr.result == TranslateAddressResult::PAGE_TABLE_TRANSLATED)
+    {
+      UpdateHostTLBEntry(HOST_TLB_READ, em_address, translated_addr.address);
+    }
     em_address = translated_addr.address;
   }
 
@@ -291,6 +327,11 @@ static void WriteToHardware(u32 em_address, const T data)
       }
       return;
     }
+    if (flag == XCheckTLBFlag::Write &&
+        translated_addr.result == TranslateAddressResult::PAGE_TABLE_TRANSLATED)
+    {
+      UpdateHostTLBEntry(HOST_TLB_WRITE, em_address, translated_addr.address);
+    }
     em_address = translated_addr.address;
   }
 
@@ -979,6 +1020,7 @@ void SDRUpdated()
   }
   PowerPC::ppcState.pagetable_base = htaborg << 16;
   PowerPC::ppcState.pagetable_hashmask = ((htabmask << 10) | 0x3ff);
+  InvalidateHostTLB();
 }
 
 enum class TLBLookupResult
@@ -1065,6 +1107,19 @@ void InvalidateTLBEntry(u32 address)
   TLBEntry& tlbe_i = ppcState.tlb[1][entry_index];
   tlbe_i.tag[0] = TLBEntry::INVALID_TAG;
   tlbe_i.tag[1] = TLBEntry::INVALID_TAG;
+
+  // tlbie invalidates every page with the same TLB index, which are spread over the host TLB.
+  for (auto& host_tlb : ppcState.host_tlb)
+  {
+    for (size_t i = entry_index; i < HOST_TLB_SIZE; i += HW_PAGE_INDEX_MASK + 1)
+      host_tlb[i] = {};
+  }
+}
+
+void InvalidateHostTLB()
+{
+  for (auto& host_tlb : ppcState.host_tlb)
+    host_tlb.fill({});
 }
 
 // Page Address Translation
@@ -1266,6 +1321,9 @@ void DBATUpdated()
   Memory::UpdateLogicalMemory(dbat_table);
 #endif
 
+  // BATs take precedence over the page table, and memory checks disable the host TLB.
+  InvalidateHostTLB();
+
   // IsOptimizable*Address and dcbz depends on the BAT mapping, so we need a flush here.
   JitInterface::ClearSafe();
 }
@@ -8,6 +8,7 @@
 #include <map>
 #include <queue>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <fmt/format.h>
@@ -199,6 +200,10 @@ static bool CanSwapAdjacentOps(const CodeOp& a, const CodeOp& b)
   int a_flags = a_info->flags;
   int b_flags = b_info->flags;
 
+  // can't move instructions in or out of a loop
+  if (a.isBranchTarget || b.isBranchTarget)
+    return false;
+
   // can't reorder around breakpoints
   if (SConfig::GetInstance().bEnableDebugging &&
       (PowerPC::breakpoints.IsAddressBreakPoint(a.address) ||
@@ -727,6 +732,71 @@ bool PPCAnalyzer::IsBusyWaitLoop(CodeBlock* block, CodeOp* code, size_t instruct
   return false;
 }
 
+int PPCAnalyzer::FindLoopHeader(CodeOp* code, size_t index) const
+{
+  const CodeOp& branch = code[index];
+
+  // Only conditional bcx: unconditional ones are followed or end the block, and the others jump
+  // to a register.
+  if (branch.inst.OPCD != 16 || branch.inst.LK || branch.branchTo >= branch.address)
+    return -1;
+  if ((branch.inst.BO & BO_DONT_DECREMENT_FLAG) && (branch.inst.BO & BO_DONT_CHECK_CONDITION))
+    return -1;
+
+  // A branch into another function is more likely a tail call than a loop.
+  if (g_symbolDB.GetSymbolFromAddr(branch.address) != g_symbolDB.GetSymbolFromAddr(branch.branchTo))
+    return -1;
+
+  for (size_t i = index; i > 0; --i)
+  {
+    // A followed branch in between means the loop isn't entirely part of the block.
+    if (code[i - 1].address + 4 != code[i].address)
+      return -1;
+    if (code[i - 1].address == branch.branchTo)
+      return static_cast<int>(i - 1);
+  }
+  return -1;
+}
+
+// Updates what is known about the precision of the floating point registers after op.
+static void UpdateFloatFlags(const CodeOp& op, BitSet32* single, BitSet32* duplicated,
+                             BitSet32* store_safe)
+{
+  if (op.fregOut < 0)
+    return;
+
+  (*single)[op.fregOut] = false;
+  (*duplicated)[op.fregOut] = false;
+  (*store_safe)[op.fregOut] = false;
+  // Single, duplicated, and doesn't need PPC_FP.
+  if (op.opinfo->type == OpType::SingleFP)
+  {
+    (*single)[op.fregOut] = true;
+    (*duplicated)[op.fregOut] = true;
+    (*store_safe)[op.fregOut] = true;
+  }
+  // Single and duplicated, but might be a denormal (not safe to skip PPC_FP).
+  // TODO: if we go directly from a load to store, skip conversion entirely?
+  // TODO: if we go directly from a load to a float instruction, and the value isn't used
+  // for anything else, we can skip PPC_FP on a load too.
+  if (!strncmp(op.opinfo->opname, "lfs", 3))
+  {
+    (*single)[op.fregOut] = true;
+    (*duplicated)[op.fregOut] = true;
+  }
+  // Paired are still floats, but the top/bottom halves may differ.
+  if (op.opinfo->type == OpType::PS || op.opinfo->type == OpType::LoadPS)
+  {
+    (*single)[op.fregOut] = true;
+    (*store_safe)[op.fregOut] = true;
+  }
+  // Careful: changing the float mode in a block breaks this optimization, since
+  // a previous float op might have had had FTZ off while the later store has FTZ
+  // on. So, discard all information we have.
+  if (!strncmp(op.opinfo->opname, "mtfs", 4))
+    *store_safe = BitSet32(0);
+}
+
 u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer, std::size_t block_size)
 {
   // Clear block stats
@@ -756,6 +826,8 @@ u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer, std:
   size_t caller = 0;
   u32 numFollows = 0;
   u32 num_inst = 0;
+  // Indices of the first and last instruction of the loops found in the block.
+  std::vector<std::pair<u32, u32>> loops;
 
   const bool enable_follow = SConfig::GetInstance().bJITFollowBranch;
 
@@ -878,6 +950,14 @@ u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer, std:
     code[i].branchIsIdleLoop =
         code[i].branchTo == block->m_address && IsBusyWaitLoop(block, code, i);
 
+    if (!code[i].branchIsIdleLoop)
+    {
+      const int loop_header = FindLoopHeader(code, i);
+      code[i].branchIsLoop = loop_header >= 0;
+      if (code[i].branchIsLoop)
+        loops.emplace_back(static_cast<u32>(loop_header), static_cast<u32>(i));
+    }
+
     if (follow && numFollows < BRANCH_FOLLOWING_THRESHOLD)
     {
       // Follow the unconditional branch.
@@ -904,6 +984,12 @@ u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer, std:
 
   block->m_num_instructions = num_inst;
 
+  if (HasOption(OPTION_COMPLEX_BLOCK))
+  {
+    for (const auto& loop : loops)
+      code[loop.first].isBranchTarget = true;
+  }
+
   if (block->m_num_instructions > 1)
     ReorderInstructions(block->m_num_instructions, code);
 
@@ -956,8 +1042,37 @@ u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer, std:
       fprInUse[op.fregOut] = true;
   }
 
+  if (HasOption(OPTION_COMPLEX_BLOCK))
+  {
+    // Registers used anywhere in a loop are needed again on its next iteration.
+    for (const auto& [first, last] : loops)
+    {
+      BitSet32 loopGprInUse, loopGprInReg, loopFprInUse, loopFprInXmm;
+      for (u32 i = first; i <= last; i++)
+      {
+        const CodeOp& op = code[i];
+        loopGprInUse |= op.regsIn | op.regsOut;
+        loopGprInReg |= op.regsIn;
+        loopFprInUse |= op.fregsIn;
+        if (strncmp(op.opinfo->opname, "stfd", 4))
+          loopFprInXmm |= op.fregsIn;
+        if (op.fregOut >= 0)
+          loopFprInUse[op.fregOut] = true;
+      }
+      for (u32 i = first; i <= last; i++)
+      {
+        code[i].gprInUse |= loopGprInUse;
+        code[i].gprInReg |= loopGprInReg;
+        code[i].fprInUse |= loopFprInUse;
+        code[i].fprInXmm |= loopFprInXmm;
+      }
+    }
+  }
+
   // Forward scan, for flags that need the other direction for calculation.
-  BitSet32 fprIsSingle, fprIsDuplicated, fprIsStoreSafe, gprDefined, gprBlockInputs;
+  BitSet32 fprIsSingle = m_entry_hints.single_fprs;
+  BitSet32 fprIsDuplicated = m_entry_hints.duplicated_fprs;
+  BitSet32 fprIsStoreSafe, gprDefined, gprBlockInputs, fprDefined, fprBlockInputs;
   BitSet8 gqrUsed, gqrModified;
   for (u32 i = 0; i < block->m_num_instructions; i++)
   {
@@ -966,42 +1081,22 @@ u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer, std:
     gprBlockInputs |= op.regsIn & ~gprDefined;
     gprDefined |= op.regsOut;
 
+    // Nothing is known about the registers at the start of a loop, as it is also reached from
+    // the end of the loop.
+    if (op.isBranchTarget)
+    {
+      fprIsSingle = BitSet32(0);
+      fprIsDuplicated = BitSet32(0);
+      fprIsStoreSafe = BitSet32(0);
+    }
+
     op.fprIsSingle = fprIsSingle;
     op.fprIsDuplicated = fprIsDuplicated;
     op.fprIsStoreSafe = fprIsStoreSafe;
+    UpdateFloatFlags(op, &fprIsSingle, &fprIsDuplicated, &fprIsStoreSafe);
+    fprBlockInputs |= op.fregsIn & ~fprDefined;
     if (op.fregOut >= 0)
-    {
-      fprIsSingle[op.fregOut] = false;
-      fprIsDuplicated[op.fregOut] = false;
-      fprIsStoreSafe[op.fregOut] = false;
-      // Single, duplicated, and doesn't need PPC_FP.
-      if (op.opinfo->type == OpType::SingleFP)
-      {
-        fprIsSingle[op.fregOut] = true;
-        fprIsDuplicated[op.fregOut] = true;
-        fprIsStoreSafe[op.fregOut] = true;
-      }
-      // Single and duplicated, but might be a denormal (not safe to skip PPC_FP).
-      // TODO: if we go directly from a load to store, skip conversion entirely?
-      // TODO: if we go directly from a load to a float instruction, and the value isn't used
-      // for anything else, we can skip PPC_FP on a load too.
-      if (!strncmp(op.opinfo->opname, "lfs", 3))
-      {
-        fprIsSingle[op.fregOut] = true;
-        fprIsDuplicated[op.fregOut] = true;
-      }
-      // Paired are still floats, but the top/bottom halves may differ.
-      if (op.opinfo->type == OpType::PS || op.opinfo->type == OpType::LoadPS)
-      {
-        fprIsSingle[op.fregOut] = true;
-        fprIsStoreSafe[op.fregOut] = true;
-      }
-      // Careful: changing the float mode in a block breaks this optimization, since
-      // a previous float op might have had had FTZ off while the later store has FTZ
-      // on. So, discard all information we have.
-      if (!strncmp(op.opinfo->opname, "mtfs", 4))
-        fprIsStoreSafe = BitSet32(0);
-    }
+      fprDefined[op.fregOut] = true;
 
     if (op.opinfo->type == OpType::StorePS || op.opinfo->type == OpType::LoadPS)
     {
@@ -1019,7 +1114,207 @@ u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer, std:
   block->m_gqr_used = gqrUsed;
   block->m_gqr_modified = gqrModified;
   block->m_gpr_inputs = gprBlockInputs;
+  block->m_fpr_inputs = fprBlockInputs;
+
+  block->m_entry_hints = m_entry_hints;
+  block->m_entry_hints.single_fprs &= fprBlockInputs;
+  block->m_entry_hints.duplicated_fprs &= block->m_entry_hints.single_fprs;
+  block->m_entry_hints.constant_gprs &= gprBlockInputs;
   return address;
 }
 
+// Tracks registers loaded with immediates the way compilers build constants and addresses: li or
+// lis, followed by addi or ori for the low half.
+static void UpdateConstantGPRs(const CodeOp& op, EntryHints* hints)
+{
+  const UGeckoInstruction inst = op.inst;
+  const BitSet32 constants = hints->constant_gprs;
+  bool known = false;
+  u32 value = 0;
+  switch (inst.OPCD)
+  {
+  case 14:  // addi
+  case 15:  // addis
+  {
+    const u32 imm = static_cast<u32>(inst.SIMM_16) << (inst.OPCD == 15 ? 16 : 0);
+    known = inst.RA == 0 || constants[inst.RA];
+    value = (inst.RA == 0 ? 0 : hints->gpr_values[inst.RA]) + imm;
+    break;
+  }
+  case 24:  // ori
+  case 25:  // oris
+  {
+    const u32 imm = inst.UIMM << (inst.OPCD == 25 ? 16 : 0);
+    known = constants[inst.RS];
+    value = hints->gpr_values[inst.RS] | imm;
+    break;
+  }
+  }
+
+  for (int i : op.regsOut)
+  {
+    hints->constant_gprs[i] = false;
+    hints->gpr_values[i] = 0;
+  }
+
+  if (known)
+  {
+    const u32 reg = inst.OPCD <= 15 ? inst.RD : inst.RA;
+    hints->constant_gprs[reg] = true;
+    hints->gpr_values[reg] = value;
+  }
+}
+
+// Keeps what is known in both states. Returns whether into changed.
+static bool MergeEntryHints(EntryHints* into, const EntryHints& from)
+{
+  const BitSet32 single = into->single_fprs & from.single_fprs;
+  const BitSet32 duplicated = into->duplicated_fprs & from.duplicated_fprs;
+  BitSet32 constant = into->constant_gprs & from.constant_gprs;
+  for (int i : constant)
+  {
+    if (into->gpr_values[i] != from.gpr_values[i])
+      constant[i] = false;
+  }
+
+  if (single == into->single_fprs && duplicated == into->duplicated_fprs &&
+      constant == into->constant_gprs)
+  {
+    return false;
+  }
+
+  into->single_fprs = single;
+  into->duplicated_fprs = duplicated;
+  for (int i : into->constant_gprs & ~constant)
+    into->gpr_values[i] = 0;
+  into->constant_gprs = constant;
+  return true;
+}
+
+EntryHints PPCAnalyzer::ComputeEntryHints(u32 address)
+{
+  // The analysis runs whenever a block is compiled, so it only looks at nearby code.
+  constexpr u32 MAX_FUNCTION_SIZE = 0x1000;
+  constexpr u32 WINDOW_SIZE = 0x200;
+  // Registers a called function may change, according to the PowerPC EABI: r0, r3-r12 and
+  // f0-f13.
+  constexpr BitSet32 VOLATILE_GPRS(0x00001FF9);
+  constexpr BitSet32 VOLATILE_FPRS(0x00003FFF);
+
+  u32 start = address - std::min(address, WINDOW_SIZE);
+  u32 count = (address - start + std::min(0xFFFFFFFF - address, WINDOW_SIZE)) / 4 + 1;
+  const Common::Symbol* symbol = g_symbolDB.GetSymbolFromAddr(address);
+  if (symbol && symbol->size != 0 && symbol->size <= MAX_FUNCTION_SIZE)
+  {
+    start = symbol->address;
+    count = symbol->size / 4;
+  }
+
+  const u32 index = (address - start) / 4;
+  if (index >= count)
+    return {};
+
+  BlockStats stats{};
+  BlockRegStats gpa{};
+  BlockRegStats fpa{};
+  gpa.Clear();
+  fpa.Clear();
+  CodeBlock block{};
+  block.m_stats = &stats;
+  block.m_gpa = &gpa;
+  block.m_fpa = &fpa;
+
+  // Instructions that couldn't be read are left without opinfo.
+  std::vector<CodeOp> code(count);
+  for (u32 i = 0; i < count; i++)
+  {
+    const auto result = PowerPC::TryReadInstruction(start + i * 4);
+    if (!result.valid)
+      continue;
+
+    code[i].inst = result.hex;
+    code[i].opinfo = PPCTables::GetOpInfo(code[i].inst);
+    code[i].address = start + i * 4;
+    SetInstructionStats(&block, &code[i], code[i].opinfo, i);
+  }
+
+  // The state before each instruction reached so far. Nothing is known at the start.
+  std::vector<EntryHints> states(count);
+  std::vector<bool> reached(count);
+  std::vector<bool> queued(count);
+  std::vector<u32> worklist{0};
+  reached[0] = true;
+  queued[0] = true;
+
+  const auto flow_to = [&](u32 target, const EntryHints& state) {
+    if (target < start || target % 4 != 0 || (target - start) / 4 >= count)
+      return;
+
+    const u32 i = (target - start) / 4;
+    if (reached[i] && !MergeEntryHints(&states[i], state))
+      return;
+
+    if (!reached[i])
+    {
+      reached[i] = true;
+      states[i] = state;
+    }
+    if (!queued[i])
+    {
+      queued[i] = true;
+      worklist.push_back(i);
+    }
+  };
+
+  while (!worklist.empty())
+  {
+    const u32 i = worklist.back();
+    worklist.pop_back();
+    queued[i] = false;
+
+    const CodeOp& op = code[i];
+    if (!op.opinfo)
+      continue;
+
+    EntryHints state = states[i];
+    BitSet32 store_safe;
+    UpdateConstantGPRs(op, &state);
+    UpdateFloatFlags(op, &state.single_fprs, &state.duplicated_fprs, &store_safe);
+
+    const UGeckoInstruction inst = op.inst;
+    if (inst.OPCD == 19 && inst.SUBOP10 == 50)  // rfi
+      continue;
+
+    if (op.opinfo->type != OpType::Branch)
+    {
+      flow_to(op.address + 4, state);
+      continue;
+    }
+
+    if (inst.LK)
+    {
+      // The called function returns to the next instruction.
+      state.single_fprs &= ~VOLATILE_FPRS;
+      state.duplicated_fprs &= ~VOLATILE_FPRS;
+      for (int reg : state.constant_gprs & VOLATILE_GPRS)
+        state.gpr_values[reg] = 0;
+      state.constant_gprs &= ~VOLATILE_GPRS;
+      flow_to(op.address + 4, state);
+      continue;
+    }
+
+    const bool always_taken = inst.OPCD == 18 || ((inst.BO & BO_DONT_DECREMENT_FLAG) &&
+                                                  (inst.BO & BO_DONT_CHECK_CONDITION));
+    if (op.branchTo != UINT32_MAX)
+      flow_to(op.branchTo, state);
+    if (!always_taken)
+      flow_to(op.address + 4, state);
+  }
+
+  if (!reached[index])
+    return {};
+
+  return states[index];
+}
+
 }  // namespace PPCAnalyst
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
 #include <cstddef>
 #include <set>
 #include <vector>
@@ -35,6 +36,9 @@ struct CodeOp  // 16B
   bool isBranchTarget;
   bool branchUsesCtr;
   bool branchIsIdleLoop;
+  // conditional branch back to an earlier instruction of the block, with only straight-line code
+  // in between
+  bool branchIsLoop;
   bool wantsCR0;
   bool wantsCR1;
   bool wantsFPRF;
@@ -122,6 +126,20 @@ struct BlockRegStats
 
 using CodeBuffer = std::vector<CodeOp>;
 
+// What the code around a block suggests about the registers when the block is entered, found by
+// PPCAnalyzer::ComputeEntryHints. These are guesses: the block may also be reached from code the
+// analysis didn't see, so the JIT has to check them on entry.
+struct EntryHints
+{
+  // Registers whose both halves are exactly representable as singles.
+  BitSet32 single_fprs;
+  // Registers whose halves are equal. A subset of single_fprs.
+  BitSet32 duplicated_fprs;
+  BitSet32 constant_gprs;
+  // Values of the registers in constant_gprs. Values of the other registers are zero.
+  std::array<u32, 32> gpr_values{};
+};
+
 struct CodeBlock
 {
   // Beginning PPC address.
@@ -152,6 +170,12 @@ struct CodeBlock
   // Which GPRs this block reads from before defining, if any.
   BitSet32 m_gpr_inputs;
 
+  // Which FPRs this block reads from before defining, if any.
+  BitSet32 m_fpr_inputs;
+
+  // The entry hints the analysis of the block relied on, limited to its input registers.
+  EntryHints m_entry_hints;
+
   // Which memory locations are occupied by this block.
   std::set<u32> m_physical_addresses;
 };
@@ -175,8 +199,9 @@ public:
 
     // Complex blocks support jumping backwards on to themselves.
     // Happens commonly in loops, pretty complex to support.
-    // May require register caches to use register usage metrics.
-    // XXX: NOT COMPLETE
+    // The first instruction of every loop is marked as a branch target, instructions are not
+    // reordered around it, and registers used in the loop are kept in use until its last branch.
+    // Requires JIT support to work.
     OPTION_COMPLEX_BLOCK = (1 << 2),
 
     // Similar to complex blocks.
@@ -203,6 +228,13 @@ public:
   bool HasOption(AnalystOption option) const { return !!(m_options & option); }
   u32 Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer, std::size_t block_size);
 
+  // Guesses the state of the registers at address from the function containing it, or from the
+  // code around it if it isn't in a known function, by propagating constants and the precision
+  // of floating point values through the branches between them.
+  EntryHints ComputeEntryHints(u32 address);
+  // Hints Analyze starts the floating point precision tracking of the next blocks with.
+  void SetEntryHints(const EntryHints& hints) { m_entry_hints = hints; }
+
 private:
   enum class ReorderType
   {
@@ -215,9 +247,13 @@ private:
   void ReorderInstructions(u32 instructions, CodeOp* code);
   void SetInstructionStats(CodeBlock* block, CodeOp* code, const GekkoOPInfo* opinfo, u32 index);
   bool IsBusyWaitLoop(CodeBlock* block, CodeOp* code, size_t instructions);
+  // Returns the index of the instruction the loop branch at index jumps back to, or -1.
+  int FindLoopHeader(CodeOp* code, size_t index) const;
 
   // Options
   u32 m_options = 0;
+
+  EntryHints m_entry_hints;
 };
 
 void FindFunctions(u32 startAddr, u32 endAddr, PPCSymbolDB* func_db);
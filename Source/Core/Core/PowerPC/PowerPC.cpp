@@ -267,6 +267,7 @@ void Reset()
   ppcState.pagetable_base = 0;
   ppcState.pagetable_hashmask = 0;
   ppcState.tlb = {};
+  InvalidateHostTLB();
 
   ResetRegisters();
   ppcState.iCache.Reset();
@@ -623,6 +624,7 @@ void PowerPCState::SetSR(u32 index, u32 value)
 {
   DEBUG_LOG_FMT(POWERPC, "{:08x}: MMU: Segment register {} set to {:08x}", pc, index, value);
   sr[index] = value;
+  InvalidateHostTLB();
 }
 
 // FPSCR update functions
@@ -58,6 +58,29 @@ struct TLBEntry
   u8 recent = 0;
 };
 
+// Host TLB: direct-mapped caches of page table translations of RAM to host addresses, one for
+// reads and one for writes, which Jit64 probes inline before calling the Read and Write functions.
+// A page is only added once the access that translated it has set the referenced bit (and for
+// writes, the changed bit) of its page table entry, so that hits don't need to update them.
+constexpr size_t HOST_TLB_SIZE = 256;
+constexpr size_t NUM_HOST_TLBS = 2;
+constexpr size_t HOST_TLB_READ = 0;
+constexpr size_t HOST_TLB_WRITE = 1;
+constexpr u32 HOST_TLB_PAGE_SHIFT = 12;
+constexpr u32 HOST_TLB_PAGE_SIZE = 1 << HOST_TLB_PAGE_SHIFT;
+
+struct HostTLBEntry
+{
+  // Page addresses never have the lowest bit set.
+  static constexpr u32 INVALID_TAG = 1;
+
+  // Effective address of the page.
+  u32 tag = INVALID_TAG;
+  // Added to an effective address in the page to get its host address.
+  u64 offset = 0;
+};
+static_assert(sizeof(HostTLBEntry) == 16, "Jit64 computes the offset of an entry with a shift");
+
 struct PairedSingle
 {
   u64 PS0AsU64() const { return ps0; }
@@ -151,6 +174,7 @@ struct PowerPCState
   u8* stored_stack_pointer;
 
   std::array<std::array<TLBEntry, TLB_SIZE / TLB_WAYS>, NUM_TLBS> tlb;
+  std::array<std::array<HostTLBEntry, HOST_TLB_SIZE>, NUM_HOST_TLBS> host_tlb;
 
   u32 pagetable_base;
   u32 pagetable_hashmask;
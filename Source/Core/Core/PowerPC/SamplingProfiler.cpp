@@ -0,0 +1,562 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "Core/PowerPC/SamplingProfiler.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <fmt/format.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#elif !defined(_M_GENERIC)
+#include <pthread.h>
+#include <signal.h>
+#endif
+
+#include "Common/CommonTypes.h"
+#include "Common/Event.h"
+#include "Common/File.h"
+#include "Common/Flag.h"
+#include "Common/Logging/Log.h"
+#include "Common/Thread.h"
+#include "Core/Core.h"
+#include "Core/HW/CPU.h"
+#include "Core/MachineContext.h"
+#include "Core/PowerPC/JitCommon/JitCache.h"
+#include "Core/PowerPC/JitInterface.h"
+#include "Core/PowerPC/MMU.h"
+#include "Core/PowerPC/PPCSymbolDB.h"
+#include "Core/PowerPC/PowerPC.h"
+
+namespace SamplingProfiler
+{
+constexpr u32 MAX_STACK_DEPTH = 16;
+// Enough for several frames at the default rate. Samples are processed at every frame boundary.
+constexpr u32 RING_SIZE = 1024;
+// Number of samples waiting to be attributed to JIT blocks after which they are attributed at the
+// next frame boundary, rather than when the results are written.
+constexpr size_t RESOLVE_BATCH_SIZE = 16 * 1024;
+
+struct RawSample
+{
+  uintptr_t host_pc;
+  u32 pc;
+  u32 lr;
+  u32 r1;
+};
+
+struct Sample
+{
+  uintptr_t host_pc;
+  u32 pc;
+  u32 lr;
+  u32 depth;
+  // Return addresses found by walking the back chain, innermost first.
+  std::array<u32, MAX_STACK_DEPTH> stack;
+};
+
+// Written only by the code that takes samples, which doesn't run concurrently with itself, and
+// read only by Drain, which holds s_lock. Taking a sample must not take locks, allocate or read
+// guest memory, as it either runs in a signal handler or while the CPU thread is suspended.
+static std::array<RawSample, RING_SIZE> s_ring;
+static std::atomic<u32> s_ring_write;
+static std::atomic<u32> s_ring_read;
+static std::atomic<u64> s_dropped_count;
+
+// Guards the aggregated results.
+static std::mutex s_lock;
+// Samples whose host PC hasn't been mapped to a JIT block yet.
+static std::vector<Sample> s_unresolved;
+// Call site addresses from the outermost to the innermost frame, then the address of the sample.
+static std::map<std::vector<u32>, u64> s_stacks;
+// Keyed by the start address of the block, or the guest PC for samples outside of JIT code.
+static std::map<u32, u64> s_blocks;
+static u64 s_sample_count;
+static u64 s_outside_block_count;
+
+// Guards the state of the sampler thread.
+static std::mutex s_control_lock;
+static bool s_enabled;
+static u32 s_sample_rate = DEFAULT_SAMPLE_RATE;
+static bool s_cpu_thread_registered;
+static std::thread s_sampler;
+static Common::Flag s_sampler_stop;
+static Common::Event s_sampler_wakeup;
+
+#ifdef _WIN32
+static HANDLE s_cpu_thread;
+#elif !defined(_M_GENERIC)
+static pthread_t s_cpu_thread;
+static struct sigaction s_old_sigprof_action;
+// Set by the sampler thread when it sends SIGPROF to the CPU thread, cleared by the handler.
+static std::atomic<bool> s_sigprof_pending;
+#endif
+
+static bool IsStackBottom(u32 addr)
+{
+  return !addr || !PowerPC::HostIsRAMAddress(addr);
+}
+
+// Runs on the CPU thread from a signal handler, or on the sampler thread while the CPU thread is
+// suspended.
+static void TakeSample(uintptr_t host_pc)
+{
+  const u32 write = s_ring_write.load(std::memory_order_relaxed);
+  if (write - s_ring_read.load(std::memory_order_acquire) >= RING_SIZE)
+  {
+    s_dropped_count.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+
+  RawSample& sample = s_ring[write % RING_SIZE];
+  sample.host_pc = host_pc;
+  sample.pc = PowerPC::ppcState.pc;
+  sample.lr = LR;
+  sample.r1 = PowerPC::ppcState.gpr[1];
+
+  s_ring_write.store(write + 1, std::memory_order_release);
+}
+
+// Same walk as the debugger's call stack. Runs on the CPU thread at the next frame boundary, so
+// frames that have returned since the sample was taken may be missing or overwritten.
+static void WalkStack(u32 r1, Sample* sample)
+{
+  sample->depth = 0;
+  if (IsStackBottom(r1))
+    return;
+
+  u32 addr = PowerPC::HostRead_U32(r1);
+  while (sample->depth < MAX_STACK_DEPTH && !IsStackBottom(addr + 4))
+  {
+    sample->stack[sample->depth++] = PowerPC::HostRead_U32(addr + 4);
+    if (IsStackBottom(addr))
+      break;
+    addr = PowerPC::HostRead_U32(addr);
+  }
+}
+
+#if !defined(_WIN32) && !defined(_M_GENERIC)
+static void SigprofHandler(int sig, siginfo_t* info, void* raw_context)
+{
+  // The handler is process-wide, and other code in the process may use SIGPROF as well, such as
+  // the profiler of an embedding JS engine. Pass on the signals that aren't ours.
+  if (!pthread_equal(pthread_self(), s_cpu_thread) || !s_sigprof_pending.exchange(false))
+  {
+    if (s_old_sigprof_action.sa_flags & SA_SIGINFO)
+    {
+      s_old_sigprof_action.sa_sigaction(sig, info, raw_context);
+    }
+    else if (s_old_sigprof_action.sa_handler != SIG_DFL &&
+             s_old_sigprof_action.sa_handler != SIG_IGN)
+    {
+      s_old_sigprof_action.sa_handler(sig);
+    }
+    return;
+  }
+
+  uintptr_t host_pc;
+#if defined(__APPLE__)
+  const ucontext_t* context = static_cast<const ucontext_t*>(raw_context);
+#if _M_X86_64
+  host_pc = context->uc_mcontext->__ss.__rip;
+#else
+  host_pc = context->uc_mcontext->__ss.__pc;
+#endif
+#elif defined(__OpenBSD__)
+  host_pc = static_cast<const ucontext_t*>(raw_context)->CTX_PC;
+#else
+  host_pc = static_cast<const ucontext_t*>(raw_context)->uc_mcontext.CTX_PC;
+#endif
+
+  TakeSample(host_pc);
+}
+#endif
+
+static void InterruptCPUThread()
+{
+#if defined(_WIN32)
+  if (SuspendThread(s_cpu_thread) == static_cast<DWORD>(-1))
+    return;
+
+  CONTEXT context{};
+  context.ContextFlags = CONTEXT_CONTROL;
+  if (GetThreadContext(s_cpu_thread, &context))
+    TakeSample(static_cast<uintptr_t>(context.CTX_PC));
+
+  ResumeThread(s_cpu_thread);
+#elif defined(_M_GENERIC)
+  TakeSample(0);
+#else
+  // Signals of the same kind don't queue up, so wait for the previous one to be handled.
+  if (s_sigprof_pending.exchange(true))
+    return;
+
+  if (pthread_kill(s_cpu_thread, SIGPROF) != 0)
+    s_sigprof_pending = false;
+#endif
+}
+
+static void SamplerThread(u32 sample_rate)
+{
+  Common::SetCurrentThreadName("Sampling Profiler");
+
+  const auto interval = std::chrono::microseconds(1000000 / sample_rate);
+  while (!s_sampler_stop.IsSet())
+  {
+    s_sampler_wakeup.WaitFor(interval);
+    if (s_sampler_stop.IsSet())
+      break;
+
+    if (CPU::GetState() == CPU::State::Running)
+      InterruptCPUThread();
+  }
+}
+
+#if !defined(_WIN32) && !defined(_M_GENERIC)
+// The handler is only installed while sampling, so that other users of SIGPROF are undisturbed
+// the rest of the time.
+static void InstallSigprofHandler()
+{
+  s_sigprof_pending = false;
+
+  struct sigaction sa
+  {
+  };
+  sa.sa_sigaction = &SigprofHandler;
+  sa.sa_flags = SA_SIGINFO | SA_RESTART;
+  sigemptyset(&sa.sa_mask);
+  sigaction(SIGPROF, &sa, &s_old_sigprof_action);
+}
+
+// Must be called once the sampler thread has stopped.
+static void RestoreSigprofHandler()
+{
+  // A signal the CPU thread hasn't handled yet would reach the previous action, which by default
+  // terminates the process. Delivery doesn't depend on the CPU thread doing anything in particular,
+  // as even a blocked thread is woken up to run the handler.
+  while (s_sigprof_pending.load())
+    std::this_thread::yield();
+
+  sigaction(SIGPROF, &s_old_sigprof_action, nullptr);
+}
+#endif
+
+// Both must be called with s_control_lock held.
+static void StartSamplerThread()
+{
+  if (s_sampler.joinable())
+    return;
+
+#if !defined(_WIN32) && !defined(_M_GENERIC)
+  InstallSigprofHandler();
+#endif
+
+  s_sampler_stop.Clear();
+  s_sampler = std::thread(SamplerThread, s_sample_rate);
+}
+
+static void StopSamplerThread()
+{
+  if (!s_sampler.joinable())
+    return;
+
+  s_sampler_stop.Set();
+  s_sampler_wakeup.Set();
+  s_sampler.join();
+
+#if !defined(_WIN32) && !defined(_M_GENERIC)
+  RestoreSigprofHandler();
+#endif
+}
+
+struct CodeRange
+{
+  const u8* begin;
+  const u8* end;
+};
+
+// Attributes the samples in s_unresolved to JIT blocks. Must be called with s_lock held, on the
+// CPU thread or while it is paused, as it reads the block cache. This walks every block, so it is
+// only done when the results are needed or many samples have piled up.
+static void Resolve()
+{
+  if (s_unresolved.empty())
+    return;
+
+  std::vector<Sample>& samples = s_unresolved;
+  std::sort(samples.begin(), samples.end(),
+            [](const Sample& a, const Sample& b) { return a.host_pc < b.host_pc; });
+
+  // The address each sample is attributed to. Starts as the guest PC, which is exact for the
+  // interpreters and the best guess for code outside of blocks.
+  std::vector<u32> leaves(samples.size());
+  std::vector<bool> resolved(samples.size());
+  for (size_t i = 0; i < samples.size(); ++i)
+    leaves[i] = samples[i].pc;
+
+  const auto attribute = [&](const CodeRange& range, u32 address) {
+    if (range.begin == range.end)
+      return;
+
+    auto it = std::lower_bound(
+        samples.begin(), samples.end(), reinterpret_cast<uintptr_t>(range.begin),
+        [](const Sample& sample, uintptr_t pc) { return sample.host_pc < pc; });
+    for (; it != samples.end() && it->host_pc < reinterpret_cast<uintptr_t>(range.end); ++it)
+    {
+      const size_t i = it - samples.begin();
+      leaves[i] = address;
+      resolved[i] = true;
+    }
+  };
+
+  JitInterface::RunOnBlocks([&](const JitBlock& block) {
+    // Only Jit64 records where the near and far code of a block are.
+    if (block.near_begin)
+    {
+      attribute({block.near_begin, block.near_end}, block.effectiveAddress);
+      attribute({block.far_begin, block.far_end}, block.effectiveAddress);
+    }
+    else
+    {
+      attribute({block.normalEntry, block.normalEntry + block.codeSize}, block.effectiveAddress);
+    }
+  });
+
+  std::vector<u32> stack;
+  for (size_t i = 0; i < samples.size(); ++i)
+  {
+    const Sample& sample = samples[i];
+
+    stack.clear();
+    for (u32 j = sample.depth; j > 0; --j)
+      stack.push_back(sample.stack[j - 1] - 4);
+    stack.push_back(sample.lr - 4);
+    stack.push_back(leaves[i]);
+
+    ++s_stacks[stack];
+    ++s_blocks[leaves[i]];
+    ++s_sample_count;
+    if (!resolved[i])
+      ++s_outside_block_count;
+  }
+
+  samples.clear();
+}
+
+// Moves the samples out of the ring and walks their stacks. Must run on the CPU thread, or while
+// it is paused.
+static void Drain()
+{
+  std::lock_guard lk(s_lock);
+
+  const u32 read = s_ring_read.load(std::memory_order_relaxed);
+  const u32 write = s_ring_write.load(std::memory_order_acquire);
+  for (u32 i = read; i != write; ++i)
+  {
+    const RawSample& raw_sample = s_ring[i % RING_SIZE];
+
+    Sample& sample = s_unresolved.emplace_back();
+    sample.host_pc = raw_sample.host_pc;
+    sample.pc = raw_sample.pc;
+    sample.lr = raw_sample.lr;
+    WalkStack(raw_sample.r1, &sample);
+  }
+  s_ring_read.store(write, std::memory_order_release);
+
+  // JIT code that is freed and reused before its samples are resolved gets attributed to the new
+  // block, so don't let them pile up forever.
+  if (s_unresolved.size() >= RESOLVE_BATCH_SIZE)
+    Resolve();
+}
+
+// Attributes every sample taken so far.
+static void Flush()
+{
+  Drain();
+
+  std::lock_guard lk(s_lock);
+  Resolve();
+}
+
+static std::string GetFunctionName(u32 address)
+{
+  const Common::Symbol* symbol = g_symbolDB.GetSymbolFromAddr(address);
+  std::string name = symbol ? symbol->name : fmt::format("{:08x}", address);
+  // Semicolons separate frames in the output.
+  std::replace(name.begin(), name.end(), ';', ':');
+  return name;
+}
+
+void Start(u32 sample_rate)
+{
+  std::lock_guard lk(s_control_lock);
+
+  const u32 new_rate = std::clamp<u32>(sample_rate, 1, 100000);
+  if (s_enabled && s_sample_rate != new_rate)
+    StopSamplerThread();
+
+  s_enabled = true;
+  s_sample_rate = new_rate;
+  if (s_cpu_thread_registered)
+    StartSamplerThread();
+}
+
+void Stop()
+{
+  std::lock_guard lk(s_control_lock);
+
+  s_enabled = false;
+  StopSamplerThread();
+}
+
+bool IsEnabled()
+{
+  std::lock_guard lk(s_control_lock);
+  return s_enabled;
+}
+
+void Clear()
+{
+  std::lock_guard lk(s_lock);
+  s_ring_read.store(s_ring_write.load(std::memory_order_acquire), std::memory_order_release);
+  s_unresolved.clear();
+  s_stacks.clear();
+  s_blocks.clear();
+  s_sample_count = 0;
+  s_outside_block_count = 0;
+  s_dropped_count = 0;
+}
+
+Stats GetStats()
+{
+  std::lock_guard lk(s_lock);
+  return {s_sample_count + s_unresolved.size(), s_outside_block_count, s_dropped_count.load()};
+}
+
+bool WriteCollapsedStacks(const std::string& filename)
+{
+  Core::RunAsCPUThread(Flush);
+
+  File::IOFile f(filename, "w");
+  if (!f)
+  {
+    ERROR_LOG_FMT(POWERPC, "Failed to open {} for writing", filename);
+    return false;
+  }
+
+  // Different raw stacks usually end up with the same function names.
+  std::map<std::string, u64> lines;
+  {
+    std::lock_guard lk(s_lock);
+    for (const auto& [stack, count] : s_stacks)
+    {
+      // The last two entries are LR and the sample address.
+      const std::string leaf = GetFunctionName(stack.back());
+      const std::string caller = GetFunctionName(stack[stack.size() - 2]);
+
+      std::string line;
+      for (size_t i = 0; i + 2 < stack.size(); ++i)
+        line += GetFunctionName(stack[i]) + ';';
+
+      // If the function has saved LR to the stack, the innermost walked frame already is its
+      // caller, and LR may point into the function itself.
+      const bool lr_is_walked =
+          stack.size() > 2 && GetFunctionName(stack[stack.size() - 3]) == caller;
+      if (!lr_is_walked && caller != leaf)
+        line += caller + ';';
+
+      line += leaf;
+      lines[line] += count;
+    }
+  }
+
+  for (const auto& [line, count] : lines)
+    f.WriteString(fmt::format("{} {}\n", line, count));
+
+  return true;
+}
+
+bool WriteBlockProfile(const std::string& filename)
+{
+  Core::RunAsCPUThread(Flush);
+
+  File::IOFile f(filename, "w");
+  if (!f)
+  {
+    ERROR_LOG_FMT(POWERPC, "Failed to open {} for writing", filename);
+    return false;
+  }
+
+  std::vector<std::pair<u64, u32>> blocks;
+  u64 sample_count;
+  {
+    std::lock_guard lk(s_lock);
+    for (const auto& [address, count] : s_blocks)
+      blocks.emplace_back(count, address);
+    sample_count = s_sample_count;
+  }
+  std::sort(blocks.rbegin(), blocks.rend());
+
+  f.WriteString("origAddr\tblkName\tsamples\tpercent\n");
+  for (const auto& [count, address] : blocks)
+  {
+    const double percent = 100.0 * static_cast<double>(count) / static_cast<double>(sample_count);
+    f.WriteString(fmt::format("{:08x}\t{}\t{}\t{:.2f}\n", address,
+                              g_symbolDB.GetDescription(address), count, percent));
+  }
+
+  return true;
+}
+
+void OnCPUThreadStart()
+{
+  std::lock_guard lk(s_control_lock);
+
+#ifdef _WIN32
+  s_cpu_thread = OpenThread(THREAD_SUSPEND_RESUME | THREAD_GET_CONTEXT, FALSE,
+                            static_cast<DWORD>(Common::CurrentThreadId()));
+  if (!s_cpu_thread)
+    return;
+#elif !defined(_M_GENERIC)
+  s_cpu_thread = pthread_self();
+#endif
+
+  s_cpu_thread_registered = true;
+  if (s_enabled)
+    StartSamplerThread();
+}
+
+void OnCPUThreadStop()
+{
+  {
+    std::lock_guard lk(s_control_lock);
+    if (!s_cpu_thread_registered)
+      return;
+
+    StopSamplerThread();
+    s_cpu_thread_registered = false;
+
+#ifdef _WIN32
+    CloseHandle(s_cpu_thread);
+    s_cpu_thread = nullptr;
+#endif
+  }
+
+  // The JIT's code goes away with the emulation.
+  Flush();
+}
+
+void OnFrameEnd()
+{
+  Drain();
+}
+}  // namespace SamplingProfiler
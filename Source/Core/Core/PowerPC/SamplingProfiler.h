@@ -0,0 +1,59 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+// Sampling profiler for guest code.
+//
+// Unlike JIT block profiling, which instruments every block and makes the emulator much slower,
+// this interrupts the CPU thread at a fixed rate and records where it was: SIGPROF is sent to the
+// thread on POSIX systems, and the thread is briefly suspended on Windows. A sample only holds the
+// host program counter and the guest PC, LR and r1.
+//
+// At every frame boundary, the CPU thread walks the guest stack back chain of the new samples.
+// When the results are written, host program counters are mapped back to the JIT block whose code
+// contains them. Samples that hit code outside of any block (the dispatcher, or the interpreter)
+// are attributed to the guest PC instead. The registers of the JIT's register cache may be newer
+// than the guest state a sample reads, and the stack may have changed by the end of the frame, so
+// the stacks are approximate.
+
+#pragma once
+
+#include <string>
+
+#include "Common/CommonTypes.h"
+
+namespace SamplingProfiler
+{
+constexpr u32 DEFAULT_SAMPLE_RATE = 1000;
+
+struct Stats
+{
+  u64 sample_count;
+  // Samples that weren't in the code of a JIT block, out of those mapped to blocks so far.
+  u64 outside_block_count;
+  // Samples lost because the CPU thread didn't process them in time.
+  u64 dropped_count;
+};
+
+// Thread-safe. Sampling only happens while the CPU thread is running; if emulation isn't
+// running, it starts with the next one.
+void Start(u32 sample_rate = DEFAULT_SAMPLE_RATE);
+void Stop();
+bool IsEnabled();
+
+// Drops every sample collected so far.
+void Clear();
+Stats GetStats();
+
+// Writes one line per guest call stack, with the names of the functions from the outermost to
+// the innermost separated by semicolons, followed by the number of samples. This is the input
+// format of flamegraph.pl, speedscope and similar tools.
+bool WriteCollapsedStacks(const std::string& filename);
+// Writes the number of samples of each block, like JitInterface::WriteProfileResults.
+bool WriteBlockProfile(const std::string& filename);
+
+// Called by the CPU thread.
+void OnCPUThreadStart();
+void OnCPUThreadStop();
+void OnFrameEnd();
+}  // namespace SamplingProfiler
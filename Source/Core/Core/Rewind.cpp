@@ -0,0 +1,271 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "Core/Rewind.h"
+
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include <zstd.h>
+
+#include "Common/Config/Config.h"
+#include "Common/Event.h"
+#include "Common/Flag.h"
+#include "Common/Logging/Log.h"
+#include "Common/WorkQueueThread.h"
+#include "Core/Config/MainSettings.h"
+#include "Core/CoreTiming.h"
+#include "Core/NetPlayProto.h"
+#include "Core/State.h"
+
+namespace Rewind
+{
+constexpr int DELTA_COMPRESSION_LEVEL = 1;
+
+struct Entry
+{
+  // Compressed XOR of this state and the state saved right after it. Bytes past the end of the
+  // shorter of the two count as zeros.
+  std::vector<u8> delta;
+  size_t state_size;
+};
+
+// Guards everything below, which is shared by the CPU thread and the worker.
+static std::mutex s_lock;
+static std::deque<Entry> s_entries;
+static std::vector<u8> s_newest_state;
+static std::vector<u8> s_spare_buffer;
+// Only used by StepBack.
+static std::vector<u8> s_xor_buffer;
+static u64 s_memory_usage;
+
+static Common::WorkQueueThread<std::vector<u8>> s_worker;
+static Common::Flag s_capture_pending;
+static Common::Event s_capture_done;
+static Common::Flag s_step_back_requested;
+static u32 s_frames_since_capture;
+
+// a ^= b over max(a.size(), b.size()) bytes; a is grown with zeros as needed.
+static void XorInto(std::vector<u8>& a, const u8* b, size_t b_size)
+{
+  if (a.size() < b_size)
+    a.resize(b_size);
+
+  size_t i = 0;
+  for (; i + sizeof(u64) <= b_size; i += sizeof(u64))
+  {
+    u64 va, vb;
+    std::memcpy(&va, a.data() + i, sizeof(va));
+    std::memcpy(&vb, b + i, sizeof(vb));
+    va ^= vb;
+    std::memcpy(a.data() + i, &va, sizeof(va));
+  }
+
+  for (; i < b_size; ++i)
+    a[i] ^= b[i];
+}
+
+// Must be called with s_lock held.
+static void TrimToBudget()
+{
+  const u64 budget = u64{Config::Get(Config::MAIN_REWIND_MEMORY_BUDGET)} * 1024 * 1024;
+  while (s_memory_usage > budget && !s_entries.empty())
+  {
+    s_memory_usage -= s_entries.front().delta.size();
+    s_entries.pop_front();
+  }
+}
+
+static void StoreState(std::vector<u8> state)
+{
+  // The previous newest state is turned into the delta in place, then recycled for the next
+  // capture.
+  std::vector<u8> previous;
+  {
+    std::lock_guard<std::mutex> lk(s_lock);
+    previous.swap(s_newest_state);
+    s_memory_usage -= previous.size();
+  }
+
+  Entry entry;
+  bool has_entry = false;
+  if (!previous.empty())
+  {
+    entry.state_size = previous.size();
+    XorInto(previous, state.data(), state.size());
+
+    entry.delta.resize(ZSTD_compressBound(previous.size()));
+    const size_t compressed_size = ZSTD_compress(entry.delta.data(), entry.delta.size(),
+                                                 previous.data(), previous.size(),
+                                                 DELTA_COMPRESSION_LEVEL);
+
+    if (ZSTD_isError(compressed_size))
+    {
+      ERROR_LOG_FMT(CORE, "Rewind: failed to compress a state: {}",
+                    ZSTD_getErrorName(compressed_size));
+    }
+    else
+    {
+      entry.delta.resize(compressed_size);
+      entry.delta.shrink_to_fit();
+      has_entry = true;
+    }
+  }
+
+  {
+    std::lock_guard<std::mutex> lk(s_lock);
+
+    if (has_entry)
+    {
+      s_memory_usage += entry.delta.size();
+      s_entries.push_back(std::move(entry));
+    }
+    else
+    {
+      // Without this delta, the older states can't be rebuilt anymore.
+      for (const Entry& e : s_entries)
+        s_memory_usage -= e.delta.size();
+      s_entries.clear();
+    }
+
+    s_newest_state = std::move(state);
+    s_memory_usage += s_newest_state.size();
+    s_spare_buffer = std::move(previous);
+
+    TrimToBudget();
+  }
+
+  s_capture_pending.Clear();
+  s_capture_done.Set();
+}
+
+static void WaitForCapture()
+{
+  if (s_capture_pending.IsSet())
+    s_capture_done.Wait();
+}
+
+static void StepBack()
+{
+  WaitForCapture();
+
+  std::lock_guard<std::mutex> lk(s_lock);
+  if (s_newest_state.empty() || !State::LoadFromBuffer(s_newest_state))
+    return;
+
+  // Stay on the oldest state once there is nothing left to rebuild.
+  if (s_entries.empty())
+    return;
+
+  Entry entry = std::move(s_entries.back());
+  s_entries.pop_back();
+  s_memory_usage -= entry.delta.size() + s_newest_state.size();
+
+  const size_t xor_size = std::max(entry.state_size, s_newest_state.size());
+  s_xor_buffer.resize(xor_size);
+  const size_t decompressed_size =
+      ZSTD_decompress(s_xor_buffer.data(), xor_size, entry.delta.data(), entry.delta.size());
+  if (ZSTD_isError(decompressed_size) || decompressed_size != xor_size)
+  {
+    ERROR_LOG_FMT(CORE, "Rewind: failed to decompress a state");
+    s_entries.clear();
+    s_memory_usage = s_newest_state.size();
+    return;
+  }
+
+  XorInto(s_newest_state, s_xor_buffer.data(), xor_size);
+  s_newest_state.resize(entry.state_size);
+  s_memory_usage += s_newest_state.size();
+  s_xor_buffer.clear();
+}
+
+static void Capture()
+{
+  // If the worker hasn't caught up yet, skip this capture rather than queueing up whole states.
+  if (s_capture_pending.IsSet())
+    return;
+
+  std::vector<u8> state;
+  {
+    std::lock_guard<std::mutex> lk(s_lock);
+    state.swap(s_spare_buffer);
+  }
+
+  if (!State::SaveToBuffer(state))
+    return;
+
+  s_capture_pending.Set();
+  s_capture_done.Reset();
+  s_worker.EmplaceItem(std::move(state));
+}
+
+void Init()
+{
+  s_capture_pending.Clear();
+  s_step_back_requested.Clear();
+  s_frames_since_capture = 0;
+  s_worker.Reset(&StoreState);
+}
+
+void Shutdown()
+{
+  s_worker.Cancel();
+  s_capture_pending.Clear();
+  Clear();
+}
+
+void OnFrameEnd()
+{
+  if (!Config::Get(Config::MAIN_REWIND_ENABLE) || NetPlay::IsNetPlayRunning())
+  {
+    s_step_back_requested.Clear();
+    if (GetStats().state_count != 0)
+      Clear();
+    return;
+  }
+
+  // This runs inside the VI event, which a state saved here would lack. Loading one here would
+  // also replace the event queue while CoreTiming walks it.
+  if (s_step_back_requested.TestAndClear())
+  {
+    CoreTiming::RunBetweenSlices(&StepBack);
+    s_frames_since_capture = 0;
+    return;
+  }
+
+  if (++s_frames_since_capture < std::max(Config::Get(Config::MAIN_REWIND_INTERVAL), 1u))
+    return;
+
+  s_frames_since_capture = 0;
+  CoreTiming::RunBetweenSlices(&Capture);
+}
+
+void RequestStepBack()
+{
+  s_step_back_requested.Set();
+}
+
+void Clear()
+{
+  WaitForCapture();
+
+  std::lock_guard<std::mutex> lk(s_lock);
+  s_entries.clear();
+  std::vector<u8>().swap(s_newest_state);
+  std::vector<u8>().swap(s_spare_buffer);
+  std::vector<u8>().swap(s_xor_buffer);
+  s_memory_usage = 0;
+}
+
+Stats GetStats()
+{
+  std::lock_guard<std::mutex> lk(s_lock);
+  const u32 newest_count = s_newest_state.empty() ? 0 : 1;
+  return {static_cast<u32>(s_entries.size()) + newest_count, s_memory_usage};
+}
+}  // namespace Rewind
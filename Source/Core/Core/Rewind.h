@@ -0,0 +1,41 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+// In-memory rewind buffer.
+//
+// Every MAIN_REWIND_INTERVAL frames, the CPU thread saves a state at the frame boundary, once the
+// VI event has been processed. A worker thread then replaces the previous newest state with a
+// Zstandard-compressed XOR delta against the new one, so only the newest state is kept whole.
+// Consecutive states are nearly identical, which makes the deltas mostly zeros. The oldest deltas
+// are dropped to stay within MAIN_REWIND_MEMORY_BUDGET.
+//
+// Stepping back loads the newest state and rebuilds the one before it from its delta, so that the
+// next step goes further back.
+
+#pragma once
+
+#include "Common/CommonTypes.h"
+
+namespace Rewind
+{
+struct Stats
+{
+  u32 state_count;
+  u64 memory_usage;
+};
+
+void Init();
+void Shutdown();
+
+// Called by the CPU thread from Core::OnFrameEnd.
+void OnFrameEnd();
+
+// Thread-safe. The step happens on the CPU thread at the next frame boundary.
+void RequestStepBack();
+
+// Drops every stored state.
+void Clear();
+
+Stats GetStats();
+}  // namespace Rewind
@@ -4,6 +4,9 @@
 
 #include "Core/State.h"
 
+#include <algorithm>
+#include <atomic>
+#include <functional>
 #include <lzo/lzo1x.h>
 #include <map>
 #include <mutex>
@@ -13,6 +16,7 @@
 #include <vector>
 
 #include <fmt/format.h>
+#include <zstd.h>
 
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
@@ -53,12 +57,22 @@ static const u32 IN_LEN = 128 * 1024u;
 
 static const u32 OUT_LEN = IN_LEN + (IN_LEN / 16) + 64 + 3;
 
-static unsigned char __LZO_MMODEL out[OUT_LEN];
+// Compressed states are written as independent Zstandard chunks, so that both compression and
+// decompression can be spread over several threads. A ZstdStateHeader and a table of compressed
+// chunk sizes follow the StateHeader. Older states start with the length of their first LZO block
+// instead, which is at most OUT_LEN and thus never equal to the magic.
+constexpr u32 ZSTD_STATE_MAGIC = 0x5A535443;  // "CTSZ"
+constexpr u32 ZSTD_STATE_FORMAT_VERSION = 1;
+constexpr u32 ZSTD_STATE_CHUNK_SIZE = 1024 * 1024;
+constexpr int ZSTD_STATE_COMPRESSION_LEVEL = 1;
 
-#define HEAP_ALLOC(var, size)                                                                      \
-  lzo_align_t __LZO_MMODEL var[((size) + (sizeof(lzo_align_t) - 1)) / sizeof(lzo_align_t)]
-
-static HEAP_ALLOC(wrkmem, LZO1X_1_MEM_COMPRESS);
+struct ZstdStateHeader
+{
+  u32 magic;
+  u32 version;
+  u32 chunk_size;
+  u32 chunk_count;
+};
 
 static AfterLoadCallbackFunc s_on_after_load_callback;
 
@@ -215,25 +229,33 @@ static void DoState(PointerWrap& p)
   p.DoMarker("Gecko");
 }
 
-void LoadFromBuffer(std::vector<u8>& buffer)
+bool LoadFromBuffer(std::vector<u8>& buffer)
 {
   if (NetPlay::IsNetPlayRunning())
   {
     OSD::AddMessage("Loading savestates is disabled in Netplay to prevent desyncs");
-    return;
+    return false;
   }
 
+  if (buffer.empty())
+    return false;
+
+  bool loaded = false;
   Core::RunOnCPUThread(
       [&] {
         u8* ptr = &buffer[0];
         PointerWrap p(&ptr, PointerWrap::MODE_READ);
         DoState(p);
+        loaded = p.GetMode() == PointerWrap::MODE_READ;
       },
       true);
+
+  return loaded;
 }
 
-void SaveToBuffer(std::vector<u8>& buffer)
+bool SaveToBuffer(std::vector<u8>& buffer)
 {
+  bool saved = false;
   Core::RunOnCPUThread(
       [&] {
         u8* ptr = nullptr;
@@ -246,8 +268,11 @@ void SaveToBuffer(std::vector<u8>& buffer)
         ptr = &buffer[0];
         p.SetMode(PointerWrap::MODE_WRITE);
         DoState(p);
+        saved = p.GetMode() == PointerWrap::MODE_WRITE;
       },
       true);
+
+  return saved;
 }
 
 // return state number not in map
@@ -297,6 +322,155 @@ static std::map<double, int> GetSavedStates()
   return m;
 }
 
+// Runs function(i) for every i in [0, count), spread over the available hardware threads.
+static void ParallelFor(size_t count, const std::function<void(size_t)>& function)
+{
+  const size_t thread_count =
+      std::min<size_t>(count, std::max(std::thread::hardware_concurrency(), 1u));
+
+  std::atomic<size_t> next_index{0};
+  const auto worker = [&] {
+    for (size_t i = next_index++; i < count; i = next_index++)
+      function(i);
+  };
+
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < thread_count; ++i)
+    threads.emplace_back(worker);
+
+  worker();
+
+  for (std::thread& thread : threads)
+    thread.join();
+}
+
+static bool WriteZstdState(File::IOFile& f, const u8* buffer_data, size_t buffer_size)
+{
+  const ZstdStateHeader zstd_header{
+      ZSTD_STATE_MAGIC, ZSTD_STATE_FORMAT_VERSION, ZSTD_STATE_CHUNK_SIZE,
+      static_cast<u32>((buffer_size + ZSTD_STATE_CHUNK_SIZE - 1) / ZSTD_STATE_CHUNK_SIZE)};
+
+  std::vector<std::vector<u8>> chunks(zstd_header.chunk_count);
+  std::vector<u32> chunk_sizes(zstd_header.chunk_count);
+  std::atomic<bool> failed{false};
+
+  ParallelFor(chunks.size(), [&](size_t i) {
+    const size_t offset = i * ZSTD_STATE_CHUNK_SIZE;
+    const size_t size = std::min<size_t>(buffer_size - offset, ZSTD_STATE_CHUNK_SIZE);
+
+    chunks[i].resize(ZSTD_compressBound(size));
+    const size_t compressed_size = ZSTD_compress(chunks[i].data(), chunks[i].size(),
+                                                 buffer_data + offset, size,
+                                                 ZSTD_STATE_COMPRESSION_LEVEL);
+    if (ZSTD_isError(compressed_size))
+    {
+      failed = true;
+      return;
+    }
+
+    chunk_sizes[i] = static_cast<u32>(compressed_size);
+  });
+
+  if (failed)
+  {
+    PanicAlertFmtT("Internal Zstandard Error - compression failed");
+    return false;
+  }
+
+  f.WriteArray(&zstd_header, 1);
+  f.WriteArray(chunk_sizes.data(), chunk_sizes.size());
+  for (size_t i = 0; i < chunks.size(); ++i)
+    f.WriteBytes(chunks[i].data(), chunk_sizes[i]);
+
+  return f.IsGood();
+}
+
+static bool ReadZstdState(File::IOFile& f, std::vector<u8>& buffer)
+{
+  ZstdStateHeader zstd_header;
+  zstd_header.magic = ZSTD_STATE_MAGIC;
+  if (!f.ReadBytes(&zstd_header.version, sizeof(zstd_header) - sizeof(zstd_header.magic)))
+    return false;
+
+  if (zstd_header.version != ZSTD_STATE_FORMAT_VERSION || zstd_header.chunk_size == 0 ||
+      zstd_header.chunk_count !=
+          (buffer.size() + zstd_header.chunk_size - 1) / zstd_header.chunk_size)
+  {
+    return false;
+  }
+
+  std::vector<u32> chunk_sizes(zstd_header.chunk_count);
+  if (!f.ReadArray(chunk_sizes.data(), chunk_sizes.size()))
+    return false;
+
+  // The sizes come from the file, so check them before allocating anything for them. No chunk can
+  // be larger than its worst case compression, and together they have to fit in the rest of the
+  // file.
+  std::vector<size_t> chunk_offsets(zstd_header.chunk_count);
+  u64 compressed_size = 0;
+  for (size_t i = 0; i < chunk_sizes.size(); ++i)
+  {
+    const size_t offset = i * zstd_header.chunk_size;
+    const size_t size = std::min<size_t>(buffer.size() - offset, zstd_header.chunk_size);
+    if (chunk_sizes[i] > ZSTD_compressBound(size))
+      return false;
+
+    chunk_offsets[i] = static_cast<size_t>(compressed_size);
+    compressed_size += chunk_sizes[i];
+  }
+
+  const u64 position = f.Tell();
+  const u64 file_size = f.GetSize();
+  if (position > file_size || compressed_size > file_size - position)
+    return false;
+
+  std::vector<u8> compressed(static_cast<size_t>(compressed_size));
+  if (!f.ReadBytes(compressed.data(), compressed.size()))
+    return false;
+
+  std::atomic<bool> failed{false};
+  ParallelFor(chunk_sizes.size(), [&](size_t i) {
+    const size_t offset = i * zstd_header.chunk_size;
+    const size_t size = std::min<size_t>(buffer.size() - offset, zstd_header.chunk_size);
+
+    const size_t decompressed_size = ZSTD_decompress(
+        buffer.data() + offset, size, compressed.data() + chunk_offsets[i], chunk_sizes[i]);
+    if (ZSTD_isError(decompressed_size) || decompressed_size != size)
+      failed = true;
+  });
+
+  return !failed;
+}
+
+static bool ReadLZOState(File::IOFile& f, lzo_uint32 first_block_size, std::vector<u8>& buffer)
+{
+  std::vector<u8> in(OUT_LEN);
+
+  lzo_uint i = 0;
+  lzo_uint32 cur_len = first_block_size;  // number of bytes to read
+  do
+  {
+    lzo_uint new_len = buffer.size() - i;  // number of bytes to write
+
+    if (cur_len > in.size() || !f.ReadBytes(in.data(), cur_len))
+      return false;
+
+    const int res = lzo1x_decompress_safe(in.data(), cur_len, &buffer[i], &new_len, nullptr);
+    if (res != LZO_E_OK)
+    {
+      // This doesn't seem to happen anymore.
+      PanicAlertFmtT("Internal LZO Error - decompression failed ({0}) ({1}, {2}) \n"
+                     "Try loading the state again",
+                     res, i, new_len);
+      return false;
+    }
+
+    i += new_len;
+  } while (i < buffer.size() && f.ReadArray(&cur_len, 1));
+
+  return true;
+}
+
 struct CompressAndDumpState_args
 {
   std::vector<u8>* buffer_vector;
@@ -365,32 +539,10 @@ static void CompressAndDumpState(CompressAndDumpState_args save_args)
 
   if (header.size != 0)  // non-zero header size means the state is compressed
   {
-    lzo_uint i = 0;
-    while (true)
+    if (!WriteZstdState(f, buffer_data, buffer_size))
     {
-      lzo_uint32 cur_len = 0;
-      lzo_uint out_len = 0;
-
-      if ((i + IN_LEN) >= buffer_size)
-      {
-        cur_len = (lzo_uint32)(buffer_size - i);
-      }
-      else
-      {
-        cur_len = IN_LEN;
-      }
-
-      if (lzo1x_1_compress(buffer_data + i, cur_len, out, &out_len, wrkmem) != LZO_E_OK)
-        PanicAlertFmtT("Internal LZO Error - compression failed");
-
-      // The size of the data to write is 'out_len'
-      f.WriteArray((lzo_uint32*)&out_len, 1);
-      f.WriteBytes(out, out_len);
-
-      if (cur_len != IN_LEN)
-        break;
-
-      i += cur_len;
+      Core::DisplayMessage("Could not save state", 2000);
+      return;
     }
   }
   else  // uncompressed
@@ -518,27 +670,17 @@ static void LoadFileStateData(const std::string& filename, std::vector<u8>& ret_
 
     buffer.resize(header.size);
 
-    lzo_uint i = 0;
-    while (true)
-    {
-      lzo_uint32 cur_len = 0;  // number of bytes to read
-      lzo_uint new_len = 0;    // number of bytes to write
-
-      if (!f.ReadArray(&cur_len, 1))
-        break;
-
-      f.ReadBytes(out, cur_len);
-      const int res = lzo1x_decompress(out, cur_len, &buffer[i], &new_len, nullptr);
-      if (res != LZO_E_OK)
-      {
-        // This doesn't seem to happen anymore.
-        PanicAlertFmtT("Internal LZO Error - decompression failed ({0}) ({1}, {2}) \n"
-                       "Try loading the state again",
-                       res, i, new_len);
-        return;
-      }
+    u32 magic_or_block_size;
+    if (!f.ReadArray(&magic_or_block_size, 1))
+      return;
 
-      i += new_len;
+    const bool success = magic_or_block_size == ZSTD_STATE_MAGIC ?
+                             ReadZstdState(f, buffer) :
+                             ReadLZOState(f, magic_or_block_size, buffer);
+    if (!success)
+    {
+      Core::DisplayMessage("The savestate could not be decompressed", 2000);
+      return;
     }
   }
   else  // uncompressed
@@ -50,8 +50,10 @@ void Load(int slot);
 void SaveAs(const std::string& filename, bool wait = false);
 void LoadAs(const std::string& filename);
 
-void SaveToBuffer(std::vector<u8>& buffer);
-void LoadFromBuffer(std::vector<u8>& buffer);
+// Uncompressed in-memory states. Both return false if DoState failed (e.g. a version mismatch).
+// buffer is resized to fit the state, so reusing it between saves avoids a reallocation.
+bool SaveToBuffer(std::vector<u8>& buffer);
+bool LoadFromBuffer(std::vector<u8>& buffer);
 
 void LoadLastSaved(int i = 1);
 void SaveFirstSaved();
@@ -0,0 +1,58 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "Core/Turbo.h"
+
+#include <algorithm>
+#include <atomic>
+
+#include "Common/Config/Config.h"
+#include "Common/Logging/Log.h"
+#include "Core/Config/MainSettings.h"
+#include "Core/NetPlayProto.h"
+
+namespace Turbo
+{
+// The settings are read on the CPU thread once per frame, as the GPU and sound threads check them
+// far too often to go through the config system.
+static std::atomic<bool> s_enabled{false};
+static std::atomic<u32> s_present_interval{1};
+
+static void Update()
+{
+  // Netplay needs every player to run at the same speed.
+  const bool enabled = Config::Get(Config::MAIN_TURBO_MODE) && !NetPlay::IsNetPlayRunning();
+  if (enabled != s_enabled.load(std::memory_order_relaxed))
+    INFO_LOG_FMT(CORE, "Turbo mode {}", enabled ? "enabled" : "disabled");
+
+  s_present_interval.store(std::max(Config::Get(Config::MAIN_TURBO_PRESENT_INTERVAL), 1u),
+                           std::memory_order_relaxed);
+  s_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+void Init()
+{
+  Update();
+}
+
+void Shutdown()
+{
+  s_enabled.store(false, std::memory_order_relaxed);
+}
+
+void OnFrameEnd()
+{
+  Update();
+}
+
+bool IsEnabled()
+{
+  return s_enabled.load(std::memory_order_relaxed);
+}
+
+u32 GetPresentInterval()
+{
+  return s_present_interval.load(std::memory_order_relaxed);
+}
+}  // namespace Turbo
@@ -0,0 +1,33 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+// Turbo mode, for replaying inputs and other batch jobs as fast as possible.
+//
+// The emulation runs unthrottled and without VSync, and audio is dropped before it reaches the
+// mixer. The GPU still processes the whole FIFO, so EFB copies, bounding box and PE tokens keep
+// working, but primitives are only drawn in the frames that are presented, one every
+// MAIN_TURBO_PRESENT_INTERVAL frames. Games whose logic reads the EFB back (through EFB copies to
+// RAM or peeks) see what was last drawn rather than the current frame, which can change their
+// behavior.
+//
+// Not saved to the configuration file: turbo mode is meant to be enabled for one session, through
+// the command line or the frontend.
+
+#pragma once
+
+#include "Common/CommonTypes.h"
+
+namespace Turbo
+{
+void Init();
+void Shutdown();
+
+// Called by the CPU thread from Core::OnFrameEnd, to pick up changes to the settings.
+void OnFrameEnd();
+
+// Thread-safe.
+bool IsEnabled();
+// At least 1.
+u32 GetPresentInterval();
+}  // namespace Turbo
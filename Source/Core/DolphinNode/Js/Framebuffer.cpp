@@ -0,0 +1,123 @@
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "Core/Core.h"
+
+#include "DolphinNode/Js/Framebuffer.h"
+#include "DolphinNode/Js/TypeConv.h"
+
+#include "VideoCommon/RenderBase.h"
+
+namespace Js::Framebuffer {
+
+using PixelBuffer = std::vector<u8>;
+
+struct Result {
+  u64 id{};
+  u32 width{};
+  u32 height{};
+  // Null if the frame could not be read back.
+  std::shared_ptr<PixelBuffer> pixels;
+};
+
+static Napi::ThreadSafeFunction s_complete;
+
+// The promises the renderer hasn't answered yet. Only accessed on the JS thread, so that they can
+// be rejected when the function is released.
+static std::map<u64, Napi::Promise::Deferred> s_pending;
+static u64 s_next_id{};
+
+static Napi::Object MakeError(Napi::Env env, const char* message) {
+  return Napi::Error(env, Napi::String::New(env, message)).Value();
+}
+
+// Requests served by the same frame share its pixels, so the buffers never copy them.
+static Napi::Buffer<u8> WrapBuffer(Napi::Env env, std::shared_ptr<PixelBuffer> buffer) {
+  auto* hint{new std::shared_ptr<PixelBuffer>{std::move(buffer)}};
+
+  return Napi::Buffer<u8>::New(env, (*hint)->data(), (*hint)->size(),
+    [](Napi::Env, u8*, std::shared_ptr<PixelBuffer>* hint) { delete hint; }, hint);
+}
+
+static void DeliverResult(Napi::Env env, Napi::Function, Result* data) {
+  std::unique_ptr<Result> result{data};
+
+  // The queue is drained without an environment when the function is released, after Shutdown
+  // rejected every pending promise.
+  if (env == nullptr)
+    return;
+
+  const auto it{s_pending.find(result->id)};
+  if (it == s_pending.end())
+    return;
+
+  const auto deferred{it->second};
+  s_pending.erase(it);
+
+  if (!result->pixels) {
+    deferred.Reject(MakeError(env, "the frame could not be read back"));
+    return;
+  }
+
+  auto obj{Napi::Object::New(env)};
+  obj.Set("width", TypeConv::FromU32(env, result->width));
+  obj.Set("height", TypeConv::FromU32(env, result->height));
+  obj.Set("data", WrapBuffer(env, std::move(result->pixels)));
+
+  deferred.Resolve(obj);
+}
+
+void Init(Napi::Env env) {
+  s_complete = Napi::ThreadSafeFunction::New(env, Napi::Function::New(env, [](const Napi::CallbackInfo&) {}), "DolphinFramebuffer", 0, 1);
+  s_complete.Unref(env);
+}
+
+void Shutdown() {
+  for (auto& [id, deferred] : s_pending)
+    deferred.Reject(MakeError(deferred.Env(), "the emulation stopped before the frame was read back"));
+  s_pending.clear();
+
+  s_complete.Release();
+}
+
+Napi::Promise Read(Napi::Env env) {
+  auto deferred{Napi::Promise::Deferred::New(env)};
+  const auto promise{deferred.Promise()};
+
+  const auto state{Core::GetState()};
+  if ((state != Core::State::Running && state != Core::State::Paused) || !g_renderer) {
+    deferred.Reject(MakeError(env, "emulation is not running"));
+    return promise;
+  }
+
+  const u64 id{s_next_id++};
+  s_pending.emplace(id, deferred);
+
+  // Called on the video thread, on this thread for the last frame if it was already read back, or
+  // while the renderer shuts down, which rejects the request.
+  auto callback{[id](u32 width, u32 height, std::shared_ptr<PixelBuffer> pixels) {
+    auto result{std::make_unique<Result>()};
+    result->id = id;
+    result->width = width;
+    result->height = height;
+    result->pixels = std::move(pixels);
+
+    if (s_complete.NonBlockingCall(result.get(), &DeliverResult) == napi_ok)
+      result.release();
+  }};
+
+  // No frame is presented while paused, so the request gets the last one.
+  if (state == Core::State::Paused) {
+    if (!g_renderer->RequestLastFrameCapture(std::move(callback))) {
+      s_pending.erase(id);
+      deferred.Reject(MakeError(env, "no frame was presented since the first read"));
+    }
+  } else {
+    g_renderer->RequestFrameCapture(std::move(callback));
+  }
+
+  return promise;
+}
+
+}
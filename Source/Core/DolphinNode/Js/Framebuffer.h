@@ -0,0 +1,19 @@
+#pragma once
+
+#include <napi.h>
+
+namespace Js::Framebuffer {
+
+// Readback of the emulated output, for tests that need frames without a window. Each request is
+// served by the next frame the renderer presents; the promise settles on the JS thread once the
+// GPU has finished copying it, one frame later.
+
+void Init(Napi::Env env);
+void Shutdown();
+
+// Resolves to {width, height, data}, where data holds the XFB in RGBA8 at the internal
+// resolution. While the emulation is paused, resolves to the last presented frame right away.
+// Pending reads are rejected on shutdown.
+Napi::Promise Read(Napi::Env env);
+
+}
@@ -1,17 +1,25 @@
 #include <QDir>
 
+#include <algorithm>
 #include <unordered_map>
 
 #include <imgui.h>
 
+#include "Common/Config/Config.h"
 #include "Common/FileUtil.h"
+#include "Common/ScopeGuard.h"
 
 #include "Core/Boot/Boot.h"
 #include "Core/Config/MainSettings.h"
 #include "Core/Core.h"
+#include "Core/PowerPC/SamplingProfiler.h"
+#include "Core/Rewind.h"
 
 #include "DolphinNode/Host.h"
+#include "DolphinNode/Js/Framebuffer.h"
 #include "DolphinNode/Js/Frontend.h"
+#include "DolphinNode/Js/Memory.h"
+#include "DolphinNode/Js/SaveState.h"
 #include "DolphinNode/MainWindow.h"
 #include "DolphinNode/RenderWidget.h"
 #include "DolphinNode/Resources.h"
@@ -26,6 +34,44 @@ bool QtMsgAlertHandler(const char* caption, const char* text, bool yes_no, Commo
 
 namespace Js {
 
+void LatencyHistogram::Record(std::chrono::microseconds latency) {
+  const u64 us{static_cast<u64>(std::max<s64>(latency.count(), 0))};
+
+  size_t bucket{};
+  for (u64 v{us}; v != 0 && bucket < BUCKET_COUNT - 1; v >>= 1)
+    ++bucket;
+
+  m_buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+  m_count.fetch_add(1, std::memory_order_relaxed);
+  m_total_us.fetch_add(us, std::memory_order_relaxed);
+
+  u64 max_us{m_max_us.load(std::memory_order_relaxed)};
+  while (us > max_us && !m_max_us.compare_exchange_weak(max_us, us, std::memory_order_relaxed));
+}
+
+void LatencyHistogram::Reset() {
+  for (auto& bucket : m_buckets)
+    bucket.store(0, std::memory_order_relaxed);
+
+  m_count.store(0, std::memory_order_relaxed);
+  m_total_us.store(0, std::memory_order_relaxed);
+  m_max_us.store(0, std::memory_order_relaxed);
+}
+
+Napi::Object LatencyHistogram::ToObject(Napi::Env env) const {
+  auto buckets{Napi::Array::New(env, BUCKET_COUNT)};
+  for (size_t i{}; i < BUCKET_COUNT; ++i)
+    buckets.Set(static_cast<u32>(i), Napi::Number::New(env, static_cast<double>(m_buckets[i].load(std::memory_order_relaxed))));
+
+  auto obj{Napi::Object::New(env)};
+  obj.Set("count", Napi::Number::New(env, static_cast<double>(m_count.load(std::memory_order_relaxed))));
+  obj.Set("totalUs", Napi::Number::New(env, static_cast<double>(m_total_us.load(std::memory_order_relaxed))));
+  obj.Set("maxUs", Napi::Number::New(env, static_cast<double>(m_max_us.load(std::memory_order_relaxed))));
+  obj.Set("buckets", buckets);
+
+  return obj;
+}
+
 Napi::FunctionReference Frontend::constructor;
 
 Napi::Object Frontend::Init(Napi::Env env, Napi::Object exports) {
@@ -49,6 +95,30 @@ Napi::Object Frontend::Init(Napi::Env env, Napi::Object exports) {
     InstanceMethod("isOnImGuiPending", &Frontend::IsOnImGuiPending),
     InstanceMethod("signalHandlingOnImGui", &Frontend::SignalHandlingOnImGui),
     InstanceMethod("unlockOnImGui", &Frontend::UnlockOnImGui),
+    InstanceMethod("getTickLatencyHistogram", &Frontend::GetTickLatencyHistogram),
+    InstanceMethod("resetTickLatencyHistogram", &Frontend::ResetTickLatencyHistogram),
+
+    InstanceMethod("saveStateToBuffer", &Frontend::SaveStateToBuffer),
+    InstanceMethod("loadStateFromBuffer", &Frontend::LoadStateFromBuffer),
+    InstanceMethod("setStateSlotCount", &Frontend::SetStateSlotCount),
+    InstanceMethod("getStateSlotCount", &Frontend::GetStateSlotCount),
+    InstanceMethod("saveStateToSlot", &Frontend::SaveStateToSlot),
+    InstanceMethod("loadStateFromSlot", &Frontend::LoadStateFromSlot),
+    InstanceMethod("getStateSlot", &Frontend::GetStateSlot),
+
+    InstanceMethod("setRewindConfig", &Frontend::SetRewindConfig),
+    InstanceMethod("rewind", &Frontend::Rewind),
+    InstanceMethod("getRewindStats", &Frontend::GetRewindStats),
+
+    InstanceMethod("setTurboConfig", &Frontend::SetTurboConfig),
+
+    InstanceMethod("readFramebuffer", &Frontend::ReadFramebuffer),
+
+    InstanceMethod("startProfiler", &Frontend::StartProfiler),
+    InstanceMethod("stopProfiler", &Frontend::StopProfiler),
+    InstanceMethod("clearProfile", &Frontend::ClearProfile),
+    InstanceMethod("getProfilerStats", &Frontend::GetProfilerStats),
+    InstanceMethod("writeProfile", &Frontend::WriteProfile),
 
     InstanceMethod("button", &Frontend::Button)
   });
@@ -62,7 +132,7 @@ Napi::Object Frontend::Init(Napi::Env env, Napi::Object exports) {
 }
 
 Frontend::Frontend(const Napi::CallbackInfo& info) :
-  Napi::ObjectWrap<Frontend>{info}, m_states{}
+  Napi::ObjectWrap<Frontend>{info}
 {}
 
 static Frontend::CreateInfo GetCreateInfoFromObject(const Napi::Object& obj) {
@@ -79,6 +149,9 @@ static Frontend::CreateInfo GetCreateInfoFromObject(const Napi::Object& obj) {
   info.base_dir = make_path("baseDir");
   info.user_dir = make_path("userDir");
 
+  const auto headless = obj.Get("headless");
+  info.headless = !headless.IsUndefined() && headless.As<Napi::Boolean>().Value();
+
   return info;
 }
 
@@ -113,6 +186,12 @@ Napi::Value Frontend::Initialize(const Napi::CallbackInfo& info) {
   QCoreApplication::setApplicationName(QString::fromStdString(start_info.app_name));
   QGuiApplication::setApplicationDisplayName(QString::fromStdString(start_info.app_display_name));
 
+  // The offscreen platform needs no display server. The main window and the render widget still
+  // exist, but the video backend is given a headless surface.
+  m_headless = start_info.headless;
+  if (m_headless)
+    qputenv("QT_QPA_PLATFORM", "offscreen");
+
   static int argc = 0;
   static char** argv;
   m_app.reset(new QApplication{argc, argv});
@@ -165,42 +244,55 @@ Napi::Value Frontend::Startup(const Napi::CallbackInfo& info) {
   m_settings->SetDebugModeEnabled(false);
 
   QObject::connect(m_settings, &Settings::EmulationStateChanged, this, [this](Core::State new_state) {
+    if (new_state == Core::State::Uninitialized) {
+      Js::Memory::InvalidateRamViews();
+      Js::Memory::ClearJournal();
+      Js::Memory::ClearWatches();
+      Js::SaveState::CancelPending();
+    }
+
     m_callbacks[CallbackIndex_StateChanged].Call({ Napi::Number::New(m_callbacks[CallbackIndex_StateChanged].Env(), static_cast<double>(new_state)) });
   });
 
-  JsCallbacks::SetOnStateChangeBegin([this]() {
-    m_states[AtomicState_FreeOnTick] = true;
+  // Wakes the Node loop through its uv async handle as soon as a callback is pending, so JS no
+  // longer has to poll isOnTickPending/isOnImGuiPending.
+  m_wake_js = Napi::ThreadSafeFunction::New(info.Env(), Napi::Function::New(info.Env(), [](const Napi::CallbackInfo&) {}), "DolphinWakeJs", 0, 1);
+  m_wake_js.Unref(info.Env());
+
+  Js::SaveState::Init(info.Env());
+  Js::Framebuffer::Init(info.Env());
 
-    if (m_states[AtomicState_PendingOnTick] && !m_states[AtomicState_HandlingOnTick])
-      m_states[AtomicState_PendingOnTick] = false;
-    else if (m_states[AtomicState_PendingOnTick] && m_states[AtomicState_HandlingOnTick])
-      while (m_states[AtomicState_PendingOnTick]);
+  JsCallbacks::SetOnStateChangeBegin([this]() {
+    // No new callback can be posted until the state change ends. If JS is already inside the
+    // callback, let it finish before the state changes.
+    if (!m_on_tick.Suspend())
+      m_on_tick.WaitWhileHandling();
 
-    if (m_states[AtomicState_PendingOnImGui] && !m_states[AtomicState_HandlingOnImGui])
-      m_states[AtomicState_PendingOnImGui] = false;
-    else if (m_states[AtomicState_PendingOnImGui] && m_states[AtomicState_HandlingOnImGui])
-      while (m_states[AtomicState_PendingOnImGui]);
+    if (!m_on_imgui.Suspend())
+      m_on_imgui.WaitWhileHandling();
   });
   JsCallbacks::SetOnStateChangeEnd([this]() {
-    m_states[AtomicState_FreeOnTick] = false;
+    m_on_tick.Resume();
+    m_on_imgui.Resume();
   });
   JsCallbacks::SetOnTick([this]() {
-    if (m_states[AtomicState_MtCbEnabled] && !m_states[AtomicState_FreeOnTick]) {
-      m_states[AtomicState_PendingOnTick] = true;
-      while (m_states[AtomicState_PendingOnTick]);
-    }
+    if (!m_mt_callbacks_enabled)
+      return;
+
+    if (const auto latency{ParkForJs(m_on_tick, CallbackIndex_Tick)})
+      m_tick_latency.Record(*latency);
   });
   JsCallbacks::SetOnImGui([this]() {
-    if (m_states[AtomicState_MtCbEnabled] && !m_states[AtomicState_FreeOnTick]) {
-      m_states[AtomicState_PendingOnImGui] = true;
-      while (m_states[AtomicState_PendingOnImGui]);
-    }
+    if (m_mt_callbacks_enabled)
+      ParkForJs(m_on_imgui, CallbackIndex_ImGui);
   });
   JsCallbacks::SetPassEventToImGui([this]() {
-    return !(m_states[AtomicState_PendingOnImGui] && !m_states[AtomicState_HandlingOnImGui]);
+    return !m_on_imgui.IsPending();
   });
 
-  m_mw->show();
+  m_mw->JsSetHeadless(m_headless);
+  if (!m_headless)
+    m_mw->show();
   m_mw->StartGame(std::move(boot));
 
   return info.Env().Undefined();
@@ -213,10 +305,22 @@ Napi::Value Frontend::Shutdown(const Napi::CallbackInfo& info) {
   JsCallbacks::SetOnImGui({});
   JsCallbacks::SetPassEventToImGui({});
 
+  // Let go of a tick that is still parked, as its call may never be dispatched once the function
+  // is released.
+  m_on_tick.Release();
+  m_on_imgui.Release();
+
+  m_wake_js.Release();
+
   m_mw->hide();
   delete m_mw;
 
   Core::Shutdown();
+  Js::Memory::InvalidateRamViews();
+  Js::Memory::ClearJournal();
+  Js::Memory::ClearWatches();
+  Js::SaveState::Shutdown();
+  Js::Framebuffer::Shutdown();
   UICommon::Shutdown();
 
   Host::GetInstance()->deleteLater();
@@ -242,6 +346,8 @@ Napi::Value Frontend::On(const Napi::CallbackInfo& info) {
     {"stop-requested", CallbackIndex_StopRequested},
     {"stop-complete", CallbackIndex_StopComplete},
     {"exit-requested", CallbackIndex_ExitRequested},
+    {"tick", CallbackIndex_Tick},
+    {"imgui", CallbackIndex_ImGui},
   };
 
   const auto name = info[0].As<Napi::String>().Utf8Value();
@@ -269,51 +375,242 @@ Napi::Value Frontend::RequestStop(const Napi::CallbackInfo& info) {
 }
 
 Napi::Value Frontend::EnableMtCallbacks(const Napi::CallbackInfo& info) {
-  m_states[AtomicState_MtCbEnabled] = true;
+  m_mt_callbacks_enabled = true;
 
   return info.Env().Undefined();
 }
 
 Napi::Value Frontend::DisableMtCallbacks(const Napi::CallbackInfo& info) {
-  m_states[AtomicState_MtCbEnabled] = false;
+  m_mt_callbacks_enabled = false;
+
+  m_on_tick.Cancel();
+  m_on_imgui.Cancel();
 
   return info.Env().Undefined();
 }
 
 Napi::Value Frontend::IsOnTickPending(const Napi::CallbackInfo& info) {
-  return Napi::Boolean::New(info.Env(), m_states[AtomicState_PendingOnTick]);
+  return Napi::Boolean::New(info.Env(), m_on_tick.IsPending());
 }
 
 Napi::Value Frontend::SignalHandlingOnTick(const Napi::CallbackInfo& info) {
-  m_states[AtomicState_HandlingOnTick] = true;
+  m_polled_on_tick = m_on_tick.ClaimPending();
 
   return info.Env().Undefined();
 }
 
 Napi::Value Frontend::UnlockOnTick(const Napi::CallbackInfo& info) {
-  m_states[AtomicState_PendingOnTick] = false;
-  m_states[AtomicState_HandlingOnTick] = false;
+  // Unlocking without signalling first lets go of the request without handling it.
+  if (m_polled_on_tick)
+    m_on_tick.Complete(*m_polled_on_tick);
+  else
+    m_on_tick.Cancel();
+  m_polled_on_tick.reset();
 
   return info.Env().Undefined();
 }
 
 Napi::Value Frontend::IsOnImGuiPending(const Napi::CallbackInfo& info) {
-  return Napi::Boolean::New(info.Env(), m_states[AtomicState_PendingOnImGui]);
+  return Napi::Boolean::New(info.Env(), m_on_imgui.IsPending());
 }
 
 Napi::Value Frontend::SignalHandlingOnImGui(const Napi::CallbackInfo& info) {
-  m_states[AtomicState_HandlingOnImGui] = true;
+  m_polled_on_imgui = m_on_imgui.ClaimPending();
 
   return info.Env().Undefined();
 }
 
 Napi::Value Frontend::UnlockOnImGui(const Napi::CallbackInfo& info) {
-  m_states[AtomicState_PendingOnImGui] = false;
-  m_states[AtomicState_HandlingOnImGui] = false;
+  // Unlocking without signalling first lets go of the request without handling it.
+  if (m_polled_on_imgui)
+    m_on_imgui.Complete(*m_polled_on_imgui);
+  else
+    m_on_imgui.Cancel();
+  m_polled_on_imgui.reset();
+
+  return info.Env().Undefined();
+}
+
+Napi::Value Frontend::GetTickLatencyHistogram(const Napi::CallbackInfo& info) {
+  return m_tick_latency.ToObject(info.Env());
+}
+
+Napi::Value Frontend::ResetTickLatencyHistogram(const Napi::CallbackInfo& info) {
+  m_tick_latency.Reset();
+
+  return info.Env().Undefined();
+}
+
+Napi::Value Frontend::SaveStateToBuffer(const Napi::CallbackInfo& info) {
+  return Js::SaveState::SaveToBuffer(info.Env());
+}
+
+Napi::Value Frontend::LoadStateFromBuffer(const Napi::CallbackInfo& info) {
+  const auto data = info[0].As<Napi::Uint8Array>();
+
+  return Js::SaveState::LoadFromBuffer(info.Env(), data.Data(), data.ByteLength());
+}
+
+Napi::Value Frontend::SetStateSlotCount(const Napi::CallbackInfo& info) {
+  Js::SaveState::SetSlotCount(info[0].As<Napi::Number>().Uint32Value());
+
+  return info.Env().Undefined();
+}
+
+Napi::Value Frontend::GetStateSlotCount(const Napi::CallbackInfo& info) {
+  return Napi::Number::New(info.Env(), Js::SaveState::GetSlotCount());
+}
+
+Napi::Value Frontend::SaveStateToSlot(const Napi::CallbackInfo& info) {
+  std::optional<u32> slot;
+  if (!info[0].IsUndefined())
+    slot = info[0].As<Napi::Number>().Uint32Value();
+
+  return Js::SaveState::SaveToSlot(info.Env(), slot);
+}
+
+Napi::Value Frontend::LoadStateFromSlot(const Napi::CallbackInfo& info) {
+  return Js::SaveState::LoadFromSlot(info.Env(), info[0].As<Napi::Number>().Uint32Value());
+}
+
+Napi::Value Frontend::GetStateSlot(const Napi::CallbackInfo& info) {
+  return Js::SaveState::GetSlot(info.Env(), info[0].As<Napi::Number>().Uint32Value());
+}
+
+Napi::Value Frontend::SetRewindConfig(const Napi::CallbackInfo& info) {
+  const auto config{info[0].As<Napi::Object>()};
+
+  if (config.Has("enabled"))
+    Config::SetBaseOrCurrent(Config::MAIN_REWIND_ENABLE, config.Get("enabled").As<Napi::Boolean>().Value());
+  if (config.Has("interval"))
+    Config::SetBaseOrCurrent(Config::MAIN_REWIND_INTERVAL, config.Get("interval").As<Napi::Number>().Uint32Value());
+  if (config.Has("memoryBudgetMB"))
+    Config::SetBaseOrCurrent(Config::MAIN_REWIND_MEMORY_BUDGET, config.Get("memoryBudgetMB").As<Napi::Number>().Uint32Value());
+
+  return info.Env().Undefined();
+}
+
+Napi::Value Frontend::Rewind(const Napi::CallbackInfo& info) {
+  ::Rewind::RequestStepBack();
+
+  return info.Env().Undefined();
+}
+
+Napi::Value Frontend::GetRewindStats(const Napi::CallbackInfo& info) {
+  const auto stats{::Rewind::GetStats()};
+
+  auto obj{Napi::Object::New(info.Env())};
+  obj.Set("stateCount", Napi::Number::New(info.Env(), stats.state_count));
+  obj.Set("memoryUsage", Napi::Number::New(info.Env(), static_cast<double>(stats.memory_usage)));
+
+  return obj;
+}
+
+Napi::Value Frontend::SetTurboConfig(const Napi::CallbackInfo& info) {
+  const auto config{info[0].As<Napi::Object>()};
+
+  if (config.Has("enabled"))
+    Config::SetBaseOrCurrent(Config::MAIN_TURBO_MODE, config.Get("enabled").As<Napi::Boolean>().Value());
+  if (config.Has("presentInterval"))
+    Config::SetBaseOrCurrent(Config::MAIN_TURBO_PRESENT_INTERVAL, config.Get("presentInterval").As<Napi::Number>().Uint32Value());
+
+  return info.Env().Undefined();
+}
+
+Napi::Value Frontend::ReadFramebuffer(const Napi::CallbackInfo& info) {
+  return Js::Framebuffer::Read(info.Env());
+}
+
+Napi::Value Frontend::StartProfiler(const Napi::CallbackInfo& info) {
+  u32 sample_rate{SamplingProfiler::DEFAULT_SAMPLE_RATE};
+  if (!info[0].IsUndefined())
+    sample_rate = info[0].As<Napi::Number>().Uint32Value();
+
+  SamplingProfiler::Start(sample_rate);
+
+  return info.Env().Undefined();
+}
+
+Napi::Value Frontend::StopProfiler(const Napi::CallbackInfo& info) {
+  SamplingProfiler::Stop();
 
   return info.Env().Undefined();
 }
 
+Napi::Value Frontend::ClearProfile(const Napi::CallbackInfo& info) {
+  SamplingProfiler::Clear();
+
+  return info.Env().Undefined();
+}
+
+Napi::Value Frontend::GetProfilerStats(const Napi::CallbackInfo& info) {
+  const auto stats{SamplingProfiler::GetStats()};
+
+  auto obj{Napi::Object::New(info.Env())};
+  obj.Set("enabled", Napi::Boolean::New(info.Env(), SamplingProfiler::IsEnabled()));
+  obj.Set("sampleCount", Napi::Number::New(info.Env(), static_cast<double>(stats.sample_count)));
+  obj.Set("outsideBlockCount", Napi::Number::New(info.Env(), static_cast<double>(stats.outside_block_count)));
+  obj.Set("droppedCount", Napi::Number::New(info.Env(), static_cast<double>(stats.dropped_count)));
+
+  return obj;
+}
+
+Napi::Value Frontend::WriteProfile(const Napi::CallbackInfo& info) {
+  const auto path{info[0].As<Napi::String>().Utf8Value()};
+  const auto format{info[1].IsUndefined() ? std::string{"collapsed"} : info[1].As<Napi::String>().Utf8Value()};
+
+  bool success{false};
+  if (format == "collapsed")
+    success = SamplingProfiler::WriteCollapsedStacks(path);
+  else if (format == "blocks")
+    success = SamplingProfiler::WriteBlockProfile(path);
+  else
+    throw Napi::TypeError(info.Env(), Napi::String::New(info.Env(), "unknown profile format: " + format));
+
+  return Napi::Boolean::New(info.Env(), success);
+}
+
+std::optional<std::chrono::microseconds> Frontend::ParkForJs(Common::ParkingHandoff& handoff, CallbackIndex index) {
+  const auto begin{std::chrono::steady_clock::now()};
+
+  // Nothing is posted while a state change is in progress.
+  const auto ticket{handoff.Post()};
+  if (!ticket)
+    return std::nullopt;
+
+  const napi_status status{m_wake_js.NonBlockingCall([this, &handoff, ticket = *ticket, index](Napi::Env, Napi::Function) {
+    DispatchPendingToJs(handoff, ticket, index);
+  })};
+
+  // The call fails once the function is released or closing, and then nothing would ever complete
+  // the request. A polling JS loop may still have claimed it in the meantime.
+  if (status != napi_ok && handoff.Withdraw(*ticket))
+    return std::nullopt;
+
+  handoff.Wait(*ticket);
+
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin);
+}
+
+void Frontend::DispatchPendingToJs(Common::ParkingHandoff& handoff, u64 ticket, CallbackIndex index) {
+  // The request may have been cancelled by a state change, or already picked up by a poller.
+  if (!handoff.Claim(ticket))
+    return;
+
+  Common::ScopeGuard complete_guard{[&] { handoff.Complete(ticket); }};
+
+  // The callbacks are cleared on shutdown, while calls can still be queued.
+  if (m_callbacks[index].IsEmpty())
+    return;
+
+  try {
+    m_callbacks[index].Call({});
+  }
+  catch (const Napi::Error& e) {
+    e.ThrowAsJavaScriptException();
+  }
+}
+
 Napi::Value Frontend::Button(const Napi::CallbackInfo& info) {
   const auto label = info[0].As<Napi::String>().Utf8Value();
 
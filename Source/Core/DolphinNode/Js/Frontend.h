@@ -5,16 +5,37 @@
 
 #include <array>
 #include <atomic>
+#include <chrono>
 #include <optional>
 #include <string>
 
 #include <napi.h>
 
+#include "Common/CommonTypes.h"
+#include "Common/ParkingHandoff.h"
+
 class MainWindow;
 class Settings;
 
 namespace Js {
 
+// Log2-bucketed histogram of how long the emulation stays parked waiting for a JS callback.
+// Bucket i counts samples in [2^(i-1), 2^i) microseconds; the last bucket is open-ended.
+class LatencyHistogram {
+public:
+  static constexpr size_t BUCKET_COUNT = 24;
+
+  void Record(std::chrono::microseconds latency);
+  void Reset();
+  Napi::Object ToObject(Napi::Env env) const;
+
+private:
+  std::array<std::atomic<u64>, BUCKET_COUNT> m_buckets{};
+  std::atomic<u64> m_count{};
+  std::atomic<u64> m_total_us{};
+  std::atomic<u64> m_max_us{};
+};
+
 class Frontend : public QObject, public Napi::ObjectWrap<Frontend> {
   Q_OBJECT
 
@@ -26,6 +47,8 @@ public:
     std::string app_display_name;
     std::string base_dir;
     std::string user_dir;
+    // Renders to an offscreen surface and never shows a window, so no display server is needed.
+    bool headless;
   };
 
   struct BootInfo {
@@ -39,19 +62,11 @@ public:
     CallbackIndex_StopRequested,
     CallbackIndex_StopComplete,
     CallbackIndex_ExitRequested,
+    CallbackIndex_Tick,
+    CallbackIndex_ImGui,
     CallbackIndex_Count
   };
 
-  enum AtomicState {
-    AtomicState_MtCbEnabled,
-    AtomicState_FreeOnTick,
-    AtomicState_PendingOnTick,
-    AtomicState_HandlingOnTick,
-    AtomicState_PendingOnImGui,
-    AtomicState_HandlingOnImGui,
-    AtomicState_Count
-  };
-
   static Napi::FunctionReference constructor;
   static Napi::Object Init(Napi::Env env, Napi::Object exports);
 
@@ -73,15 +88,50 @@ public:
   Napi::Value IsOnImGuiPending(const Napi::CallbackInfo& info);
   Napi::Value SignalHandlingOnImGui(const Napi::CallbackInfo& info);
   Napi::Value UnlockOnImGui(const Napi::CallbackInfo& info);
+  Napi::Value GetTickLatencyHistogram(const Napi::CallbackInfo& info);
+  Napi::Value ResetTickLatencyHistogram(const Napi::CallbackInfo& info);
+
+  Napi::Value SaveStateToBuffer(const Napi::CallbackInfo& info);
+  Napi::Value LoadStateFromBuffer(const Napi::CallbackInfo& info);
+  Napi::Value SetStateSlotCount(const Napi::CallbackInfo& info);
+  Napi::Value GetStateSlotCount(const Napi::CallbackInfo& info);
+  Napi::Value SaveStateToSlot(const Napi::CallbackInfo& info);
+  Napi::Value LoadStateFromSlot(const Napi::CallbackInfo& info);
+  Napi::Value GetStateSlot(const Napi::CallbackInfo& info);
+
+  Napi::Value SetRewindConfig(const Napi::CallbackInfo& info);
+  Napi::Value Rewind(const Napi::CallbackInfo& info);
+  Napi::Value GetRewindStats(const Napi::CallbackInfo& info);
+
+  Napi::Value SetTurboConfig(const Napi::CallbackInfo& info);
+
+  Napi::Value ReadFramebuffer(const Napi::CallbackInfo& info);
+
+  Napi::Value StartProfiler(const Napi::CallbackInfo& info);
+  Napi::Value StopProfiler(const Napi::CallbackInfo& info);
+  Napi::Value ClearProfile(const Napi::CallbackInfo& info);
+  Napi::Value GetProfilerStats(const Napi::CallbackInfo& info);
+  Napi::Value WriteProfile(const Napi::CallbackInfo& info);
 
   Napi::Value Button(const Napi::CallbackInfo& info);
 
 private:
+  std::optional<std::chrono::microseconds> ParkForJs(Common::ParkingHandoff& handoff, CallbackIndex index);
+  void DispatchPendingToJs(Common::ParkingHandoff& handoff, u64 ticket, CallbackIndex index);
+
   QScopedPointer<QApplication> m_app;
   MainWindow* m_mw;
   Settings* m_settings;
+  bool m_headless{};
   std::array<Napi::FunctionReference, CallbackIndex_Count> m_callbacks;
-  std::array<std::atomic_bool, AtomicState_Count> m_states;
+  std::atomic_bool m_mt_callbacks_enabled{};
+  Napi::ThreadSafeFunction m_wake_js;
+  Common::ParkingHandoff m_on_tick;
+  Common::ParkingHandoff m_on_imgui;
+  // Tickets claimed through signalHandlingOnTick/signalHandlingOnImGui by a polling JS loop.
+  std::optional<u64> m_polled_on_tick;
+  std::optional<u64> m_polled_on_imgui;
+  LatencyHistogram m_tick_latency;
 };
 
 }
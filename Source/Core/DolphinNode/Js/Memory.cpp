@@ -1,18 +1,539 @@
+#include <algorithm>
+#include <array>
 #include <bitset>
+#include <cstring>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 #include <napi.h>
 
 #include "Common/BitUtils.h"
+#include "Common/Intrinsics.h"
+#include "Common/MsgHandler.h"
 
+#include "Core/Core.h"
 #include "Core/HW/AddressSpace.h"
 #include "Core/HW/Memmap.h"
+#include "Core/MemoryWatchEngine.h"
 #include "Core/PowerPC/JitInterface.h"
 
 #include "DolphinNode/Js/TypeConv.h"
 
 namespace Js::Memory {
 
+namespace Helpers {
+
+// Bit arrays are exposed to JS as one byte per bit, most significant bit first. Conversions are
+// done in chunks so the std::function accessors never need a heap-allocated staging buffer.
+constexpr u32 BIT_CHUNK_SIZE = 64;
+
+static u8 ReverseBits(u8 value) {
+  value = static_cast<u8>(((value & 0xF0) >> 4) | ((value & 0x0F) << 4));
+  value = static_cast<u8>(((value & 0xCC) >> 2) | ((value & 0x33) << 2));
+  value = static_cast<u8>(((value & 0xAA) >> 1) | ((value & 0x55) << 1));
+  return value;
+}
+
+// Expands each of the size source bytes into 8 output bytes of 0 or 1.
+static void ExpandBits(const u8* src, u8* dst, u32 size) {
+  u32 i{};
+#ifdef _M_X86
+  const __m128i bit_masks{_mm_set_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128)};
+  const __m128i ones{_mm_set1_epi8(1)};
+  for (; i + 2 <= size; i += 2) {
+    // Broadcast each source byte over 8 lanes, then test one bit per lane.
+    __m128i v{_mm_cvtsi32_si128(src[i] | (src[i + 1] << 8))};
+    v = _mm_unpacklo_epi8(v, v);
+    v = _mm_unpacklo_epi16(v, v);
+    v = _mm_unpacklo_epi32(v, v);
+    v = _mm_and_si128(_mm_cmpeq_epi8(_mm_and_si128(v, bit_masks), bit_masks), ones);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 8), v);
+  }
+#endif
+  for (; i < size; ++i) {
+    // Replicate the byte, keep bit 7-j in byte j, then fold every non-zero byte down to 1.
+    u64 v{(src[i] * 0x0101010101010101ULL) & 0x0102040810204080ULL};
+    v = ((v + 0x7F7F7F7F7F7F7F7FULL) >> 7) & 0x0101010101010101ULL;
+    std::memcpy(dst + i * 8, &v, sizeof(v));
+  }
+}
+
+// Packs size groups of 8 source bytes into size output bytes; any non-zero source byte sets its bit.
+static void PackBits(const u8* src, u8* dst, u32 size) {
+  u32 i{};
+#ifdef _M_X86
+  const __m128i zero{_mm_setzero_si128()};
+  for (; i + 2 <= size; i += 2) {
+    const __m128i v{_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 8))};
+    // movemask puts source byte j in bit j, so each half needs reversing to be MSB first.
+    const u32 mask{~static_cast<u32>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, zero)))};
+    dst[i] = ReverseBits(static_cast<u8>(mask));
+    dst[i + 1] = ReverseBits(static_cast<u8>(mask >> 8));
+  }
+#endif
+  for (; i < size; ++i) {
+    u8 value{};
+    for (u32 j{}; j < 8; ++j)
+      value |= static_cast<u8>((src[i * 8 + j] != 0) << (7 - j));
+    dst[i] = value;
+  }
+}
+
+// Bit arrays hold one Uint8Array element per bit.
+static Napi::Uint8Array AsBitArray(Napi::Env env, const Napi::Value& value) {
+  if (!value.IsTypedArray() || value.As<Napi::TypedArray>().TypedArrayType() != napi_uint8_array)
+    throw Napi::TypeError(env, Napi::String::New(env, "bit array must be a Uint8Array"));
+
+  return value.As<Napi::Uint8Array>();
+}
+
+// Returns out if the caller passed an array large enough to hold length elements, or a new array.
+static Napi::Uint8Array GetOutputArray(Napi::Env env, const Napi::Value& out, u64 length) {
+  if (length > std::numeric_limits<u32>::max())
+    throw Napi::RangeError(env, Napi::String::New(env, "bit array would be too large"));
+
+  if (out.IsUndefined())
+    return Napi::Uint8Array::New(env, static_cast<size_t>(length));
+
+  auto data{AsBitArray(env, out)};
+  if (data.ElementLength() < length)
+    throw Napi::Error(env, Napi::String::New(env, "output array is too small"));
+
+  return data;
+}
+
+// Bit offsets count from the most significant bit, so only 0-7 name a bit of the byte.
+static u32 AsBitOffset(Napi::Env env, const Napi::Value& value) {
+  const u32 bit_offset{TypeConv::AsU32(value)};
+  if (bit_offset > 7)
+    throw Napi::RangeError(env, Napi::String::New(env, "bit offset must be between 0 and 7"));
+
+  return bit_offset;
+}
+
+static Napi::Value ReadBufferU8(Napi::Env env, u32 address, u32 size, std::function<u8(u32)> read_fn) {
+  auto buf{Napi::Buffer<u8>::New(env, size)};
+  for (u32 i{}; i < size; ++i)
+    buf.Data()[i] = read_fn(address + i);
+
+  return buf;
+}
+
+static Napi::Value ReadBitU8(Napi::Env env, u32 address, u32 bit_offset, std::function<u8(u32)> read_fn) {
+  return TypeConv::FromBool(env, std::bitset<8>{read_fn(address)}.test(7 - bit_offset));
+}
+
+static Napi::Value ReadBitsU8(Napi::Env env, u32 address, const Napi::Value& out, std::function<u8(u32)> read_fn) {
+  auto data{GetOutputArray(env, out, 8)};
+
+  const u8 value{read_fn(address)};
+  ExpandBits(&value, data.Data(), 1);
+
+  return data;
+}
+
+static Napi::Value ReadBitsBufferU8(Napi::Env env, u32 address, u32 size, const Napi::Value& out, std::function<u8(u32)> read_fn) {
+  auto data{GetOutputArray(env, out, u64{size} * 8)};
+
+  std::array<u8, BIT_CHUNK_SIZE> chunk;
+  for (u32 i{}; i < size; i += BIT_CHUNK_SIZE) {
+    const u32 chunk_size{std::min(size - i, BIT_CHUNK_SIZE)};
+    for (u32 j{}; j < chunk_size; ++j)
+      chunk[j] = read_fn(address + i + j);
+
+    ExpandBits(chunk.data(), data.Data() + size_t{i} * 8, chunk_size);
+  }
+
+  return data;
+}
+
+static void WriteBufferU8(u32 address, Napi::Uint8Array data, std::function<void(u32, u8)> write_fn) {
+  const u8* values{data.Data()};
+  for (u32 i{}; i < data.ElementLength(); ++i)
+    write_fn(address + i, values[i]);
+}
+
+static void WriteBitU8(u32 address, u32 bit_offset, bool set, std::function<u8(u32)> read_fn, std::function<void(u32, u8)> write_fn) {
+  std::bitset<8> bitset{read_fn(address)};
+  bitset.set(7 - bit_offset, set);
+
+  write_fn(address, static_cast<u8>(bitset.to_ulong()));
+}
+
+static void WriteBitsU8(u32 address, Napi::Uint8Array data, std::function<void(u32, u8)> write_fn) {
+  if (data.ElementLength() < 8)
+    throw Napi::RangeError(data.Env(), Napi::String::New(data.Env(), "bit array must hold 8 elements"));
+
+  u8 value;
+  PackBits(data.Data(), &value, 1);
+
+  write_fn(address, value);
+}
+
+static void WriteBitsBufferU8(u32 address, Napi::Uint8Array data, std::function<void(u32, u8)> write_fn) {
+  if (data.ElementLength() % 8 != 0)
+    throw Napi::RangeError(data.Env(), Napi::String::New(data.Env(), "bit array length must be a multiple of 8"));
+  if (data.ElementLength() / 8 > std::numeric_limits<u32>::max())
+    throw Napi::RangeError(data.Env(), Napi::String::New(data.Env(), "bit array is too large"));
+
+  const u32 size{static_cast<u32>(data.ElementLength() / 8)};
+
+  std::array<u8, BIT_CHUNK_SIZE> chunk;
+  for (u32 i{}; i < size; i += BIT_CHUNK_SIZE) {
+    const u32 chunk_size{std::min(size - i, BIT_CHUNK_SIZE)};
+    PackBits(data.Data() + size_t{i} * 8, chunk.data(), chunk_size);
+
+    for (u32 j{}; j < chunk_size; ++j)
+      write_fn(address + i + j, chunk[j]);
+  }
+}
+
+}
+
+namespace Journal {
+
+// Writes issued between Memmap.beginBatch() and Memmap.commit() are recorded here in guest byte
+// order instead of hitting emulated memory, then applied in one pass on the CPU thread at the next
+// frame boundary so the game never observes a partially applied patch.
+struct Batch {
+  struct Write {
+    u32 address;
+    u32 size;
+    u32 data_offset;
+    // Bits of the byte to replace, for bit writes, which must not use the value the byte has
+    // before the commit. 0xFF for whole writes.
+    u8 mask;
+  };
+
+  struct ICacheRange {
+    u32 address;
+    u32 size;
+    bool forced;
+  };
+
+  std::vector<u8> data;
+  std::vector<Write> writes;
+  std::vector<ICacheRange> icache_ranges;
+};
+
+// Only touched on the JS thread.
+static std::optional<Batch> s_recording;
+
+static std::mutex s_committed_lock;
+static std::vector<Batch> s_committed;
+
+// Returns the data of a whole write of size bytes at address. Writes that continue the previous
+// one, like the bytes of a buffer written one at a time, are merged into it, as long as the merged
+// range stays within one memory region. Otherwise a single write outside of RAM would make Apply
+// drop all of the valid writes merged with it.
+static u8* Reserve(u32 address, u32 size) {
+  auto& batch{s_recording.value()};
+  const u32 data_offset{static_cast<u32>(batch.data.size())};
+  batch.data.resize(batch.data.size() + size);
+
+  if (!batch.writes.empty()) {
+    auto& last{batch.writes.back()};
+    if (last.mask == 0xFF && last.address + last.size == address && last.data_offset + last.size == data_offset &&
+        ::Memory::TryGetPointer(last.address, last.size + size)) {
+      last.size += size;
+      return batch.data.data() + data_offset;
+    }
+  }
+
+  batch.writes.push_back({address, size, data_offset, 0xFF});
+  return batch.data.data() + data_offset;
+}
+
+static void Record(u32 address, const void* data, u32 size) {
+  std::memcpy(Reserve(address, size), data, size);
+}
+
+static void Apply(Batch& batch) {
+  for (const auto& write : batch.writes) {
+    u8* ptr{::Memory::TryGetPointer(write.address, write.size)};
+    if (!ptr) {
+      PanicAlertFmt("Invalid range in batched write. {:x} bytes to {:#010x}", write.size, write.address);
+      continue;
+    }
+
+    const u8* data{batch.data.data() + write.data_offset};
+    if (write.mask == 0xFF)
+      std::memcpy(ptr, data, write.size);
+    else
+      *ptr = static_cast<u8>((*ptr & ~write.mask) | (*data & write.mask));
+  }
+
+  if (batch.icache_ranges.empty())
+    return;
+
+  // Coalesce overlapping and adjacent invalidations so each block cache walk happens once.
+  std::sort(batch.icache_ranges.begin(), batch.icache_ranges.end(),
+    [](const Batch::ICacheRange& a, const Batch::ICacheRange& b) { return a.address < b.address; });
+
+  auto merged{batch.icache_ranges.front()};
+  for (size_t i{1}; i < batch.icache_ranges.size(); ++i) {
+    const auto& range{batch.icache_ranges[i]};
+    const u64 merged_end{u64{merged.address} + merged.size};
+
+    if (range.address <= merged_end) {
+      merged.size = static_cast<u32>(std::max<u64>(merged_end, u64{range.address} + range.size) - merged.address);
+      merged.forced |= range.forced;
+    }
+    else {
+      ::JitInterface::InvalidateICache(merged.address, merged.size, merged.forced);
+      merged = range;
+    }
+  }
+
+  ::JitInterface::InvalidateICache(merged.address, merged.size, merged.forced);
+}
+
+// Called by the CPU thread from Core::OnFrameEnd, after the JS tick callback has returned.
+static void ApplyCommitted() {
+  std::vector<Batch> committed;
+  {
+    std::lock_guard lk{s_committed_lock};
+    if (s_committed.empty())
+      return;
+
+    committed.swap(s_committed);
+  }
+
+  for (auto& batch : committed)
+    Apply(batch);
+}
+
+static void Begin(Napi::Env env) {
+  if (s_recording.has_value())
+    throw Napi::Error(env, Napi::String::New(env, "a memory batch is already in progress"));
+
+  s_recording.emplace();
+}
+
+static void Commit(Napi::Env env) {
+  if (!s_recording.has_value())
+    throw Napi::Error(env, Napi::String::New(env, "no memory batch is in progress"));
+
+  Batch batch{std::move(s_recording.value())};
+  s_recording.reset();
+
+  // Only apply right away when nothing else can touch memory. While the emulation is starting,
+  // the batch waits for the first frame boundary like it does while running. While it is
+  // stopping, there won't be another frame boundary, and memory is about to go away.
+  switch (Core::GetState()) {
+  case Core::State::Paused:
+  case Core::State::Uninitialized:
+    Apply(batch);
+    return;
+  case Core::State::Stopping:
+    throw Napi::Error(env, Napi::String::New(env, "the emulation is stopping, the memory batch was dropped"));
+  default:
+    break;
+  }
+
+  std::lock_guard lk{s_committed_lock};
+  s_committed.push_back(std::move(batch));
+}
+
+static void Memset(u32 address, u8 value, u32 size) {
+  if (!s_recording.has_value())
+    return ::Memory::Memset(address, value, size);
+
+  std::memset(Reserve(address, size), value, size);
+}
+
+static void WriteBuffer(u32 address, const u8* data, u32 size) {
+  if (!s_recording.has_value())
+    return ::Memory::CopyToEmu(address, data, size);
+
+  Record(address, data, size);
+}
+
+static void WriteBit_U8(u32 address, u32 bit_offset, bool set) {
+  const u8 mask{static_cast<u8>(0x80 >> bit_offset)};
+  const u8 value{set ? mask : u8{}};
+
+  if (!s_recording.has_value())
+    return ::Memory::Write_U8(static_cast<u8>((::Memory::Read_U8(address) & ~mask) | value), address);
+
+  auto& batch{s_recording.value()};
+  batch.writes.push_back({address, 1, static_cast<u32>(batch.data.size()), mask});
+  batch.data.push_back(value);
+}
+
+static void Write_U8(u8 value, u32 address) {
+  if (!s_recording.has_value())
+    return ::Memory::Write_U8(value, address);
+
+  Record(address, &value, sizeof(value));
+}
+
+static void Write_U16(u16 value, u32 address) {
+  if (!s_recording.has_value())
+    return ::Memory::Write_U16(value, address);
+
+  const u16 swapped_value{Common::swap16(value)};
+  Record(address, &swapped_value, sizeof(swapped_value));
+}
+
+static void Write_U32(u32 value, u32 address) {
+  if (!s_recording.has_value())
+    return ::Memory::Write_U32(value, address);
+
+  const u32 swapped_value{Common::swap32(value)};
+  Record(address, &swapped_value, sizeof(swapped_value));
+}
+
+static void Write_U64(u64 value, u32 address) {
+  if (!s_recording.has_value())
+    return ::Memory::Write_U64(value, address);
+
+  const u64 swapped_value{Common::swap64(value)};
+  Record(address, &swapped_value, sizeof(swapped_value));
+}
+
+static void InvalidateICache(u32 address, u32 size, bool forced) {
+  if (!s_recording.has_value())
+    return ::JitInterface::InvalidateICache(address, size, forced);
+
+  s_recording.value().icache_ranges.push_back({address, size, forced});
+}
+
+// Drops the batch being recorded and the committed ones, so they are not applied to the next game.
+static void Clear() {
+  s_recording.reset();
+
+  std::lock_guard lk{s_committed_lock};
+  s_committed.clear();
+}
+
+}
+
+namespace Watches {
+
+// Change batches are handed from the CPU thread to the JS thread through the subscription's
+// thread-safe function. data holds the changed bytes of every change, back to back.
+struct Batch {
+  std::vector<MemoryWatchEngine::Change> changes;
+  std::vector<u32> addresses;
+  std::vector<u8> data;
+};
+
+struct Subscription {
+  MemoryWatchEngine engine;
+  Napi::ThreadSafeFunction callback;
+};
+
+static std::mutex s_lock;
+static u32 s_next_handle;
+static std::map<u32, Subscription> s_subscriptions;
+
+static void DeliverBatch(Napi::Env env, Napi::Function callback, Batch* data) {
+  std::unique_ptr<Batch> batch{data};
+
+  // The queue is drained without an environment when the subscription is released.
+  if (env == nullptr)
+    return;
+
+  auto changes{Napi::Array::New(env, batch->changes.size())};
+
+  u32 data_offset{};
+  for (size_t i{}; i < batch->changes.size(); ++i) {
+    const auto& change{batch->changes[i]};
+
+    auto obj{Napi::Object::New(env)};
+    obj.Set("index", TypeConv::FromU32(env, change.watch_id));
+    obj.Set("addr", TypeConv::FromU32(env, batch->addresses[i]));
+    obj.Set("offset", TypeConv::FromU32(env, change.offset));
+    obj.Set("data", Napi::Buffer<u8>::Copy(env, batch->data.data() + data_offset, change.size));
+    changes.Set(static_cast<u32>(i), obj);
+
+    data_offset += change.size;
+  }
+
+  callback.Call({changes});
+}
+
+// Called by the CPU thread from Core::OnFrameEnd.
+static void Step() {
+  std::lock_guard lk{s_lock};
+
+  for (auto& [handle, subscription] : s_subscriptions) {
+    const auto& changes{subscription.engine.Step()};
+    if (changes.empty())
+      continue;
+
+    auto batch{std::make_unique<Batch>()};
+    batch->changes = changes;
+    batch->addresses.reserve(changes.size());
+    for (const auto& change : changes) {
+      const u8* snapshot{subscription.engine.GetSnapshot(change.watch_id)};
+      batch->addresses.push_back(subscription.engine.GetResolvedAddress(change.watch_id) + change.offset);
+      batch->data.insert(batch->data.end(), snapshot + change.offset, snapshot + change.offset + change.size);
+    }
+
+    if (subscription.callback.NonBlockingCall(batch.get(), &DeliverBatch) == napi_ok)
+      batch.release();
+  }
+}
+
+static u32 Subscribe(Napi::Env env, Napi::Array ranges, Napi::Function callback) {
+  Subscription subscription;
+
+  for (u32 i{}; i < ranges.Length(); ++i) {
+    const auto obj{TypeConv::AsObject(ranges.Get(i))};
+
+    std::vector<u32> ptr_chain;
+    const auto ptr_chain_value{obj.Get("ptrChain")};
+    if (!ptr_chain_value.IsUndefined()) {
+      const auto offsets{TypeConv::AsArray(ptr_chain_value)};
+      for (u32 j{}; j < offsets.Length(); ++j)
+        ptr_chain.push_back(TypeConv::AsU32(offsets.Get(j)));
+    }
+
+    subscription.engine.AddWatch(TypeConv::AsU32(obj.Get("addr")), TypeConv::AsU32(obj.Get("size")), ptr_chain);
+  }
+
+  subscription.callback = Napi::ThreadSafeFunction::New(env, callback, "MemmapWatch", 0, 1);
+  subscription.callback.Unref(env);
+
+  std::lock_guard lk{s_lock};
+  const u32 handle{s_next_handle++};
+  s_subscriptions.emplace(handle, std::move(subscription));
+
+  return handle;
+}
+
+static bool Unsubscribe(u32 handle) {
+  std::lock_guard lk{s_lock};
+
+  const auto it{s_subscriptions.find(handle)};
+  if (it == s_subscriptions.end())
+    return false;
+
+  it->second.callback.Release();
+  s_subscriptions.erase(it);
+
+  return true;
+}
+
+static void Clear() {
+  std::lock_guard lk{s_lock};
+
+  for (auto& [handle, subscription] : s_subscriptions)
+    subscription.callback.Release();
+
+  s_subscriptions.clear();
+}
+
+}
+
 struct JitInterface : Napi::ObjectWrap<JitInterface> {
 
 JitInterface(const Napi::CallbackInfo& info) :
@@ -38,7 +559,7 @@ static Napi::Object Init(Napi::Env env, Napi::Object exports) {
 }
 
 static Napi::Value InvalidateICache(const Napi::CallbackInfo& info) {
-  ::JitInterface::InvalidateICache(
+  Journal::InvalidateICache(
     TypeConv::AsU32(info[0]), // address
     TypeConv::AsU32(info[1]), // size
     TypeConv::AsBool(info[2]) // forced
@@ -51,74 +572,195 @@ static Napi::Value InvalidateICache(const Napi::CallbackInfo& info) {
 
 Napi::FunctionReference JitInterface::constructor;
 
-namespace Helpers {
+namespace RamViews {
 
-static Napi::Value ReadBufferU8(Napi::Env env, u32 address, u32 size, std::function<u8(u32)> read_fn) {
-  std::vector<u8> buf(size);
-  for (u32 i{}; i < size; ++i)
-    buf[i] = read_fn(address + i);
+// Weak references to every ArrayBuffer returned by Memmap.getRamView(), so they can be
+// detached once the emulated memory they alias is torn down. Only touched on the JS thread.
+static std::vector<Napi::Reference<Napi::ArrayBuffer>> s_views;
 
-  return Napi::Buffer<u8>::Copy(env, buf.data(), buf.size());
+// Once the GC collects a buffer, its weak reference is still set but Value() is an empty handle.
+static bool IsAttached(const Napi::Reference<Napi::ArrayBuffer>& ref) {
+  if (ref.IsEmpty())
+    return false;
+
+  Napi::ArrayBuffer buffer{ref.Value()};
+  return !buffer.IsEmpty() && !buffer.IsDetached();
 }
 
-static Napi::Value ReadBitU8(Napi::Env env, u32 address, u32 bit_offset, std::function<u8(u32)> read_fn) {
-  return TypeConv::FromBool(env, std::bitset<8>{read_fn(address)}.test(7 - bit_offset));
+static Napi::Value Create(Napi::Env env, u32 physical_address, u32 size) {
+  u8* view{::Memory::CreateHostView(physical_address, size)};
+  if (!view)
+    return env.Undefined();
+
+  // The host view is a separate mapping of the same shared memory, so it remains valid (if
+  // stale) even when Memory::Shutdown releases the core's views before JS detaches this one.
+  auto buffer{Napi::ArrayBuffer::New(env, view, size, [size](Napi::Env, void* data) {
+    ::Memory::ReleaseHostView(static_cast<u8*>(data), size);
+  })};
+
+  s_views.erase(std::remove_if(s_views.begin(), s_views.end(),
+    [](const Napi::Reference<Napi::ArrayBuffer>& ref) { return !IsAttached(ref); }),
+    s_views.end());
+  s_views.emplace_back(Napi::Weak(buffer));
+
+  return Napi::DataView::New(env, buffer);
 }
 
-static Napi::Value ReadBitsU8(Napi::Env env, u32 address, std::function<u8(u32)> read_fn) {
-  auto data = Napi::Uint8Array::New(env, 8);
+static void Invalidate() {
+  for (auto& ref : s_views) {
+    if (IsAttached(ref))
+      ref.Value().Detach();
+  }
 
-  std::bitset<8> bitset{read_fn(address)};
-  for (u32 j{}; j < 8; ++j)
-    data.Set(j, TypeConv::FromU8(env, bitset.test(7 - j)));
+  // Also drops the references to buffers that were collected.
+  s_views.clear();
+}
 
-  return data;
 }
 
-static Napi::Value ReadBitsBufferU8(Napi::Env env, u32 address, u32 size, std::function<u8(u32)> read_fn) {
-  auto data = Napi::Uint8Array::New(env, size * 8);
+struct ReadPlan : Napi::ObjectWrap<ReadPlan> {
 
-  for (u32 i{}; i < size; ++i) {
-    std::bitset<8> bitset{read_fn(address + i)};
-    for (u32 j{}; j < 8; ++j)
-      data.Set(i * 8 + j, TypeConv::FromU8(env, bitset.test(7 - j)));
+enum class ValueType : u8 {
+  U8, U16, U32, S8, S16, S32, F32, F64
+};
+
+struct Entry {
+  u32 address;
+  ValueType type;
+  bool little_endian;
+  u32 ptr_chain_begin;
+  u32 ptr_chain_size;
+};
+
+std::vector<Entry> m_entries;
+std::vector<u32> m_ptr_chains;
+Napi::Reference<Napi::Float64Array> m_values;
+
+ReadPlan(const Napi::CallbackInfo& info) :
+  Napi::ObjectWrap<ReadPlan>{info}
+{
+  static const std::unordered_map<std::string, ValueType> type_map{
+    {"u8", ValueType::U8},
+    {"u16", ValueType::U16},
+    {"u32", ValueType::U32},
+    {"s8", ValueType::S8},
+    {"s16", ValueType::S16},
+    {"s32", ValueType::S32},
+    {"f32", ValueType::F32},
+    {"f64", ValueType::F64},
+  };
+
+  const auto entries{TypeConv::AsArray(info[0])};
+  m_entries.reserve(entries.Length());
+
+  for (u32 i{}; i < entries.Length(); ++i) {
+    const auto obj{TypeConv::AsObject(entries.Get(i))};
+    const auto type_it{type_map.find(TypeConv::AsStrUtf8(obj.Get("type")))};
+
+    if (type_it == type_map.end())
+      throw Napi::Error(info.Env(), Napi::String::New(info.Env(), "invalid read plan type"));
+
+    Entry entry;
+    entry.address = TypeConv::AsU32(obj.Get("addr"));
+    entry.type = type_it->second;
+    entry.little_endian = TypeConv::AsStrUtf8Or(obj.Get("endian"), "be") == "le";
+    entry.ptr_chain_begin = static_cast<u32>(m_ptr_chains.size());
+    entry.ptr_chain_size = 0;
+
+    const auto ptr_chain{obj.Get("ptrChain")};
+    if (!ptr_chain.IsUndefined()) {
+      const auto offsets{TypeConv::AsArray(ptr_chain)};
+      for (u32 j{}; j < offsets.Length(); ++j)
+        m_ptr_chains.push_back(TypeConv::AsU32(offsets.Get(j)));
+      entry.ptr_chain_size = offsets.Length();
+    }
+
+    m_entries.push_back(entry);
   }
 
-  return data;
+  m_values = Napi::Persistent(Napi::Float64Array::New(info.Env(), m_entries.size()));
 }
 
-static void WriteBufferU8(u32 address, Napi::Uint8Array data, std::function<void(u32, u8)> write_fn) {
-  for (u32 i{}; i < data.ElementLength(); ++i)
-    write_fn(address + i, TypeConv::AsU8(data.Get(i)));
-}
+static Napi::FunctionReference constructor;
 
-static void WriteBitU8(u32 address, u32 bit_offset, bool set, std::function<u8(u32)> read_fn, std::function<void(u32, u8)> write_fn) {
-  std::bitset<8> bitset{read_fn(address)};
-  bitset.set(7 - bit_offset, set);
+static Napi::Object Init(Napi::Env env, Napi::Object exports) {
+  Napi::HandleScope scope{env};
 
-  write_fn(address, static_cast<u8>(bitset.to_ulong()));
+  Napi::Function func =
+  DefineClass(env, "ReadPlan", {
+    InstanceAccessor("length", &ReadPlan::GetLength, nullptr),
+    InstanceMethod("execute", &ReadPlan::Execute)
+  });
+
+  constructor = Napi::Persistent(func);
+  constructor.SuppressDestruct();
+
+  exports.Set("ReadPlan", func);
+
+  return exports;
 }
 
-static void WriteBitsU8(u32 address, Napi::Uint8Array data, std::function<void(u32, u8)> write_fn) {
-  std::bitset<8> bitset;
-  for (u32 j{}; j < 8; ++j)
-    bitset.set(7 - j, TypeConv::ToBool(data.Get(j)));
+// Follows the pointer chain the same way Memmap.readPtr* does: each step dereferences the current
+// address and adds the next offset. Returns nullptr if any step leaves MEM1/MEM2.
+const u8* Resolve(const Entry& entry, u32 size) const {
+  u32 address{entry.address};
+  for (u32 i{}; i < entry.ptr_chain_size; ++i) {
+    const u8* ptr{::Memory::TryGetPointer(address, sizeof(u32))};
+    if (!ptr)
+      return nullptr;
 
-  write_fn(address, static_cast<u8>(bitset.to_ulong()));
+    address = Common::swap32(ptr) + m_ptr_chains[entry.ptr_chain_begin + i];
+  }
+
+  return ::Memory::TryGetPointer(address, size);
 }
 
-static void WriteBitsBufferU8(u32 address, Napi::Uint8Array data, std::function<void(u32, u8)> write_fn) {
-  for (u32 i{}; i < data.ElementLength() / 8; ++i) {
-    std::bitset<8> bitset;
-    for (u32 j{}; j < 8; ++j)
-      bitset.set(7 - j, TypeConv::ToBool(data.Get(i * 8 + j)));
+double ReadEntry(const Entry& entry) const {
+  static constexpr std::array<u32, 8> type_sizes{1, 2, 4, 1, 2, 4, 4, 8};
+
+  const u8* ptr{Resolve(entry, type_sizes[static_cast<size_t>(entry.type)])};
+  if (!ptr)
+    return std::numeric_limits<double>::quiet_NaN();
+
+  const auto read16 = [&] { u16 v; std::memcpy(&v, ptr, sizeof(v)); return entry.little_endian ? v : Common::swap16(v); };
+  const auto read32 = [&] { u32 v; std::memcpy(&v, ptr, sizeof(v)); return entry.little_endian ? v : Common::swap32(v); };
+  const auto read64 = [&] { u64 v; std::memcpy(&v, ptr, sizeof(v)); return entry.little_endian ? v : Common::swap64(v); };
 
-    write_fn(address + i, static_cast<u8>(bitset.to_ulong()));
+  switch (entry.type) {
+  case ValueType::U8: return *ptr;
+  case ValueType::U16: return read16();
+  case ValueType::U32: return read32();
+  case ValueType::S8: return static_cast<s8>(*ptr);
+  case ValueType::S16: return static_cast<s16>(read16());
+  case ValueType::S32: return static_cast<s32>(read32());
+  case ValueType::F32: return Common::BitCast<float>(read32());
+  case ValueType::F64: return Common::BitCast<double>(read64());
   }
+
+  return std::numeric_limits<double>::quiet_NaN();
 }
 
+Napi::Value GetLength(const Napi::CallbackInfo& info) {
+  return TypeConv::FromU32(info.Env(), static_cast<u32>(m_entries.size()));
 }
 
+Napi::Value Execute(const Napi::CallbackInfo& info) {
+  auto values{info[0].IsUndefined() ? m_values.Value() : info[0].As<Napi::Float64Array>()};
+
+  if (values.ElementLength() < m_entries.size())
+    throw Napi::Error(info.Env(), Napi::String::New(info.Env(), "read plan output array is too small"));
+
+  double* data{values.Data()};
+  for (size_t i{}; i < m_entries.size(); ++i)
+    data[i] = ReadEntry(m_entries[i]);
+
+  return values;
+}
+
+};
+
+Napi::FunctionReference ReadPlan::constructor;
+
 struct Memmap : Napi::ObjectWrap<Memmap> {
 
 Memmap(const Napi::CallbackInfo& info) :
@@ -133,6 +775,12 @@ static Napi::Object Init(Napi::Env env, Napi::Object exports) {
   Napi::Function func =
   DefineClass(env, "Memmap", {
     StaticMethod("memset", &Memmap::Memset),
+    StaticMethod("getRamView", &Memmap::GetRamView),
+    StaticMethod("compileReadPlan", &Memmap::CompileReadPlan),
+    StaticMethod("beginBatch", &Memmap::BeginBatch),
+    StaticMethod("commit", &Memmap::Commit),
+    StaticMethod("watch", &Memmap::Watch),
+    StaticMethod("unwatch", &Memmap::Unwatch),
 
     StaticMethod("readU8", &Memmap::ReadU8),
     StaticMethod("readU16LE", &Memmap::ReadU16LE),
@@ -221,7 +869,7 @@ static Napi::Object Init(Napi::Env env, Napi::Object exports) {
 }
 
 static Napi::Value Memset(const Napi::CallbackInfo& info) {
-  ::Memory::Memset(
+  Journal::Memset(
     TypeConv::AsU32(info[0]), // address
     TypeConv::AsU8(info[1]),  // value
     TypeConv::AsU32(info[2])  // size
@@ -230,6 +878,49 @@ static Napi::Value Memset(const Napi::CallbackInfo& info) {
   return info.Env().Undefined();
 }
 
+static Napi::Value GetRamView(const Napi::CallbackInfo& info) {
+  if (!::Memory::IsInitialized())
+    return info.Env().Undefined();
+
+  auto views{Napi::Object::New(info.Env())};
+  views.Set("mem1", RamViews::Create(info.Env(), 0x00000000, ::Memory::GetRamSizeReal()));
+  if (::Memory::m_pEXRAM)
+    views.Set("mem2", RamViews::Create(info.Env(), 0x10000000, ::Memory::GetExRamSizeReal()));
+
+  return views;
+}
+
+static Napi::Value CompileReadPlan(const Napi::CallbackInfo& info) {
+  return ReadPlan::constructor.New({
+    TypeConv::AsArray(info[0]) // entries
+  });
+}
+
+static Napi::Value BeginBatch(const Napi::CallbackInfo& info) {
+  Journal::Begin(info.Env());
+
+  return info.Env().Undefined();
+}
+
+static Napi::Value Commit(const Napi::CallbackInfo& info) {
+  Journal::Commit(info.Env());
+
+  return info.Env().Undefined();
+}
+
+static Napi::Value Watch(const Napi::CallbackInfo& info) {
+  return TypeConv::FromU32(info.Env(), Watches::Subscribe(info.Env(),
+    TypeConv::AsArray(info[0]),  // ranges
+    info[1].As<Napi::Function>() // callback
+  ));
+}
+
+static Napi::Value Unwatch(const Napi::CallbackInfo& info) {
+  return TypeConv::FromBool(info.Env(), Watches::Unsubscribe(
+    TypeConv::AsU32(info[0]) // handle
+  ));
+}
+
 static Napi::Value ReadU8(const Napi::CallbackInfo& info) {
   return TypeConv::FromU8(info.Env(), ::Memory::Read_U8(
     TypeConv::AsU32(info[0]) // address
@@ -348,8 +1039,8 @@ static Napi::Value ReadBufferU8(const Napi::CallbackInfo& info) {
 
 static Napi::Value ReadBitU8(const Napi::CallbackInfo& info) {
   return Helpers::ReadBitU8(info.Env(),
-    TypeConv::AsU32(info[0]), // address
-    TypeConv::AsU32(info[1]), // bit_offset
+    TypeConv::AsU32(info[0]),                  // address
+    Helpers::AsBitOffset(info.Env(), info[1]), // bit_offset
     [](u32 address) { return ::Memory::Read_U8(address); }
   );
 }
@@ -357,6 +1048,7 @@ static Napi::Value ReadBitU8(const Napi::CallbackInfo& info) {
 static Napi::Value ReadBitsU8(const Napi::CallbackInfo& info) {
   return Helpers::ReadBitsU8(info.Env(),
     TypeConv::AsU32(info[0]), // address
+    info[1],                  // out
     [](u32 address) { return ::Memory::Read_U8(address); }
   );
 }
@@ -365,12 +1057,13 @@ static Napi::Value ReadBitsBufferU8(const Napi::CallbackInfo& info) {
   return Helpers::ReadBitsBufferU8(info.Env(),
     TypeConv::AsU32(info[0]), // address
     TypeConv::AsU32(info[1]), // size
+    info[2],                  // out
     [](u32 address) { return ::Memory::Read_U8(address); }
   );
 }
 
 static Napi::Value WriteU8(const Napi::CallbackInfo& info) {
-  ::Memory::Write_U8(
+  Journal::Write_U8(
     TypeConv::AsU8(info[1]), // value
     TypeConv::AsU32(info[0]) // address
   );
@@ -379,7 +1072,7 @@ static Napi::Value WriteU8(const Napi::CallbackInfo& info) {
 }
 
 static Napi::Value WriteU16LE(const Napi::CallbackInfo& info) {
-  ::Memory::Write_U16(
+  Journal::Write_U16(
     Common::swap16(TypeConv::AsU16(info[1])), // value
     TypeConv::AsU32(info[0])                  // address
   );
@@ -388,7 +1081,7 @@ static Napi::Value WriteU16LE(const Napi::CallbackInfo& info) {
 }
 
 static Napi::Value WriteU32LE(const Napi::CallbackInfo& info) {
-  ::Memory::Write_U32(
+  Journal::Write_U32(
     Common::swap32(TypeConv::AsU32(info[1])), // value
     TypeConv::AsU32(info[0])                  // address
   );
@@ -397,7 +1090,7 @@ static Napi::Value WriteU32LE(const Napi::CallbackInfo& info) {
 }
 
 static Napi::Value WriteU64LE(const Napi::CallbackInfo& info) {
-  ::Memory::Write_U64(
+  Journal::Write_U64(
     Common::swap64(TypeConv::AsU64(info[1])), // value
     TypeConv::AsU32(info[0])                  // address
   );
@@ -406,7 +1099,7 @@ static Napi::Value WriteU64LE(const Napi::CallbackInfo& info) {
 }
 
 static Napi::Value WriteF32LE(const Napi::CallbackInfo& info) {
-  ::Memory::Write_U32(
+  Journal::Write_U32(
     Common::swap32(Common::BitCast<u32>(TypeConv::AsF32(info[1]))), // value
     TypeConv::AsU32(info[0])                                        // address
   );
@@ -415,7 +1108,7 @@ static Napi::Value WriteF32LE(const Napi::CallbackInfo& info) {
 }
 
 static Napi::Value WriteF64LE(const Napi::CallbackInfo& info) {
-  ::Memory::Write_U64(
+  Journal::Write_U64(
     Common::swap64(Common::BitCast<u64>(TypeConv::AsF64(info[1]))), // value
     TypeConv::AsU32(info[0])                                        // address
   );
@@ -424,7 +1117,7 @@ static Napi::Value WriteF64LE(const Napi::CallbackInfo& info) {
 }
 
 static Napi::Value WriteU16BE(const Napi::CallbackInfo& info) {
-  ::Memory::Write_U16(
+  Journal::Write_U16(
     TypeConv::AsU16(info[1]), // value
     TypeConv::AsU32(info[0])  // address
   );
@@ -433,7 +1126,7 @@ static Napi::Value WriteU16BE(const Napi::CallbackInfo& info) {
 }
 
 static Napi::Value WriteU32BE(const Napi::CallbackInfo& info) {
-  ::Memory::Write_U32(
+  Journal::Write_U32(
     TypeConv::AsU32(info[1]), // value
     TypeConv::AsU32(info[0])  // address
   );
@@ -442,7 +1135,7 @@ static Napi::Value WriteU32BE(const Napi::CallbackInfo& info) {
 }
 
 static Napi::Value WriteU64BE(const Napi::CallbackInfo& info) {
-  ::Memory::Write_U64(
+  Journal::Write_U64(
     TypeConv::AsU64(info[1]), // value
     TypeConv::AsU32(info[0])  // address
   );
@@ -451,7 +1144,7 @@ static Napi::Value WriteU64BE(const Napi::CallbackInfo& info) {
 }
 
 static Napi::Value WriteF32BE(const Napi::CallbackInfo& info) {
-  ::Memory::Write_U32(
+  Journal::Write_U32(
     Common::BitCast<u32>(TypeConv::AsF32(info[1])), // value
     TypeConv::AsU32(info[0])                        // address
   );
@@ -460,7 +1153,7 @@ static Napi::Value WriteF32BE(const Napi::CallbackInfo& info) {
 }
 
 static Napi::Value WriteF64BE(const Napi::CallbackInfo& info) {
-  ::Memory::Write_U64(
+  Journal::Write_U64(
     Common::BitCast<u64>(TypeConv::AsF64(info[1])), // value
     TypeConv::AsU32(info[0])                        // address
   );
@@ -469,22 +1162,17 @@ static Napi::Value WriteF64BE(const Napi::CallbackInfo& info) {
 }
 
 static Napi::Value WriteBufferU8(const Napi::CallbackInfo& info) {
-  Helpers::WriteBufferU8(
-    TypeConv::AsU32(info[0]),       // address
-    info[1].As<Napi::Uint8Array>(), // data
-    [](u32 address, u8 value) { ::Memory::Write_U8(value, address); }
-  );
+  const auto data{info[1].As<Napi::Uint8Array>()};
+  Journal::WriteBuffer(TypeConv::AsU32(info[0]), data.Data(), static_cast<u32>(data.ElementLength()));
 
   return info.Env().Undefined();
 }
 
 static Napi::Value WriteBitU8(const Napi::CallbackInfo& info) {
-  Helpers::WriteBitU8(
-    TypeConv::AsU32(info[0]),  // address
-    TypeConv::AsU32(info[1]),  // bit_offset
-    TypeConv::AsBool(info[2]), // set
-    [](u32 address) { return ::Memory::Read_U8(address); },
-    [](u32 address, u8 value) { ::Memory::Write_U8(value, address); }
+  Journal::WriteBit_U8(
+    TypeConv::AsU32(info[0]),                  // address
+    Helpers::AsBitOffset(info.Env(), info[1]), // bit_offset
+    TypeConv::AsBool(info[2])                  // set
   );
 
   return info.Env().Undefined();
@@ -492,9 +1180,9 @@ static Napi::Value WriteBitU8(const Napi::CallbackInfo& info) {
 
 static Napi::Value WriteBitsU8(const Napi::CallbackInfo& info) {
   Helpers::WriteBitsU8(
-    TypeConv::AsU32(info[0]),       // address
-    info[1].As<Napi::Uint8Array>(), // data
-    [](u32 address, u8 value) { ::Memory::Write_U8(value, address); }
+    TypeConv::AsU32(info[0]),                // address
+    Helpers::AsBitArray(info.Env(), info[1]), // data
+    [](u32 address, u8 value) { Journal::Write_U8(value, address); }
   );
 
   return info.Env().Undefined();
@@ -502,9 +1190,9 @@ static Napi::Value WriteBitsU8(const Napi::CallbackInfo& info) {
 
 static Napi::Value WriteBitsBufferU8(const Napi::CallbackInfo& info) {
   Helpers::WriteBitsBufferU8(
-    TypeConv::AsU32(info[0]),       // address
-    info[1].As<Napi::Uint8Array>(), // data
-    [](u32 address, u8 value) { ::Memory::Write_U8(value, address); }
+    TypeConv::AsU32(info[0]),                // address
+    Helpers::AsBitArray(info.Env(), info[1]), // data
+    [](u32 address, u8 value) { Journal::Write_U8(value, address); }
   );
 
   return info.Env().Undefined();
@@ -640,8 +1328,8 @@ static Napi::Value ReadPtrBufferU8(const Napi::CallbackInfo& info) {
 
 static Napi::Value ReadPtrBitU8(const Napi::CallbackInfo& info) {
   return Helpers::ReadBitU8(info.Env(),
-    DerefPtrOffset(info),     // address
-    TypeConv::AsU32(info[2]), // bit_offset
+    DerefPtrOffset(info),                      // address
+    Helpers::AsBitOffset(info.Env(), info[2]), // bit_offset
     [](u32 address) { return ::Memory::Read_U8(address); }
   );
 }
@@ -649,6 +1337,7 @@ static Napi::Value ReadPtrBitU8(const Napi::CallbackInfo& info) {
 static Napi::Value ReadPtrBitsU8(const Napi::CallbackInfo& info) {
   return Helpers::ReadBitsU8(info.Env(),
     DerefPtrOffset(info), // address
+    info[2],              // out
     [](u32 address) { return ::Memory::Read_U8(address); }
   );
 }
@@ -657,12 +1346,13 @@ static Napi::Value ReadPtrBitsBufferU8(const Napi::CallbackInfo& info) {
   return Helpers::ReadBitsBufferU8(info.Env(),
     DerefPtrOffset(info),     // address
     TypeConv::AsU32(info[2]), // size
+    info[3],                  // out
     [](u32 address) { return ::Memory::Read_U8(address); }
   );
 }
 
 static Napi::Value WritePtrU8(const Napi::CallbackInfo& info) {
-  ::Memory::Write_U8(
+  Journal::Write_U8(
     TypeConv::AsU8(info[2]), // value
     DerefPtrOffset(info)     // address
   );
@@ -671,7 +1361,7 @@ static Napi::Value WritePtrU8(const Napi::CallbackInfo& info) {
 }
 
 static Napi::Value WritePtrU16LE(const Napi::CallbackInfo& info) {
-  ::Memory::Write_U16(
+  Journal::Write_U16(
     Common::swap16(TypeConv::AsU16(info[2])), // value
     DerefPtrOffset(info)                      // address
   );
@@ -680,7 +1370,7 @@ static Napi::Value WritePtrU16LE(const Napi::CallbackInfo& info) {
 }
 
 static Napi::Value WritePtrU32LE(const Napi::CallbackInfo& info) {
-  ::Memory::Write_U32(
+  Journal::Write_U32(
     Common::swap32(TypeConv::AsU32(info[2])), // value
     DerefPtrOffset(info)                      // address
   );
@@ -689,7 +1379,7 @@ static Napi::Value WritePtrU32LE(const Napi::CallbackInfo& info) {
 }
 
 static Napi::Value WritePtrU64LE(const Napi::CallbackInfo& info) {
-  ::Memory::Write_U64(
+  Journal::Write_U64(
     Common::swap64(TypeConv::AsU64(info[2])), // value
     DerefPtrOffset(info)                      // address
   );
@@ -698,7 +1388,7 @@ static Napi::Value WritePtrU64LE(const Napi::CallbackInfo& info) {
 }
 
 static Napi::Value WritePtrF32LE(const Napi::CallbackInfo& info) {
-  ::Memory::Write_U32(
+  Journal::Write_U32(
     Common::swap32(Common::BitCast<u32>(TypeConv::AsF32(info[2]))), // value
     DerefPtrOffset(info)                                            // address
   );
@@ -707,7 +1397,7 @@ static Napi::Value WritePtrF32LE(const Napi::CallbackInfo& info) {
 }
 
 static Napi::Value WritePtrF64LE(const Napi::CallbackInfo& info) {
-  ::Memory::Write_U64(
+  Journal::Write_U64(
     Common::swap64(Common::BitCast<u64>(TypeConv::AsF64(info[2]))), // value
     DerefPtrOffset(info)                                            // address
   );
@@ -716,7 +1406,7 @@ static Napi::Value WritePtrF64LE(const Napi::CallbackInfo& info) {
 }
 
 static Napi::Value WritePtrU16BE(const Napi::CallbackInfo& info) {
-  ::Memory::Write_U16(
+  Journal::Write_U16(
     TypeConv::AsU16(info[2]), // value
     DerefPtrOffset(info)      // address
   );
@@ -725,7 +1415,7 @@ static Napi::Value WritePtrU16BE(const Napi::CallbackInfo& info) {
 }
 
 static Napi::Value WritePtrU32BE(const Napi::CallbackInfo& info) {
-  ::Memory::Write_U32(
+  Journal::Write_U32(
     TypeConv::AsU32(info[2]), // value
     DerefPtrOffset(info)      // address
   );
@@ -734,7 +1424,7 @@ static Napi::Value WritePtrU32BE(const Napi::CallbackInfo& info) {
 }
 
 static Napi::Value WritePtrU64BE(const Napi::CallbackInfo& info) {
-  ::Memory::Write_U64(
+  Journal::Write_U64(
     TypeConv::AsU64(info[2]), // value
     DerefPtrOffset(info)      // address
   );
@@ -743,7 +1433,7 @@ static Napi::Value WritePtrU64BE(const Napi::CallbackInfo& info) {
 }
 
 static Napi::Value WritePtrF32BE(const Napi::CallbackInfo& info) {
-  ::Memory::Write_U32(
+  Journal::Write_U32(
     Common::BitCast<u32>(TypeConv::AsF32(info[2])), // value
     DerefPtrOffset(info)                            // address
   );
@@ -752,7 +1442,7 @@ static Napi::Value WritePtrF32BE(const Napi::CallbackInfo& info) {
 }
 
 static Napi::Value WritePtrF64BE(const Napi::CallbackInfo& info) {
-  ::Memory::Write_U64(
+  Journal::Write_U64(
     Common::BitCast<u64>(TypeConv::AsF64(info[2])), // value
     DerefPtrOffset(info)                            // address
   );
@@ -761,22 +1451,17 @@ static Napi::Value WritePtrF64BE(const Napi::CallbackInfo& info) {
 }
 
 static Napi::Value WritePtrBufferU8(const Napi::CallbackInfo& info) {
-  Helpers::WriteBufferU8(
-    DerefPtrOffset(info),           // address
-    info[2].As<Napi::Uint8Array>(), // data
-    [](u32 address, u8 value) { ::Memory::Write_U8(value, address); }
-  );
+  const auto data{info[2].As<Napi::Uint8Array>()};
+  Journal::WriteBuffer(DerefPtrOffset(info), data.Data(), static_cast<u32>(data.ElementLength()));
 
   return info.Env().Undefined();
 }
 
 static Napi::Value WritePtrBitU8(const Napi::CallbackInfo& info) {
-  Helpers::WriteBitU8(
-    DerefPtrOffset(info),      // address
-    TypeConv::AsU32(info[2]),  // bit_offset
-    TypeConv::AsBool(info[3]), // set
-    [](u32 address) { return ::Memory::Read_U8(address); },
-    [](u32 address, u8 value) { ::Memory::Write_U8(value, address); }
+  Journal::WriteBit_U8(
+    DerefPtrOffset(info),                      // address
+    Helpers::AsBitOffset(info.Env(), info[2]), // bit_offset
+    TypeConv::AsBool(info[3])                  // set
   );
 
   return info.Env().Undefined();
@@ -784,9 +1469,9 @@ static Napi::Value WritePtrBitU8(const Napi::CallbackInfo& info) {
 
 static Napi::Value WritePtrBitsU8(const Napi::CallbackInfo& info) {
   Helpers::WriteBitsU8(
-    DerefPtrOffset(info),           // address
-    info[2].As<Napi::Uint8Array>(), // data
-    [](u32 address, u8 value) { ::Memory::Write_U8(value, address); }
+    DerefPtrOffset(info),                     // address
+    Helpers::AsBitArray(info.Env(), info[2]), // data
+    [](u32 address, u8 value) { Journal::Write_U8(value, address); }
   );
 
   return info.Env().Undefined();
@@ -794,9 +1479,9 @@ static Napi::Value WritePtrBitsU8(const Napi::CallbackInfo& info) {
 
 static Napi::Value WritePtrBitsBufferU8(const Napi::CallbackInfo& info) {
   Helpers::WriteBitsBufferU8(
-    DerefPtrOffset(info),           // address
-    info[2].As<Napi::Uint8Array>(), // data
-    [](u32 address, u8 value) { ::Memory::Write_U8(value, address); }
+    DerefPtrOffset(info),                     // address
+    Helpers::AsBitArray(info.Env(), info[2]), // data
+    [](u32 address, u8 value) { Journal::Write_U8(value, address); }
   );
 
   return info.Env().Undefined();
@@ -1012,8 +1697,8 @@ Napi::Value ReadBufferU8(const Napi::CallbackInfo& info) {
 
 Napi::Value ReadBitU8(const Napi::CallbackInfo& info) {
   return Helpers::ReadBitU8(info.Env(),
-    TypeConv::AsU32(info[0]), // address
-    TypeConv::AsU32(info[1]), // bit_offset
+    TypeConv::AsU32(info[0]),                  // address
+    Helpers::AsBitOffset(info.Env(), info[1]), // bit_offset
     [this](u32 address) { return m_this->ReadU8(address); }
   );
 }
@@ -1021,6 +1706,7 @@ Napi::Value ReadBitU8(const Napi::CallbackInfo& info) {
 Napi::Value ReadBitsU8(const Napi::CallbackInfo& info) {
   return Helpers::ReadBitsU8(info.Env(),
     TypeConv::AsU32(info[0]), // address
+    info[1],                  // out
     [this](u32 address) { return m_this->ReadU8(address); }
   );
 }
@@ -1029,6 +1715,7 @@ Napi::Value ReadBitsBufferU8(const Napi::CallbackInfo& info) {
   return Helpers::ReadBitsBufferU8(info.Env(),
     TypeConv::AsU32(info[0]), // address
     TypeConv::AsU32(info[1]), // size
+    info[2],                  // out
     [this](u32 address) { return m_this->ReadU8(address); }
   );
 }
@@ -1144,9 +1831,9 @@ Napi::Value WriteBufferU8(const Napi::CallbackInfo& info) {
 
 Napi::Value WriteBitU8(const Napi::CallbackInfo& info) {
   Helpers::WriteBitU8(
-    TypeConv::AsU32(info[0]),  // address
-    TypeConv::AsU32(info[1]),  // bit_offset
-    TypeConv::AsBool(info[2]), // set
+    TypeConv::AsU32(info[0]),                  // address
+    Helpers::AsBitOffset(info.Env(), info[1]), // bit_offset
+    TypeConv::AsBool(info[2]),                 // set
     [this](u32 address) { return m_this->ReadU8(address); },
     [this](u32 address, u8 value) { m_this->WriteU8(address, value); }
   );
@@ -1156,8 +1843,8 @@ Napi::Value WriteBitU8(const Napi::CallbackInfo& info) {
 
 Napi::Value WriteBitsU8(const Napi::CallbackInfo& info) {
   Helpers::WriteBitsU8(
-    TypeConv::AsU32(info[0]),       // address
-    info[1].As<Napi::Uint8Array>(), // data
+    TypeConv::AsU32(info[0]),                // address
+    Helpers::AsBitArray(info.Env(), info[1]), // data
     [this](u32 address, u8 value) { m_this->WriteU8(address, value); }
   );
 
@@ -1166,8 +1853,8 @@ Napi::Value WriteBitsU8(const Napi::CallbackInfo& info) {
 
 Napi::Value WriteBitsBufferU8(const Napi::CallbackInfo& info) {
   Helpers::WriteBitsBufferU8(
-    TypeConv::AsU32(info[0]),       // address
-    info[1].As<Napi::Uint8Array>(), // data
+    TypeConv::AsU32(info[0]),                // address
+    Helpers::AsBitArray(info.Env(), info[1]), // data
     [this](u32 address, u8 value) { m_this->WriteU8(address, value); }
   );
 
@@ -1206,6 +1893,7 @@ Napi::Value GetAccessors(const Napi::CallbackInfo& info) {
 
 Napi::Object BuildExports(Napi::Env env, Napi::Object exports) {
   JitInterface::Init(env, exports);
+  ReadPlan::Init(env, exports);
   Memmap::Init(env, exports);
 
   auto address_space{Napi::Object::New(env)};
@@ -1216,4 +1904,21 @@ Napi::Object BuildExports(Napi::Env env, Napi::Object exports) {
   return exports;
 }
 
+void OnFrameEnd() {
+  Journal::ApplyCommitted();
+  Watches::Step();
+}
+
+void InvalidateRamViews() {
+  RamViews::Invalidate();
+}
+
+void ClearJournal() {
+  Journal::Clear();
+}
+
+void ClearWatches() {
+  Watches::Clear();
+}
+
 }
@@ -6,4 +6,19 @@ namespace Js::Memory {
 
 Napi::Object BuildExports(Napi::Env env, Napi::Object exports);
 
+// Applies committed write batches and steps the watches. Called by the CPU thread from
+// Core::OnFrameEnd.
+void OnFrameEnd();
+
+// Detaches every ArrayBuffer handed out by Memmap.getRamView(). Must be called on the JS thread.
+void InvalidateRamViews();
+
+// Drops the write batches that are not applied yet. Called when emulation stops, as they were
+// meant for the game that was running.
+void ClearJournal();
+
+// Releases every subscription made with Memmap.watch(). Called when emulation stops, as their
+// addresses belong to the game that was running.
+void ClearWatches();
+
 }
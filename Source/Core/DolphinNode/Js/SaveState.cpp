@@ -0,0 +1,278 @@
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "Core/Core.h"
+#include "Core/CoreTiming.h"
+#include "Core/State.h"
+
+#include "DolphinNode/Js/SaveState.h"
+#include "DolphinNode/Js/TypeConv.h"
+
+namespace Js::SaveState {
+
+using StateBuffer = std::vector<u8>;
+
+struct Request {
+  enum class Type {
+    Save, Load
+  };
+
+  Request(Napi::Env env, Type type_, std::optional<u32> slot_) :
+    type{type_}, slot{slot_}, deferred{Napi::Promise::Deferred::New(env)}
+  {}
+
+  Type type;
+  // When no slot is given, the state is saved to or loaded from buffer.
+  std::optional<u32> slot;
+  std::shared_ptr<StateBuffer> buffer;
+  bool success{};
+  Napi::Promise::Deferred deferred;
+};
+
+static Napi::ThreadSafeFunction s_complete;
+
+static std::mutex s_pending_lock;
+static std::vector<std::unique_ptr<Request>> s_pending;
+// Held while requests are served, by the CPU thread or, once the emulation is paused, by the JS
+// thread, so they always run in the order they were submitted.
+static std::mutex s_serve_lock;
+
+static std::mutex s_slots_lock;
+static std::vector<std::shared_ptr<StateBuffer>> s_slots(State::NUM_STATES);
+static u32 s_next_slot;
+// Slot saves are written here without holding s_slots_lock, then swapped into the slot, which
+// keeps its previous state until the new one is complete. Both the CPU thread and the JS thread
+// serve requests, so it is only touched while holding s_serve_lock.
+static std::shared_ptr<StateBuffer> s_spare_slot;
+
+static Napi::Object MakeError(Napi::Env env, const char* message) {
+  return Napi::Error(env, Napi::String::New(env, message)).Value();
+}
+
+// The JS buffer shares ownership of the state, so handing it out never copies it.
+static Napi::Buffer<u8> WrapBuffer(Napi::Env env, std::shared_ptr<StateBuffer> buffer) {
+  auto* hint{new std::shared_ptr<StateBuffer>{std::move(buffer)}};
+
+  return Napi::Buffer<u8>::New(env, (*hint)->data(), (*hint)->size(),
+    [](Napi::Env, u8*, std::shared_ptr<StateBuffer>* hint) { delete hint; }, hint);
+}
+
+// Runs on the CPU thread, or on the JS thread while the emulation is paused.
+static void Execute(Request& request) {
+  if (request.type == Request::Type::Save) {
+    if (!request.slot.has_value()) {
+      request.buffer = std::make_shared<StateBuffer>();
+      request.success = State::SaveToBuffer(*request.buffer);
+      return;
+    }
+
+    // Reuse the spare allocation unless JS still holds a buffer referencing it.
+    if (!s_spare_slot || s_spare_slot.use_count() != 1)
+      s_spare_slot = std::make_shared<StateBuffer>();
+
+    if (!State::SaveToBuffer(*s_spare_slot))
+      return;
+
+    std::lock_guard lk{s_slots_lock};
+    if (request.slot.value() >= s_slots.size())
+      return;
+
+    std::swap(s_slots[request.slot.value()], s_spare_slot);
+    request.success = true;
+    return;
+  }
+
+  if (request.slot.has_value()) {
+    std::lock_guard lk{s_slots_lock};
+    if (request.slot.value() < s_slots.size())
+      request.buffer = s_slots[request.slot.value()];
+  }
+
+  request.success = request.buffer && State::LoadFromBuffer(*request.buffer);
+}
+
+static void Settle(Napi::Env env, Request& request) {
+  if (!request.success) {
+    request.deferred.Reject(MakeError(env, request.type == Request::Type::Save ?
+      "the state could not be saved" : "the state could not be loaded"));
+  }
+  else if (request.type == Request::Type::Load) {
+    request.deferred.Resolve(env.Undefined());
+  }
+  else if (request.slot.has_value()) {
+    request.deferred.Resolve(TypeConv::FromU32(env, request.slot.value()));
+  }
+  else {
+    request.deferred.Resolve(WrapBuffer(env, std::move(request.buffer)));
+  }
+}
+
+static void DeliverResult(Napi::Env env, Napi::Function, Request* data) {
+  std::unique_ptr<Request> request{data};
+
+  // The queue is drained without an environment when the function is released.
+  if (env == nullptr)
+    return;
+
+  Settle(env, *request);
+}
+
+static Napi::Promise Submit(Napi::Env env, std::unique_ptr<Request> request) {
+  const auto promise{request->deferred.Promise()};
+
+  switch (Core::GetState()) {
+  case Core::State::Running: {
+    std::lock_guard lk{s_pending_lock};
+    s_pending.push_back(std::move(request));
+    break;
+  }
+  case Core::State::Paused: {
+    // Without a running CPU thread there is no frame boundary to wait for. Requests queued before
+    // the pause are served first, so none of them runs on top of this one later.
+    std::lock_guard serve_lk{s_serve_lock};
+
+    std::vector<std::unique_ptr<Request>> pending;
+    {
+      std::lock_guard lk{s_pending_lock};
+      pending.swap(s_pending);
+    }
+    pending.push_back(std::move(request));
+
+    for (auto& queued : pending) {
+      Execute(*queued);
+      Settle(env, *queued);
+    }
+    break;
+  }
+  default:
+    request->deferred.Reject(MakeError(env, "emulation is not running"));
+    break;
+  }
+
+  return promise;
+}
+
+void Init(Napi::Env env) {
+  s_complete = Napi::ThreadSafeFunction::New(env, Napi::Function::New(env, [](const Napi::CallbackInfo&) {}), "DolphinSaveState", 0, 1);
+  s_complete.Unref(env);
+}
+
+void Shutdown() {
+  CancelPending();
+  s_complete.Release();
+  s_spare_slot.reset();
+}
+
+static void ServePending() {
+  // The JS thread is already serving the queue, as the emulation was paused meanwhile. Waiting for
+  // it could deadlock, since it may need the CPU thread to save or load the state.
+  std::unique_lock serve_lk{s_serve_lock, std::try_to_lock};
+  if (!serve_lk.owns_lock())
+    return;
+
+  std::vector<std::unique_ptr<Request>> pending;
+  {
+    std::lock_guard lk{s_pending_lock};
+    pending.swap(s_pending);
+  }
+
+  for (auto& request : pending) {
+    Execute(*request);
+
+    if (s_complete.NonBlockingCall(request.get(), &DeliverResult) == napi_ok)
+      request.release();
+  }
+}
+
+void OnFrameEnd() {
+  {
+    std::lock_guard lk{s_pending_lock};
+    if (s_pending.empty())
+      return;
+  }
+
+  // This runs inside the VI event: a state saved here would lack the VI event, and loading one
+  // would replace the event queue while CoreTiming walks it.
+  CoreTiming::RunBetweenSlices(&ServePending);
+}
+
+void CancelPending() {
+  std::vector<std::unique_ptr<Request>> pending;
+  {
+    std::lock_guard lk{s_pending_lock};
+    pending.swap(s_pending);
+  }
+
+  for (auto& request : pending)
+    request->deferred.Reject(MakeError(request->deferred.Env(), "emulation stopped before the request was served"));
+}
+
+Napi::Promise SaveToBuffer(Napi::Env env) {
+  return Submit(env, std::make_unique<Request>(env, Request::Type::Save, std::nullopt));
+}
+
+Napi::Promise LoadFromBuffer(Napi::Env env, const u8* data, size_t size) {
+  auto request{std::make_unique<Request>(env, Request::Type::Load, std::nullopt)};
+  request->buffer = std::make_shared<StateBuffer>(data, data + size);
+
+  return Submit(env, std::move(request));
+}
+
+void SetSlotCount(u32 count) {
+  std::lock_guard lk{s_slots_lock};
+  s_slots.resize(count);
+
+  if (s_next_slot >= count)
+    s_next_slot = 0;
+}
+
+u32 GetSlotCount() {
+  std::lock_guard lk{s_slots_lock};
+  return static_cast<u32>(s_slots.size());
+}
+
+Napi::Promise SaveToSlot(Napi::Env env, std::optional<u32> slot) {
+  {
+    std::lock_guard lk{s_slots_lock};
+
+    if (!slot.has_value()) {
+      if (s_slots.empty())
+        throw Napi::Error(env, Napi::String::New(env, "no state slots are available"));
+
+      slot = s_next_slot;
+      s_next_slot = (s_next_slot + 1) % static_cast<u32>(s_slots.size());
+    }
+    else if (slot.value() >= s_slots.size()) {
+      throw Napi::Error(env, Napi::String::New(env, "invalid state slot"));
+    }
+  }
+
+  return Submit(env, std::make_unique<Request>(env, Request::Type::Save, slot));
+}
+
+Napi::Promise LoadFromSlot(Napi::Env env, u32 slot) {
+  {
+    std::lock_guard lk{s_slots_lock};
+    if (slot >= s_slots.size())
+      throw Napi::Error(env, Napi::String::New(env, "invalid state slot"));
+  }
+
+  return Submit(env, std::make_unique<Request>(env, Request::Type::Load, slot));
+}
+
+Napi::Value GetSlot(Napi::Env env, u32 slot) {
+  std::shared_ptr<StateBuffer> buffer;
+  {
+    std::lock_guard lk{s_slots_lock};
+    if (slot < s_slots.size())
+      buffer = s_slots[slot];
+  }
+
+  if (!buffer)
+    return env.Undefined();
+
+  return WrapBuffer(env, std::move(buffer));
+}
+
+}
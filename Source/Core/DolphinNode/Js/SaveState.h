@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstddef>
+#include <optional>
+
+#include <napi.h>
+
+#include "Common/CommonTypes.h"
+
+namespace Js::SaveState {
+
+// Uncompressed in-memory save states. While the core is running, requests are queued and served
+// by the CPU thread at the next frame boundary, after the JS tick callback has returned and the VI
+// event has been processed; the returned promises settle on the JS thread once that is done.
+// While the core is paused, requests are served right away on the JS thread, after the ones still
+// queued from before the pause.
+
+void Init(Napi::Env env);
+void Shutdown();
+
+// Called by the CPU thread from Core::OnFrameEnd.
+void OnFrameEnd();
+
+// Rejects every request that has not been served yet. Must be called on the JS thread.
+void CancelPending();
+
+Napi::Promise SaveToBuffer(Napi::Env env);
+Napi::Promise LoadFromBuffer(Napi::Env env, const u8* data, size_t size);
+
+// Slots form a ring: saving without an explicit slot overwrites the oldest one.
+void SetSlotCount(u32 count);
+u32 GetSlotCount();
+Napi::Promise SaveToSlot(Napi::Env env, std::optional<u32> slot);
+Napi::Promise LoadFromSlot(Napi::Env env, u32 slot);
+// Returns the contents of a slot without copying them, or undefined if the slot is empty.
+Napi::Value GetSlot(Napi::Env env, u32 slot);
+
+}
@@ -14,6 +14,7 @@
 
 #include "DolphinNode/Js/Frontend.h"
 #include "DolphinNode/Js/Memory.h"
+#include "DolphinNode/Js/SaveState.h"
 #include "DolphinNode/QtUtils/ModalMessageBox.h"
 #include "DolphinNode/QtUtils/RunOnObject.h"
 
@@ -79,6 +80,12 @@ bool QtMsgAlertHandler(const char* caption, const char* text, bool yes_no,
 }
 
 Napi::Object ModuleEntryPoint(Napi::Env env, Napi::Object exports) {
+  // Memory goes first so states saved at the frame boundary include the writes committed by JS.
+  JsCallbacks::SetOnFrameEnd([] {
+    Js::Memory::OnFrameEnd();
+    Js::SaveState::OnFrameEnd();
+  });
+
   Js::Frontend::Init(env, exports);
   Js::Memory::BuildExports(env, exports);
 
@@ -151,6 +151,8 @@ static WindowSystemType GetWindowSystemType()
     return WindowSystemType::X11;
   else if (platform_name == QStringLiteral("wayland"))
     return WindowSystemType::Wayland;
+  else if (platform_name == QStringLiteral("offscreen"))
+    return WindowSystemType::Headless;
 
   ModalMessageBox::critical(
       nullptr, QStringLiteral("Error"),
@@ -954,12 +956,16 @@ void MainWindow::StartGame(std::unique_ptr<BootParameters>&& parameters)
     return;
   }
 
-  // We need the render widget before booting.
-  ShowRenderWidget();
+  // We need the render widget before booting, unless the backend renders offscreen.
+  WindowSystemInfo wsi;
+  if (!m_js_headless)
+  {
+    ShowRenderWidget();
+    wsi = GetWindowSystemInfo(m_render_widget->windowHandle());
+  }
 
   // Boot up, show an error if it fails to load the game.
-  if (!BootManager::BootCore(std::move(parameters),
-                             GetWindowSystemInfo(m_render_widget->windowHandle())))
+  if (!BootManager::BootCore(std::move(parameters), wsi))
   {
     ModalMessageBox::critical(this, tr("Error"), tr("Failed to init core"), QMessageBox::Ok);
     HideRenderWidget();
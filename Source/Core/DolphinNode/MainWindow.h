@@ -81,9 +81,12 @@ signals:
 
 private:
   bool m_js_exit_requested{};
+  bool m_js_headless{};
 
 public:
   bool JsIsExitRequested() { return m_js_exit_requested; }
+  // Boots without showing the render widget, rendering to an offscreen surface.
+  void JsSetHeadless(bool headless) { m_js_headless = headless; }
 
   void Open();
   void RefreshGameList();
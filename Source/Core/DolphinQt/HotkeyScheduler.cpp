@@ -23,6 +23,7 @@
 #include "Core/HotkeyManager.h"
 #include "Core/IOS/IOS.h"
 #include "Core/IOS/USB/Bluetooth/BTBase.h"
+#include "Core/Rewind.h"
 #include "Core/State.h"
 
 #include "DolphinQt/Settings.h"
@@ -619,6 +620,10 @@ void HotkeyScheduler::Run()
 
     if (IsHotkey(HK_SAVE_STATE_FILE))
       emit StateSaveFile();
+
+    // Holding the hotkey keeps stepping back, one stored state per frame.
+    if (IsHotkey(HK_REWIND, true))
+      Rewind::RequestStepBack();
   }
 }
 
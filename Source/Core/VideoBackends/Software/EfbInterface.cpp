@@ -6,6 +6,7 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cstddef>
 #include <cstring>
 #include <vector>
@@ -23,7 +24,9 @@ namespace EfbInterface
 {
 static std::array<u8, EFB_WIDTH * EFB_HEIGHT * 6> efb;
 
-static std::array<u32, PQ_NUM_MEMBERS> perf_values;
+// Atomic, as the rasterizer may draw on several threads.
+static std::array<std::atomic<u32>, PQ_NUM_MEMBERS> perf_values;
+static std::array<std::atomic<u32>, PQ_NUM_MEMBERS> perf_quad_counters;
 
 static inline u32 GetColorOffset(u16 x, u16 y)
 {
@@ -702,12 +705,13 @@ bool ZCompare(u16 x, u16 y, u32 z)
 
 u32 GetPerfQueryResult(PerfQueryType type)
 {
-  return perf_values[type];
+  return perf_values[type].load(std::memory_order_relaxed);
 }
 
 void ResetPerfQuery()
 {
-  perf_values = {};
+  for (std::atomic<u32>& value : perf_values)
+    value.store(0, std::memory_order_relaxed);
 }
 
 void IncPerfCounterQuadCount(PerfQueryType type)
@@ -716,10 +720,8 @@ void IncPerfCounterQuadCount(PerfQueryType type)
   // Current software renderer architecture works on pixels though, so
   // we have this "quad" hack here to only increment the registers on
   // every fourth rendered pixel
-  static u32 quad[PQ_NUM_MEMBERS];
-  if (++quad[type] != 3)
+  if (perf_quad_counters[type].fetch_add(1, std::memory_order_relaxed) % 3 != 2)
     return;
-  quad[type] = 0;
-  ++perf_values[type];
+  perf_values[type].fetch_add(1, std::memory_order_relaxed);
 }
 }  // namespace EfbInterface
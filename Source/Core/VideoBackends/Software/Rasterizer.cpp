@@ -5,9 +5,18 @@
 #include "VideoBackends/Software/Rasterizer.h"
 
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <condition_variable>
 #include <cstring>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 #include "Common/CommonTypes.h"
+#include "Common/Thread.h"
 #include "VideoBackends/Software/EfbInterface.h"
 #include "VideoBackends/Software/NativeVertexFormat.h"
 #include "VideoBackends/Software/Tev.h"
@@ -21,22 +30,112 @@ namespace Rasterizer
 {
 static constexpr int BLOCK_SIZE = 2;
 
+// With more than one rasterizer thread, triangles are sorted into tiles of the EFB as they are set
+// up, and the tiles are drawn in parallel when the batch is flushed. Each tile is drawn by a single
+// thread in submission order, so every pixel of the EFB is written in the same order as when
+// drawing serially. Tiles are a multiple of the block size, so blocks never straddle two of them.
+static constexpr s32 TILE_SIZE = 32;
+static constexpr s32 TILES_X = (EFB_WIDTH + TILE_SIZE - 1) / TILE_SIZE;
+static constexpr s32 TILES_Y = (EFB_HEIGHT + TILE_SIZE - 1) / TILE_SIZE;
+
+// Batches covering fewer pixels than this are drawn by the GPU thread alone, as waking up the
+// workers would take longer.
+static constexpr s64 MIN_AREA_FOR_WORKERS = 64 * 64;
+
+// Everything the per-pixel work needs to know about a triangle.
+struct TriangleSetup
+{
+  Slope ZSlope;
+  Slope WSlope;
+  Slope ColorSlopes[2][4];
+  Slope TexSlopes[8][3];
+
+  s32 vertex0X;
+  s32 vertex0Y;
+  float vertexOffsetX;
+  float vertexOffsetY;
+
+  // Half-edge functions, in 28.4 fixed point.
+  s32 C1, C2, C3;
+  s32 DX12, DX23, DX31;
+  s32 DY12, DY23, DY31;
+
+  // Bounding rectangle, clipped to the scissor rectangle. minx and miny are aligned to blocks.
+  s32 minx, maxx, miny, maxy;
+};
+
+// State of one rasterizer thread. The Tev's lookup tables point into itself, so contexts are
+// allocated separately and never move.
+struct RasterContext
+{
+  Tev tev;
+  RasterBlock rasterBlock;
+  u32 rasterizedPixels = 0;
+};
+
+// Kept from one triangle to the next for zfreeze.
 static Slope ZSlope;
-static Slope WSlope;
-static Slope ColorSlopes[2][4];
-static Slope TexSlopes[8][3];
 
-static s32 vertex0X;
-static s32 vertex0Y;
-static float vertexOffsetX;
-static float vertexOffsetY;
+// The first context belongs to the GPU thread, the others to the workers.
+static std::vector<std::unique_ptr<RasterContext>> s_contexts;
+static std::vector<std::thread> s_workers;
+
+static std::vector<TriangleSetup> s_triangles;
+static std::array<std::vector<u32>, TILES_X * TILES_Y> s_bins;
+static std::vector<u32> s_used_tiles;
+static s64 s_binned_area;
+
+// Guards the generation, busy count and quit flag. The triangles and bins are only written by
+// the GPU thread while the workers wait, and the lock orders the accesses.
+static std::mutex s_work_lock;
+static std::condition_variable s_work_start;
+static std::condition_variable s_work_done;
+static u64 s_work_generation;
+static size_t s_busy_workers;
+static bool s_workers_quit;
+static std::atomic<size_t> s_next_tile;
+
+static void WorkerThread(size_t index);
+
+static void StopWorkers()
+{
+  {
+    std::lock_guard<std::mutex> lk(s_work_lock);
+    s_workers_quit = true;
+  }
+  s_work_start.notify_all();
+
+  for (std::thread& worker : s_workers)
+    worker.join();
+  s_workers.clear();
+  s_workers_quit = false;
+}
+
+static void CreateContexts(size_t count)
+{
+  StopWorkers();
+
+  while (s_contexts.size() > count)
+  {
+    s_contexts.back()->tev.FlushCounters();
+    s_contexts.pop_back();
+  }
+
+  while (s_contexts.size() < count)
+  {
+    auto context = std::make_unique<RasterContext>();
+    // The constant colors are set at the start of every batch.
+    context->tev.Init();
+    s_contexts.push_back(std::move(context));
+  }
 
-static Tev tev;
-static RasterBlock rasterBlock;
+  for (size_t i = 1; i < count; i++)
+    s_workers.emplace_back(WorkerThread, i);
+}
 
 void Init()
 {
-  tev.Init();
+  CreateContexts(1);
 
   // Set initial z reference plane in the unlikely case that zfreeze is enabled when drawing the
   // first primitive.
@@ -45,6 +144,18 @@ void Init()
   ZSlope.f0 = 1.f;
 }
 
+void Shutdown()
+{
+  StopWorkers();
+  s_contexts.clear();
+
+  s_triangles.clear();
+  for (u32 tile : s_used_tiles)
+    s_bins[tile].clear();
+  s_used_tiles.clear();
+  s_binned_area = 0;
+}
+
 // Returns approximation of log2(f) in s28.4
 // results are close enough to use for LOD
 static s32 FixedLog2(float f)
@@ -69,17 +180,21 @@ static inline int iround(float x)
 
 void SetTevReg(int reg, int comp, s16 color)
 {
-  tev.SetRegColor(reg, comp, color);
+  for (auto& context : s_contexts)
+    context->tev.SetRegColor(reg, comp, color);
 }
 
-static void Draw(s32 x, s32 y, s32 xi, s32 yi)
+// Sets up one pixel of the block for the Tev. Returns false if the pixel fails the early depth
+// test.
+static bool SetupPixel(RasterContext& context, const TriangleSetup& setup, s32 x, s32 y, s32 xi,
+                       s32 yi)
 {
-  INCSTAT(g_stats.this_frame.rasterized_pixels);
+  context.rasterizedPixels++;
 
-  float dx = vertexOffsetX + (float)(x - vertex0X);
-  float dy = vertexOffsetY + (float)(y - vertex0Y);
+  float dx = setup.vertexOffsetX + (float)(x - setup.vertex0X);
+  float dy = setup.vertexOffsetY + (float)(y - setup.vertex0Y);
 
-  s32 z = (s32)std::clamp<float>(ZSlope.GetValue(dx, dy), 0.0f, 16777215.0f);
+  s32 z = (s32)std::clamp<float>(setup.ZSlope.GetValue(dx, dy), 0.0f, 16777215.0f);
 
   if (bpmem.UseEarlyDepthTest() && g_ActiveConfig.bZComploc)
   {
@@ -89,28 +204,29 @@ static void Draw(s32 x, s32 y, s32 xi, s32 yi)
     {
       // early z
       if (!EfbInterface::ZCompare(x, y, z))
-        return;
+        return false;
     }
     EfbInterface::IncPerfCounterQuadCount(PQ_ZCOMP_OUTPUT_ZCOMPLOC);
   }
 
-  RasterBlockPixel& pixel = rasterBlock.Pixel[xi][yi];
+  Tev::Pixel& tev_pixel = context.tev.Pixels[xi + yi * BLOCK_SIZE];
+  const RasterBlockPixel& pixel = context.rasterBlock.Pixel[xi][yi];
 
-  tev.Position[0] = x;
-  tev.Position[1] = y;
-  tev.Position[2] = z;
+  tev_pixel.Position[0] = x;
+  tev_pixel.Position[1] = y;
+  tev_pixel.Position[2] = z;
 
   //  colors
   for (unsigned int i = 0; i < bpmem.genMode.numcolchans; i++)
   {
     for (int comp = 0; comp < 4; comp++)
     {
-      u16 color = (u16)ColorSlopes[i][comp].GetValue(dx, dy);
+      u16 color = (u16)setup.ColorSlopes[i][comp].GetValue(dx, dy);
 
       // clamp color value to 0
       u16 mask = ~(color >> 8);
 
-      tev.Color[i][comp] = color & mask;
+      tev_pixel.Color[i][comp] = color & mask;
     }
   }
 
@@ -118,10 +234,37 @@ static void Draw(s32 x, s32 y, s32 xi, s32 yi)
   for (unsigned int i = 0; i < bpmem.genMode.numtexgens; i++)
   {
     // multiply by 128 because TEV stores UVs as s17.7
-    tev.Uv[i].s = (s32)(pixel.Uv[i][0] * 128);
-    tev.Uv[i].t = (s32)(pixel.Uv[i][1] * 128);
+    tev_pixel.Uv[i].s = (s32)(pixel.Uv[i][0] * 128);
+    tev_pixel.Uv[i].t = (s32)(pixel.Uv[i][1] * 128);
+  }
+
+  return true;
+}
+
+// Draws the pixels of the block at x, y whose bit is set in mask, bit xi + yi * BLOCK_SIZE being
+// the pixel at x + xi, y + yi. The Tev shades the pixels that pass early z together.
+static void DrawBlock(RasterContext& context, const TriangleSetup& setup, s32 x, s32 y, u32 mask)
+{
+  static_assert(BLOCK_SIZE * BLOCK_SIZE == TevCombiners::NUM_PIXELS,
+                "The Tev must shade a whole block");
+
+  u32 draw_mask = 0;
+  for (s32 yi = 0; yi < BLOCK_SIZE; yi++)
+  {
+    for (s32 xi = 0; xi < BLOCK_SIZE; xi++)
+    {
+      const u32 bit = 1 << (xi + yi * BLOCK_SIZE);
+      if ((mask & bit) && SetupPixel(context, setup, x + xi, y + yi, xi, yi))
+        draw_mask |= bit;
+    }
   }
 
+  if (draw_mask == 0)
+    return;
+
+  Tev& tev = context.tev;
+  const RasterBlock& rasterBlock = context.rasterBlock;
+
   for (unsigned int i = 0; i < bpmem.genMode.numindstages; i++)
   {
     tev.IndirectLod[i] = rasterBlock.IndirectLod[i];
@@ -134,19 +277,19 @@ static void Draw(s32 x, s32 y, s32 xi, s32 yi)
     tev.TextureLinear[i] = rasterBlock.TextureLinear[i];
   }
 
-  tev.Draw();
+  tev.Draw(draw_mask);
 }
 
-static void InitTriangle(float X1, float Y1, s32 xi, s32 yi)
+static void InitTriangle(TriangleSetup* setup, float X1, float Y1, s32 xi, s32 yi)
 {
-  vertex0X = xi;
-  vertex0Y = yi;
+  setup->vertex0X = xi;
+  setup->vertex0Y = yi;
 
   // adjust a little less than 0.5
   const float adjust = 0.495f;
 
-  vertexOffsetX = ((float)xi - X1) + adjust;
-  vertexOffsetY = ((float)yi - Y1) + adjust;
+  setup->vertexOffsetX = ((float)xi - X1) + adjust;
+  setup->vertexOffsetY = ((float)yi - Y1) + adjust;
 }
 
 static void InitSlope(Slope* slope, float f1, float f2, float f3, float DX31, float DX12,
@@ -162,7 +305,8 @@ static void InitSlope(Slope* slope, float f1, float f2, float f3, float DX31, fl
   slope->f0 = f1;
 }
 
-static inline void CalculateLOD(s32* lodp, bool* linear, u32 texmap, u32 texcoord)
+static inline void CalculateLOD(const RasterBlock& rasterBlock, s32* lodp, bool* linear,
+                                u32 texmap, u32 texcoord)
 {
   const FourTexUnits& texUnit = bpmem.tex[(texmap >> 2) & 1];
   const u8 subTexmap = texmap & 3;
@@ -175,17 +319,17 @@ static inline void CalculateLOD(s32* lodp, bool* linear, u32 texmap, u32 texcoor
   float sDelta, tDelta;
   if (tm0.diag_lod)
   {
-    float* uv0 = rasterBlock.Pixel[0][0].Uv[texcoord];
-    float* uv1 = rasterBlock.Pixel[1][1].Uv[texcoord];
+    const float* uv0 = rasterBlock.Pixel[0][0].Uv[texcoord];
+    const float* uv1 = rasterBlock.Pixel[1][1].Uv[texcoord];
 
     sDelta = fabsf(uv0[0] - uv1[0]);
     tDelta = fabsf(uv0[1] - uv1[1]);
   }
   else
   {
-    float* uv0 = rasterBlock.Pixel[0][0].Uv[texcoord];
-    float* uv1 = rasterBlock.Pixel[1][0].Uv[texcoord];
-    float* uv2 = rasterBlock.Pixel[0][1].Uv[texcoord];
+    const float* uv0 = rasterBlock.Pixel[0][0].Uv[texcoord];
+    const float* uv1 = rasterBlock.Pixel[1][0].Uv[texcoord];
+    const float* uv2 = rasterBlock.Pixel[0][1].Uv[texcoord];
 
     sDelta = std::max(fabsf(uv0[0] - uv1[0]), fabsf(uv0[0] - uv2[0]));
     tDelta = std::max(fabsf(uv0[1] - uv1[1]), fabsf(uv0[1] - uv2[1]));
@@ -210,7 +354,8 @@ static inline void CalculateLOD(s32* lodp, bool* linear, u32 texmap, u32 texcoor
   *lodp = lod;
 }
 
-static void BuildBlock(s32 blockX, s32 blockY)
+static void BuildBlock(RasterBlock& rasterBlock, const TriangleSetup& setup, s32 blockX,
+                       s32 blockY)
 {
   for (s32 yi = 0; yi < BLOCK_SIZE; yi++)
   {
@@ -218,10 +363,10 @@ static void BuildBlock(s32 blockX, s32 blockY)
     {
       RasterBlockPixel& pixel = rasterBlock.Pixel[xi][yi];
 
-      float dx = vertexOffsetX + (float)(xi + blockX - vertex0X);
-      float dy = vertexOffsetY + (float)(yi + blockY - vertex0Y);
+      float dx = setup.vertexOffsetX + (float)(xi + blockX - setup.vertex0X);
+      float dy = setup.vertexOffsetY + (float)(yi + blockY - setup.vertex0Y);
 
-      float invW = 1.0f / WSlope.GetValue(dx, dy);
+      float invW = 1.0f / setup.WSlope.GetValue(dx, dy);
       pixel.InvW = invW;
 
       // tex coords
@@ -230,13 +375,13 @@ static void BuildBlock(s32 blockX, s32 blockY)
         float projection = invW;
         if (xfmem.texMtxInfo[i].projection)
         {
-          float q = TexSlopes[i][2].GetValue(dx, dy) * invW;
+          float q = setup.TexSlopes[i][2].GetValue(dx, dy) * invW;
           if (q != 0.0f)
             projection = invW / q;
         }
 
-        pixel.Uv[i][0] = TexSlopes[i][0].GetValue(dx, dy) * projection;
-        pixel.Uv[i][1] = TexSlopes[i][1].GetValue(dx, dy) * projection;
+        pixel.Uv[i][0] = setup.TexSlopes[i][0].GetValue(dx, dy) * projection;
+        pixel.Uv[i][1] = setup.TexSlopes[i][1].GetValue(dx, dy) * projection;
       }
     }
   }
@@ -249,7 +394,8 @@ static void BuildBlock(s32 blockX, s32 blockY)
     u32 texcoord = indref & 3;
     indref >>= 3;
 
-    CalculateLOD(&rasterBlock.IndirectLod[i], &rasterBlock.IndirectLinear[i], texmap, texcoord);
+    CalculateLOD(rasterBlock, &rasterBlock.IndirectLod[i], &rasterBlock.IndirectLinear[i], texmap,
+                 texcoord);
   }
 
   for (unsigned int i = 0; i <= bpmem.genMode.numtevstages; i++)
@@ -261,11 +407,228 @@ static void BuildBlock(s32 blockX, s32 blockY)
       u32 texmap = order.getTexMap(stageOdd);
       u32 texcoord = order.getTexCoord(stageOdd);
 
-      CalculateLOD(&rasterBlock.TextureLod[i], &rasterBlock.TextureLinear[i], texmap, texcoord);
+      CalculateLOD(rasterBlock, &rasterBlock.TextureLod[i], &rasterBlock.TextureLinear[i], texmap,
+                   texcoord);
+    }
+  }
+}
+
+// Draws the part of the triangle within the given rectangle, whose corners must be aligned to
+// blocks.
+static void DrawTriangle(RasterContext& context, const TriangleSetup& setup, s32 left, s32 top,
+                         s32 right, s32 bottom)
+{
+  const s32 C1 = setup.C1;
+  const s32 C2 = setup.C2;
+  const s32 C3 = setup.C3;
+  const s32 DX12 = setup.DX12;
+  const s32 DX23 = setup.DX23;
+  const s32 DX31 = setup.DX31;
+  const s32 DY12 = setup.DY12;
+  const s32 DY23 = setup.DY23;
+  const s32 DY31 = setup.DY31;
+
+  // Fixed-pos32 deltas
+  const s32 FDX12 = DX12 * 16;
+  const s32 FDX23 = DX23 * 16;
+  const s32 FDX31 = DX31 * 16;
+
+  const s32 FDY12 = DY12 * 16;
+  const s32 FDY23 = DY23 * 16;
+  const s32 FDY31 = DY31 * 16;
+
+  const s32 minx = std::max(setup.minx, left);
+  const s32 maxx = std::min(setup.maxx, right);
+  const s32 miny = std::max(setup.miny, top);
+  const s32 maxy = std::min(setup.maxy, bottom);
+
+  // Loop through blocks
+  for (s32 y = miny; y < maxy; y += BLOCK_SIZE)
+  {
+    for (s32 x = minx; x < maxx; x += BLOCK_SIZE)
+    {
+      // Corners of block
+      s32 x0 = x << 4;
+      s32 x1 = (x + BLOCK_SIZE - 1) << 4;
+      s32 y0 = y << 4;
+      s32 y1 = (y + BLOCK_SIZE - 1) << 4;
+
+      // Evaluate half-space functions
+      bool a00 = C1 + DX12 * y0 - DY12 * x0 > 0;
+      bool a10 = C1 + DX12 * y0 - DY12 * x1 > 0;
+      bool a01 = C1 + DX12 * y1 - DY12 * x0 > 0;
+      bool a11 = C1 + DX12 * y1 - DY12 * x1 > 0;
+      int a = (a00 << 0) | (a10 << 1) | (a01 << 2) | (a11 << 3);
+
+      bool b00 = C2 + DX23 * y0 - DY23 * x0 > 0;
+      bool b10 = C2 + DX23 * y0 - DY23 * x1 > 0;
+      bool b01 = C2 + DX23 * y1 - DY23 * x0 > 0;
+      bool b11 = C2 + DX23 * y1 - DY23 * x1 > 0;
+      int b = (b00 << 0) | (b10 << 1) | (b01 << 2) | (b11 << 3);
+
+      bool c00 = C3 + DX31 * y0 - DY31 * x0 > 0;
+      bool c10 = C3 + DX31 * y0 - DY31 * x1 > 0;
+      bool c01 = C3 + DX31 * y1 - DY31 * x0 > 0;
+      bool c11 = C3 + DX31 * y1 - DY31 * x1 > 0;
+      int c = (c00 << 0) | (c10 << 1) | (c01 << 2) | (c11 << 3);
+
+      // Skip block when outside an edge
+      if (a == 0x0 || b == 0x0 || c == 0x0)
+        continue;
+
+      BuildBlock(context.rasterBlock, setup, x, y);
+
+      // Accept whole block when totally covered
+      if (a == 0xF && b == 0xF && c == 0xF)
+      {
+        DrawBlock(context, setup, x, y, 0xF);
+      }
+      else  // Partially covered block
+      {
+        s32 CY1 = C1 + DX12 * y0 - DY12 * x0;
+        s32 CY2 = C2 + DX23 * y0 - DY23 * x0;
+        s32 CY3 = C3 + DX31 * y0 - DY31 * x0;
+
+        u32 mask = 0;
+        for (s32 iy = 0; iy < BLOCK_SIZE; iy++)
+        {
+          s32 CX1 = CY1;
+          s32 CX2 = CY2;
+          s32 CX3 = CY3;
+
+          for (s32 ix = 0; ix < BLOCK_SIZE; ix++)
+          {
+            if (CX1 > 0 && CX2 > 0 && CX3 > 0)
+              mask |= 1 << (ix + iy * BLOCK_SIZE);
+
+            CX1 -= FDY12;
+            CX2 -= FDY23;
+            CX3 -= FDY31;
+          }
+
+          CY1 += FDX12;
+          CY2 += FDX23;
+          CY3 += FDX31;
+        }
+
+        DrawBlock(context, setup, x, y, mask);
+      }
     }
   }
 }
 
+static void BinTriangle(const TriangleSetup& setup)
+{
+  const u32 index = static_cast<u32>(s_triangles.size());
+  s_triangles.push_back(setup);
+  s_binned_area += s64{setup.maxx - setup.minx} * (setup.maxy - setup.miny);
+
+  // A block starting before maxx may draw the pixel at maxx, which is in the same tile.
+  for (s32 ty = setup.miny / TILE_SIZE; ty <= (setup.maxy - 1) / TILE_SIZE; ty++)
+  {
+    for (s32 tx = setup.minx / TILE_SIZE; tx <= (setup.maxx - 1) / TILE_SIZE; tx++)
+    {
+      const u32 tile = static_cast<u32>(ty * TILES_X + tx);
+      if (s_bins[tile].empty())
+        s_used_tiles.push_back(tile);
+      s_bins[tile].push_back(index);
+    }
+  }
+}
+
+static void DrawTiles(RasterContext& context)
+{
+  while (true)
+  {
+    const size_t i = s_next_tile.fetch_add(1, std::memory_order_relaxed);
+    if (i >= s_used_tiles.size())
+      break;
+
+    const u32 tile = s_used_tiles[i];
+    const s32 left = static_cast<s32>(tile % TILES_X) * TILE_SIZE;
+    const s32 top = static_cast<s32>(tile / TILES_X) * TILE_SIZE;
+    for (u32 triangle : s_bins[tile])
+      DrawTriangle(context, s_triangles[triangle], left, top, left + TILE_SIZE, top + TILE_SIZE);
+  }
+}
+
+static void WorkerThread(size_t index)
+{
+  Common::SetCurrentThreadName("SW Rasterizer");
+
+  RasterContext& context = *s_contexts[index];
+  u64 generation = 0;
+  while (true)
+  {
+    {
+      std::unique_lock<std::mutex> lk(s_work_lock);
+      s_work_start.wait(lk, [&] { return s_workers_quit || s_work_generation != generation; });
+      if (s_workers_quit)
+        return;
+      generation = s_work_generation;
+    }
+
+    DrawTiles(context);
+
+    {
+      std::lock_guard<std::mutex> lk(s_work_lock);
+      if (--s_busy_workers == 0)
+        s_work_done.notify_one();
+    }
+  }
+}
+
+static bool UseWorkers()
+{
+  // The TEV dumps go through buffers shared by every thread.
+  return !s_workers.empty() && !g_ActiveConfig.bDumpTevStages &&
+         !g_ActiveConfig.bDumpTevTextureFetches;
+}
+
+void Flush()
+{
+  if (!s_used_tiles.empty())
+  {
+    s_next_tile.store(0, std::memory_order_relaxed);
+    if (s_binned_area < MIN_AREA_FOR_WORKERS)
+    {
+      DrawTiles(*s_contexts[0]);
+    }
+    else
+    {
+      {
+        std::lock_guard<std::mutex> lk(s_work_lock);
+        s_work_generation++;
+        s_busy_workers = s_workers.size();
+      }
+      s_work_start.notify_all();
+
+      DrawTiles(*s_contexts[0]);
+
+      std::unique_lock<std::mutex> lk(s_work_lock);
+      s_work_done.wait(lk, [] { return s_busy_workers == 0; });
+    }
+
+    for (u32 tile : s_used_tiles)
+      s_bins[tile].clear();
+    s_used_tiles.clear();
+    s_triangles.clear();
+    s_binned_area = 0;
+  }
+
+  for (auto& context : s_contexts)
+  {
+    ADDSTAT(g_stats.this_frame.rasterized_pixels, context->rasterizedPixels);
+    context->rasterizedPixels = 0;
+    context->tev.FlushCounters();
+  }
+
+  // Nothing is binned at this point, so the thread count can change.
+  const size_t thread_count = g_ActiveConfig.GetSWRasterizerThreads();
+  if (thread_count != s_contexts.size())
+    CreateContexts(thread_count);
+}
+
 void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertexData* v1,
                            const OutputVertexData* v2)
 {
@@ -292,15 +655,6 @@ void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertexData* v
   const s32 DY23 = Y2 - Y3;
   const s32 DY31 = Y3 - Y1;
 
-  // Fixed-pos32 deltas
-  const s32 FDX12 = DX12 * 16;
-  const s32 FDX23 = DX23 * 16;
-  const s32 FDX31 = DX31 * 16;
-
-  const s32 FDY12 = DY12 * 16;
-  const s32 FDY23 = DY23 * 16;
-  const s32 FDY31 = DY31 * 16;
-
   // Bounding rectangle
   s32 minx = (std::min(std::min(X1, X2), X3) + 0xF) >> 4;
   s32 maxx = (std::max(std::max(X1, X2), X3) + 0xF) >> 4;
@@ -335,6 +689,8 @@ void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertexData* v
   if (minx >= maxx || miny >= maxy)
     return;
 
+  TriangleSetup setup;
+
   // Setup slopes
   float fltx1 = v0->screenPosition.x;
   float flty1 = v0->screenPosition.y;
@@ -343,11 +699,11 @@ void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertexData* v
   float fltdy12 = flty1 - v1->screenPosition.y;
   float fltdy31 = v2->screenPosition.y - flty1;
 
-  InitTriangle(fltx1, flty1, (X1 + 0xF) >> 4, (Y1 + 0xF) >> 4);
+  InitTriangle(&setup, fltx1, flty1, (X1 + 0xF) >> 4, (Y1 + 0xF) >> 4);
 
   float w[3] = {1.0f / v0->projectedPosition.w, 1.0f / v1->projectedPosition.w,
                 1.0f / v2->projectedPosition.w};
-  InitSlope(&WSlope, w[0], w[1], w[2], fltdx31, fltdx12, fltdy12, fltdy31);
+  InitSlope(&setup.WSlope, w[0], w[1], w[2], fltdx31, fltdx12, fltdy12, fltdy31);
 
   // TODO: The zfreeze emulation is not quite correct, yet!
   // Many things might prevent us from reaching this line (culling, clipping, scissoring).
@@ -358,19 +714,21 @@ void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertexData* v
   if (!bpmem.genMode.zfreeze || !g_ActiveConfig.bZFreeze)
     InitSlope(&ZSlope, v0->screenPosition[2], v1->screenPosition[2], v2->screenPosition[2], fltdx31,
               fltdx12, fltdy12, fltdy31);
+  setup.ZSlope = ZSlope;
 
   for (unsigned int i = 0; i < bpmem.genMode.numcolchans; i++)
   {
     for (int comp = 0; comp < 4; comp++)
-      InitSlope(&ColorSlopes[i][comp], v0->color[i][comp], v1->color[i][comp], v2->color[i][comp],
-                fltdx31, fltdx12, fltdy12, fltdy31);
+      InitSlope(&setup.ColorSlopes[i][comp], v0->color[i][comp], v1->color[i][comp],
+                v2->color[i][comp], fltdx31, fltdx12, fltdy12, fltdy31);
   }
 
   for (unsigned int i = 0; i < bpmem.genMode.numtexgens; i++)
   {
     for (int comp = 0; comp < 3; comp++)
-      InitSlope(&TexSlopes[i][comp], v0->texCoords[i][comp] * w[0], v1->texCoords[i][comp] * w[1],
-                v2->texCoords[i][comp] * w[2], fltdx31, fltdx12, fltdy12, fltdy31);
+      InitSlope(&setup.TexSlopes[i][comp], v0->texCoords[i][comp] * w[0],
+                v1->texCoords[i][comp] * w[1], v2->texCoords[i][comp] * w[2], fltdx31, fltdx12,
+                fltdy12, fltdy31);
   }
 
   // Half-edge constants
@@ -386,87 +744,30 @@ void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertexData* v
   if (DY31 < 0 || (DY31 == 0 && DX31 > 0))
     C3++;
 
+  setup.C1 = C1;
+  setup.C2 = C2;
+  setup.C3 = C3;
+  setup.DX12 = DX12;
+  setup.DX23 = DX23;
+  setup.DX31 = DX31;
+  setup.DY12 = DY12;
+  setup.DY23 = DY23;
+  setup.DY31 = DY31;
+
   // Start in corner of 8x8 block
-  minx &= ~(BLOCK_SIZE - 1);
-  miny &= ~(BLOCK_SIZE - 1);
+  setup.minx = minx & ~(BLOCK_SIZE - 1);
+  setup.miny = miny & ~(BLOCK_SIZE - 1);
+  setup.maxx = maxx;
+  setup.maxy = maxy;
 
-  // Loop through blocks
-  for (s32 y = miny; y < maxy; y += BLOCK_SIZE)
+  if (UseWorkers())
   {
-    for (s32 x = minx; x < maxx; x += BLOCK_SIZE)
-    {
-      // Corners of block
-      s32 x0 = x << 4;
-      s32 x1 = (x + BLOCK_SIZE - 1) << 4;
-      s32 y0 = y << 4;
-      s32 y1 = (y + BLOCK_SIZE - 1) << 4;
-
-      // Evaluate half-space functions
-      bool a00 = C1 + DX12 * y0 - DY12 * x0 > 0;
-      bool a10 = C1 + DX12 * y0 - DY12 * x1 > 0;
-      bool a01 = C1 + DX12 * y1 - DY12 * x0 > 0;
-      bool a11 = C1 + DX12 * y1 - DY12 * x1 > 0;
-      int a = (a00 << 0) | (a10 << 1) | (a01 << 2) | (a11 << 3);
-
-      bool b00 = C2 + DX23 * y0 - DY23 * x0 > 0;
-      bool b10 = C2 + DX23 * y0 - DY23 * x1 > 0;
-      bool b01 = C2 + DX23 * y1 - DY23 * x0 > 0;
-      bool b11 = C2 + DX23 * y1 - DY23 * x1 > 0;
-      int b = (b00 << 0) | (b10 << 1) | (b01 << 2) | (b11 << 3);
-
-      bool c00 = C3 + DX31 * y0 - DY31 * x0 > 0;
-      bool c10 = C3 + DX31 * y0 - DY31 * x1 > 0;
-      bool c01 = C3 + DX31 * y1 - DY31 * x0 > 0;
-      bool c11 = C3 + DX31 * y1 - DY31 * x1 > 0;
-      int c = (c00 << 0) | (c10 << 1) | (c01 << 2) | (c11 << 3);
-
-      // Skip block when outside an edge
-      if (a == 0x0 || b == 0x0 || c == 0x0)
-        continue;
-
-      BuildBlock(x, y);
-
-      // Accept whole block when totally covered
-      if (a == 0xF && b == 0xF && c == 0xF)
-      {
-        for (s32 iy = 0; iy < BLOCK_SIZE; iy++)
-        {
-          for (s32 ix = 0; ix < BLOCK_SIZE; ix++)
-          {
-            Draw(x + ix, y + iy, ix, iy);
-          }
-        }
-      }
-      else  // Partially covered block
-      {
-        s32 CY1 = C1 + DX12 * y0 - DY12 * x0;
-        s32 CY2 = C2 + DX23 * y0 - DY23 * x0;
-        s32 CY3 = C3 + DX31 * y0 - DY31 * x0;
-
-        for (s32 iy = 0; iy < BLOCK_SIZE; iy++)
-        {
-          s32 CX1 = CY1;
-          s32 CX2 = CY2;
-          s32 CX3 = CY3;
-
-          for (s32 ix = 0; ix < BLOCK_SIZE; ix++)
-          {
-            if (CX1 > 0 && CX2 > 0 && CX3 > 0)
-            {
-              Draw(x + ix, y + iy, ix, iy);
-            }
-
-            CX1 -= FDY12;
-            CX2 -= FDY23;
-            CX3 -= FDY31;
-          }
-
-          CY1 += FDX12;
-          CY2 += FDX23;
-          CY3 += FDX31;
-        }
-      }
-    }
+    BinTriangle(setup);
+  }
+  else
+  {
+    constexpr s32 max = std::numeric_limits<s32>::max();
+    DrawTriangle(*s_contexts[0], setup, 0, 0, max, max);
   }
 }
 }  // namespace Rasterizer
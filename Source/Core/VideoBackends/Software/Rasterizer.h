@@ -11,10 +11,16 @@ struct OutputVertexData;
 namespace Rasterizer
 {
 void Init();
+void Shutdown();
 
 void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertexData* v1,
                            const OutputVertexData* v2);
 
+// Draws the triangles that were set aside for the rasterizer threads and waits for them, then adds
+// the counters of every thread to the statistics. Must be called before the state or the EFB
+// changes.
+void Flush();
+
 void SetTevReg(int reg, int comp, s16 color);
 
 struct Slope
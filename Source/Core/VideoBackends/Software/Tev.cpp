@@ -39,69 +39,6 @@ void Tev::Init()
   FixedConstants[7] = 223;
   FixedConstants[8] = 255;
 
-  for (s16& comp : Zero16)
-  {
-    comp = 0;
-  }
-
-  m_ColorInputLUT[0][RED_INP] = &Reg[0][RED_C];
-  m_ColorInputLUT[0][GRN_INP] = &Reg[0][GRN_C];
-  m_ColorInputLUT[0][BLU_INP] = &Reg[0][BLU_C];  // prev.rgb
-  m_ColorInputLUT[1][RED_INP] = &Reg[0][ALP_C];
-  m_ColorInputLUT[1][GRN_INP] = &Reg[0][ALP_C];
-  m_ColorInputLUT[1][BLU_INP] = &Reg[0][ALP_C];  // prev.aaa
-  m_ColorInputLUT[2][RED_INP] = &Reg[1][RED_C];
-  m_ColorInputLUT[2][GRN_INP] = &Reg[1][GRN_C];
-  m_ColorInputLUT[2][BLU_INP] = &Reg[1][BLU_C];  // c0.rgb
-  m_ColorInputLUT[3][RED_INP] = &Reg[1][ALP_C];
-  m_ColorInputLUT[3][GRN_INP] = &Reg[1][ALP_C];
-  m_ColorInputLUT[3][BLU_INP] = &Reg[1][ALP_C];  // c0.aaa
-  m_ColorInputLUT[4][RED_INP] = &Reg[2][RED_C];
-  m_ColorInputLUT[4][GRN_INP] = &Reg[2][GRN_C];
-  m_ColorInputLUT[4][BLU_INP] = &Reg[2][BLU_C];  // c1.rgb
-  m_ColorInputLUT[5][RED_INP] = &Reg[2][ALP_C];
-  m_ColorInputLUT[5][GRN_INP] = &Reg[2][ALP_C];
-  m_ColorInputLUT[5][BLU_INP] = &Reg[2][ALP_C];  // c1.aaa
-  m_ColorInputLUT[6][RED_INP] = &Reg[3][RED_C];
-  m_ColorInputLUT[6][GRN_INP] = &Reg[3][GRN_C];
-  m_ColorInputLUT[6][BLU_INP] = &Reg[3][BLU_C];  // c2.rgb
-  m_ColorInputLUT[7][RED_INP] = &Reg[3][ALP_C];
-  m_ColorInputLUT[7][GRN_INP] = &Reg[3][ALP_C];
-  m_ColorInputLUT[7][BLU_INP] = &Reg[3][ALP_C];  // c2.aaa
-  m_ColorInputLUT[8][RED_INP] = &TexColor[RED_C];
-  m_ColorInputLUT[8][GRN_INP] = &TexColor[GRN_C];
-  m_ColorInputLUT[8][BLU_INP] = &TexColor[BLU_C];  // tex.rgb
-  m_ColorInputLUT[9][RED_INP] = &TexColor[ALP_C];
-  m_ColorInputLUT[9][GRN_INP] = &TexColor[ALP_C];
-  m_ColorInputLUT[9][BLU_INP] = &TexColor[ALP_C];  // tex.aaa
-  m_ColorInputLUT[10][RED_INP] = &RasColor[RED_C];
-  m_ColorInputLUT[10][GRN_INP] = &RasColor[GRN_C];
-  m_ColorInputLUT[10][BLU_INP] = &RasColor[BLU_C];  // ras.rgb
-  m_ColorInputLUT[11][RED_INP] = &RasColor[ALP_C];
-  m_ColorInputLUT[11][GRN_INP] = &RasColor[ALP_C];
-  m_ColorInputLUT[11][BLU_INP] = &RasColor[ALP_C];  // ras.rgb
-  m_ColorInputLUT[12][RED_INP] = &FixedConstants[8];
-  m_ColorInputLUT[12][GRN_INP] = &FixedConstants[8];
-  m_ColorInputLUT[12][BLU_INP] = &FixedConstants[8];  // one
-  m_ColorInputLUT[13][RED_INP] = &FixedConstants[4];
-  m_ColorInputLUT[13][GRN_INP] = &FixedConstants[4];
-  m_ColorInputLUT[13][BLU_INP] = &FixedConstants[4];  // half
-  m_ColorInputLUT[14][RED_INP] = &StageKonst[RED_C];
-  m_ColorInputLUT[14][GRN_INP] = &StageKonst[GRN_C];
-  m_ColorInputLUT[14][BLU_INP] = &StageKonst[BLU_C];  // konst
-  m_ColorInputLUT[15][RED_INP] = &FixedConstants[0];
-  m_ColorInputLUT[15][GRN_INP] = &FixedConstants[0];
-  m_ColorInputLUT[15][BLU_INP] = &FixedConstants[0];  // zero
-
-  m_AlphaInputLUT[0] = &Reg[0][ALP_C];      // prev
-  m_AlphaInputLUT[1] = &Reg[1][ALP_C];      // c0
-  m_AlphaInputLUT[2] = &Reg[2][ALP_C];      // c1
-  m_AlphaInputLUT[3] = &Reg[3][ALP_C];      // c2
-  m_AlphaInputLUT[4] = &TexColor[ALP_C];    // tex
-  m_AlphaInputLUT[5] = &RasColor[ALP_C];    // ras
-  m_AlphaInputLUT[6] = &StageKonst[ALP_C];  // konst
-  m_AlphaInputLUT[7] = &Zero16[ALP_C];      // zero
-
   for (int comp = 0; comp < 4; comp++)
   {
     m_KonstLUT[0][comp] = &FixedConstants[8];
@@ -146,68 +83,48 @@ void Tev::Init()
     m_KonstLUT[31][comp] = &KonstantColors[3][ALP_C];
   }
 
-  m_BiasLUT[0] = 0;
-  m_BiasLUT[1] = 128;
-  m_BiasLUT[2] = -128;
-  m_BiasLUT[3] = 0;
-
-  m_ScaleLShiftLUT[0] = 0;
-  m_ScaleLShiftLUT[1] = 1;
-  m_ScaleLShiftLUT[2] = 2;
-  m_ScaleLShiftLUT[3] = 0;
-
-  m_ScaleRShiftLUT[0] = 0;
-  m_ScaleRShiftLUT[1] = 0;
-  m_ScaleRShiftLUT[2] = 0;
-  m_ScaleRShiftLUT[3] = 1;
+  m_combiners.Init();
 }
 
-static inline s16 Clamp255(s16 in)
+void Tev::SetRasColor(int index, int colorChan, int swaptable)
 {
-  return in > 255 ? 255 : (in < 0 ? 0 : in);
-}
+  s16(&ras_color)[4] = m_combiners.GetPixel(index).RasColor;
+  const u8 alpha_bump = m_state[index].AlphaBump;
 
-static inline s16 Clamp1024(s16 in)
-{
-  return in > 1023 ? 1023 : (in < -1024 ? -1024 : in);
-}
-
-void Tev::SetRasColor(int colorChan, int swaptable)
-{
   switch (colorChan)
   {
   case 0:  // Color0
   {
-    const u8* color = Color[0];
-    RasColor[RED_C] = color[bpmem.tevksel[swaptable].swap1];
-    RasColor[GRN_C] = color[bpmem.tevksel[swaptable].swap2];
+    const u8* color = Pixels[index].Color[0];
+    ras_color[RED_C] = color[bpmem.tevksel[swaptable].swap1];
+    ras_color[GRN_C] = color[bpmem.tevksel[swaptable].swap2];
     swaptable++;
-    RasColor[BLU_C] = color[bpmem.tevksel[swaptable].swap1];
-    RasColor[ALP_C] = color[bpmem.tevksel[swaptable].swap2];
+    ras_color[BLU_C] = color[bpmem.tevksel[swaptable].swap1];
+    ras_color[ALP_C] = color[bpmem.tevksel[swaptable].swap2];
   }
   break;
   case 1:  // Color1
   {
-    const u8* color = Color[1];
-    RasColor[RED_C] = color[bpmem.tevksel[swaptable].swap1];
-    RasColor[GRN_C] = color[bpmem.tevksel[swaptable].swap2];
+    const u8* color = Pixels[index].Color[1];
+    ras_color[RED_C] = color[bpmem.tevksel[swaptable].swap1];
+    ras_color[GRN_C] = color[bpmem.tevksel[swaptable].swap2];
     swaptable++;
-    RasColor[BLU_C] = color[bpmem.tevksel[swaptable].swap1];
-    RasColor[ALP_C] = color[bpmem.tevksel[swaptable].swap2];
+    ras_color[BLU_C] = color[bpmem.tevksel[swaptable].swap1];
+    ras_color[ALP_C] = color[bpmem.tevksel[swaptable].swap2];
   }
   break;
   case 5:  // alpha bump
   {
-    for (s16& comp : RasColor)
+    for (s16& comp : ras_color)
     {
-      comp = AlphaBump;
+      comp = alpha_bump;
     }
   }
   break;
   case 6:  // alpha bump normalized
   {
-    const u8 normalized = AlphaBump | AlphaBump >> 5;
-    for (s16& comp : RasColor)
+    const u8 normalized = alpha_bump | alpha_bump >> 5;
+    for (s16& comp : ras_color)
     {
       comp = normalized;
     }
@@ -215,7 +132,7 @@ void Tev::SetRasColor(int colorChan, int swaptable)
   break;
   default:  // zero
   {
-    for (s16& comp : RasColor)
+    for (s16& comp : ras_color)
     {
       comp = 0;
     }
@@ -224,159 +141,6 @@ void Tev::SetRasColor(int colorChan, int swaptable)
   }
 }
 
-void Tev::DrawColorRegular(const TevStageCombiner::ColorCombiner& cc, const InputRegType inputs[4])
-{
-  for (int i = 0; i < 3; i++)
-  {
-    const InputRegType& InputReg = inputs[BLU_C + i];
-
-    const u16 c = InputReg.c + (InputReg.c >> 7);
-
-    s32 temp = InputReg.a * (256 - c) + (InputReg.b * c);
-    temp <<= m_ScaleLShiftLUT[cc.shift];
-    temp += (cc.shift == 3) ? 0 : (cc.op == 1) ? 127 : 128;
-    temp >>= 8;
-    temp = cc.op ? -temp : temp;
-
-    s32 result = ((InputReg.d + m_BiasLUT[cc.bias]) << m_ScaleLShiftLUT[cc.shift]) + temp;
-    result = result >> m_ScaleRShiftLUT[cc.shift];
-
-    Reg[cc.dest][BLU_C + i] = result;
-  }
-}
-
-void Tev::DrawColorCompare(const TevStageCombiner::ColorCombiner& cc, const InputRegType inputs[4])
-{
-  for (int i = BLU_C; i <= RED_C; i++)
-  {
-    switch ((cc.shift << 1) | cc.op | 8)  // encoded compare mode
-    {
-    case TEVCMP_R8_GT:
-      Reg[cc.dest][i] = inputs[i].d + ((inputs[RED_C].a > inputs[RED_C].b) ? inputs[i].c : 0);
-      break;
-
-    case TEVCMP_R8_EQ:
-      Reg[cc.dest][i] = inputs[i].d + ((inputs[RED_C].a == inputs[RED_C].b) ? inputs[i].c : 0);
-      break;
-
-    case TEVCMP_GR16_GT:
-    {
-      const u32 a = (inputs[GRN_C].a << 8) | inputs[RED_C].a;
-      const u32 b = (inputs[GRN_C].b << 8) | inputs[RED_C].b;
-      Reg[cc.dest][i] = inputs[i].d + ((a > b) ? inputs[i].c : 0);
-    }
-    break;
-
-    case TEVCMP_GR16_EQ:
-    {
-      const u32 a = (inputs[GRN_C].a << 8) | inputs[RED_C].a;
-      const u32 b = (inputs[GRN_C].b << 8) | inputs[RED_C].b;
-      Reg[cc.dest][i] = inputs[i].d + ((a == b) ? inputs[i].c : 0);
-    }
-    break;
-
-    case TEVCMP_BGR24_GT:
-    {
-      const u32 a = (inputs[BLU_C].a << 16) | (inputs[GRN_C].a << 8) | inputs[RED_C].a;
-      const u32 b = (inputs[BLU_C].b << 16) | (inputs[GRN_C].b << 8) | inputs[RED_C].b;
-      Reg[cc.dest][i] = inputs[i].d + ((a > b) ? inputs[i].c : 0);
-    }
-    break;
-
-    case TEVCMP_BGR24_EQ:
-    {
-      const u32 a = (inputs[BLU_C].a << 16) | (inputs[GRN_C].a << 8) | inputs[RED_C].a;
-      const u32 b = (inputs[BLU_C].b << 16) | (inputs[GRN_C].b << 8) | inputs[RED_C].b;
-      Reg[cc.dest][i] = inputs[i].d + ((a == b) ? inputs[i].c : 0);
-    }
-    break;
-
-    case TEVCMP_RGB8_GT:
-      Reg[cc.dest][i] = inputs[i].d + ((inputs[i].a > inputs[i].b) ? inputs[i].c : 0);
-      break;
-
-    case TEVCMP_RGB8_EQ:
-      Reg[cc.dest][i] = inputs[i].d + ((inputs[i].a == inputs[i].b) ? inputs[i].c : 0);
-      break;
-    }
-  }
-}
-
-void Tev::DrawAlphaRegular(const TevStageCombiner::AlphaCombiner& ac, const InputRegType inputs[4])
-{
-  const InputRegType& InputReg = inputs[ALP_C];
-
-  const u16 c = InputReg.c + (InputReg.c >> 7);
-
-  s32 temp = InputReg.a * (256 - c) + (InputReg.b * c);
-  temp <<= m_ScaleLShiftLUT[ac.shift];
-  temp += (ac.shift != 3) ? 0 : (ac.op == 1) ? 127 : 128;
-  temp = ac.op ? (-temp >> 8) : (temp >> 8);
-
-  s32 result = ((InputReg.d + m_BiasLUT[ac.bias]) << m_ScaleLShiftLUT[ac.shift]) + temp;
-  result = result >> m_ScaleRShiftLUT[ac.shift];
-
-  Reg[ac.dest][ALP_C] = result;
-}
-
-void Tev::DrawAlphaCompare(const TevStageCombiner::AlphaCombiner& ac, const InputRegType inputs[4])
-{
-  switch ((ac.shift << 1) | ac.op | 8)  // encoded compare mode
-  {
-  case TEVCMP_R8_GT:
-    Reg[ac.dest][ALP_C] =
-        inputs[ALP_C].d + ((inputs[RED_C].a > inputs[RED_C].b) ? inputs[ALP_C].c : 0);
-    break;
-
-  case TEVCMP_R8_EQ:
-    Reg[ac.dest][ALP_C] =
-        inputs[ALP_C].d + ((inputs[RED_C].a == inputs[RED_C].b) ? inputs[ALP_C].c : 0);
-    break;
-
-  case TEVCMP_GR16_GT:
-  {
-    const u32 a = (inputs[GRN_C].a << 8) | inputs[RED_C].a;
-    const u32 b = (inputs[GRN_C].b << 8) | inputs[RED_C].b;
-    Reg[ac.dest][ALP_C] = inputs[ALP_C].d + ((a > b) ? inputs[ALP_C].c : 0);
-  }
-  break;
-
-  case TEVCMP_GR16_EQ:
-  {
-    const u32 a = (inputs[GRN_C].a << 8) | inputs[RED_C].a;
-    const u32 b = (inputs[GRN_C].b << 8) | inputs[RED_C].b;
-    Reg[ac.dest][ALP_C] = inputs[ALP_C].d + ((a == b) ? inputs[ALP_C].c : 0);
-  }
-  break;
-
-  case TEVCMP_BGR24_GT:
-  {
-    const u32 a = (inputs[BLU_C].a << 16) | (inputs[GRN_C].a << 8) | inputs[RED_C].a;
-    const u32 b = (inputs[BLU_C].b << 16) | (inputs[GRN_C].b << 8) | inputs[RED_C].b;
-    Reg[ac.dest][ALP_C] = inputs[ALP_C].d + ((a > b) ? inputs[ALP_C].c : 0);
-  }
-  break;
-
-  case TEVCMP_BGR24_EQ:
-  {
-    const u32 a = (inputs[BLU_C].a << 16) | (inputs[GRN_C].a << 8) | inputs[RED_C].a;
-    const u32 b = (inputs[BLU_C].b << 16) | (inputs[GRN_C].b << 8) | inputs[RED_C].b;
-    Reg[ac.dest][ALP_C] = inputs[ALP_C].d + ((a == b) ? inputs[ALP_C].c : 0);
-  }
-  break;
-
-  case TEVCMP_A8_GT:
-    Reg[ac.dest][ALP_C] =
-        inputs[ALP_C].d + ((inputs[ALP_C].a > inputs[ALP_C].b) ? inputs[ALP_C].c : 0);
-    break;
-
-  case TEVCMP_A8_EQ:
-    Reg[ac.dest][ALP_C] =
-        inputs[ALP_C].d + ((inputs[ALP_C].a == inputs[ALP_C].b) ? inputs[ALP_C].c : 0);
-    break;
-  }
-}
-
 static bool AlphaCompare(int alpha, int ref, AlphaTest::CompareMode comp)
 {
   switch (comp)
@@ -445,10 +209,11 @@ static inline s32 WrapIndirectCoord(s32 coord, int wrapMode)
   }
 }
 
-void Tev::Indirect(unsigned int stageNum, s32 s, s32 t)
+void Tev::Indirect(int index, unsigned int stageNum, s32 s, s32 t)
 {
+  PixelState& state = m_state[index];
   const TevStageIndirect& indirect = bpmem.tevind[stageNum];
-  const u8* indmap = IndirectTex[indirect.bt];
+  const u8* indmap = state.IndirectTex[indirect.bt];
 
   s32 indcoord[3];
 
@@ -456,16 +221,16 @@ void Tev::Indirect(unsigned int stageNum, s32 s, s32 t)
   switch (indirect.bs)
   {
   case ITBA_OFF:
-    AlphaBump = 0;
+    state.AlphaBump = 0;
     break;
   case ITBA_S:
-    AlphaBump = indmap[TextureSampler::ALP_SMP];
+    state.AlphaBump = indmap[TextureSampler::ALP_SMP];
     break;
   case ITBA_T:
-    AlphaBump = indmap[TextureSampler::BLU_SMP];
+    state.AlphaBump = indmap[TextureSampler::BLU_SMP];
     break;
   case ITBA_U:
-    AlphaBump = indmap[TextureSampler::GRN_SMP];
+    state.AlphaBump = indmap[TextureSampler::GRN_SMP];
     break;
   }
 
@@ -483,25 +248,25 @@ void Tev::Indirect(unsigned int stageNum, s32 s, s32 t)
     indcoord[0] = indmap[TextureSampler::ALP_SMP] + bias[0];
     indcoord[1] = indmap[TextureSampler::BLU_SMP] + bias[1];
     indcoord[2] = indmap[TextureSampler::GRN_SMP] + bias[2];
-    AlphaBump = AlphaBump & 0xf8;
+    state.AlphaBump = state.AlphaBump & 0xf8;
     break;
   case ITF_5:
     indcoord[0] = (indmap[TextureSampler::ALP_SMP] & 0x1f) + bias[0];
     indcoord[1] = (indmap[TextureSampler::BLU_SMP] & 0x1f) + bias[1];
     indcoord[2] = (indmap[TextureSampler::GRN_SMP] & 0x1f) + bias[2];
-    AlphaBump = AlphaBump & 0xe0;
+    state.AlphaBump = state.AlphaBump & 0xe0;
     break;
   case ITF_4:
     indcoord[0] = (indmap[TextureSampler::ALP_SMP] & 0x0f) + bias[0];
     indcoord[1] = (indmap[TextureSampler::BLU_SMP] & 0x0f) + bias[1];
     indcoord[2] = (indmap[TextureSampler::GRN_SMP] & 0x0f) + bias[2];
-    AlphaBump = AlphaBump & 0xf0;
+    state.AlphaBump = state.AlphaBump & 0xf0;
     break;
   case ITF_3:
     indcoord[0] = (indmap[TextureSampler::ALP_SMP] & 0x07) + bias[0];
     indcoord[1] = (indmap[TextureSampler::BLU_SMP] & 0x07) + bias[1];
     indcoord[2] = (indmap[TextureSampler::GRN_SMP] & 0x07) + bias[2];
-    AlphaBump = AlphaBump & 0xf8;
+    state.AlphaBump = state.AlphaBump & 0xf8;
     break;
   default:
     PanicAlertFmt("Tev::Indirect");
@@ -555,30 +320,51 @@ void Tev::Indirect(unsigned int stageNum, s32 s, s32 t)
 
   if (indirect.fb_addprev)
   {
-    TexCoord.s += (int)(WrapIndirectCoord(s, indirect.sw) + indtevtrans[0]);
-    TexCoord.t += (int)(WrapIndirectCoord(t, indirect.tw) + indtevtrans[1]);
+    state.TexCoord.s += (int)(WrapIndirectCoord(s, indirect.sw) + indtevtrans[0]);
+    state.TexCoord.t += (int)(WrapIndirectCoord(t, indirect.tw) + indtevtrans[1]);
   }
   else
   {
-    TexCoord.s = (int)(WrapIndirectCoord(s, indirect.sw) + indtevtrans[0]);
-    TexCoord.t = (int)(WrapIndirectCoord(t, indirect.tw) + indtevtrans[1]);
+    state.TexCoord.s = (int)(WrapIndirectCoord(s, indirect.sw) + indtevtrans[0]);
+    state.TexCoord.t = (int)(WrapIndirectCoord(t, indirect.tw) + indtevtrans[1]);
   }
 }
 
-void Tev::Draw()
+void Tev::Draw(u32 mask)
 {
-  ASSERT(Position[0] >= 0 && Position[0] < s32(EFB_WIDTH));
-  ASSERT(Position[1] >= 0 && Position[1] < s32(EFB_HEIGHT));
-
-  INCSTAT(g_stats.this_frame.tev_pixels_in);
+#if ALLOW_TEV_DUMPS
+  // The dumps keep one value per stage until the pixel is output, so draw one pixel at a time.
+  if ((g_ActiveConfig.bDumpTevStages || g_ActiveConfig.bDumpTevTextureFetches) &&
+      (mask & (mask - 1)) != 0)
+  {
+    for (int i = 0; i < TevCombiners::NUM_PIXELS; i++)
+    {
+      if (mask & (1 << i))
+        Draw(1 << i);
+    }
+    return;
+  }
+#endif
 
-  // initial color values
-  for (int i = 0; i < 4; i++)
+  for (int i = 0; i < TevCombiners::NUM_PIXELS; i++)
   {
-    Reg[i][RED_C] = PixelShaderManager::constants.colors[i][0];
-    Reg[i][GRN_C] = PixelShaderManager::constants.colors[i][1];
-    Reg[i][BLU_C] = PixelShaderManager::constants.colors[i][2];
-    Reg[i][ALP_C] = PixelShaderManager::constants.colors[i][3];
+    if (!(mask & (1 << i)))
+      continue;
+
+    ASSERT(Pixels[i].Position[0] >= 0 && Pixels[i].Position[0] < s32(EFB_WIDTH));
+    ASSERT(Pixels[i].Position[1] >= 0 && Pixels[i].Position[1] < s32(EFB_HEIGHT));
+
+    m_pixels_in++;
+
+    // initial color values
+    TevCombiners::Pixel& pixel = m_combiners.GetPixel(i);
+    for (int reg = 0; reg < 4; reg++)
+    {
+      pixel.Reg[reg][RED_C] = PixelShaderManager::constants.colors[reg][0];
+      pixel.Reg[reg][GRN_C] = PixelShaderManager::constants.colors[reg][1];
+      pixel.Reg[reg][BLU_C] = PixelShaderManager::constants.colors[reg][2];
+      pixel.Reg[reg][ALP_C] = PixelShaderManager::constants.colors[reg][3];
+    }
   }
 
   for (unsigned int stageNum = 0; stageNum < bpmem.genMode.numindstages; stageNum++)
@@ -593,19 +379,26 @@ void Tev::Draw()
     const s32 scaleS = stageOdd ? texscale.ss1 : texscale.ss0;
     const s32 scaleT = stageOdd ? texscale.ts1 : texscale.ts0;
 
-    TextureSampler::Sample(Uv[texcoordSel].s >> scaleS, Uv[texcoordSel].t >> scaleT,
-                           IndirectLod[stageNum], IndirectLinear[stageNum], texmap,
-                           IndirectTex[stageNum]);
+    for (int i = 0; i < TevCombiners::NUM_PIXELS; i++)
+    {
+      if (!(mask & (1 << i)))
+        continue;
+
+      const TextureCoordinateType& uv = Pixels[i].Uv[texcoordSel];
+      u8* const indirect_tex = m_state[i].IndirectTex[stageNum];
+      TextureSampler::Sample(uv.s >> scaleS, uv.t >> scaleT, IndirectLod[stageNum],
+                             IndirectLinear[stageNum], texmap, indirect_tex);
 
 #if ALLOW_TEV_DUMPS
-    if (g_ActiveConfig.bDumpTevStages)
-    {
-      u8 stage[4] = {IndirectTex[stageNum][TextureSampler::ALP_SMP],
-                     IndirectTex[stageNum][TextureSampler::BLU_SMP],
-                     IndirectTex[stageNum][TextureSampler::GRN_SMP], 255};
-      DebugUtil::DrawTempBuffer(stage, INDIRECT + stageNum);
-    }
+      if (g_ActiveConfig.bDumpTevStages)
+      {
+        u8 stage[4] = {indirect_tex[TextureSampler::ALP_SMP],
+                       indirect_tex[TextureSampler::BLU_SMP],
+                       indirect_tex[TextureSampler::GRN_SMP], 255};
+        DebugUtil::DrawTempBuffer(stage, INDIRECT + stageNum);
+      }
 #endif
+    }
   }
 
   for (unsigned int stageNum = 0; stageNum <= bpmem.genMode.numtevstages; stageNum++)
@@ -622,100 +415,89 @@ void Tev::Draw()
     const int texcoordSel = order.getTexCoord(stageOdd);
     const int texmap = order.getTexMap(stageOdd);
 
-    Indirect(stageNum, Uv[texcoordSel].s, Uv[texcoordSel].t);
+    const int kc = kSel.getKC(stageOdd);
+    const int ka = kSel.getKA(stageOdd);
 
-    // sample texture
-    if (order.getEnable(stageOdd))
+    for (int i = 0; i < TevCombiners::NUM_PIXELS; i++)
     {
-      // RGBA
-      u8 texel[4];
+      if (!(mask & (1 << i)))
+        continue;
 
-      TextureSampler::Sample(TexCoord.s, TexCoord.t, TextureLod[stageNum], TextureLinear[stageNum],
-                             texmap, texel);
+      TevCombiners::Pixel& pixel = m_combiners.GetPixel(i);
 
-#if ALLOW_TEV_DUMPS
-      if (g_ActiveConfig.bDumpTevTextureFetches)
-        DebugUtil::DrawTempBuffer(texel, DIRECT_TFETCH + stageNum);
-#endif
+      Indirect(i, stageNum, Pixels[i].Uv[texcoordSel].s, Pixels[i].Uv[texcoordSel].t);
 
-      int swaptable = ac.tswap * 2;
+      // sample texture
+      if (order.getEnable(stageOdd))
+      {
+        // RGBA
+        u8 texel[4];
 
-      TexColor[RED_C] = texel[bpmem.tevksel[swaptable].swap1];
-      TexColor[GRN_C] = texel[bpmem.tevksel[swaptable].swap2];
-      swaptable++;
-      TexColor[BLU_C] = texel[bpmem.tevksel[swaptable].swap1];
-      TexColor[ALP_C] = texel[bpmem.tevksel[swaptable].swap2];
-    }
+        const TextureCoordinateType& tex_coord = m_state[i].TexCoord;
+        TextureSampler::Sample(tex_coord.s, tex_coord.t, TextureLod[stageNum],
+                               TextureLinear[stageNum], texmap, texel);
 
-    // set konst for this stage
-    const int kc = kSel.getKC(stageOdd);
-    const int ka = kSel.getKA(stageOdd);
-    StageKonst[RED_C] = *(m_KonstLUT[kc][RED_C]);
-    StageKonst[GRN_C] = *(m_KonstLUT[kc][GRN_C]);
-    StageKonst[BLU_C] = *(m_KonstLUT[kc][BLU_C]);
-    StageKonst[ALP_C] = *(m_KonstLUT[ka][ALP_C]);
+#if ALLOW_TEV_DUMPS
+        if (g_ActiveConfig.bDumpTevTextureFetches)
+          DebugUtil::DrawTempBuffer(texel, DIRECT_TFETCH + stageNum);
+#endif
 
-    // set color
-    SetRasColor(order.getColorChan(stageOdd), ac.rswap * 2);
+        int swaptable = ac.tswap * 2;
 
-    // combine inputs
-    InputRegType inputs[4];
-    for (int i = 0; i < 3; i++)
-    {
-      inputs[BLU_C + i].a = *m_ColorInputLUT[cc.a][i];
-      inputs[BLU_C + i].b = *m_ColorInputLUT[cc.b][i];
-      inputs[BLU_C + i].c = *m_ColorInputLUT[cc.c][i];
-      inputs[BLU_C + i].d = *m_ColorInputLUT[cc.d][i];
-    }
-    inputs[ALP_C].a = *m_AlphaInputLUT[ac.a];
-    inputs[ALP_C].b = *m_AlphaInputLUT[ac.b];
-    inputs[ALP_C].c = *m_AlphaInputLUT[ac.c];
-    inputs[ALP_C].d = *m_AlphaInputLUT[ac.d];
+        pixel.TexColor[RED_C] = texel[bpmem.tevksel[swaptable].swap1];
+        pixel.TexColor[GRN_C] = texel[bpmem.tevksel[swaptable].swap2];
+        swaptable++;
+        pixel.TexColor[BLU_C] = texel[bpmem.tevksel[swaptable].swap1];
+        pixel.TexColor[ALP_C] = texel[bpmem.tevksel[swaptable].swap2];
+      }
 
-    if (cc.bias != 3)
-      DrawColorRegular(cc, inputs);
-    else
-      DrawColorCompare(cc, inputs);
+      // set konst for this stage
+      pixel.StageKonst[RED_C] = *(m_KonstLUT[kc][RED_C]);
+      pixel.StageKonst[GRN_C] = *(m_KonstLUT[kc][GRN_C]);
+      pixel.StageKonst[BLU_C] = *(m_KonstLUT[kc][BLU_C]);
+      pixel.StageKonst[ALP_C] = *(m_KonstLUT[ka][ALP_C]);
 
-    if (cc.clamp)
-    {
-      Reg[cc.dest][RED_C] = Clamp255(Reg[cc.dest][RED_C]);
-      Reg[cc.dest][GRN_C] = Clamp255(Reg[cc.dest][GRN_C]);
-      Reg[cc.dest][BLU_C] = Clamp255(Reg[cc.dest][BLU_C]);
-    }
-    else
-    {
-      Reg[cc.dest][RED_C] = Clamp1024(Reg[cc.dest][RED_C]);
-      Reg[cc.dest][GRN_C] = Clamp1024(Reg[cc.dest][GRN_C]);
-      Reg[cc.dest][BLU_C] = Clamp1024(Reg[cc.dest][BLU_C]);
+      // set color
+      SetRasColor(i, order.getColorChan(stageOdd), ac.rswap * 2);
     }
 
-    if (ac.bias != 3)
-      DrawAlphaRegular(ac, inputs);
-    else
-      DrawAlphaCompare(ac, inputs);
-
-    if (ac.clamp)
-      Reg[ac.dest][ALP_C] = Clamp255(Reg[ac.dest][ALP_C]);
-    else
-      Reg[ac.dest][ALP_C] = Clamp1024(Reg[ac.dest][ALP_C]);
+    m_combiners.Combine(cc, ac, mask);
 
 #if ALLOW_TEV_DUMPS
     if (g_ActiveConfig.bDumpTevStages)
     {
-      u8 stage[4] = {(u8)Reg[0][RED_C], (u8)Reg[0][GRN_C], (u8)Reg[0][BLU_C], (u8)Reg[0][ALP_C]};
-      DebugUtil::DrawTempBuffer(stage, DIRECT + stageNum);
+      for (int i = 0; i < TevCombiners::NUM_PIXELS; i++)
+      {
+        if (!(mask & (1 << i)))
+          continue;
+
+        const s16(&prev)[4] = m_combiners.GetPixel(i).Reg[0];
+        u8 stage[4] = {(u8)prev[RED_C], (u8)prev[GRN_C], (u8)prev[BLU_C], (u8)prev[ALP_C]};
+        DebugUtil::DrawTempBuffer(stage, DIRECT + stageNum);
+      }
     }
 #endif
   }
 
+  for (int i = 0; i < TevCombiners::NUM_PIXELS; i++)
+  {
+    if (mask & (1 << i))
+      OutputPixel(i);
+  }
+}
+
+void Tev::OutputPixel(int index)
+{
+  const TevCombiners::Pixel& pixel = m_combiners.GetPixel(index);
+  s32(&position)[3] = Pixels[index].Position;
+
   // convert to 8 bits per component
   // the results of the last tev stage are put onto the screen,
   // regardless of the used destination register - TODO: Verify!
   const u32 color_index = bpmem.combiners[bpmem.genMode.numtevstages].colorC.dest;
   const u32 alpha_index = bpmem.combiners[bpmem.genMode.numtevstages].alphaC.dest;
-  u8 output[4] = {(u8)Reg[alpha_index][ALP_C], (u8)Reg[color_index][BLU_C],
-                  (u8)Reg[color_index][GRN_C], (u8)Reg[color_index][RED_C]};
+  u8 output[4] = {(u8)pixel.Reg[alpha_index][ALP_C], (u8)pixel.Reg[color_index][BLU_C],
+                  (u8)pixel.Reg[color_index][GRN_C], (u8)pixel.Reg[color_index][RED_C]};
 
   if (!TevAlphaTest(output[ALP_C]))
     return;
@@ -727,20 +509,20 @@ void Tev::Draw()
     switch (bpmem.ztex2.type)
     {
     case 0:  // 8 bit
-      ztex += TexColor[ALP_C];
+      ztex += pixel.TexColor[ALP_C];
       break;
     case 1:  // 16 bit
-      ztex += TexColor[ALP_C] << 8 | TexColor[RED_C];
+      ztex += pixel.TexColor[ALP_C] << 8 | pixel.TexColor[RED_C];
       break;
     case 2:  // 24 bit
-      ztex += TexColor[RED_C] << 16 | TexColor[GRN_C] << 8 | TexColor[BLU_C];
+      ztex += pixel.TexColor[RED_C] << 16 | pixel.TexColor[GRN_C] << 8 | pixel.TexColor[BLU_C];
       break;
     }
 
     if (bpmem.ztex2.op == ZTEXTURE_ADD)
-      ztex += Position[2];
+      ztex += position[2];
 
-    Position[2] = ztex & 0x00ffffff;
+    position[2] = ztex & 0x00ffffff;
   }
 
   // fog
@@ -752,7 +534,7 @@ void Tev::Draw()
     {
       // perspective
       // ze = A/(B - (Zs >> B_SHF))
-      const s32 denom = bpmem.fog.b_magnitude - (Position[2] >> bpmem.fog.b_shift);
+      const s32 denom = bpmem.fog.b_magnitude - (position[2] >> bpmem.fog.b_shift);
       // in addition downscale magnitude and zs to 0.24 bits
       ze = (bpmem.fog.GetA() * 16777215.0f) / static_cast<float>(denom);
     }
@@ -761,7 +543,7 @@ void Tev::Draw()
       // orthographic
       // ze = a*Zs
       // in addition downscale zs to 0.24 bits
-      ze = bpmem.fog.GetA() * (static_cast<float>(Position[2]) / 16777215.0f);
+      ze = bpmem.fog.GetA() * (static_cast<float>(position[2]) / 16777215.0f);
     }
 
     if (bpmem.fogRange.Base.Enabled)
@@ -773,7 +555,7 @@ void Tev::Draw()
 
       // First, calculate the offset from the viewport center (normalized to 0..1)
       const float offset =
-          (Position[0] - (static_cast<s32>(bpmem.fogRange.Base.Center.Value()) - 342)) /
+          (position[0] - (static_cast<s32>(bpmem.fogRange.Base.Center.Value()) - 342)) /
           static_cast<float>(xfmem.viewport.wd);
 
       // Based on that, choose the index such that points which are far away from the z-axis use the
@@ -835,22 +617,24 @@ void Tev::Draw()
     // TODO: Check against hw if these values get incremented even if depth testing is disabled
     EfbInterface::IncPerfCounterQuadCount(PQ_ZCOMP_INPUT);
 
-    if (!EfbInterface::ZCompare(Position[0], Position[1], Position[2]))
+    if (!EfbInterface::ZCompare(position[0], position[1], position[2]))
       return;
 
     EfbInterface::IncPerfCounterQuadCount(PQ_ZCOMP_OUTPUT);
   }
 
-  BoundingBox::Update(static_cast<u16>(Position[0]), static_cast<u16>(Position[0]),
-                      static_cast<u16>(Position[1]), static_cast<u16>(Position[1]));
+  m_bbox_left = std::min(m_bbox_left, static_cast<u16>(position[0]));
+  m_bbox_right = std::max(m_bbox_right, static_cast<u16>(position[0]));
+  m_bbox_top = std::min(m_bbox_top, static_cast<u16>(position[1]));
+  m_bbox_bottom = std::max(m_bbox_bottom, static_cast<u16>(position[1]));
 
 #if ALLOW_TEV_DUMPS
   if (g_ActiveConfig.bDumpTevStages)
   {
     for (u32 i = 0; i < bpmem.genMode.numindstages; ++i)
-      DebugUtil::CopyTempBuffer(Position[0], Position[1], INDIRECT, i, "Indirect");
+      DebugUtil::CopyTempBuffer(position[0], position[1], INDIRECT, i, "Indirect");
     for (u32 i = 0; i <= bpmem.genMode.numtevstages; ++i)
-      DebugUtil::CopyTempBuffer(Position[0], Position[1], DIRECT, i, "Stage");
+      DebugUtil::CopyTempBuffer(position[0], position[1], DIRECT, i, "Stage");
   }
 
   if (g_ActiveConfig.bDumpTevTextureFetches)
@@ -859,15 +643,30 @@ void Tev::Draw()
     {
       TwoTevStageOrders& order = bpmem.tevorders[i >> 1];
       if (order.getEnable(i & 1))
-        DebugUtil::CopyTempBuffer(Position[0], Position[1], DIRECT_TFETCH, i, "TFetch");
+        DebugUtil::CopyTempBuffer(position[0], position[1], DIRECT_TFETCH, i, "TFetch");
     }
   }
 #endif
 
-  INCSTAT(g_stats.this_frame.tev_pixels_out);
+  m_pixels_out++;
   EfbInterface::IncPerfCounterQuadCount(PQ_BLEND_INPUT);
 
-  EfbInterface::BlendTev(Position[0], Position[1], output);
+  EfbInterface::BlendTev(position[0], position[1], output);
+}
+
+void Tev::FlushCounters()
+{
+  ADDSTAT(g_stats.this_frame.tev_pixels_in, m_pixels_in);
+  ADDSTAT(g_stats.this_frame.tev_pixels_out, m_pixels_out);
+  m_pixels_in = 0;
+  m_pixels_out = 0;
+
+  if (m_bbox_left <= m_bbox_right)
+    BoundingBox::Update(m_bbox_left, m_bbox_right, m_bbox_top, m_bbox_bottom);
+  m_bbox_left = 0xFFFF;
+  m_bbox_right = 0;
+  m_bbox_top = 0xFFFF;
+  m_bbox_bottom = 0;
 }
 
 void Tev::SetRegColor(int reg, int comp, s16 color)
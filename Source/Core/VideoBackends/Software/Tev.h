@@ -4,51 +4,44 @@
 
 #pragma once
 
+#include "VideoBackends/Software/TevCombiners.h"
 #include "VideoCommon/BPMemory.h"
 
+// Shades the pixels of a 2x2 block together, so that the combiners of a stage run on all of them
+// at once.
 class Tev
 {
-  struct InputRegType
-  {
-    unsigned a : 8;
-    unsigned b : 8;
-    unsigned c : 8;
-    signed d : 11;
-  };
-
+public:
   struct TextureCoordinateType
   {
     signed s : 24;
     signed t : 24;
   };
 
-  // color order: ABGR
-  s16 Reg[4][4];
-  s16 KonstantColors[4][4];
-  s16 TexColor[4];
-  s16 RasColor[4];
-  s16 StageKonst[4];
-  s16 Zero16[4];
+  // What the rasterizer sets for each pixel of the block.
+  struct Pixel
+  {
+    s32 Position[3];
+    u8 Color[2][4];  // must be RGBA for correct swap table ordering
+    TextureCoordinateType Uv[8];
+  };
+
+private:
+  // State of each pixel between the stages, besides what the combiners read and write.
+  struct PixelState
+  {
+    u8 AlphaBump;
+    u8 IndirectTex[4][4];
+    TextureCoordinateType TexCoord;
+  };
 
+  s16 KonstantColors[4][4];
   s16 FixedConstants[9];
-  u8 AlphaBump;
-  u8 IndirectTex[4][4];
-  TextureCoordinateType TexCoord;
 
-  s16* m_ColorInputLUT[16][3];
-  s16* m_AlphaInputLUT[8];  // values must point to ABGR color
-  s16* m_KonstLUT[32][4];
-  s16 m_BiasLUT[4];
-  u8 m_ScaleLShiftLUT[4];
-  u8 m_ScaleRShiftLUT[4];
+  TevCombiners m_combiners;
+  PixelState m_state[TevCombiners::NUM_PIXELS];
 
-  // enumeration for color input LUT
-  enum
-  {
-    BLU_INP,
-    GRN_INP,
-    RED_INP
-  };
+  s16* m_KonstLUT[32][4];
 
   enum BufferBase
   {
@@ -57,19 +50,24 @@ class Tev
     INDIRECT = 32
   };
 
-  void SetRasColor(int colorChan, int swaptable);
+  void SetRasColor(int index, int colorChan, int swaptable);
 
-  void DrawColorRegular(const TevStageCombiner::ColorCombiner& cc, const InputRegType inputs[4]);
-  void DrawColorCompare(const TevStageCombiner::ColorCombiner& cc, const InputRegType inputs[4]);
-  void DrawAlphaRegular(const TevStageCombiner::AlphaCombiner& ac, const InputRegType inputs[4]);
-  void DrawAlphaCompare(const TevStageCombiner::AlphaCombiner& ac, const InputRegType inputs[4]);
+  void Indirect(int index, unsigned int stageNum, s32 s, s32 t);
 
-  void Indirect(unsigned int stageNum, s32 s, s32 t);
+  // Runs everything after the last stage for one pixel.
+  void OutputPixel(int index);
+
+  // Statistics and bounding box of the pixels drawn since the last FlushCounters. They are kept
+  // per Tev rather than updated in place, so that several Tevs can draw at once.
+  u32 m_pixels_in = 0;
+  u32 m_pixels_out = 0;
+  u16 m_bbox_left = 0xFFFF;
+  u16 m_bbox_right = 0;
+  u16 m_bbox_top = 0xFFFF;
+  u16 m_bbox_bottom = 0;
 
 public:
-  s32 Position[3];
-  u8 Color[2][4];  // must be RGBA for correct swap table ordering
-  TextureCoordinateType Uv[8];
+  Pixel Pixels[TevCombiners::NUM_PIXELS];
   s32 IndirectLod[4];
   bool IndirectLinear[4];
   s32 TextureLod[16];
@@ -77,15 +75,20 @@ public:
 
   enum
   {
-    ALP_C,
-    BLU_C,
-    GRN_C,
-    RED_C
+    ALP_C = TevCombiners::ALP_C,
+    BLU_C = TevCombiners::BLU_C,
+    GRN_C = TevCombiners::GRN_C,
+    RED_C = TevCombiners::RED_C
   };
 
   void Init();
 
-  void Draw();
+  // Draws the pixels of the block whose bit is set in mask.
+  void Draw(u32 mask);
+
+  // Adds the counters to the frame statistics and the bounding box, and resets them. Must not be
+  // called while another Tev is drawing.
+  void FlushCounters();
 
   void SetRegColor(int reg, int comp, s16 color);
 };
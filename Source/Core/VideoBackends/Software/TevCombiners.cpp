@@ -0,0 +1,468 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "VideoBackends/Software/TevCombiners.h"
+
+#include <type_traits>
+
+#include "Common/CommonTypes.h"
+#include "Common/Intrinsics.h"
+
+// GetInput reads a Pixel as an array of s16.
+static_assert(std::is_standard_layout_v<TevCombiners::Pixel> &&
+                  sizeof(TevCombiners::Pixel) % sizeof(s16) == 0,
+              "Pixel must only hold s16");
+
+void TevCombiners::Init()
+{
+  for (Pixel& pixel : m_pixels)
+  {
+    pixel.One = 255;
+    pixel.Half = 128;
+    pixel.Zero = 0;
+  }
+
+  const Pixel& first = m_pixels[0];
+  const auto offset = [&first](const s16& input) {
+    return static_cast<u8>(&input - reinterpret_cast<const s16*>(&first));
+  };
+
+  m_ColorInputLUT[0][RED_INP] = offset(first.Reg[0][RED_C]);
+  m_ColorInputLUT[0][GRN_INP] = offset(first.Reg[0][GRN_C]);
+  m_ColorInputLUT[0][BLU_INP] = offset(first.Reg[0][BLU_C]);  // prev.rgb
+  m_ColorInputLUT[1][RED_INP] = offset(first.Reg[0][ALP_C]);
+  m_ColorInputLUT[1][GRN_INP] = offset(first.Reg[0][ALP_C]);
+  m_ColorInputLUT[1][BLU_INP] = offset(first.Reg[0][ALP_C]);  // prev.aaa
+  m_ColorInputLUT[2][RED_INP] = offset(first.Reg[1][RED_C]);
+  m_ColorInputLUT[2][GRN_INP] = offset(first.Reg[1][GRN_C]);
+  m_ColorInputLUT[2][BLU_INP] = offset(first.Reg[1][BLU_C]);  // c0.rgb
+  m_ColorInputLUT[3][RED_INP] = offset(first.Reg[1][ALP_C]);
+  m_ColorInputLUT[3][GRN_INP] = offset(first.Reg[1][ALP_C]);
+  m_ColorInputLUT[3][BLU_INP] = offset(first.Reg[1][ALP_C]);  // c0.aaa
+  m_ColorInputLUT[4][RED_INP] = offset(first.Reg[2][RED_C]);
+  m_ColorInputLUT[4][GRN_INP] = offset(first.Reg[2][GRN_C]);
+  m_ColorInputLUT[4][BLU_INP] = offset(first.Reg[2][BLU_C]);  // c1.rgb
+  m_ColorInputLUT[5][RED_INP] = offset(first.Reg[2][ALP_C]);
+  m_ColorInputLUT[5][GRN_INP] = offset(first.Reg[2][ALP_C]);
+  m_ColorInputLUT[5][BLU_INP] = offset(first.Reg[2][ALP_C]);  // c1.aaa
+  m_ColorInputLUT[6][RED_INP] = offset(first.Reg[3][RED_C]);
+  m_ColorInputLUT[6][GRN_INP] = offset(first.Reg[3][GRN_C]);
+  m_ColorInputLUT[6][BLU_INP] = offset(first.Reg[3][BLU_C]);  // c2.rgb
+  m_ColorInputLUT[7][RED_INP] = offset(first.Reg[3][ALP_C]);
+  m_ColorInputLUT[7][GRN_INP] = offset(first.Reg[3][ALP_C]);
+  m_ColorInputLUT[7][BLU_INP] = offset(first.Reg[3][ALP_C]);  // c2.aaa
+  m_ColorInputLUT[8][RED_INP] = offset(first.TexColor[RED_C]);
+  m_ColorInputLUT[8][GRN_INP] = offset(first.TexColor[GRN_C]);
+  m_ColorInputLUT[8][BLU_INP] = offset(first.TexColor[BLU_C]);  // tex.rgb
+  m_ColorInputLUT[9][RED_INP] = offset(first.TexColor[ALP_C]);
+  m_ColorInputLUT[9][GRN_INP] = offset(first.TexColor[ALP_C]);
+  m_ColorInputLUT[9][BLU_INP] = offset(first.TexColor[ALP_C]);  // tex.aaa
+  m_ColorInputLUT[10][RED_INP] = offset(first.RasColor[RED_C]);
+  m_ColorInputLUT[10][GRN_INP] = offset(first.RasColor[GRN_C]);
+  m_ColorInputLUT[10][BLU_INP] = offset(first.RasColor[BLU_C]);  // ras.rgb
+  m_ColorInputLUT[11][RED_INP] = offset(first.RasColor[ALP_C]);
+  m_ColorInputLUT[11][GRN_INP] = offset(first.RasColor[ALP_C]);
+  m_ColorInputLUT[11][BLU_INP] = offset(first.RasColor[ALP_C]);  // ras.rgb
+  m_ColorInputLUT[12][RED_INP] = offset(first.One);
+  m_ColorInputLUT[12][GRN_INP] = offset(first.One);
+  m_ColorInputLUT[12][BLU_INP] = offset(first.One);  // one
+  m_ColorInputLUT[13][RED_INP] = offset(first.Half);
+  m_ColorInputLUT[13][GRN_INP] = offset(first.Half);
+  m_ColorInputLUT[13][BLU_INP] = offset(first.Half);  // half
+  m_ColorInputLUT[14][RED_INP] = offset(first.StageKonst[RED_C]);
+  m_ColorInputLUT[14][GRN_INP] = offset(first.StageKonst[GRN_C]);
+  m_ColorInputLUT[14][BLU_INP] = offset(first.StageKonst[BLU_C]);  // konst
+  m_ColorInputLUT[15][RED_INP] = offset(first.Zero);
+  m_ColorInputLUT[15][GRN_INP] = offset(first.Zero);
+  m_ColorInputLUT[15][BLU_INP] = offset(first.Zero);  // zero
+
+  m_AlphaInputLUT[0] = offset(first.Reg[0][ALP_C]);      // prev
+  m_AlphaInputLUT[1] = offset(first.Reg[1][ALP_C]);      // c0
+  m_AlphaInputLUT[2] = offset(first.Reg[2][ALP_C]);      // c1
+  m_AlphaInputLUT[3] = offset(first.Reg[3][ALP_C]);      // c2
+  m_AlphaInputLUT[4] = offset(first.TexColor[ALP_C]);    // tex
+  m_AlphaInputLUT[5] = offset(first.RasColor[ALP_C]);    // ras
+  m_AlphaInputLUT[6] = offset(first.StageKonst[ALP_C]);  // konst
+  m_AlphaInputLUT[7] = offset(first.Zero);               // zero
+
+  m_BiasLUT[0] = 0;
+  m_BiasLUT[1] = 128;
+  m_BiasLUT[2] = -128;
+  m_BiasLUT[3] = 0;
+
+  m_ScaleLShiftLUT[0] = 0;
+  m_ScaleLShiftLUT[1] = 1;
+  m_ScaleLShiftLUT[2] = 2;
+  m_ScaleLShiftLUT[3] = 0;
+
+  m_ScaleRShiftLUT[0] = 0;
+  m_ScaleRShiftLUT[1] = 0;
+  m_ScaleRShiftLUT[2] = 0;
+  m_ScaleRShiftLUT[3] = 1;
+}
+
+static inline s16 Clamp255(s16 in)
+{
+  return in > 255 ? 255 : (in < 0 ? 0 : in);
+}
+
+static inline s16 Clamp1024(s16 in)
+{
+  return in > 1023 ? 1023 : (in < -1024 ? -1024 : in);
+}
+
+void TevCombiners::DrawColorRegular(const TevStageCombiner::ColorCombiner& cc,
+                                    const InputRegType inputs[4], Pixel& pixel)
+{
+  for (int i = 0; i < 3; i++)
+  {
+    const InputRegType& InputReg = inputs[BLU_C + i];
+
+    const u16 c = InputReg.c + (InputReg.c >> 7);
+
+    s32 temp = InputReg.a * (256 - c) + (InputReg.b * c);
+    temp <<= m_ScaleLShiftLUT[cc.shift];
+    temp += (cc.shift == 3) ? 0 : (cc.op == 1) ? 127 : 128;
+    temp >>= 8;
+    temp = cc.op ? -temp : temp;
+
+    s32 result = ((InputReg.d + m_BiasLUT[cc.bias]) << m_ScaleLShiftLUT[cc.shift]) + temp;
+    result = result >> m_ScaleRShiftLUT[cc.shift];
+
+    pixel.Reg[cc.dest][BLU_C + i] = result;
+  }
+}
+
+void TevCombiners::DrawColorCompare(const TevStageCombiner::ColorCombiner& cc,
+                                    const InputRegType inputs[4], Pixel& pixel)
+{
+  for (int i = BLU_C; i <= RED_C; i++)
+  {
+    switch ((cc.shift << 1) | cc.op | 8)  // encoded compare mode
+    {
+    case TEVCMP_R8_GT:
+      pixel.Reg[cc.dest][i] =
+          inputs[i].d + ((inputs[RED_C].a > inputs[RED_C].b) ? inputs[i].c : 0);
+      break;
+
+    case TEVCMP_R8_EQ:
+      pixel.Reg[cc.dest][i] =
+          inputs[i].d + ((inputs[RED_C].a == inputs[RED_C].b) ? inputs[i].c : 0);
+      break;
+
+    case TEVCMP_GR16_GT:
+    {
+      const u32 a = (inputs[GRN_C].a << 8) | inputs[RED_C].a;
+      const u32 b = (inputs[GRN_C].b << 8) | inputs[RED_C].b;
+      pixel.Reg[cc.dest][i] = inputs[i].d + ((a > b) ? inputs[i].c : 0);
+    }
+    break;
+
+    case TEVCMP_GR16_EQ:
+    {
+      const u32 a = (inputs[GRN_C].a << 8) | inputs[RED_C].a;
+      const u32 b = (inputs[GRN_C].b << 8) | inputs[RED_C].b;
+      pixel.Reg[cc.dest][i] = inputs[i].d + ((a == b) ? inputs[i].c : 0);
+    }
+    break;
+
+    case TEVCMP_BGR24_GT:
+    {
+      const u32 a = (inputs[BLU_C].a << 16) | (inputs[GRN_C].a << 8) | inputs[RED_C].a;
+      const u32 b = (inputs[BLU_C].b << 16) | (inputs[GRN_C].b << 8) | inputs[RED_C].b;
+      pixel.Reg[cc.dest][i] = inputs[i].d + ((a > b) ? inputs[i].c : 0);
+    }
+    break;
+
+    case TEVCMP_BGR24_EQ:
+    {
+      const u32 a = (inputs[BLU_C].a << 16) | (inputs[GRN_C].a << 8) | inputs[RED_C].a;
+      const u32 b = (inputs[BLU_C].b << 16) | (inputs[GRN_C].b << 8) | inputs[RED_C].b;
+      pixel.Reg[cc.dest][i] = inputs[i].d + ((a == b) ? inputs[i].c : 0);
+    }
+    break;
+
+    case TEVCMP_RGB8_GT:
+      pixel.Reg[cc.dest][i] = inputs[i].d + ((inputs[i].a > inputs[i].b) ? inputs[i].c : 0);
+      break;
+
+    case TEVCMP_RGB8_EQ:
+      pixel.Reg[cc.dest][i] = inputs[i].d + ((inputs[i].a == inputs[i].b) ? inputs[i].c : 0);
+      break;
+    }
+  }
+}
+
+void TevCombiners::DrawAlphaRegular(const TevStageCombiner::AlphaCombiner& ac,
+                                    const InputRegType inputs[4], Pixel& pixel)
+{
+  const InputRegType& InputReg = inputs[ALP_C];
+
+  const u16 c = InputReg.c + (InputReg.c >> 7);
+
+  s32 temp = InputReg.a * (256 - c) + (InputReg.b * c);
+  temp <<= m_ScaleLShiftLUT[ac.shift];
+  temp += (ac.shift != 3) ? 0 : (ac.op == 1) ? 127 : 128;
+  temp = ac.op ? (-temp >> 8) : (temp >> 8);
+
+  s32 result = ((InputReg.d + m_BiasLUT[ac.bias]) << m_ScaleLShiftLUT[ac.shift]) + temp;
+  result = result >> m_ScaleRShiftLUT[ac.shift];
+
+  pixel.Reg[ac.dest][ALP_C] = result;
+}
+
+void TevCombiners::DrawAlphaCompare(const TevStageCombiner::AlphaCombiner& ac,
+                                    const InputRegType inputs[4], Pixel& pixel)
+{
+  switch ((ac.shift << 1) | ac.op | 8)  // encoded compare mode
+  {
+  case TEVCMP_R8_GT:
+    pixel.Reg[ac.dest][ALP_C] =
+        inputs[ALP_C].d + ((inputs[RED_C].a > inputs[RED_C].b) ? inputs[ALP_C].c : 0);
+    break;
+
+  case TEVCMP_R8_EQ:
+    pixel.Reg[ac.dest][ALP_C] =
+        inputs[ALP_C].d + ((inputs[RED_C].a == inputs[RED_C].b) ? inputs[ALP_C].c : 0);
+    break;
+
+  case TEVCMP_GR16_GT:
+  {
+    const u32 a = (inputs[GRN_C].a << 8) | inputs[RED_C].a;
+    const u32 b = (inputs[GRN_C].b << 8) | inputs[RED_C].b;
+    pixel.Reg[ac.dest][ALP_C] = inputs[ALP_C].d + ((a > b) ? inputs[ALP_C].c : 0);
+  }
+  break;
+
+  case TEVCMP_GR16_EQ:
+  {
+    const u32 a = (inputs[GRN_C].a << 8) | inputs[RED_C].a;
+    const u32 b = (inputs[GRN_C].b << 8) | inputs[RED_C].b;
+    pixel.Reg[ac.dest][ALP_C] = inputs[ALP_C].d + ((a == b) ? inputs[ALP_C].c : 0);
+  }
+  break;
+
+  case TEVCMP_BGR24_GT:
+  {
+    const u32 a = (inputs[BLU_C].a << 16) | (inputs[GRN_C].a << 8) | inputs[RED_C].a;
+    const u32 b = (inputs[BLU_C].b << 16) | (inputs[GRN_C].b << 8) | inputs[RED_C].b;
+    pixel.Reg[ac.dest][ALP_C] = inputs[ALP_C].d + ((a > b) ? inputs[ALP_C].c : 0);
+  }
+  break;
+
+  case TEVCMP_BGR24_EQ:
+  {
+    const u32 a = (inputs[BLU_C].a << 16) | (inputs[GRN_C].a << 8) | inputs[RED_C].a;
+    const u32 b = (inputs[BLU_C].b << 16) | (inputs[GRN_C].b << 8) | inputs[RED_C].b;
+    pixel.Reg[ac.dest][ALP_C] = inputs[ALP_C].d + ((a == b) ? inputs[ALP_C].c : 0);
+  }
+  break;
+
+  case TEVCMP_A8_GT:
+    pixel.Reg[ac.dest][ALP_C] =
+        inputs[ALP_C].d + ((inputs[ALP_C].a > inputs[ALP_C].b) ? inputs[ALP_C].c : 0);
+    break;
+
+  case TEVCMP_A8_EQ:
+    pixel.Reg[ac.dest][ALP_C] =
+        inputs[ALP_C].d + ((inputs[ALP_C].a == inputs[ALP_C].b) ? inputs[ALP_C].c : 0);
+    break;
+  }
+}
+
+#ifdef _M_X86
+// Runs the color and alpha combiners of every pixel when neither of them is in compare mode, and
+// clamps the results. Each 32-bit lane computes one component of a pixel in the same order as
+// Reg, which is what DrawColorRegular and DrawAlphaRegular do, except for the rounding and the
+// order of the negation and the shift, which differ between color and alpha. The products are
+// widened by pmaddwd one pixel at a time, everything else that fits in 16 bits is done for two
+// pixels at once, and the constants of the stage are only set up once for the block.
+void TevCombiners::CombineRegular(const TevStageCombiner::ColorCombiner& cc,
+                                  const TevStageCombiner::AlphaCombiner& ac)
+{
+  const u8* const color_a = m_ColorInputLUT[cc.a];
+  const u8* const color_b = m_ColorInputLUT[cc.b];
+  const u8* const color_c = m_ColorInputLUT[cc.c];
+  const u8* const color_d = m_ColorInputLUT[cc.d];
+  const u8 alpha_a = m_AlphaInputLUT[ac.a];
+  const u8 alpha_b = m_AlphaInputLUT[ac.b];
+  const u8 alpha_c = m_AlphaInputLUT[ac.c];
+  const u8 alpha_d = m_AlphaInputLUT[ac.d];
+
+  // Like InputRegType, a, b and c are truncated to 8 bits and d is sign extended from 11 bits.
+  const __m128i mask8 = _mm_set1_epi16(0xFF);
+
+  // The weights of a and b are 256 - c and c, with c scaled from 0-255 to 0-256. Shifting the
+  // weights left shifts the products, and they stay below 1024.
+  const s16 color_scale = 1 << m_ScaleLShiftLUT[cc.shift];
+  const s16 alpha_scale = 1 << m_ScaleLShiftLUT[ac.shift];
+  const __m128i weight_negate = _mm_setr_epi16(-1, 0, -1, 0, -1, 0, -1, 0);
+  const __m128i weight_add = _mm_setr_epi16(257, 0, 257, 0, 257, 0, 257, 0);
+  const __m128i weight_scale =
+      _mm_setr_epi16(alpha_scale, alpha_scale, color_scale, color_scale, color_scale, color_scale,
+                     color_scale, color_scale);
+
+  const s32 color_round = (cc.shift == 3) ? 0 : (cc.op == 1) ? 127 : 128;
+  const s32 alpha_round = (ac.shift != 3) ? 0 : (ac.op == 1) ? 127 : 128;
+  const __m128i round = _mm_setr_epi32(alpha_round, color_round, color_round, color_round);
+
+  // Alpha is negated before the shift, color after it.
+  const __m128i negate_before = _mm_setr_epi32(ac.op ? -1 : 0, 0, 0, 0);
+  const s32 color_negate = cc.op ? -1 : 0;
+  const __m128i negate_after = _mm_setr_epi32(0, color_negate, color_negate, color_negate);
+
+  // For two pixels.
+  const s16 color_bias = m_BiasLUT[cc.bias];
+  const s16 alpha_bias = m_BiasLUT[ac.bias];
+  const __m128i bias = _mm_setr_epi16(alpha_bias, color_bias, color_bias, color_bias, alpha_bias,
+                                      color_bias, color_bias, color_bias);
+  const __m128i d_scale = _mm_setr_epi16(alpha_scale, color_scale, color_scale, color_scale,
+                                         alpha_scale, color_scale, color_scale, color_scale);
+
+  const s32 color_divide = m_ScaleRShiftLUT[cc.shift] ? -1 : 0;
+  const s32 alpha_divide = m_ScaleRShiftLUT[ac.shift] ? -1 : 0;
+  const __m128i divide = _mm_setr_epi32(alpha_divide, color_divide, color_divide, color_divide);
+
+  const s16 color_min = cc.clamp ? 0 : -1024;
+  const s16 color_max = cc.clamp ? 255 : 1023;
+  const s16 alpha_min = ac.clamp ? 0 : -1024;
+  const s16 alpha_max = ac.clamp ? 255 : 1023;
+  const __m128i min = _mm_setr_epi16(alpha_min, color_min, color_min, color_min, alpha_min,
+                                     color_min, color_min, color_min);
+  const __m128i max = _mm_setr_epi16(alpha_max, color_max, color_max, color_max, alpha_max,
+                                     color_max, color_max, color_max);
+
+  for (int first = 0; first < NUM_PIXELS; first += 2)
+  {
+    Pixel* const pixels[2] = {&m_pixels[first], &m_pixels[first + 1]};
+
+    __m128i products[2];
+    for (int i = 0; i < 2; ++i)
+    {
+      const Pixel& pixel = *pixels[i];
+
+      // a and b are interleaved, for pmaddwd.
+      const __m128i ab = _mm_and_si128(
+          _mm_setr_epi16(GetInput(pixel, alpha_a), GetInput(pixel, alpha_b),
+                         GetInput(pixel, color_a[BLU_INP]), GetInput(pixel, color_b[BLU_INP]),
+                         GetInput(pixel, color_a[GRN_INP]), GetInput(pixel, color_b[GRN_INP]),
+                         GetInput(pixel, color_a[RED_INP]), GetInput(pixel, color_b[RED_INP])),
+          mask8);
+      __m128i c = _mm_and_si128(
+          _mm_setr_epi16(GetInput(pixel, alpha_c), GetInput(pixel, alpha_c),
+                         GetInput(pixel, color_c[BLU_INP]), GetInput(pixel, color_c[BLU_INP]),
+                         GetInput(pixel, color_c[GRN_INP]), GetInput(pixel, color_c[GRN_INP]),
+                         GetInput(pixel, color_c[RED_INP]), GetInput(pixel, color_c[RED_INP])),
+          mask8);
+
+      c = _mm_add_epi16(c, _mm_srli_epi16(c, 7));
+      __m128i weights = _mm_add_epi16(_mm_xor_si128(c, weight_negate), weight_add);
+      weights = _mm_mullo_epi16(weights, weight_scale);
+
+      __m128i temp = _mm_add_epi32(_mm_madd_epi16(ab, weights), round);
+      temp = _mm_sub_epi32(_mm_xor_si128(temp, negate_before), negate_before);
+      temp = _mm_srai_epi32(temp, 8);
+      products[i] = _mm_sub_epi32(_mm_xor_si128(temp, negate_after), negate_after);
+    }
+
+    __m128i d = _mm_setr_epi16(
+        GetInput(*pixels[0], alpha_d), GetInput(*pixels[0], color_d[BLU_INP]),
+        GetInput(*pixels[0], color_d[GRN_INP]), GetInput(*pixels[0], color_d[RED_INP]),
+        GetInput(*pixels[1], alpha_d), GetInput(*pixels[1], color_d[BLU_INP]),
+        GetInput(*pixels[1], color_d[GRN_INP]), GetInput(*pixels[1], color_d[RED_INP]));
+    d = _mm_srai_epi16(_mm_slli_epi16(d, 5), 5);
+    d = _mm_mullo_epi16(_mm_add_epi16(d, bias), d_scale);
+
+    // Sign extend to 32 bits.
+    __m128i results[2] = {_mm_srai_epi32(_mm_unpacklo_epi16(d, d), 16),
+                          _mm_srai_epi32(_mm_unpackhi_epi16(d, d), 16)};
+    for (int i = 0; i < 2; ++i)
+    {
+      const __m128i result = _mm_add_epi32(results[i], products[i]);
+      results[i] = _mm_or_si128(_mm_and_si128(divide, _mm_srai_epi32(result, 1)),
+                                _mm_andnot_si128(divide, result));
+    }
+
+    __m128i result = _mm_packs_epi32(results[0], results[1]);
+    result = _mm_min_epi16(_mm_max_epi16(result, min), max);
+
+    alignas(16) s16 components[8];
+    _mm_store_si128(reinterpret_cast<__m128i*>(components), result);
+    for (int i = 0; i < 2; ++i)
+    {
+      Pixel& pixel = *pixels[i];
+      pixel.Reg[cc.dest][BLU_C] = components[i * 4 + BLU_C];
+      pixel.Reg[cc.dest][GRN_C] = components[i * 4 + GRN_C];
+      pixel.Reg[cc.dest][RED_C] = components[i * 4 + RED_C];
+      pixel.Reg[ac.dest][ALP_C] = components[i * 4 + ALP_C];
+    }
+  }
+}
+#endif
+
+void TevCombiners::Combine(const TevStageCombiner::ColorCombiner& cc,
+                           const TevStageCombiner::AlphaCombiner& ac, u32 mask)
+{
+#ifdef _M_X86
+  if (cc.bias != 3 && ac.bias != 3)
+  {
+    CombineRegular(cc, ac);
+    return;
+  }
+#endif
+
+  for (int i = 0; i < NUM_PIXELS; ++i)
+  {
+    if (mask & (1 << i))
+      CombineScalar(cc, ac, i);
+  }
+}
+
+void TevCombiners::CombineScalar(const TevStageCombiner::ColorCombiner& cc,
+                                 const TevStageCombiner::AlphaCombiner& ac, int index)
+{
+  Pixel& pixel = m_pixels[index];
+
+  // combine inputs
+  InputRegType inputs[4];
+  for (int i = 0; i < 3; i++)
+  {
+    inputs[BLU_C + i].a = GetInput(pixel, m_ColorInputLUT[cc.a][i]);
+    inputs[BLU_C + i].b = GetInput(pixel, m_ColorInputLUT[cc.b][i]);
+    inputs[BLU_C + i].c = GetInput(pixel, m_ColorInputLUT[cc.c][i]);
+    inputs[BLU_C + i].d = GetInput(pixel, m_ColorInputLUT[cc.d][i]);
+  }
+  inputs[ALP_C].a = GetInput(pixel, m_AlphaInputLUT[ac.a]);
+  inputs[ALP_C].b = GetInput(pixel, m_AlphaInputLUT[ac.b]);
+  inputs[ALP_C].c = GetInput(pixel, m_AlphaInputLUT[ac.c]);
+  inputs[ALP_C].d = GetInput(pixel, m_AlphaInputLUT[ac.d]);
+
+  if (cc.bias != 3)
+    DrawColorRegular(cc, inputs, pixel);
+  else
+    DrawColorCompare(cc, inputs, pixel);
+
+  if (cc.clamp)
+  {
+    pixel.Reg[cc.dest][RED_C] = Clamp255(pixel.Reg[cc.dest][RED_C]);
+    pixel.Reg[cc.dest][GRN_C] = Clamp255(pixel.Reg[cc.dest][GRN_C]);
+    pixel.Reg[cc.dest][BLU_C] = Clamp255(pixel.Reg[cc.dest][BLU_C]);
+  }
+  else
+  {
+    pixel.Reg[cc.dest][RED_C] = Clamp1024(pixel.Reg[cc.dest][RED_C]);
+    pixel.Reg[cc.dest][GRN_C] = Clamp1024(pixel.Reg[cc.dest][GRN_C]);
+    pixel.Reg[cc.dest][BLU_C] = Clamp1024(pixel.Reg[cc.dest][BLU_C]);
+  }
+
+  if (ac.bias != 3)
+    DrawAlphaRegular(ac, inputs, pixel);
+  else
+    DrawAlphaCompare(ac, inputs, pixel);
+
+  if (ac.clamp)
+    pixel.Reg[ac.dest][ALP_C] = Clamp255(pixel.Reg[ac.dest][ALP_C]);
+  else
+    pixel.Reg[ac.dest][ALP_C] = Clamp1024(pixel.Reg[ac.dest][ALP_C]);
+}
@@ -0,0 +1,97 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include "Common/CommonTypes.h"
+#include "VideoCommon/BPMemory.h"
+
+// The color and alpha combiners of a TEV stage, for the pixels of a 2x2 block.
+class TevCombiners
+{
+public:
+  // The pixels of a block, in the order x0y0, x1y0, x0y1, x1y1.
+  static constexpr int NUM_PIXELS = 4;
+
+  // color order: ABGR
+  enum
+  {
+    ALP_C,
+    BLU_C,
+    GRN_C,
+    RED_C
+  };
+
+  // What the combiners of one pixel read and write.
+  struct Pixel
+  {
+    s16 Reg[4][4];
+    s16 TexColor[4];
+    s16 RasColor[4];
+    s16 StageKonst[4];
+
+    // The fixed inputs.
+    s16 One;
+    s16 Half;
+    s16 Zero;
+  };
+
+  void Init();
+
+  Pixel& GetPixel(int index) { return m_pixels[index]; }
+  const Pixel& GetPixel(int index) const { return m_pixels[index]; }
+
+  // Runs the combiners of a stage on the pixels whose bit is set in mask, and clamps the results.
+  // On x86 the regular combiners run on the whole block with SSE2, so the other pixels must hold
+  // some value too.
+  void Combine(const TevStageCombiner::ColorCombiner& cc,
+               const TevStageCombiner::AlphaCombiner& ac, u32 mask);
+
+  // The same for one pixel, without SIMD.
+  void CombineScalar(const TevStageCombiner::ColorCombiner& cc,
+                     const TevStageCombiner::AlphaCombiner& ac, int index);
+
+private:
+  struct InputRegType
+  {
+    unsigned a : 8;
+    unsigned b : 8;
+    unsigned c : 8;
+    signed d : 11;
+  };
+
+  // enumeration for color input LUT
+  enum
+  {
+    BLU_INP,
+    GRN_INP,
+    RED_INP
+  };
+
+  // The lookup tables hold the offsets of the inputs in a Pixel, counted in s16, so that the
+  // same table works for every pixel.
+  static s16 GetInput(const Pixel& pixel, u8 offset)
+  {
+    return reinterpret_cast<const s16*>(&pixel)[offset];
+  }
+
+  void DrawColorRegular(const TevStageCombiner::ColorCombiner& cc, const InputRegType inputs[4],
+                        Pixel& pixel);
+  void DrawColorCompare(const TevStageCombiner::ColorCombiner& cc, const InputRegType inputs[4],
+                        Pixel& pixel);
+  void DrawAlphaRegular(const TevStageCombiner::AlphaCombiner& ac, const InputRegType inputs[4],
+                        Pixel& pixel);
+  void DrawAlphaCompare(const TevStageCombiner::AlphaCombiner& ac, const InputRegType inputs[4],
+                        Pixel& pixel);
+  void CombineRegular(const TevStageCombiner::ColorCombiner& cc,
+                      const TevStageCombiner::AlphaCombiner& ac);
+
+  Pixel m_pixels[NUM_PIXELS] = {};
+
+  u8 m_ColorInputLUT[16][3];
+  u8 m_AlphaInputLUT[8];
+  s16 m_BiasLUT[4];
+  u8 m_ScaleLShiftLUT[4];
+  u8 m_ScaleRShiftLUT[4];
+};
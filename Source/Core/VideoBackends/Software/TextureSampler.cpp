@@ -5,9 +5,12 @@
 #include "VideoBackends/Software/TextureSampler.h"
 
 #include <algorithm>
+#include <array>
 #include <cmath>
+#include <cstring>
 
 #include "Common/CommonTypes.h"
+#include "Common/Intrinsics.h"
 #include "Core/HW/Memmap.h"
 
 #include "VideoCommon/BPMemory.h"
@@ -59,6 +62,60 @@ static inline void AddTexel(const u8* inTexel, u32* outTexel, u32 fract)
   outTexel[3] += inTexel[3] * fract;
 }
 
+// The weights of the four texels around the sample location, from the fractional parts of the
+// location, which are in s0.7.
+static inline std::array<int, 4> GetFilterWeights(int fractS, int fractT)
+{
+  return {(128 - fractS) * (128 - fractT), fractS * (128 - fractT), (128 - fractS) * fractT,
+          fractS * fractT};
+}
+
+void FilterTexelsScalar(const u8 texels[4][4], int fractS, int fractT, u8* sample)
+{
+  const std::array<int, 4> weights = GetFilterWeights(fractS, fractT);
+
+  u32 texel[4];
+  SetTexel(texels[0], texel, weights[0]);
+  AddTexel(texels[1], texel, weights[1]);
+  AddTexel(texels[2], texel, weights[2]);
+  AddTexel(texels[3], texel, weights[3]);
+
+  sample[0] = (u8)(texel[0] >> 14);
+  sample[1] = (u8)(texel[1] >> 14);
+  sample[2] = (u8)(texel[2] >> 14);
+  sample[3] = (u8)(texel[3] >> 14);
+}
+
+void FilterTexels(const u8 texels[4][4], int fractS, int fractT, u8* sample)
+{
+#ifdef _M_X86
+  const std::array<int, 4> weights = GetFilterWeights(fractS, fractT);
+
+  // Each pair of 16-bit lanes holds one component of two texels, so that pmaddwd multiplies
+  // them by their weights and adds them up. The weights are at most 128 * 128, and the sum at
+  // most 255 * 128 * 128, so nothing overflows.
+  u32 packed[4];
+  std::memcpy(packed, texels, sizeof(packed));
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i top = _mm_unpacklo_epi8(
+      _mm_unpacklo_epi8(_mm_cvtsi32_si128(packed[0]), _mm_cvtsi32_si128(packed[1])), zero);
+  const __m128i bottom = _mm_unpacklo_epi8(
+      _mm_unpacklo_epi8(_mm_cvtsi32_si128(packed[2]), _mm_cvtsi32_si128(packed[3])), zero);
+  const __m128i top_weights = _mm_set1_epi32(weights[0] | (weights[1] << 16));
+  const __m128i bottom_weights = _mm_set1_epi32(weights[2] | (weights[3] << 16));
+
+  __m128i sum =
+      _mm_add_epi32(_mm_madd_epi16(top, top_weights), _mm_madd_epi16(bottom, bottom_weights));
+  sum = _mm_srli_epi32(sum, 14);
+  sum = _mm_packus_epi16(_mm_packs_epi32(sum, sum), zero);
+
+  const u32 result = static_cast<u32>(_mm_cvtsi128_si32(sum));
+  std::memcpy(sample, &result, sizeof(result));
+#else
+  FilterTexelsScalar(texels, fractS, fractT, sample);
+#endif
+}
+
 void Sample(s32 s, s32 t, s32 lod, bool linear, u8 texmap, u8* sample)
 {
   int baseMip = 0;
@@ -180,8 +237,8 @@ void SampleMip(s32 s, s32 t, s32 mip, bool linear, u8 texmap, u8* sample)
     int imageTPlus1 = imageT + 1;
     const int fractT = t & 0x7f;
 
-    u8 sampledTex[4];
-    u32 texel[4];
+    // Top left, top right, bottom left and bottom right.
+    u8 sampledTex[4][4];
 
     WrapCoord(&imageS, tm0.wrap_s, imageWidth);
     WrapCoord(&imageT, tm0.wrap_t, imageHeight);
@@ -190,45 +247,28 @@ void SampleMip(s32 s, s32 t, s32 mip, bool linear, u8 texmap, u8* sample)
 
     if (!(texfmt == TextureFormat::RGBA8 && texUnit.texImage1[subTexmap].image_type))
     {
-      TexDecoder_DecodeTexel(sampledTex, imageSrc, imageS, imageT, imageWidth, texfmt, tlut,
+      TexDecoder_DecodeTexel(sampledTex[0], imageSrc, imageS, imageT, imageWidth, texfmt, tlut,
                              tlutfmt);
-      SetTexel(sampledTex, texel, (128 - fractS) * (128 - fractT));
-
-      TexDecoder_DecodeTexel(sampledTex, imageSrc, imageSPlus1, imageT, imageWidth, texfmt, tlut,
-                             tlutfmt);
-      AddTexel(sampledTex, texel, (fractS) * (128 - fractT));
-
-      TexDecoder_DecodeTexel(sampledTex, imageSrc, imageS, imageTPlus1, imageWidth, texfmt, tlut,
-                             tlutfmt);
-      AddTexel(sampledTex, texel, (128 - fractS) * (fractT));
-
-      TexDecoder_DecodeTexel(sampledTex, imageSrc, imageSPlus1, imageTPlus1, imageWidth, texfmt,
+      TexDecoder_DecodeTexel(sampledTex[1], imageSrc, imageSPlus1, imageT, imageWidth, texfmt,
+                             tlut, tlutfmt);
+      TexDecoder_DecodeTexel(sampledTex[2], imageSrc, imageS, imageTPlus1, imageWidth, texfmt,
+                             tlut, tlutfmt);
+      TexDecoder_DecodeTexel(sampledTex[3], imageSrc, imageSPlus1, imageTPlus1, imageWidth, texfmt,
                              tlut, tlutfmt);
-      AddTexel(sampledTex, texel, (fractS) * (fractT));
     }
     else
     {
-      TexDecoder_DecodeTexelRGBA8FromTmem(sampledTex, imageSrc, imageSrcOdd, imageS, imageT,
+      TexDecoder_DecodeTexelRGBA8FromTmem(sampledTex[0], imageSrc, imageSrcOdd, imageS, imageT,
                                           imageWidth);
-      SetTexel(sampledTex, texel, (128 - fractS) * (128 - fractT));
-
-      TexDecoder_DecodeTexelRGBA8FromTmem(sampledTex, imageSrc, imageSrcOdd, imageSPlus1, imageT,
-                                          imageWidth);
-      AddTexel(sampledTex, texel, (fractS) * (128 - fractT));
-
-      TexDecoder_DecodeTexelRGBA8FromTmem(sampledTex, imageSrc, imageSrcOdd, imageS, imageTPlus1,
-                                          imageWidth);
-      AddTexel(sampledTex, texel, (128 - fractS) * (fractT));
-
-      TexDecoder_DecodeTexelRGBA8FromTmem(sampledTex, imageSrc, imageSrcOdd, imageSPlus1,
+      TexDecoder_DecodeTexelRGBA8FromTmem(sampledTex[1], imageSrc, imageSrcOdd, imageSPlus1,
+                                          imageT, imageWidth);
+      TexDecoder_DecodeTexelRGBA8FromTmem(sampledTex[2], imageSrc, imageSrcOdd, imageS,
+                                          imageTPlus1, imageWidth);
+      TexDecoder_DecodeTexelRGBA8FromTmem(sampledTex[3], imageSrc, imageSrcOdd, imageSPlus1,
                                           imageTPlus1, imageWidth);
-      AddTexel(sampledTex, texel, (fractS) * (fractT));
     }
 
-    sample[0] = (u8)(texel[0] >> 14);
-    sample[1] = (u8)(texel[1] >> 14);
-    sample[2] = (u8)(texel[2] >> 14);
-    sample[3] = (u8)(texel[3] >> 14);
+    FilterTexels(sampledTex, fractS, fractT, sample);
   }
   else
   {
@@ -12,6 +12,12 @@ void Sample(s32 s, s32 t, s32 lod, bool linear, u8 texmap, u8* sample);
 
 void SampleMip(s32 s, s32 t, s32 mip, bool linear, u8 texmap, u8* sample);
 
+// Weights the four texels around the sample location by the fractional parts of the location,
+// which are in s0.7, and writes the result to sample. FilterTexels uses SIMD where available, and
+// gives the same results as FilterTexelsScalar.
+void FilterTexels(const u8 texels[4][4], int fractS, int fractT, u8* sample);
+void FilterTexelsScalar(const u8 texels[4][4], int fractS, int fractT, u8* sample);
+
 enum
 {
   RED_SMP,
@@ -0,0 +1,154 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "VideoCommon/AsyncTextureDecoder.h"
+
+#include <algorithm>
+
+#include "Common/Assert.h"
+#include "Common/Thread.h"
+#include "VideoCommon/TextureDecoder.h"
+
+namespace VideoCommon
+{
+// Large enough that the locking doesn't matter, small enough that a 1024x1024 level is split into
+// enough stripes to keep all the threads busy.
+constexpr int MIN_STRIPE_TEXELS = 128 * 128;
+
+AsyncTextureDecoder::AsyncTextureDecoder() = default;
+
+AsyncTextureDecoder::~AsyncTextureDecoder()
+{
+  WaitAll();
+  StopWorkers();
+}
+
+void AsyncTextureDecoder::SetThreadCount(u32 num_threads)
+{
+  const u32 num_workers = std::max(num_threads, 1u) - 1;
+  if (num_workers == m_workers.size())
+    return;
+
+  WaitAll();
+  StopWorkers();
+  StartWorkers(num_workers);
+}
+
+void AsyncTextureDecoder::StartWorkers(u32 num_workers)
+{
+  m_workers_quit = false;
+  for (u32 i = 0; i < num_workers; ++i)
+    m_workers.emplace_back(&AsyncTextureDecoder::WorkerThread, this);
+}
+
+void AsyncTextureDecoder::StopWorkers()
+{
+  {
+    std::lock_guard<std::mutex> lk(m_lock);
+    m_workers_quit = true;
+  }
+  m_work_available.notify_all();
+
+  for (std::thread& worker : m_workers)
+    worker.join();
+  m_workers.clear();
+}
+
+u32 AsyncTextureDecoder::Decode(u8* dst, const u8* src, int width, int height,
+                                TextureFormat texformat, const u8* tlut, TLUTFormat tlutfmt)
+{
+  const u32 id = static_cast<u32>(m_levels.size());
+
+  if (m_workers.empty())
+  {
+    TexDecoder_Decode(dst, src, width, height, texformat, tlut, tlutfmt);
+    m_levels.push_back({dst, src, width, height, texformat, tlut, tlutfmt, 0, true});
+    return id;
+  }
+
+  // Stripes have to start on a row of blocks.
+  const int block_height = TexDecoder_GetBlockHeightInTexels(texformat);
+  const int rows_per_stripe =
+      std::max(MIN_STRIPE_TEXELS / width / block_height, 1) * block_height;
+  const u32 num_stripes = static_cast<u32>((height + rows_per_stripe - 1) / rows_per_stripe);
+
+  {
+    std::lock_guard<std::mutex> lk(m_lock);
+    m_levels.push_back({dst, src, width, height, texformat, tlut, tlutfmt, num_stripes, false});
+    for (int row = 0; row < height; row += rows_per_stripe)
+      m_stripes.push_back({id, row, std::min(rows_per_stripe, height - row)});
+  }
+
+  m_work_available.notify_all();
+
+  return id;
+}
+
+void AsyncTextureDecoder::Wait(u32 id)
+{
+  ASSERT(id < m_levels.size());
+  Level& level = m_levels[id];
+  if (level.finished)
+    return;
+
+  {
+    std::unique_lock<std::mutex> lk(m_lock);
+    while (level.remaining_stripes != 0)
+    {
+      // Help out rather than sleep. The stripes are queued in order, so this thread only picks up
+      // stripes of later levels once the workers have started on the last ones of this level.
+      if (!m_stripes.empty())
+        DecodeStripe(lk);
+      else
+        m_stripe_done.wait(lk);
+    }
+  }
+
+  FinishLevel(level);
+}
+
+void AsyncTextureDecoder::WaitAll()
+{
+  for (u32 id = 0; id < m_levels.size(); ++id)
+    Wait(id);
+
+  m_levels.clear();
+}
+
+void AsyncTextureDecoder::DecodeStripe(std::unique_lock<std::mutex>& lk)
+{
+  const Stripe stripe = m_stripes.front();
+  m_stripes.pop_front();
+  Level& level = m_levels[stripe.level];
+
+  lk.unlock();
+  TexDecoder_DecodeRows(level.dst, level.src, level.width, stripe.first_row, stripe.num_rows,
+                        level.texformat, level.tlut, level.tlutfmt);
+  lk.lock();
+
+  if (--level.remaining_stripes == 0)
+    m_stripe_done.notify_all();
+}
+
+void AsyncTextureDecoder::FinishLevel(Level& level)
+{
+  TexDecoder_FinishDecode(level.dst, level.width, level.height, level.texformat);
+  level.finished = true;
+}
+
+void AsyncTextureDecoder::WorkerThread()
+{
+  Common::SetCurrentThreadName("Texture Decoder Worker");
+
+  std::unique_lock<std::mutex> lk(m_lock);
+  while (true)
+  {
+    m_work_available.wait(lk, [this] { return m_workers_quit || !m_stripes.empty(); });
+    if (m_workers_quit)
+      return;
+
+    DecodeStripe(lk);
+  }
+}
+}  // namespace VideoCommon
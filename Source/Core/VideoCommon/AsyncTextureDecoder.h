@@ -0,0 +1,84 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+enum class TextureFormat;
+enum class TLUTFormat;
+
+namespace VideoCommon
+{
+// Decodes textures on worker threads. Levels are split into stripes of rows, so that a big texture
+// is decoded by all the threads at once, and the small levels of a texture are decoded alongside
+// each other.
+class AsyncTextureDecoder
+{
+public:
+  AsyncTextureDecoder();
+  ~AsyncTextureDecoder();
+
+  // The thread that calls Decode and Wait counts as one of the threads, as it decodes while it
+  // waits. With a single thread, Decode decodes the level right away. Waits for queued levels.
+  void SetThreadCount(u32 num_threads);
+
+  // Queues the decoding of a texture level, see TexDecoder_Decode. The buffers must stay valid
+  // until the level is waited for. Returns the id to pass to Wait.
+  u32 Decode(u8* dst, const u8* src, int width, int height, TextureFormat texformat,
+             const u8* tlut, TLUTFormat tlutfmt);
+
+  // Blocks until the level is decoded.
+  void Wait(u32 id);
+
+  // Blocks until every queued level is decoded. The ids start over afterwards.
+  void WaitAll();
+
+private:
+  struct Level
+  {
+    u8* dst;
+    const u8* src;
+    int width;
+    int height;
+    TextureFormat texformat;
+    const u8* tlut;
+    TLUTFormat tlutfmt;
+    u32 remaining_stripes;
+    bool finished;
+  };
+
+  struct Stripe
+  {
+    u32 level;
+    int first_row;
+    int num_rows;
+  };
+
+  void StartWorkers(u32 num_workers);
+  void StopWorkers();
+  void WorkerThread();
+
+  // Called with m_lock held, which is released while decoding.
+  void DecodeStripe(std::unique_lock<std::mutex>& lk);
+
+  void FinishLevel(Level& level);
+
+  std::vector<std::thread> m_workers;
+  bool m_workers_quit = false;
+
+  // A deque, as the workers hold references to the levels while more are queued.
+  std::deque<Level> m_levels;
+  std::deque<Stripe> m_stripes;
+  std::mutex m_lock;
+  std::condition_variable m_work_available;
+  std::condition_variable m_stripe_done;
+};
+}  // namespace VideoCommon
@@ -26,6 +26,7 @@
 #include "VideoCommon/CommandProcessor.h"
 #include "VideoCommon/DataReader.h"
 #include "VideoCommon/OpcodeDecoding.h"
+#include "VideoCommon/RenderBase.h"
 #include "VideoCommon/VertexLoaderManager.h"
 #include "VideoCommon/VertexManagerBase.h"
 #include "VideoCommon/VideoBackendBase.h"
@@ -305,9 +306,12 @@ void RunGpuLoop()
         // Run events from the CPU thread.
         AsyncRequests::GetInstance()->PullEvents();
 
-        // Do nothing while paused
+        // Do nothing while paused, except reading back the last presented frame for frontends
         if (!s_emu_running_state.IsSet())
+        {
+          g_renderer->FlushFrameCaptureWhilePaused();
           return;
+        }
 
         if (s_use_deterministic_gpu_thread)
         {
@@ -394,6 +398,15 @@ void RunGpuLoop()
   AsyncRequests::GetInstance()->SetPassthrough(true);
 }
 
+void CPUThreadStopped()
+{
+  // With a GPU thread, RunGpuLoop does this while paused.
+  if (SConfig::GetInstance().bCPUThread)
+    return;
+
+  g_renderer->FlushFrameCaptureWhilePaused();
+}
+
 void FlushGpu()
 {
   const SConfig& param = SConfig::GetInstance();
@@ -36,6 +36,10 @@ void SyncGPU(SyncGPUReason reason, bool may_move_read_ptr = true);
 void PushFifoAuxBuffer(const void* ptr, size_t size);
 void* PopFifoAuxBuffer(size_t size);
 
+// Called on the CPU thread when it stops running. Without a GPU thread, it is also the video
+// thread, so this does what RunGpuLoop does while paused.
+void CPUThreadStopped();
+
 void FlushGpu();
 void RunGpu();
 void GpuMaySleep();
@@ -17,6 +17,7 @@
 #include <algorithm>
 #include <cinttypes>
 #include <cmath>
+#include <iterator>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -49,6 +50,7 @@
 #include "Core/HW/VideoInterface.h"
 #include "Core/Host.h"
 #include "Core/Movie.h"
+#include "Core/Turbo.h"
 
 #include "InputCommon/ControllerInterface/ControllerInterface.h"
 
@@ -143,6 +145,7 @@ void Renderer::Shutdown()
   // First stop any framedumping, which might need to dump the last xfb frame. This process
   // can require additional graphics sub-systems so it needs to be done first
   ShutdownFrameDumping();
+  ShutdownFrameCapture();
   ShutdownImGui();
   m_post_processor.reset();
 }
@@ -1236,6 +1239,7 @@ void Renderer::Swap(u32 xfb_addr, u32 fb_width, u32 fb_stride, u32 fb_height, u6
   // This is required even if frame dumping has stopped, since the frame dump is one frame
   // behind the renderer.
   FlushFrameDump();
+  FlushFrameCapture();
 
   if (xfb_addr && fb_width && fb_stride && fb_height)
   {
@@ -1249,6 +1253,9 @@ void Renderer::Swap(u32 xfb_addr, u32 fb_width, u32 fb_stride, u32 fb_height, u6
       const bool is_duplicate_frame = xfb_entry->id == m_last_xfb_id;
       m_last_xfb_id = xfb_entry->id;
 
+      // Nothing was drawn for the frames that turbo mode skips.
+      const bool present = !m_turbo_skip_draws;
+
       // Since we use the common pipelines here and draw vertices if a batch is currently being
       // built by the vertex loader, we end up trampling over its pointer, as we share the buffer
       // with the loader, and it has not been unmapped yet. Force a pipeline flush to avoid this.
@@ -1266,7 +1273,7 @@ void Renderer::Swap(u32 xfb_addr, u32 fb_width, u32 fb_stride, u32 fb_height, u6
 
       // Render the XFB to the screen.
       BeginUtilityDrawing();
-      if (!IsHeadless())
+      if (!IsHeadless() && present)
       {
         BindBackbuffer({{0.0f, 0.0f, 0.0f, 1.0f}});
 
@@ -1295,6 +1302,9 @@ void Renderer::Swap(u32 xfb_addr, u32 fb_width, u32 fb_stride, u32 fb_height, u6
         SetWindowSize(xfb_rect.GetWidth(), xfb_rect.GetHeight());
       }
 
+      if (present)
+        CaptureFrame(xfb_entry->texture.get(), xfb_rect);
+
       if (!is_duplicate_frame)
       {
         m_fps_counter.Update();
@@ -1305,12 +1315,23 @@ void Renderer::Swap(u32 xfb_addr, u32 fb_width, u32 fb_stride, u32 fb_height, u6
         perf_sample.num_draw_calls = g_stats.this_frame.num_draw_calls;
         DolphinAnalytics::Instance().ReportPerformanceInfo(std::move(perf_sample));
 
-        if (IsFrameDumping())
+        if (IsFrameDumping() && present)
           DumpCurrentFrame(xfb_entry->texture.get(), xfb_rect, ticks, m_frame_count);
 
         // Begin new frame
         m_frame_count++;
         g_stats.ResetFrame();
+
+        if (Turbo::IsEnabled())
+        {
+          m_turbo_frame_counter = (m_turbo_frame_counter + 1) % Turbo::GetPresentInterval();
+          m_turbo_skip_draws = m_turbo_frame_counter != 0;
+        }
+        else
+        {
+          m_turbo_frame_counter = 0;
+          m_turbo_skip_draws = false;
+        }
       }
 
       g_shader_cache->RetrieveAsyncShaders();
@@ -1507,6 +1528,156 @@ void Renderer::FlushFrameDump()
     ShutdownFrameDumping();
 }
 
+void Renderer::RequestFrameCapture(FrameCaptureCallback callback)
+{
+  std::lock_guard<std::mutex> guard(m_frame_capture_lock);
+  m_frame_capture_requests.push_back(std::move(callback));
+  m_frame_capture_keep_last = true;
+}
+
+bool Renderer::RequestLastFrameCapture(FrameCaptureCallback callback)
+{
+  u32 width;
+  u32 height;
+  std::shared_ptr<std::vector<u8>> pixels;
+  {
+    std::lock_guard<std::mutex> guard(m_frame_capture_lock);
+    if (m_last_frame_capture_stale)
+    {
+      m_frame_capture_requests.push_back(std::move(callback));
+      return true;
+    }
+    if (!m_last_frame_capture)
+      return false;
+
+    width = m_last_frame_capture_width;
+    height = m_last_frame_capture_height;
+    pixels = m_last_frame_capture;
+  }
+
+  callback(width, height, std::move(pixels));
+  return true;
+}
+
+void Renderer::CaptureFrame(const AbstractTexture* src_texture,
+                            const MathUtil::Rectangle<int>& src_rect)
+{
+  {
+    std::lock_guard<std::mutex> guard(m_frame_capture_lock);
+    if (!m_frame_capture_keep_last)
+      return;
+
+    m_last_frame_capture_stale = true;
+    std::move(m_frame_capture_requests.begin(), m_frame_capture_requests.end(),
+              std::back_inserter(m_frame_capture_pending));
+    m_frame_capture_requests.clear();
+  }
+
+  const u32 width = static_cast<u32>(src_rect.GetWidth());
+  const u32 height = static_cast<u32>(src_rect.GetHeight());
+  std::unique_ptr<AbstractStagingTexture>& rbtex = m_frame_capture_texture;
+  if (!rbtex || rbtex->GetWidth() != width || rbtex->GetHeight() != height)
+  {
+    rbtex.reset();
+    rbtex = CreateStagingTexture(
+        StagingTextureType::Readback,
+        TextureConfig(width, height, 1, 1, 1, AbstractTextureFormat::RGBA8, 0));
+    if (!rbtex)
+    {
+      ERROR_LOG_FMT(VIDEO, "Failed to create frame capture texture");
+      return;
+    }
+  }
+
+  rbtex->CopyFromTexture(src_texture, src_rect, 0, 0, rbtex->GetRect());
+  m_frame_capture_needs_flush = true;
+}
+
+void Renderer::FlushFrameCapture()
+{
+  if (!m_frame_capture_needs_flush && m_frame_capture_pending.empty())
+    return;
+
+  std::vector<FrameCaptureCallback> callbacks = std::move(m_frame_capture_pending);
+  m_frame_capture_pending.clear();
+
+  u32 width = 0;
+  u32 height = 0;
+  std::shared_ptr<std::vector<u8>> pixels;
+  AbstractStagingTexture* const rbtex = m_frame_capture_texture.get();
+  if (rbtex && m_frame_capture_needs_flush)
+  {
+    rbtex->Flush();
+    if (rbtex->Map())
+    {
+      width = rbtex->GetWidth();
+      height = rbtex->GetHeight();
+      pixels = std::make_shared<std::vector<u8>>(static_cast<size_t>(width) * height * 4);
+      rbtex->ReadTexels(rbtex->GetRect(), pixels->data(), width * 4);
+    }
+    else
+    {
+      ERROR_LOG_FMT(VIDEO, "Failed to map texture for frame capture.");
+    }
+  }
+  m_frame_capture_needs_flush = false;
+
+  {
+    std::lock_guard<std::mutex> guard(m_frame_capture_lock);
+    if (pixels)
+    {
+      m_last_frame_capture = pixels;
+      m_last_frame_capture_width = width;
+      m_last_frame_capture_height = height;
+    }
+    m_last_frame_capture_stale = false;
+  }
+
+  for (FrameCaptureCallback& callback : callbacks)
+    callback(width, height, pixels);
+}
+
+void Renderer::FlushFrameCaptureWhilePaused()
+{
+  FlushFrameCapture();
+
+  // No frame will be presented until the emulation resumes, so the requests waiting for the next
+  // one get the last one.
+  std::vector<FrameCaptureCallback> callbacks;
+  u32 width;
+  u32 height;
+  std::shared_ptr<std::vector<u8>> pixels;
+  {
+    std::lock_guard<std::mutex> guard(m_frame_capture_lock);
+    if (!m_last_frame_capture)
+      return;
+
+    callbacks.swap(m_frame_capture_requests);
+    width = m_last_frame_capture_width;
+    height = m_last_frame_capture_height;
+    pixels = m_last_frame_capture;
+  }
+
+  for (FrameCaptureCallback& callback : callbacks)
+    callback(width, height, pixels);
+}
+
+void Renderer::ShutdownFrameCapture()
+{
+  FlushFrameCapture();
+
+  std::vector<FrameCaptureCallback> callbacks;
+  {
+    std::lock_guard<std::mutex> guard(m_frame_capture_lock);
+    callbacks.swap(m_frame_capture_requests);
+    m_last_frame_capture.reset();
+  }
+  for (FrameCaptureCallback& callback : callbacks)
+    callback(0, 0, nullptr);
+
+  m_frame_capture_texture.reset();
+}
+
 void Renderer::ShutdownFrameDumping()
 {
   // Ensure the last queued readback has been sent to the encoder.
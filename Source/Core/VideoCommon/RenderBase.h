@@ -15,6 +15,7 @@
 #pragma once
 
 #include <array>
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -227,6 +228,28 @@ public:
   // Finish up the current frame, print some stats
   void Swap(u32 xfb_addr, u32 fb_width, u32 fb_stride, u32 fb_height, u64 ticks);
 
+  // In turbo mode, primitives are only drawn in the frames that are presented.
+  bool IsSkippingDraws() const { return m_turbo_skip_draws; }
+
+  // Copies the XFB of the next presented frame to memory, at the internal resolution and in
+  // RGBA8, for frontends that need the output without a window. The copy is read back during the
+  // following swap so that the GPU isn't stalled. The callback is called on the GPU thread, with
+  // null pixels if the readback failed or the renderer shut down first. If the emulation pauses
+  // first, it gets the last presented frame instead. Thread-safe.
+  using FrameCaptureCallback =
+      std::function<void(u32 width, u32 height, std::shared_ptr<std::vector<u8>> pixels)>;
+  void RequestFrameCapture(FrameCaptureCallback callback);
+
+  // Once a capture has been requested, every presented frame is read back the same way, and the
+  // last one is kept for frontends to get while the emulation is paused. This calls the callback
+  // with it, on the calling thread if it was already read back, or else on the video thread once
+  // it is. Returns false without calling it if no frame was read back yet. Thread-safe.
+  bool RequestLastFrameCapture(FrameCaptureCallback callback);
+
+  // Reads back the last presented frame, which would otherwise wait for the next swap. Called on
+  // the video thread while the emulation is paused.
+  void FlushFrameCaptureWhilePaused();
+
   void UpdateWidescreenHeuristic();
 
   // Draws the specified XFB buffer to the screen, performing any post-processing.
@@ -396,6 +419,26 @@ private:
   u32 m_last_xfb_stride = 0;
   u32 m_last_xfb_height = 0;
 
+  // Frames since the last one presented in turbo mode.
+  u32 m_turbo_frame_counter = 0;
+  bool m_turbo_skip_draws = false;
+
+  // Frame captures. Requests are moved from m_frame_capture_requests to
+  // m_frame_capture_pending when the XFB is copied to the staging texture.
+  std::mutex m_frame_capture_lock;
+  std::vector<FrameCaptureCallback> m_frame_capture_requests;
+  bool m_frame_capture_keep_last = false;
+  std::shared_ptr<std::vector<u8>> m_last_frame_capture;
+  u32 m_last_frame_capture_width = 0;
+  u32 m_last_frame_capture_height = 0;
+  // Set while a presented frame is waiting to be read back.
+  bool m_last_frame_capture_stale = false;
+
+  // Only accessed on the GPU thread.
+  std::vector<FrameCaptureCallback> m_frame_capture_pending;
+  std::unique_ptr<AbstractStagingTexture> m_frame_capture_texture;
+  bool m_frame_capture_needs_flush = false;
+
   // NOTE: The methods below are called on the framedumping thread.
   void FrameDumpThreadFunc();
   bool StartFrameDumpToFFMPEG(const FrameDump::FrameData&);
@@ -428,6 +471,14 @@ private:
   // Ensures all encoded frames have been written to the output file.
   void FinishFrameData();
 
+  // Copies the XFB texture to the frame capture staging texture, once a capture was requested.
+  void CaptureFrame(const AbstractTexture* src_texture, const MathUtil::Rectangle<int>& src_rect);
+
+  // Reads back the last captured frame, keeps it, and hands it to the requests waiting for it.
+  void FlushFrameCapture();
+
+  void ShutdownFrameCapture();
+
   std::unique_ptr<NetPlayChatUI> m_netplay_chat_ui;
 
   Common::Flag m_force_reload_textures;
@@ -91,6 +91,7 @@ TextureCacheBase::TextureCacheBase()
 
   TexDecoder_SetTexFmtOverlayOptions(backup_config.texfmt_overlay,
                                      backup_config.texfmt_overlay_center);
+  m_texture_decoder.SetThreadCount(g_ActiveConfig.GetTextureDecodingThreads());
 
   HiresTexture::Init();
 
@@ -132,6 +133,7 @@ void TextureCacheBase::Invalidate()
     delete tex.second;
   }
   textures_by_address.clear();
+  textures_by_page.Clear();
   textures_by_hash.clear();
 
   texture_pool.clear();
@@ -169,6 +171,8 @@ void TextureCacheBase::OnConfigChanged(const VideoConfig& config)
     TexDecoder_SetTexFmtOverlayOptions(config.bTexFmtOverlayEnable, config.bTexFmtOverlayCenter);
   }
 
+  m_texture_decoder.SetThreadCount(config.GetTextureDecodingThreads());
+
   SetBackupConfig(config);
 }
 
@@ -325,7 +329,7 @@ TextureCacheBase::ApplyPaletteToEntry(TCacheEntry* entry, u8* palette, TLUTForma
     g_renderer->EndUtilityDrawing();
   }
 
-  textures_by_address.emplace(decoded_entry->addr, decoded_entry);
+  AddToAddressCache(decoded_entry->addr, decoded_entry);
 
   return decoded_entry;
 }
@@ -372,7 +376,7 @@ TextureCacheBase::TCacheEntry* TextureCacheBase::ReinterpretEntry(const TCacheEn
   g_renderer->EndUtilityDrawing();
   reinterpreted_entry->texture->FinishedRendering();
 
-  textures_by_address.emplace(reinterpreted_entry->addr, reinterpreted_entry);
+  AddToAddressCache(reinterpreted_entry->addr, reinterpreted_entry);
 
   return reinterpreted_entry;
 }
@@ -696,7 +700,7 @@ void TextureCacheBase::DoLoadState(PointerWrap& p)
 
     TCacheEntry* entry = GetEntry(id);
     if (entry)
-      textures_by_address.emplace(addr, entry);
+      AddToAddressCache(addr, entry);
   }
 
   // Fill in hash map.
@@ -763,10 +767,10 @@ TextureCacheBase::DoPartialTextureUpdates(TCacheEntry* entry_to_update, u8* pale
 
   u32 numBlocksX = (entry_to_update->native_width + block_width - 1) / block_width;
 
-  auto iter = FindOverlappingTextures(entry_to_update->addr, entry_to_update->size_in_bytes);
-  while (iter.first != iter.second)
+  for (TexAddrCache::iterator iter :
+       FindOverlappingTextures(entry_to_update->addr, entry_to_update->size_in_bytes))
   {
-    TCacheEntry* entry = iter.first->second;
+    TCacheEntry* entry = iter->second;
     if (entry != entry_to_update && entry->IsCopy() && !entry->tmem_only &&
         entry->references.count(entry_to_update) == 0 &&
         entry->OverlapsMemoryRange(entry_to_update->addr, entry_to_update->size_in_bytes) &&
@@ -779,7 +783,6 @@ TextureCacheBase::DoPartialTextureUpdates(TCacheEntry* entry_to_update, u8* pale
         {
           if (!CanReinterpretTextureOnGPU(entry_to_update->format.texfmt, entry->format.texfmt))
           {
-            ++iter.first;
             continue;
           }
 
@@ -803,7 +806,6 @@ TextureCacheBase::DoPartialTextureUpdates(TCacheEntry* entry_to_update, u8* pale
           }
           else
           {
-            ++iter.first;
             continue;
           }
         }
@@ -865,7 +867,6 @@ TextureCacheBase::DoPartialTextureUpdates(TCacheEntry* entry_to_update, u8* pale
             static_cast<u32>(dst_x + copy_width) > entry_to_update->GetWidth() ||
             static_cast<u32>(dst_y + copy_height) > entry_to_update->GetHeight())
         {
-          ++iter.first;
           continue;
         }
 
@@ -891,7 +892,7 @@ TextureCacheBase::DoPartialTextureUpdates(TCacheEntry* entry_to_update, u8* pale
         {
           // Remove the temporary converted texture, it won't be used anywhere else
           // TODO: It would be nice to convert and copy in one step, but this code path isn't common
-          iter.first = InvalidateTexture(iter.first);
+          InvalidateTexture(iter);
           continue;
         }
         else
@@ -905,11 +906,10 @@ TextureCacheBase::DoPartialTextureUpdates(TCacheEntry* entry_to_update, u8* pale
       else
       {
         // If the hash does not match, this EFB copy will not be used for anything, so remove it
-        iter.first = InvalidateTexture(iter.first);
+        InvalidateTexture(iter);
         continue;
       }
     }
-    ++iter.first;
   }
 
   return entry_to_update;
@@ -1558,6 +1558,21 @@ TextureCacheBase::GetTexture(u32 address, u32 width, u32 height, const TextureFo
   // Initialized to null because only software loading uses this buffer
   u8* dst_buffer = nullptr;
 
+  // Levels decoded on the CPU are all queued before waiting for any, so that the workers decode
+  // the small levels together. They are then waited for and uploaded in order, and GetTexture only
+  // returns once the whole texture is uploaded.
+  struct PendingUpload
+  {
+    u32 level;
+    u32 width;
+    u32 height;
+    u32 row_length;
+    const u8* buffer;
+    size_t size;
+    u32 decode_id;
+  };
+  std::vector<PendingUpload> pending_uploads;
+
   if (!hires_tex)
   {
     if (!decode_on_gpu ||
@@ -1587,32 +1602,34 @@ TextureCacheBase::GetTexture(u32 address, u32 width, u32 height, const TextureFo
       dst_buffer = temp;
       if (!(texformat == TextureFormat::RGBA8 && from_tmem))
       {
-        TexDecoder_Decode(dst_buffer, src_data, expandedWidth, expandedHeight, texformat, tlut,
-                          tlutfmt);
+        const u32 decode_id = m_texture_decoder.Decode(dst_buffer, src_data, expandedWidth,
+                                                       expandedHeight, texformat, tlut, tlutfmt);
+        pending_uploads.push_back(
+            {0, width, height, expandedWidth, dst_buffer, decoded_texture_size, decode_id});
       }
       else
       {
         u8* src_data_gb = &texMem[tmem_address_odd];
         TexDecoder_DecodeRGBA8FromTmem(dst_buffer, src_data, src_data_gb, expandedWidth,
                                        expandedHeight);
-      }
 
-      entry->texture->Load(0, width, height, expandedWidth, dst_buffer, decoded_texture_size);
+        entry->texture->Load(0, width, height, expandedWidth, dst_buffer, decoded_texture_size);
 
-      arbitrary_mip_detector.AddLevel(width, height, expandedWidth, dst_buffer);
+        arbitrary_mip_detector.AddLevel(width, height, expandedWidth, dst_buffer);
+      }
 
       dst_buffer += decoded_texture_size;
     }
   }
 
-  iter = textures_by_address.emplace(address, entry);
+  entry->SetGeneralParameters(address, texture_size, full_format, false);
+  iter = AddToAddressCache(address, entry);
   if (textureCacheSafetyColorSampleSize == 0 ||
       std::max(texture_size, palette_size) <= (u32)textureCacheSafetyColorSampleSize * 8)
   {
     entry->textures_by_hash_iter = textures_by_hash.emplace(full_hash, entry);
   }
 
-  entry->SetGeneralParameters(address, texture_size, full_format, false);
   entry->SetDimensions(nativeW, nativeH, tex_levels);
   entry->SetHashes(base_hash, full_hash);
   entry->is_custom_tex = hires_tex != nullptr;
@@ -1666,12 +1683,11 @@ TextureCacheBase::GetTexture(u32 address, u32 width, u32 height, const TextureFo
       {
         // No need to call CheckTempSize here, as the whole buffer is preallocated at the beginning
         const u32 decoded_mip_size = expanded_mip_width * sizeof(u32) * expanded_mip_height;
-        TexDecoder_Decode(dst_buffer, mip_src_data, expanded_mip_width, expanded_mip_height,
-                          texformat, tlut, tlutfmt);
-        entry->texture->Load(level, mip_width, mip_height, expanded_mip_width, dst_buffer,
-                             decoded_mip_size);
-
-        arbitrary_mip_detector.AddLevel(mip_width, mip_height, expanded_mip_width, dst_buffer);
+        const u32 decode_id =
+            m_texture_decoder.Decode(dst_buffer, mip_src_data, expanded_mip_width,
+                                     expanded_mip_height, texformat, tlut, tlutfmt);
+        pending_uploads.push_back({level, mip_width, mip_height, expanded_mip_width, dst_buffer,
+                                   decoded_mip_size, decode_id});
 
         dst_buffer += decoded_mip_size;
       }
@@ -1680,6 +1696,16 @@ TextureCacheBase::GetTexture(u32 address, u32 width, u32 height, const TextureFo
     }
   }
 
+  for (const PendingUpload& upload : pending_uploads)
+  {
+    m_texture_decoder.Wait(upload.decode_id);
+    entry->texture->Load(upload.level, upload.width, upload.height, upload.row_length,
+                         upload.buffer, upload.size);
+
+    arbitrary_mip_detector.AddLevel(upload.width, upload.height, upload.row_length, upload.buffer);
+  }
+  m_texture_decoder.WaitAll();
+
   entry->has_arbitrary_mips = hires_tex ? hires_tex->HasArbitraryMipmaps() :
                                           arbitrary_mip_detector.HasArbitraryMipmaps(dst_buffer);
 
@@ -1767,7 +1793,7 @@ TextureCacheBase::GetXFBTexture(u32 address, u32 width, u32 height, u32 stride,
   entry->texture->FinishedRendering();
 
   // Insert into the texture cache so we can re-use it next frame, if needed.
-  textures_by_address.emplace(entry->addr, entry);
+  AddToAddressCache(entry->addr, entry);
   SETSTAT(g_stats.num_textures_alive, static_cast<int>(textures_by_address.size()));
   INCSTAT(g_stats.num_textures_uploaded);
 
@@ -1837,15 +1863,15 @@ void TextureCacheBase::StitchXFBCopy(TCacheEntry* stitched_entry)
   std::vector<TCacheEntry*> candidates;
   bool create_upscaled_copy = false;
 
-  auto iter = FindOverlappingTextures(stitched_entry->addr, stitched_entry->size_in_bytes);
-  while (iter.first != iter.second)
+  for (TexAddrCache::iterator iter :
+       FindOverlappingTextures(stitched_entry->addr, stitched_entry->size_in_bytes))
   {
     // Currently, this checks the stride of the VRAM copy against the VI request. Therefore, for
     // interlaced modes, VRAM copies won't be considered candidates. This is okay for now, because
     // our force progressive hack means that an XFB copy should always have a matching stride. If
     // the hack is disabled, XFB2RAM should also be enabled. Should we wish to implement interlaced
     // stitching in the future, this would require a shader which grabs every second line.
-    TCacheEntry* entry = iter.first->second;
+    TCacheEntry* entry = iter->second;
     if (entry != stitched_entry && entry->IsCopy() && !entry->tmem_only &&
         entry->OverlapsMemoryRange(stitched_entry->addr, stitched_entry->size_in_bytes) &&
         entry->memory_stride == stitched_entry->memory_stride)
@@ -1861,11 +1887,10 @@ void TextureCacheBase::StitchXFBCopy(TCacheEntry* stitched_entry)
       else
       {
         // If the hash does not match, this EFB copy will not be used for anything, so remove it
-        iter.first = InvalidateTexture(iter.first);
+        InvalidateTexture(iter);
         continue;
       }
     }
-    ++iter.first;
   }
 
   if (candidates.empty())
@@ -2257,10 +2282,9 @@ void TextureCacheBase::CopyRenderTargetToTexture(
   // as our efb copy are marked to check them for partial texture updates.
   // TODO: The logic to detect overlapping strided efb copies is not 100% accurate.
   bool strided_efb_copy = dstStride != bytes_per_row;
-  auto iter = FindOverlappingTextures(dstAddr, covered_range);
-  while (iter.first != iter.second)
+  for (TexAddrCache::iterator iter : FindOverlappingTextures(dstAddr, covered_range))
   {
-    TCacheEntry* overlapping_entry = iter.first->second;
+    TCacheEntry* overlapping_entry = iter->second;
 
     if (overlapping_entry->addr == dstAddr && overlapping_entry->is_xfb_copy)
     {
@@ -2282,7 +2306,7 @@ void TextureCacheBase::CopyRenderTargetToTexture(
       {
         // Pending EFB copies which are completely covered by this new copy can simply be tossed,
         // instead of having to flush them later on, since this copy will write over everything.
-        iter.first = InvalidateTexture(iter.first, true);
+        InvalidateTexture(iter, true);
         continue;
       }
 
@@ -2312,7 +2336,6 @@ void TextureCacheBase::CopyRenderTargetToTexture(
         overlapping_entry->textures_by_hash_iter = textures_by_hash.end();
       }
     }
-    ++iter.first;
   }
 
   if (OpcodeDecoder::g_record_fifo_data)
@@ -2333,7 +2356,7 @@ void TextureCacheBase::CopyRenderTargetToTexture(
   {
     const u64 hash = entry->CalculateHash();
     entry->SetHashes(hash, hash);
-    textures_by_address.emplace(dstAddr, entry);
+    AddToAddressCache(dstAddr, entry);
   }
 }
 
@@ -2381,8 +2404,7 @@ void TextureCacheBase::FlushEFBCopy(TCacheEntry* entry)
   if (entry->is_xfb_copy)
   {
     const u32 covered_range = entry->pending_efb_copy_height * entry->memory_stride;
-    auto range = FindOverlappingTextures(entry->addr, covered_range);
-    for (auto iter = range.first; iter != range.second; ++iter)
+    for (TexAddrCache::iterator iter : FindOverlappingTextures(entry->addr, covered_range))
     {
       TCacheEntry* overlapping_entry = iter->second;
       if (overlapping_entry->may_have_overlapping_textures && overlapping_entry->is_xfb_copy &&
@@ -2539,21 +2561,13 @@ TextureCacheBase::GetTexCacheIter(TextureCacheBase::TCacheEntry* entry)
   return textures_by_address.end();
 }
 
-std::pair<TextureCacheBase::TexAddrCache::iterator, TextureCacheBase::TexAddrCache::iterator>
+std::vector<TextureCacheBase::TexAddrCache::iterator>
 TextureCacheBase::FindOverlappingTextures(u32 addr, u32 size_in_bytes)
 {
-  // We index by the starting address only, so there is no way to query all textures
-  // which end after the given addr. But the GC textures have a limited size, so we
-  // look for all textures which have a start address bigger than addr minus the maximal
-  // texture size. But this yields false-positives which must be checked later on.
-
-  // 1024 x 1024 texel times 8 nibbles per texel
-  constexpr u32 max_texture_size = 1024 * 1024 * 4;
-  u32 lower_addr = addr > max_texture_size ? addr - max_texture_size : 0;
-  auto begin = textures_by_address.lower_bound(lower_addr);
-  auto end = textures_by_address.upper_bound(addr + size_in_bytes);
-
-  return std::make_pair(begin, end);
+  // We index by the starting address only in textures_by_address, so there is no way to query all
+  // textures which end after the given addr there. textures_by_page has every texture in all the
+  // pages it covers, so only the textures sharing a page with the range are visited.
+  return textures_by_page.Find(addr, size_in_bytes);
 }
 
 TextureCacheBase::TexAddrCache::iterator
@@ -2608,6 +2622,8 @@ TextureCacheBase::InvalidateTexture(TexAddrCache::iterator iter, bool discard_pe
     }
   }
 
+  textures_by_page.Remove(iter->first, entry->size_in_bytes, iter);
+
   auto config = entry->texture->GetConfig();
   texture_pool.emplace(config,
                        TexPoolEntry(std::move(entry->texture), std::move(entry->framebuffer)));
@@ -2619,6 +2635,14 @@ TextureCacheBase::InvalidateTexture(TexAddrCache::iterator iter, bool discard_pe
   return textures_by_address.erase(iter);
 }
 
+TextureCacheBase::TexAddrCache::iterator TextureCacheBase::AddToAddressCache(u32 address,
+                                                                              TCacheEntry* entry)
+{
+  const TexAddrCache::iterator iter = textures_by_address.emplace(address, entry);
+  textures_by_page.Add(address, entry->size_in_bytes, iter);
+  return iter;
+}
+
 bool TextureCacheBase::CreateUtilityTextures()
 {
   constexpr TextureConfig encoding_texture_config(
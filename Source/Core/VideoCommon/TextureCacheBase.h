@@ -18,9 +18,11 @@
 #include "Common/CommonTypes.h"
 #include "Common/MathUtil.h"
 #include "VideoCommon/AbstractTexture.h"
+#include "VideoCommon/AsyncTextureDecoder.h"
 #include "VideoCommon/BPMemory.h"
 #include "VideoCommon/TextureConfig.h"
 #include "VideoCommon/TextureDecoder.h"
+#include "VideoCommon/TexturePageMap.h"
 
 class AbstractFramebuffer;
 class AbstractStagingTexture;
@@ -302,10 +304,13 @@ private:
   TexPool::iterator FindMatchingTextureFromPool(const TextureConfig& config);
   TexAddrCache::iterator GetTexCacheIter(TCacheEntry* entry);
 
-  // Return all possible overlapping textures. As addr+size of the textures is not
-  // indexed, this may return false positives.
-  std::pair<TexAddrCache::iterator, TexAddrCache::iterator>
-  FindOverlappingTextures(u32 addr, u32 size_in_bytes);
+  // Return all possible overlapping textures, in the order of textures_by_address. The textures
+  // are only known to share a page with the range, so this may return false positives.
+  std::vector<TexAddrCache::iterator> FindOverlappingTextures(u32 addr, u32 size_in_bytes);
+
+  // Adds the texture to textures_by_address and textures_by_page. The size of the texture must be
+  // set already, and must not change while it is in the cache.
+  TexAddrCache::iterator AddToAddressCache(u32 address, TCacheEntry* entry);
 
   // Removes and unlinks texture from texture cache and returns it to the pool
   TexAddrCache::iterator InvalidateTexture(TexAddrCache::iterator t_iter,
@@ -339,6 +344,9 @@ private:
   TexPool texture_pool;
   u64 last_entry_id = 0;
 
+  // The entries of textures_by_address, by the pages of memory they cover
+  TexturePageMap<TexAddrCache::iterator> textures_by_page;
+
   // Backup configuration values
   struct BackupConfig
   {
@@ -363,6 +371,9 @@ private:
   // Decoding texture used for GPU texture decoding.
   std::unique_ptr<AbstractTexture> m_decoding_texture;
 
+  // Worker threads for decoding textures on the CPU.
+  VideoCommon::AsyncTextureDecoder m_texture_decoder;
+
   // Pool of readback textures used for deferred EFB copies.
   std::vector<std::unique_ptr<AbstractStagingTexture>> m_efb_copy_staging_texture_pool;
 
@@ -383,6 +383,21 @@ void TexDecoder_Decode(u8* dst, const u8* src, int width, int height, TextureFor
     TexDecoder_DrawOverlay(dst, width, height, texformat);
 }
 
+void TexDecoder_DecodeRows(u8* dst, const u8* src, int width, int first_row, int num_rows,
+                           TextureFormat texformat, const u8* tlut, TLUTFormat tlutfmt)
+{
+  // The blocks are stored row by row, so the rows of blocks are independent.
+  dst += static_cast<size_t>(first_row) * width * sizeof(u32);
+  src += TexDecoder_GetTextureSizeInBytes(width, first_row, texformat);
+  _TexDecoder_DecodeImpl((u32*)dst, src, width, num_rows, texformat, tlut, tlutfmt);
+}
+
+void TexDecoder_FinishDecode(u8* dst, int width, int height, TextureFormat texformat)
+{
+  if (TexFmt_Overlay_Enable)
+    TexDecoder_DrawOverlay(dst, width, height, texformat);
+}
+
 static inline u32 DecodePixel_IA8(u16 val)
 {
   int a = val & 0xFF;
@@ -0,0 +1,138 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+// Index of address ranges by the 4 KiB pages of guest memory they overlap, so the texture cache can
+// find the textures overlapping a range without walking every texture that starts before it. Each
+// value is stored in the bucket of every page its range covers. The first level is indexed by the
+// top bits of the page number, and the second level is only allocated for pages which have been
+// used, as in JitBaseBlockCache::page_map.
+template <typename Value>
+class TexturePageMap final
+{
+public:
+  static constexpr u32 PAGE_SHIFT = 12;
+
+  // Adds a value for the given range. Ranges of size 0 are treated as covering their first byte.
+  void Add(u32 address, u32 size, const Value& value)
+  {
+    const Entry entry{address, m_next_order++, value};
+
+    const u32 last_page = LastPage(address, size);
+    for (u32 page = address >> PAGE_SHIFT; page <= last_page; page++)
+      GetBucket(page).push_back(entry);
+
+    m_size++;
+  }
+
+  // Removes a value that was added with the same range.
+  void Remove(u32 address, u32 size, const Value& value)
+  {
+    bool found = false;
+
+    const u32 last_page = LastPage(address, size);
+    for (u32 page = address >> PAGE_SHIFT; page <= last_page; page++)
+    {
+      std::vector<Entry>& bucket = GetBucket(page);
+      const auto it = std::find_if(bucket.begin(), bucket.end(), [&](const Entry& entry) {
+        return entry.address == address && entry.value == value;
+      });
+      if (it == bucket.end())
+        continue;
+
+      *it = bucket.back();
+      bucket.pop_back();
+      found = true;
+    }
+
+    if (found)
+      m_size--;
+  }
+
+  void Clear()
+  {
+    for (auto& level : m_levels)
+      level.reset();
+    m_size = 0;
+  }
+
+  size_t Size() const { return m_size; }
+
+  // Returns every value whose range shares a page with the given range, once each. The values are
+  // ordered by address, and values with the same address in the order they were added, which is the
+  // order of a std::multimap keyed by address. The ranges are only known to share a page, so this
+  // may return false positives.
+  std::vector<Value> Find(u32 address, u32 size) const
+  {
+    std::vector<const Entry*> found;
+
+    const u32 first_page = address >> PAGE_SHIFT;
+    const u32 last_page = LastPage(address, size);
+    for (u32 page = first_page; page <= last_page; page++)
+    {
+      const Level* level = m_levels[page >> LEVEL_BITS].get();
+      if (!level)
+      {
+        // Skip to the last page covered by this (unallocated) level.
+        page |= LEVEL_MASK;
+        continue;
+      }
+
+      // A value starting before this page also covers the previous one, where it was found already.
+      for (const Entry& entry : (*level)[page & LEVEL_MASK])
+      {
+        if (page == first_page || entry.address >> PAGE_SHIFT == page)
+          found.push_back(&entry);
+      }
+    }
+
+    std::sort(found.begin(), found.end(), [](const Entry* a, const Entry* b) {
+      return a->address != b->address ? a->address < b->address : a->order < b->order;
+    });
+
+    std::vector<Value> values;
+    values.reserve(found.size());
+    for (const Entry* entry : found)
+      values.push_back(entry->value);
+    return values;
+  }
+
+private:
+  struct Entry
+  {
+    u32 address;
+    u64 order;
+    Value value;
+  };
+
+  static constexpr u32 LEVEL_BITS = 10;
+  static constexpr u32 LEVEL_MASK = (1 << LEVEL_BITS) - 1;
+  using Level = std::array<std::vector<Entry>, 1 << LEVEL_BITS>;
+
+  static u32 LastPage(u32 address, u32 size)
+  {
+    const u64 end = std::min<u64>(u64{address} + std::max<u32>(size, 1), u64{1} << 32);
+    return static_cast<u32>((end - 1) >> PAGE_SHIFT);
+  }
+
+  std::vector<Entry>& GetBucket(u32 page)
+  {
+    std::unique_ptr<Level>& level = m_levels[page >> LEVEL_BITS];
+    if (!level)
+      level = std::make_unique<Level>();
+    return (*level)[page & LEVEL_MASK];
+  }
+
+  std::array<std::unique_ptr<Level>, 1 << LEVEL_BITS> m_levels;
+  size_t m_size = 0;
+  u64 m_next_order = 0;
+};
@@ -11,6 +11,7 @@
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
 #include "Core/Movie.h"
+#include "Core/Turbo.h"
 #include "VideoCommon/OnScreenDisplay.h"
 #include "VideoCommon/VideoCommon.h"
 #include "VideoCommon/VideoConfig.h"
@@ -21,8 +22,8 @@ static bool s_has_registered_callback = false;
 
 static bool IsVSyncActive(bool enabled)
 {
-  // Vsync is disabled when the throttler is disabled by the tab key.
-  return enabled && !Core::GetIsThrottlerTempDisabled() &&
+  // Vsync is disabled when the throttler is disabled by the tab key or turbo mode.
+  return enabled && !Core::GetIsThrottlerTempDisabled() && !Turbo::IsEnabled() &&
          SConfig::GetInstance().m_EmulationSpeed == 1.0;
 }
 
@@ -102,6 +103,7 @@ void VideoConfig::Refresh()
   iBitrateKbps = Config::Get(Config::GFX_BITRATE_KBPS);
   bInternalResolutionFrameDumps = Config::Get(Config::GFX_INTERNAL_RESOLUTION_FRAME_DUMPS);
   bEnableGPUTextureDecoding = Config::Get(Config::GFX_ENABLE_GPU_TEXTURE_DECODING);
+  iTextureDecodingThreads = Config::Get(Config::GFX_TEXTURE_DECODING_THREADS);
   bEnablePixelLighting = Config::Get(Config::GFX_ENABLE_PIXEL_LIGHTING);
   bFastDepthCalc = Config::Get(Config::GFX_FAST_DEPTH_CALC);
   iMultisamples = Config::Get(Config::GFX_MSAA);
@@ -128,6 +130,7 @@ void VideoConfig::Refresh()
   bDumpTevTextureFetches = Config::Get(Config::GFX_SW_DUMP_TEV_TEX_FETCHES);
   drawStart = Config::Get(Config::GFX_SW_DRAW_START);
   drawEnd = Config::Get(Config::GFX_SW_DRAW_END);
+  iSWRasterizerThreads = Config::Get(Config::GFX_SW_RASTERIZER_THREADS);
 
   bForceFiltering = Config::Get(Config::GFX_ENHANCE_FORCE_FILTERING);
   iMaxAnisotropy = Config::Get(Config::GFX_ENHANCE_MAX_ANISOTROPY);
@@ -225,3 +228,22 @@ u32 VideoConfig::GetShaderPrecompilerThreads() const
   else
     return GetNumAutoShaderCompilerThreads();
 }
+
+u32 VideoConfig::GetSWRasterizerThreads() const
+{
+  // Automatic number: one per core, including the GPU thread.
+  if (iSWRasterizerThreads > 0)
+    return static_cast<u32>(iSWRasterizerThreads);
+  else
+    return static_cast<u32>(std::max(cpu_info.num_cores, 1));
+}
+
+u32 VideoConfig::GetTextureDecodingThreads() const
+{
+  // Including the GPU thread, so 0 and 1 both decode on the GPU thread alone. The automatic
+  // number, for -1, is clamp(cpus - 2, 1, 4), leaving a core for the CPU thread.
+  if (iTextureDecodingThreads >= 0)
+    return static_cast<u32>(iTextureDecodingThreads);
+  else
+    return static_cast<u32>(std::min(std::max(cpu_info.num_cores - 2, 1), 4));
+}
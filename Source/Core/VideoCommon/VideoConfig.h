@@ -119,6 +119,7 @@ struct VideoConfig final
   FreelookControlType iFreelookControlType;
   bool bBorderlessFullscreen;
   bool bEnableGPUTextureDecoding;
+  int iTextureDecodingThreads;
   int iBitrateKbps;
 
   // Hacks
@@ -165,6 +166,7 @@ struct VideoConfig final
   bool bDumpObjects;
   bool bDumpTevStages;
   bool bDumpTevTextureFetches;
+  int iSWRasterizerThreads;
 
   // Enable API validation layers, currently only supported with Vulkan.
   bool bEnableValidationLayer;
@@ -250,6 +252,8 @@ struct VideoConfig final
   bool UsingUberShaders() const;
   u32 GetShaderCompilerThreads() const;
   u32 GetShaderPrecompilerThreads() const;
+  u32 GetSWRasterizerThreads() const;
+  u32 GetTextureDecodingThreads() const;
 };
 
 extern VideoConfig g_Config;
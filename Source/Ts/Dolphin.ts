@@ -6,7 +6,8 @@ export interface CreateInfo {
   appName: string,
   appDisplayName: string,
   baseDir: string,
-  userDir: string
+  userDir: string,
+  headless?: boolean
 }
 
 export interface BootInfo {
@@ -19,12 +20,89 @@ export enum CoreState {
   Uninitialized, Paused, Running, Stopping, Starting
 };
 
+export interface LatencyHistogram {
+  count: number;
+  totalUs: number;
+  maxUs: number;
+  buckets: number[];
+}
+
+export interface RewindConfig {
+  enabled?: boolean;
+  interval?: number;
+  memoryBudgetMB?: number;
+}
+
+export interface RewindStats {
+  stateCount: number;
+  memoryUsage: number;
+}
+
+export interface TurboConfig {
+  enabled?: boolean;
+  presentInterval?: number;
+}
+
+export interface Frame {
+  width: number;
+  height: number;
+  // RGBA8, top row first.
+  data: Buffer;
+}
+
+export interface ProfilerStats {
+  enabled: boolean;
+  sampleCount: number;
+  outsideBlockCount: number;
+  droppedCount: number;
+}
+
+export type ProfileFormat = 'collapsed' | 'blocks';
+
 export interface JitInterface {
   invalidateICache(address: number, size: number, forced: boolean): void;
 }
 
+export interface RamView {
+  mem1: DataView;
+  mem2?: DataView;
+}
+
+export type ReadPlanType = 'u8' | 'u16' | 'u32' | 's8' | 's16' | 's32' | 'f32' | 'f64';
+
+export interface ReadPlanEntry {
+  addr: number;
+  type: ReadPlanType;
+  endian?: 'le' | 'be';
+  ptrChain?: number[];
+}
+
+export interface ReadPlan {
+  readonly length: number;
+  execute(out?: Float64Array): Float64Array;
+}
+
+export interface WatchRange {
+  addr: number;
+  size: number;
+  ptrChain?: number[];
+}
+
+export interface WatchChange {
+  index: number;
+  addr: number;
+  offset: number;
+  data: Uint8Array;
+}
+
 export interface Memmap {
   memset(address: number, value: number, size: number): void;
+  getRamView(): RamView | undefined;
+  compileReadPlan(entries: ReadPlanEntry[]): ReadPlan;
+  beginBatch(): void;
+  commit(): void;
+  watch(ranges: WatchRange[], callback: (changes: WatchChange[]) => void): number;
+  unwatch(handle: number): boolean;
 
   readU8(address: number): number;
   readU16LE(address: number): number;
@@ -46,8 +124,8 @@ export interface Memmap {
   readS64BE(address: number): bigint;
   readBufferU8(address: number, size: number): Uint8Array;
   readBitU8(address: number, bitOffset: number): boolean;
-  readBitsU8(address: number): Uint8Array;
-  readBitsBufferU8(address: number, size: number): Uint8Array;
+  readBitsU8(address: number, out?: Uint8Array): Uint8Array;
+  readBitsBufferU8(address: number, size: number, out?: Uint8Array): Uint8Array;
   writeU8(address: number, value: number): void;
   writeU16LE(address: number, value: number): void;
   writeU32LE(address: number, value: number): void;
@@ -85,8 +163,8 @@ export interface Memmap {
   readPtrS64BE(address: number, offset: number): bigint;
   readPtrBufferU8(address: number, offset: number, size: number): Uint8Array;
   readPtrBitU8(address: number, offset: number, bitOffset: number): boolean;
-  readPtrBitsU8(address: number, offset: number): Uint8Array;
-  readPtrBitsBufferU8(address: number, offset: number, size: number): Uint8Array;
+  readPtrBitsU8(address: number, offset: number, out?: Uint8Array): Uint8Array;
+  readPtrBitsBufferU8(address: number, offset: number, size: number, out?: Uint8Array): Uint8Array;
   writePtrU8(address: number, offset: number, value: number): void;
   writePtrU16LE(address: number, offset: number, value: number): void;
   writePtrU32LE(address: number, offset: number, value: number): void;
@@ -134,8 +212,8 @@ export interface Accessors {
   readS64BE(address: number): bigint;
   readBufferU8(address: number, size: number): Uint8Array;
   readBitU8(address: number, bitOffset: number): boolean;
-  readBitsU8(address: number): Uint8Array;
-  readBitsBufferU8(address: number, size: number): Uint8Array;
+  readBitsU8(address: number, out?: Uint8Array): Uint8Array;
+  readBitsBufferU8(address: number, size: number, out?: Uint8Array): Uint8Array;
   writeU8(address: number, value: number): void;
   writeU16LE(address: number, value: number): void;
   writeU32LE(address: number, value: number): void;
@@ -167,7 +245,6 @@ export class Dolphin {
   private frontend: any;
   private createInfo?: CreateInfo;
   private eventHandler?: NodeJS.Timeout = undefined;
-  private mtCbHandler?: NodeJS.Timeout = undefined;
   private numTicks = 0;
   private coreState = -1;
 
@@ -185,7 +262,6 @@ export class Dolphin {
     this.frontend.initialize(this.createInfo);
     delete this.createInfo;
     this.eventHandler = setInterval((() => this.frontend.processEvents(4)).bind(this), 16);
-    this.mtCbHandler = setInterval(this.handleMtCb.bind(this), 0);
     this.bindCallbacks();
     this.frontend.enableMtCallbacks();
     this.frontend.startup(bootInfo);
@@ -197,6 +273,8 @@ export class Dolphin {
     this.frontend.on('stop-requested', this.handleStopRequested.bind(this));
     this.frontend.on('stop-complete', this.handleStopComplete.bind(this));
     this.frontend.on('exit-requested', this.handleExitRequested.bind(this));
+    this.frontend.on('tick', this.handleTick.bind(this));
+    this.frontend.on('imgui', this.handleImGui.bind(this));
   }
 
   private handleStateChanged(newState: CoreState) {
@@ -221,22 +299,15 @@ export class Dolphin {
   private handleExitRequested() {
     if (this.eventHandler) clearInterval(this.eventHandler);
     this.frontend.shutdown();
-    if (this.mtCbHandler) clearInterval(this.mtCbHandler);
   }
 
-  private handleMtCb() {
-    if (this.frontend.isOnTickPending()) {
-      this.frontend.signalHandlingOnTick();
-      ++this.numTicks;
-      try { if (this.onTick) this.onTick(); }
-      finally { this.frontend.unlockOnTick(); }
-    }
+  private handleTick() {
+    ++this.numTicks;
+    if (this.onTick) this.onTick();
+  }
 
-    if (this.frontend.isOnImGuiPending()) {
-      this.frontend.signalHandlingOnImGui();
-      try { if (this.onImGui) this.onImGui(); }
-      finally { this.frontend.unlockOnImGui(); }
-    }
+  private handleImGui() {
+    if (this.onImGui) this.onImGui();
   }
 
   public displayMessage(text: string, timeMs: number) {
@@ -247,6 +318,99 @@ export class Dolphin {
     return this.frontend.button(text);
   }
 
+  public getTickLatencyHistogram(): LatencyHistogram {
+    return this.frontend.getTickLatencyHistogram();
+  }
+
+  public resetTickLatencyHistogram() {
+    this.frontend.resetTickLatencyHistogram();
+  }
+
+  // Save states are kept in memory and uncompressed. While running, they are taken or restored at
+  // the next frame boundary, after onTick has returned.
+  public saveStateToBuffer(): Promise<Buffer> {
+    return this.frontend.saveStateToBuffer();
+  }
+
+  public loadStateFromBuffer(data: Uint8Array): Promise<void> {
+    return this.frontend.loadStateFromBuffer(data);
+  }
+
+  public setStateSlotCount(count: number) {
+    this.frontend.setStateSlotCount(count);
+  }
+
+  public getStateSlotCount(): number {
+    return this.frontend.getStateSlotCount();
+  }
+
+  // Without a slot, the oldest slot of the ring is overwritten. Resolves with the slot used.
+  public saveStateToSlot(slot?: number): Promise<number> {
+    return this.frontend.saveStateToSlot(slot);
+  }
+
+  public loadStateFromSlot(slot: number): Promise<void> {
+    return this.frontend.loadStateFromSlot(slot);
+  }
+
+  public getStateSlot(slot: number): Buffer | undefined {
+    return this.frontend.getStateSlot(slot);
+  }
+
+  // Rewinding keeps a state every `interval` frames, compressed against the next one, and drops
+  // the oldest ones past `memoryBudgetMB`. It is unavailable during netplay.
+  public setRewindConfig(config: RewindConfig) {
+    this.frontend.setRewindConfig(config);
+  }
+
+  // Steps back to the previously stored state at the next frame boundary.
+  public rewind() {
+    this.frontend.rewind();
+  }
+
+  public getRewindStats(): RewindStats {
+    return this.frontend.getRewindStats();
+  }
+
+  // Turbo mode runs unthrottled without audio, and only draws and presents one frame every
+  // `presentInterval`. The GPU still handles EFB copies, bounding box and PE tokens. It is
+  // unavailable during netplay, and takes effect at the next frame boundary.
+  public setTurboConfig(config: TurboConfig) {
+    this.frontend.setTurboConfig(config);
+  }
+
+  // Resolves with the next frame presented, at the internal resolution, once the GPU has copied it
+  // back. While paused, resolves with the last frame presented instead, and rejects if none was
+  // since the first call. Works the same with a headless frontend, which renders offscreen and
+  // shows no window.
+  public readFramebuffer(): Promise<Frame> {
+    return this.frontend.readFramebuffer();
+  }
+
+  // Samples where the emulated CPU is `sampleRate` times per second, with little overhead. The
+  // samples accumulate until clearProfile() is called.
+  public startProfiler(sampleRate?: number) {
+    this.frontend.startProfiler(sampleRate);
+  }
+
+  public stopProfiler() {
+    this.frontend.stopProfiler();
+  }
+
+  public clearProfile() {
+    this.frontend.clearProfile();
+  }
+
+  public getProfilerStats(): ProfilerStats {
+    return this.frontend.getProfilerStats();
+  }
+
+  // 'collapsed' writes the guest call stacks in the input format of flamegraph.pl and speedscope,
+  // 'blocks' the number of samples of each JIT block as tab-separated values.
+  public writeProfile(path: string, format: ProfileFormat = 'collapsed'): boolean {
+    return this.frontend.writeProfile(path, format);
+  }
+
   public get JitInterface(): JitInterface {
     return this.module.JitInterface;
   }
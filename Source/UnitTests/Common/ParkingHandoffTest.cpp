@@ -0,0 +1,157 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <atomic>
+#include <gtest/gtest.h>
+#include <thread>
+
+#include "Common/ParkingHandoff.h"
+#include "Common/SPSCQueue.h"
+
+using Common::ParkingHandoff;
+
+TEST(ParkingHandoff, ClaimAndComplete)
+{
+  ParkingHandoff handoff;
+
+  const auto ticket = handoff.Post();
+  ASSERT_TRUE(ticket.has_value());
+  EXPECT_TRUE(handoff.IsPending());
+  EXPECT_FALSE(handoff.Post().has_value());
+
+  EXPECT_TRUE(handoff.Claim(*ticket));
+  EXPECT_FALSE(handoff.Claim(*ticket));
+  EXPECT_TRUE(handoff.IsHandling());
+
+  handoff.Complete(*ticket);
+  EXPECT_FALSE(handoff.IsHandling());
+  handoff.Wait(*ticket);
+}
+
+TEST(ParkingHandoff, CancelAndClaimExcludeEachOther)
+{
+  ParkingHandoff handoff;
+
+  const auto cancelled = handoff.Post();
+  EXPECT_TRUE(handoff.Cancel());
+  EXPECT_FALSE(handoff.Claim(*cancelled));
+  handoff.Wait(*cancelled);
+
+  const auto claimed = handoff.Post();
+  EXPECT_TRUE(handoff.Claim(*claimed));
+  EXPECT_FALSE(handoff.Cancel());
+  EXPECT_TRUE(handoff.IsHandling());
+  handoff.Complete(*claimed);
+}
+
+TEST(ParkingHandoff, StaleCompletionIsIgnored)
+{
+  ParkingHandoff handoff;
+
+  const auto old_ticket = handoff.Post();
+  EXPECT_TRUE(handoff.Claim(*old_ticket));
+  handoff.Release();
+
+  const auto new_ticket = handoff.Post();
+  ASSERT_TRUE(new_ticket.has_value());
+  EXPECT_NE(*old_ticket, *new_ticket);
+
+  handoff.Complete(*old_ticket);
+  EXPECT_TRUE(handoff.IsPending());
+  EXPECT_FALSE(handoff.Claim(*old_ticket));
+  EXPECT_TRUE(handoff.Claim(*new_ticket));
+  handoff.Complete(*new_ticket);
+}
+
+TEST(ParkingHandoff, SuspendCancelsAndRefusesPosts)
+{
+  ParkingHandoff handoff;
+
+  const auto ticket = handoff.Post();
+  EXPECT_TRUE(handoff.Suspend());
+  EXPECT_FALSE(handoff.IsPending());
+  EXPECT_FALSE(handoff.Claim(*ticket));
+  EXPECT_FALSE(handoff.Post().has_value());
+
+  handoff.Resume();
+  EXPECT_TRUE(handoff.Post().has_value());
+}
+
+// Models the Node frontend: the CPU thread parks on every tick, the JS thread serves the requests
+// it is woken up for, and a host thread keeps pausing and resuming.
+TEST(ParkingHandoff, PauseWhileTicking)
+{
+  constexpr int PARK_COUNT = 20000;
+
+  ParkingHandoff handoff;
+  Common::SPSCQueue<u64, false> wake_js;
+  std::atomic<bool> done{false};
+  std::atomic<bool> paused{false};
+  std::atomic<u64> running_ticket{0};
+  std::atomic<int> handled{0};
+
+  std::thread cpu_thread([&] {
+    for (int i = 0; i < PARK_COUNT;)
+    {
+      const auto ticket = handoff.Post();
+      if (!ticket)
+      {
+        std::this_thread::yield();
+        continue;
+      }
+
+      wake_js.Push(*ticket);
+      handoff.Wait(*ticket);
+      EXPECT_NE(*ticket, running_ticket.load());
+      ++i;
+    }
+    done = true;
+  });
+
+  std::thread js_thread([&] {
+    u64 ticket;
+    while (!done || !wake_js.Empty())
+    {
+      if (!wake_js.Pop(ticket))
+      {
+        std::this_thread::yield();
+        continue;
+      }
+
+      if (!handoff.Claim(ticket))
+        continue;
+
+      running_ticket = ticket;
+      EXPECT_FALSE(paused.load());
+      std::this_thread::yield();
+      running_ticket = 0;
+      ++handled;
+      handoff.Complete(ticket);
+    }
+  });
+
+  std::thread host_thread([&] {
+    while (!done)
+    {
+      if (!handoff.Suspend())
+        handoff.WaitWhileHandling();
+
+      paused = true;
+      EXPECT_EQ(0u, running_ticket.load());
+      std::this_thread::yield();
+      paused = false;
+
+      handoff.Resume();
+      std::this_thread::yield();
+    }
+  });
+
+  cpu_thread.join();
+  js_thread.join();
+  host_thread.join();
+
+  EXPECT_GT(handled.load(), 0);
+  EXPECT_FALSE(handoff.IsPending());
+  EXPECT_FALSE(handoff.IsHandling());
+}
@@ -0,0 +1,572 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Common/BitUtils.h"
+#include "Common/CommonTypes.h"
+#include "Common/Config/Config.h"
+#include "Common/FileUtil.h"
+#include "Common/SymbolDB.h"
+#include "Core/Config/MainSettings.h"
+#include "Core/ConfigManager.h"
+#include "Core/Core.h"
+#include "Core/CoreTiming.h"
+#include "Core/HLE/HLE_SDK.h"
+#include "Core/HW/Memmap.h"
+#include "Core/PowerPC/BreakPoints.h"
+#include "Core/PowerPC/Gekko.h"
+#include "Core/PowerPC/MMU.h"
+#include "Core/PowerPC/PowerPC.h"
+#include "UICommon/UICommon.h"
+
+// include order is important
+#include <gtest/gtest.h>  // NOLINT
+
+// Each replacement is checked against the SDK's own code for the function, run in the interpreter
+// from the same registers and memory. The code is the version the replacement accepts, so it has
+// to leave the non-volatile registers and memory exactly as that code does.
+
+constexpr u32 SYSCALL_VECTOR = 0x00000C00;
+constexpr u32 RETURN_ADDRESS = 0x00002000;
+constexpr u32 CONSTANTS_ADDRESS = 0x00002800;
+constexpr u32 STACK_ADDRESS = 0x00002F00;
+constexpr u32 CODE_ADDRESS = 0x00003000;
+
+// The memory the tests work on: some RAM, and some of the locked L1 cache, which isn't plain RAM
+// and makes the replacements fall back to byte accesses. Both span several pages.
+constexpr u32 RAM_WINDOW = 0x00010000;
+constexpr u32 L1_WINDOW = 0xE0000000;
+constexpr u32 WINDOW_SIZE = 0x4000;
+
+// An address the tests never touch, for a memory check that only disables the RAM fast paths.
+constexpr u32 MEMCHECK_ADDRESS = 0x00001000;
+
+// The (0, 1) pair PSMTXConcat loads. PSMTXIdentity loads its 0.0f and 1.0f from the small data
+// area through r2, which the tests point here too.
+static constexpr std::array<float, 2> CONSTANTS{{0.0f, 1.0f}};
+
+// The system call handler of the OS, which DCFlushRange and DCStoreRange end with.
+static const std::vector<u32> SYSCALL_HANDLER{
+    0x7D30FAA6,  // mfspr r9, HID0
+    0x612A0008,  // ori r10, r9, 8
+    0x7D50FBA6,  // mtspr HID0, r10
+    0x4C00012C,  // isync
+    0x7C0004AC,  // sync
+    0x7D30FBA6,  // mtspr HID0, r9
+    0x4C000064,  // rfi
+};
+
+// void* memcpy(void* dest, const void* src, size_t n)
+static const std::vector<u32> MEMCPY{
+    0x7C041840,  // cmplw r4, r3
+    0x41800028,  // blt backwards
+    0x3884FFFF,  // subi r4, r4, 1
+    0x38C3FFFF,  // subi r6, r3, 1
+    0x38A50001,  // addi r5, r5, 1
+    0x4800000C,  // b forward_check
+    0x8C040001,  // forward: lbzu r0, 1(r4)
+    0x9C060001,  // stbu r0, 1(r6)
+    0x34A5FFFF,  // forward_check: subic. r5, r5, 1
+    0x4082FFF4,  // bne forward
+    0x4E800020,  // blr
+    0x7C842A14,  // backwards: add r4, r4, r5
+    0x7CC32A14,  // add r6, r3, r5
+    0x38A50001,  // addi r5, r5, 1
+    0x4800000C,  // b backward_check
+    0x8C04FFFF,  // backward: lbzu r0, -1(r4)
+    0x9C06FFFF,  // stbu r0, -1(r6)
+    0x34A5FFFF,  // backward_check: subic. r5, r5, 1
+    0x4082FFF4,  // bne backward
+    0x4E800020,  // blr
+};
+
+// void __fill_mem(void* dest, int value, size_t n)
+// The 184 byte version. The words after an unaligned head are stored 32 bytes at a time.
+static const std::vector<u32> FILL_MEM{
+    0x28050020,  // cmplwi r5, 32
+    0x5480063E,  // clrlwi r0, r4, 24
+    0x38C3FFFF,  // subi r6, r3, 1
+    0x7C070378,  // mr r7, r0
+    0x41800090,  // blt bytes
+    0x7CC030F8,  // not r0, r6
+    0x540307BF,  // clrlwi. r3, r0, 30
+    0x41820014,  // beq aligned
+    0x7CA32850,  // sub r5, r5, r3
+    0x3463FFFF,  // head: subic. r3, r3, 1
+    0x9CE60001,  // stbu r7, 1(r6)
+    0x4082FFF8,  // bne head
+    0x28070000,  // aligned: cmplwi r7, 0
+    0x4182001C,  // beq splatted
+    0x54E3C00E,  // slwi r3, r7, 24
+    0x54E0801E,  // slwi r0, r7, 16
+    0x54E4402E,  // slwi r4, r7, 8
+    0x7C600378,  // or r0, r3, r0
+    0x7C800378,  // or r0, r4, r0
+    0x7CE70378,  // or r7, r7, r0
+    0x54A3D97F,  // splatted: srwi. r3, r5, 5
+    0x3886FFFD,  // subi r4, r6, 3
+    0x4182002C,  // beq words
+    0x90E40004,  // blocks: stw r7, 4(r4)
+    0x3463FFFF,  // subic. r3, r3, 1
+    0x90E40008,  // stw r7, 8(r4)
+    0x90E4000C,  // stw r7, 12(r4)
+    0x90E40010,  // stw r7, 16(r4)
+    0x90E40014,  // stw r7, 20(r4)
+    0x90E40018,  // stw r7, 24(r4)
+    0x90E4001C,  // stw r7, 28(r4)
+    0x94E40020,  // stwu r7, 32(r4)
+    0x4082FFDC,  // bne blocks
+    0x54A3F77F,  // words: extrwi. r3, r5, 3, 27
+    0x41820010,  // beq words_done
+    0x3463FFFF,  // word: subic. r3, r3, 1
+    0x94E40004,  // stwu r7, 4(r4)
+    0x4082FFF8,  // bne word
+    0x38C40003,  // words_done: addi r6, r4, 3
+    0x54A507BE,  // clrlwi r5, r5, 30
+    0x28050000,  // bytes: cmplwi r5, 0
+    0x4D820020,  // beqlr
+    0x34A5FFFF,  // byte: subic. r5, r5, 1
+    0x9CE60001,  // stbu r7, 1(r6)
+    0x4082FFF8,  // bne byte
+    0x4E800020,  // blr
+};
+
+// void DCFlushRange(void* start, u32 size) and DCStoreRange, which only differ in dcbf and dcbst.
+static std::vector<u32> CacheRangeRoutine(u32 cache_instruction)
+{
+  return {
+      0x28040000,         // cmplwi r4, 0
+      0x4C810020,         // blelr
+      0x546506FE,         // clrlwi r5, r3, 27
+      0x7C842A14,         // add r4, r4, r5
+      0x3884001F,         // addi r4, r4, 31
+      0x5484D97E,         // srwi r4, r4, 5
+      0x7C8903A6,         // mtctr r4
+      cache_instruction,  // loop: dcbf/dcbst 0, r3
+      0x38630020,         // addi r3, r3, 32
+      0x4200FFF8,         // bdnz loop
+      0x44000002,         // sc
+      0x4E800020,         // blr
+  };
+}
+
+constexpr u32 DCBF = 0x7C0018AC;
+constexpr u32 DCBST = 0x7C00186C;
+
+// void PSMTXConcat(const Mtx a, const Mtx b, Mtx ab)
+// The lis and addi load the address of the (0, 1) constant, which is relocated to CONSTANTS here.
+static const std::vector<u32> PSMTX_CONCAT{
+    0x9421FFC0,  // stwu r1, -64(r1)
+    0xE0030000,  // psq_l f0, 0(r3), 0, qr0
+    0xD9C10008,  // stfd f14, 8(r1)
+    0xE0C40000,  // psq_l f6, 0(r4), 0, qr0
+    0x3CC00000,  // lis r6, CONSTANTS@ha
+    0xE0E40008,  // psq_l f7, 8(r4), 0, qr0
+    0xD9E10010,  // stfd f15, 16(r1)
+    0x38C62800,  // addi r6, r6, CONSTANTS@l
+    0xDBE10028,  // stfd f31, 40(r1)
+    0xE1040010,  // psq_l f8, 16(r4), 0, qr0
+    0x11860018,  // ps_muls0 f12, f6, f0
+    0xE0430010,  // psq_l f2, 16(r3), 0, qr0
+    0x11A70018,  // ps_muls0 f13, f7, f0
+    0xE3E60000,  // psq_l f31, 0(r6), 0, qr0
+    0x11C60098,  // ps_muls0 f14, f6, f2
+    0xE1240018,  // psq_l f9, 24(r4), 0, qr0
+    0x11E70098,  // ps_muls0 f15, f7, f2
+    0xE0230008,  // psq_l f1, 8(r3), 0, qr0
+    0x1188601E,  // ps_madds1 f12, f8, f0, f12
+    0xE0630018,  // psq_l f3, 24(r3), 0, qr0
+    0x11C8709E,  // ps_madds1 f14, f8, f2, f14
+    0xE1440020,  // psq_l f10, 32(r4), 0, qr0
+    0x11A9681E,  // ps_madds1 f13, f9, f0, f13
+    0xE1640028,  // psq_l f11, 40(r4), 0, qr0
+    0x11E9789E,  // ps_madds1 f15, f9, f2, f15
+    0xE0830020,  // psq_l f4, 32(r3), 0, qr0
+    0xE0A30028,  // psq_l f5, 40(r3), 0, qr0
+    0x118A605C,  // ps_madds0 f12, f10, f1, f12
+    0x11AB685C,  // ps_madds0 f13, f11, f1, f13
+    0x11CA70DC,  // ps_madds0 f14, f10, f3, f14
+    0x11EB78DC,  // ps_madds0 f15, f11, f3, f15
+    0xF1850000,  // psq_st f12, 0(r5), 0, qr0
+    0x10460118,  // ps_muls0 f2, f6, f4
+    0x11BF685E,  // ps_madds1 f13, f31, f1, f13
+    0x10070118,  // ps_muls0 f0, f7, f4
+    0xF1C50010,  // psq_st f14, 16(r5), 0, qr0
+    0x11FF78DE,  // ps_madds1 f15, f31, f3, f15
+    0xF1A50008,  // psq_st f13, 8(r5), 0, qr0
+    0x1048111E,  // ps_madds1 f2, f8, f4, f2
+    0x1009011E,  // ps_madds1 f0, f9, f4, f0
+    0x104A115C,  // ps_madds0 f2, f10, f5, f2
+    0xC9C10008,  // lfd f14, 8(r1)
+    0xF1E50018,  // psq_st f15, 24(r5), 0, qr0
+    0x100B015C,  // ps_madds0 f0, f11, f5, f0
+    0xF0450020,  // psq_st f2, 32(r5), 0, qr0
+    0x101F015E,  // ps_madds1 f0, f31, f5, f0
+    0xC9E10010,  // lfd f15, 16(r1)
+    0xF0050028,  // psq_st f0, 40(r5), 0, qr0
+    0xCBE10028,  // lfd f31, 40(r1)
+    0x38210040,  // addi r1, r1, 64
+    0x4E800020,  // blr
+};
+static_assert(CONSTANTS_ADDRESS == 0x2800, "PSMTX_CONCAT loads the constants from here");
+
+// void PSMTXIdentity(Mtx m)
+// The lfs offsets are relocated to CONSTANTS, which r2 points to.
+static const std::vector<u32> PSMTX_IDENTITY{
+    0xC0020000,  // lfs f0, 0.0f@sda21(r2)
+    0xC0220004,  // lfs f1, 1.0f@sda21(r2)
+    0xF0030008,  // psq_st f0, 8(r3), 0, qr0
+    0x10400C60,  // ps_merge01 f2, f0, f1
+    0xF0030018,  // psq_st f0, 24(r3), 0, qr0
+    0x102104A0,  // ps_merge10 f1, f1, f0
+    0xF0030020,  // psq_st f0, 32(r3), 0, qr0
+    0xF0430010,  // psq_st f2, 16(r3), 0, qr0
+    0xF0230000,  // psq_st f1, 0(r3), 0, qr0
+    0xF0230028,  // psq_st f1, 40(r3), 0, qr0
+    0x4E800020,  // blr
+};
+
+class HLESDKTest : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    m_profile_path = File::CreateTempDir();
+    Core::DeclareAsCPUThread();
+    UICommon::SetUserDirectory(m_profile_path);
+    Config::Init();
+    SConfig::Init();
+    Memory::Init();
+    PowerPC::Init(PowerPC::CPUCore::Interpreter);
+    CoreTiming::Init();
+
+    std::mt19937 rng(3456);
+    std::uniform_int_distribution<int> byte(0, 0xFF);
+    for (auto* window : {&m_initial_ram, &m_initial_l1})
+    {
+      window->resize(WINDOW_SIZE);
+      for (u8& value : *window)
+        value = static_cast<u8>(byte(rng));
+    }
+
+    for (u32 i = 0; i < CONSTANTS.size(); ++i)
+      PowerPC::HostWrite_U32(Common::BitCast<u32>(CONSTANTS[i]), CONSTANTS_ADDRESS + i * 4);
+    WriteCode(SYSCALL_HANDLER, SYSCALL_VECTOR);
+
+    Config::SetCurrent(Config::MAIN_HLE_SDK_FUNCTIONS, true);
+  }
+
+  void TearDown() override
+  {
+    PowerPC::memchecks.Remove(MEMCHECK_ADDRESS);
+
+    CoreTiming::Shutdown();
+    PowerPC::Shutdown();
+    Memory::Shutdown();
+    SConfig::Shutdown();
+    Config::Shutdown();
+    Core::UndeclareAsCPUThread();
+    File::DeleteDirRecursively(m_profile_path);
+  }
+
+  struct Result
+  {
+    u32 pc;
+    u32 exceptions;
+    std::array<u32, 32> gpr;
+    std::array<u32, 8> cr;
+    std::array<u64, 64> ps;
+    u32 fpscr;
+    std::vector<u8> ram;
+    std::vector<u8> l1;
+  };
+
+  static void WriteCode(const std::vector<u32>& code, u32 address)
+  {
+    for (u32 i = 0; i < code.size(); ++i)
+      PowerPC::HostWrite_U32(code[i], address + i * 4);
+  }
+
+  // Also checks that the code is a version the replacement is used for.
+  static void WriteRoutine(const std::string& name, const std::vector<u32>& routine)
+  {
+    WriteCode(routine, CODE_ADDRESS);
+
+    Common::Symbol symbol;
+    symbol.name = name;
+    symbol.address = CODE_ADDRESS;
+    symbol.size = static_cast<u32>(routine.size() * 4);
+    ASSERT_TRUE(HLE_SDK::CanReplace(symbol)) << name;
+  }
+
+  // Makes the replacements take their byte by byte path for RAM too.
+  static void AddMemCheck()
+  {
+    TMemCheck check;
+    check.start_address = MEMCHECK_ADDRESS;
+    check.end_address = MEMCHECK_ADDRESS;
+    PowerPC::memchecks.Add(check);
+  }
+
+  void SetInitialU32(u32 address, u32 value)
+  {
+    std::vector<u8>& window = address >= L1_WINDOW ? m_initial_l1 : m_initial_ram;
+    const u32 offset = address - (address >= L1_WINDOW ? L1_WINDOW : RAM_WINDOW);
+    ASSERT_LE(offset + sizeof(u32), window.size());
+    for (u32 i = 0; i < sizeof(u32); ++i)
+      window[offset + i] = static_cast<u8>(value >> (24 - i * 8));
+  }
+
+  void SetInitialMtx(u32 address, const std::array<u32, 12>& mtx)
+  {
+    for (u32 i = 0; i < mtx.size(); ++i)
+      SetInitialU32(address + i * 4, mtx[i]);
+  }
+
+  // Starts from the initial memory and the same pseudo-random registers every time.
+  void Reset(u32 r3, u32 r4, u32 r5)
+  {
+    std::memcpy(Memory::m_pRAM + RAM_WINDOW, m_initial_ram.data(), WINDOW_SIZE);
+    std::memcpy(Memory::m_pL1Cache, m_initial_l1.data(), WINDOW_SIZE);
+
+    std::mt19937 rng(7890);
+    for (u32& gpr : PowerPC::ppcState.gpr)
+      gpr = rng();
+    for (PowerPC::PairedSingle& ps : PowerPC::ppcState.ps)
+      ps.SetBoth(u64{rng()} << 32 | rng(), u64{rng()} << 32 | rng());
+    PowerPC::ppcState.cr.Set(rng());
+    CTR = rng();
+
+    GPR(1) = STACK_ADDRESS;
+    GPR(2) = CONSTANTS_ADDRESS;
+    GPR(3) = r3;
+    GPR(4) = r4;
+    GPR(5) = r5;
+    FPSCR.Hex = 0;
+    PowerPC::ppcState.xer_ca = 0;
+    PowerPC::ppcState.xer_so_ov = 0;
+    PowerPC::ppcState.Exceptions = 0;
+
+    // Real mode, with floating point and paired singles enabled.
+    MSR.Hex = 0;
+    MSR.FP = 1;
+    rSPR(SPR_HID2) = 0;
+    HID2.PSE = 1;
+    HID2.LSQE = 1;
+    GQR(0) = 0;
+
+    LR = RETURN_ADDRESS;
+    PC = CODE_ADDRESS;
+    NPC = PC + 4;
+  }
+
+  static Result GetResult()
+  {
+    Result result;
+    result.pc = PC;
+    result.exceptions = PowerPC::ppcState.Exceptions;
+    std::copy(std::begin(PowerPC::ppcState.gpr), std::end(PowerPC::ppcState.gpr),
+              result.gpr.begin());
+    for (u32 i = 0; i < result.cr.size(); ++i)
+      result.cr[i] = PowerPC::ppcState.cr.GetField(i);
+    for (u32 i = 0; i < 32; ++i)
+    {
+      result.ps[i * 2] = rPS(i).PS0AsU64();
+      result.ps[i * 2 + 1] = rPS(i).PS1AsU64();
+    }
+    result.fpscr = FPSCR.Hex;
+    result.ram.assign(Memory::m_pRAM + RAM_WINDOW, Memory::m_pRAM + RAM_WINDOW + WINDOW_SIZE);
+    result.l1.assign(Memory::m_pL1Cache, Memory::m_pL1Cache + WINDOW_SIZE);
+    return result;
+  }
+
+  // Runs the routine written by WriteRoutine in the interpreter, then the replacement, and checks
+  // that they end up in the same state. r3 is only compared when it holds a return value.
+  void Check(void (*replacement)(), u32 r3, u32 r4, u32 r5, bool returns_r3 = false)
+  {
+    SCOPED_TRACE(testing::Message() << std::hex << "r3 " << r3 << ", r4 " << r4 << ", r5 " << r5);
+
+    Reset(r3, r4, r5);
+    for (int steps = 0; steps < 0x100000 && PC != RETURN_ADDRESS; ++steps)
+      PowerPC::SingleStep();
+    const Result expected = GetResult();
+    ASSERT_EQ(RETURN_ADDRESS, expected.pc);
+    ASSERT_EQ(0u, expected.exceptions);
+
+    Reset(r3, r4, r5);
+    replacement();
+    PC = NPC;
+    const Result actual = GetResult();
+
+    EXPECT_EQ(expected.pc, actual.pc);
+    EXPECT_EQ(expected.exceptions, actual.exceptions);
+    // The non-volatile registers: r1, r2, r13 to r31, cr2 to cr4 and f14 to f31.
+    for (u32 i : {1, 2})
+      EXPECT_EQ(expected.gpr[i], actual.gpr[i]) << "r" << i;
+    for (u32 i = 13; i < 32; ++i)
+      EXPECT_EQ(expected.gpr[i], actual.gpr[i]) << "r" << i;
+    if (returns_r3)
+    {
+      EXPECT_EQ(expected.gpr[3], actual.gpr[3]) << "r3";
+    }
+    for (u32 i = 2; i <= 4; ++i)
+      EXPECT_EQ(expected.cr[i], actual.cr[i]) << "cr" << i;
+    // Only ps0, as the SDK saves these with stfd, which leaves ps1 as the function set it.
+    for (u32 i = 14; i < 32; ++i)
+      EXPECT_EQ(expected.ps[i * 2], actual.ps[i * 2]) << "f" << i;
+    EXPECT_EQ(expected.fpscr, actual.fpscr);
+    EXPECT_TRUE(expected.ram == actual.ram) << "RAM differs";
+    EXPECT_TRUE(expected.l1 == actual.l1) << "L1 cache differs";
+  }
+
+  // Sets up two pseudo-random matrices at a and b.
+  void SetInitialMatrices(u32 a, u32 b, bool special_values = false)
+  {
+    std::mt19937 rng(a ^ b);
+    std::uniform_real_distribution<float> element(-100.0f, 100.0f);
+    std::array<u32, 12> mtx_a;
+    std::array<u32, 12> mtx_b;
+    for (u32 i = 0; i < 12; ++i)
+    {
+      // Any bit pattern, so also denormals, infinities and NaNs.
+      mtx_a[i] = special_values ? static_cast<u32>(rng()) : Common::BitCast<u32>(element(rng));
+      mtx_b[i] = special_values ? static_cast<u32>(rng()) : Common::BitCast<u32>(element(rng));
+    }
+    SetInitialMtx(a, mtx_a);
+    SetInitialMtx(b, mtx_b);
+  }
+
+  std::string m_profile_path;
+  std::vector<u8> m_initial_ram;
+  std::vector<u8> m_initial_l1;
+};
+
+TEST_F(HLESDKTest, Memcpy)
+{
+  WriteRoutine("memcpy", MEMCPY);
+
+  Check(HLE_SDK::Memcpy, 0x00010100, 0x00010800, 0x300, true);
+  // Nothing to copy.
+  Check(HLE_SDK::Memcpy, 0x00010100, 0x00010800, 0, true);
+  // Unaligned.
+  Check(HLE_SDK::Memcpy, 0x00010103, 0x00010a09, 0x3d, true);
+  Check(HLE_SDK::Memcpy, 0x00010a09, 0x00010103, 1, true);
+}
+
+TEST_F(HLESDKTest, MemcpyOverlap)
+{
+  WriteRoutine("memcpy", MEMCPY);
+
+  // Forwards, backwards, and onto itself.
+  Check(HLE_SDK::Memcpy, 0x00010100, 0x00010181, 0x200, true);
+  Check(HLE_SDK::Memcpy, 0x00010181, 0x00010100, 0x200, true);
+  Check(HLE_SDK::Memcpy, 0x00010100, 0x00010100, 0x200, true);
+  Check(HLE_SDK::Memcpy, 0x00010101, 0x00010100, 0x200, true);
+}
+
+TEST_F(HLESDKTest, MemcpyPageCrossing)
+{
+  WriteRoutine("memcpy", MEMCPY);
+
+  // The two ranges cross pages at different offsets, and the copy is split at both.
+  Check(HLE_SDK::Memcpy, 0x00010f81, 0x00012f13, 0x1a7, true);
+  Check(HLE_SDK::Memcpy, 0x00012f13, 0x00010f81, 0x1a7, true);
+  // Overlapping over more than a page.
+  Check(HLE_SDK::Memcpy, 0x00010ff0, 0x00010fe1, 0x1035, true);
+  Check(HLE_SDK::Memcpy, 0x00010fe1, 0x00010ff0, 0x1035, true);
+}
+
+TEST_F(HLESDKTest, MemcpyNotRAM)
+{
+  WriteRoutine("memcpy", MEMCPY);
+
+  Check(HLE_SDK::Memcpy, 0xe0000ff1, 0x00010007, 0x123, true);
+  Check(HLE_SDK::Memcpy, 0x00010007, 0xe0000ff1, 0x123, true);
+  Check(HLE_SDK::Memcpy, 0xe0001010, 0xe0000fff, 0x400, true);
+  Check(HLE_SDK::Memcpy, 0xe0000fff, 0xe0001010, 0x400, true);
+
+  AddMemCheck();
+  Check(HLE_SDK::Memcpy, 0x00010f81, 0x00012f13, 0x1a7, true);
+  Check(HLE_SDK::Memcpy, 0x00010ff0, 0x00010fe1, 0x1035, true);
+}
+
+TEST_F(HLESDKTest, FillMem)
+{
+  WriteRoutine("__fill_mem", FILL_MEM);
+
+  // Only the low byte of the value is stored.
+  Check(HLE_SDK::FillMem, 0x00010100, 0x12345687, 0x300);
+  Check(HLE_SDK::FillMem, 0x00010100, 0x12345687, 0);
+  Check(HLE_SDK::FillMem, 0x00010103, 0, 0x3d);
+  Check(HLE_SDK::FillMem, 0x00010f81, 0xff, 0x1a7);
+  Check(HLE_SDK::FillMem, 0x00010fff, 0x5a, 0x2002);
+}
+
+TEST_F(HLESDKTest, FillMemNotRAM)
+{
+  WriteRoutine("__fill_mem", FILL_MEM);
+
+  Check(HLE_SDK::FillMem, 0xe0000ff1, 0x12345687, 0x123);
+  Check(HLE_SDK::FillMem, 0xe0000003, 0x33, 0x2002);
+
+  AddMemCheck();
+  Check(HLE_SDK::FillMem, 0x00010f81, 0xff, 0x1a7);
+}
+
+TEST_F(HLESDKTest, DCFlushRange)
+{
+  WriteRoutine("DCFlushRange", CacheRangeRoutine(DCBF));
+
+  Check(HLE_SDK::DCFlushRange, 0x00010000, 0x20, 0);
+  Check(HLE_SDK::DCFlushRange, 0x00010000, 0, 0);
+  Check(HLE_SDK::DCFlushRange, 0x00010013, 0x1000, 0);
+  Check(HLE_SDK::DCFlushRange, 0x00010fff, 2, 0);
+  Check(HLE_SDK::DCFlushRange, 0xe0000ff1, 0x123, 0);
+}
+
+TEST_F(HLESDKTest, DCStoreRange)
+{
+  WriteRoutine("DCStoreRange", CacheRangeRoutine(DCBST));
+
+  Check(HLE_SDK::DCStoreRange, 0x00010000, 0x20, 0);
+  Check(HLE_SDK::DCStoreRange, 0x00010000, 0, 0);
+  Check(HLE_SDK::DCStoreRange, 0x00010013, 0x1000, 0);
+  Check(HLE_SDK::DCStoreRange, 0x00010fff, 2, 0);
+  Check(HLE_SDK::DCStoreRange, 0xe0000ff1, 0x123, 0);
+}
+
+TEST_F(HLESDKTest, PSMTXConcat)
+{
+  WriteRoutine("PSMTXConcat", PSMTX_CONCAT);
+
+  SetInitialMatrices(0x00010100, 0x00010200);
+  Check(HLE_SDK::PSMTXConcat, 0x00010100, 0x00010200, 0x00010300);
+  // The result may be written over either input.
+  Check(HLE_SDK::PSMTXConcat, 0x00010100, 0x00010200, 0x00010100);
+  Check(HLE_SDK::PSMTXConcat, 0x00010100, 0x00010200, 0x00010200);
+
+  // Crossing a page, and in the locked L1 cache.
+  SetInitialMatrices(0x00010fe8, 0xe0000ff8);
+  Check(HLE_SDK::PSMTXConcat, 0x00010fe8, 0xe0000ff8, 0xe0001ff0);
+  Check(HLE_SDK::PSMTXConcat, 0xe0000ff8, 0x00010fe8, 0x00011ff8);
+
+  SetInitialMatrices(0x00012000, 0x00012100, true);
+  Check(HLE_SDK::PSMTXConcat, 0x00012000, 0x00012100, 0x00012200);
+}
+
+TEST_F(HLESDKTest, PSMTXIdentity)
+{
+  WriteRoutine("PSMTXIdentity", PSMTX_IDENTITY);
+
+  Check(HLE_SDK::PSMTXIdentity, 0x00010100, 0, 0);
+  Check(HLE_SDK::PSMTXIdentity, 0x00010ff0, 0, 0);
+  Check(HLE_SDK::PSMTXIdentity, 0xe0000ff8, 0, 0);
+}
@@ -0,0 +1,166 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <chrono>
+#include <cstdio>
+#include <set>
+
+#include "Common/CommonTypes.h"
+#include "Core/PowerPC/JitCommon/JitBase.h"
+#include "Core/PowerPC/JitCommon/JitCache.h"
+#include "Core/PowerPC/PowerPC.h"
+
+// include order is important
+#include <gtest/gtest.h>  // NOLINT
+
+namespace
+{
+class FakeJit : public JitBase
+{
+public:
+  // CPUCoreBase methods
+  void Init() override {}
+  void Shutdown() override {}
+  void ClearCache() override {}
+  void Run() override {}
+  void SingleStep() override {}
+  const char* GetName() const override { return nullptr; }
+  // JitBase methods
+  JitBaseBlockCache* GetBlockCache() override { return nullptr; }
+  void Jit(u32 em_address) override {}
+  const CommonAsmRoutinesBase* GetAsmRoutines() override { return nullptr; }
+  bool HandleFault(uintptr_t access_address, SContext* ctx) override { return false; }
+};
+
+// There is no generated code to patch, so this only measures the bookkeeping of the cache.
+class FakeBlockCache final : public JitBaseBlockCache
+{
+public:
+  using JitBaseBlockCache::JitBaseBlockCache;
+
+private:
+  void WriteLinkBlock(const JitBlock::LinkData& source, const JitBlock* dest) override {}
+};
+
+constexpr u32 BASE_ADDRESS = 0x00003000;
+constexpr u32 BLOCK_SIZE = 0x20;
+constexpr u32 NUM_BLOCKS = 0x8000;
+constexpr u32 NUM_LOOKUP_ROUNDS = 16;
+
+constexpr u32 BlockAddress(u32 index)
+{
+  return BASE_ADDRESS + index * BLOCK_SIZE;
+}
+
+// Each block falls through to the next one and calls the first one, so that one address is the
+// destination of every block's exits.
+void CompileBlock(JitBaseBlockCache& cache, u32 index)
+{
+  const u32 address = BlockAddress(index);
+  JitBlock* block = cache.AllocateBlock(address);
+  block->originalSize = BLOCK_SIZE / 4;
+
+  JitBlock::LinkData link_data{};
+  link_data.exitAddress = BlockAddress(0);
+  link_data.call = true;
+  block->linkData.push_back(link_data);
+  link_data.exitAddress = BlockAddress(index + 1);
+  link_data.call = false;
+  block->linkData.push_back(link_data);
+
+  std::set<u32> physical_addresses;
+  for (u32 i = 0; i < BLOCK_SIZE; i += 4)
+    physical_addresses.insert(address + i);
+
+  cache.FinalizeBlock(*block, true, physical_addresses);
+}
+
+u32 CountBlocks(JitBaseBlockCache& cache)
+{
+  u32 count = 0;
+  cache.RunOnBlocks([&count](const JitBlock&) { ++count; });
+  return count;
+}
+
+unsigned long long ElapsedNanoseconds(std::chrono::high_resolution_clock::time_point start)
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::high_resolution_clock::now() - start)
+      .count();
+}
+}  // namespace
+
+TEST(JitBlockCache, CompileLinkInvalidate)
+{
+  MSR.Hex = 0;
+
+  FakeJit jit;
+  FakeBlockCache cache(jit);
+  cache.Clear();
+
+  auto start = std::chrono::high_resolution_clock::now();
+  for (u32 i = 0; i < NUM_BLOCKS; i++)
+    CompileBlock(cache, i);
+  const unsigned long long compile_time = ElapsedNanoseconds(start);
+
+  EXPECT_EQ(CountBlocks(cache), NUM_BLOCKS);
+  for (u32 i = 0; i < NUM_BLOCKS; i++)
+  {
+    JitBlock* block = cache.GetBlockFromStartAddress(BlockAddress(i), MSR.Hex);
+    ASSERT_NE(block, nullptr);
+    EXPECT_TRUE(block->linkData[0].linkStatus);
+    EXPECT_EQ(block->linkData[1].linkStatus, i != NUM_BLOCKS - 1);
+  }
+
+  start = std::chrono::high_resolution_clock::now();
+  u32 found = 0;
+  for (u32 round = 0; round < NUM_LOOKUP_ROUNDS; round++)
+  {
+    for (u32 i = 0; i < NUM_BLOCKS; i++)
+      found += cache.GetBlockFromStartAddress(BlockAddress(i), MSR.Hex) != nullptr;
+  }
+  const unsigned long long lookup_time = ElapsedNanoseconds(start);
+  EXPECT_EQ(found, NUM_BLOCKS * NUM_LOOKUP_ROUNDS);
+
+  // Invalidate every other block, one cache line at a time like dcbi/icbi do.
+  start = std::chrono::high_resolution_clock::now();
+  for (u32 i = 1; i < NUM_BLOCKS; i += 2)
+    cache.InvalidateICache(BlockAddress(i), 32, true);
+  const unsigned long long invalidate_time = ElapsedNanoseconds(start);
+
+  EXPECT_EQ(CountBlocks(cache), NUM_BLOCKS / 2);
+  for (u32 i = 0; i < NUM_BLOCKS; i += 2)
+  {
+    EXPECT_EQ(cache.GetBlockFromStartAddress(BlockAddress(i + 1), MSR.Hex), nullptr);
+    JitBlock* block = cache.GetBlockFromStartAddress(BlockAddress(i), MSR.Hex);
+    ASSERT_NE(block, nullptr);
+    EXPECT_TRUE(block->linkData[0].linkStatus);
+    EXPECT_FALSE(block->linkData[1].linkStatus);
+  }
+
+  // Compiling the missing blocks again links the remaining ones to them.
+  for (u32 i = 1; i < NUM_BLOCKS; i += 2)
+    CompileBlock(cache, i);
+  for (u32 i = 0; i < NUM_BLOCKS - 1; i++)
+    EXPECT_TRUE(cache.GetBlockFromStartAddress(BlockAddress(i), MSR.Hex)->linkData[1].linkStatus);
+
+  // Erasing the first block unlinks every call to it.
+  cache.InvalidateICache(BlockAddress(0), 32, true);
+  for (u32 i = 1; i < NUM_BLOCKS; i++)
+    EXPECT_FALSE(cache.GetBlockFromStartAddress(BlockAddress(i), MSR.Hex)->linkData[0].linkStatus);
+
+  start = std::chrono::high_resolution_clock::now();
+  cache.ErasePhysicalRange(0, 0xFFFFFFFF);
+  const unsigned long long erase_time = ElapsedNanoseconds(start);
+  EXPECT_EQ(CountBlocks(cache), 0u);
+
+  printf("block cache timing for %u blocks:\n", NUM_BLOCKS);
+  printf("compile and link       %llu ns/block\n", compile_time / NUM_BLOCKS);
+  printf("lookup                 %llu ns/lookup\n",
+         lookup_time / (NUM_BLOCKS * NUM_LOOKUP_ROUNDS));
+  printf("invalidate cache line  %llu ns/block\n", invalidate_time / (NUM_BLOCKS / 2));
+  printf("erase whole range      %llu ns/block\n", erase_time / (NUM_BLOCKS - 1));
+
+  cache.Clear();
+}
@@ -0,0 +1,183 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <cstring>
+#include <random>
+
+#include <gtest/gtest.h>  // NOLINT
+
+#include "Common/CommonTypes.h"
+#include "VideoBackends/Software/TevCombiners.h"
+#include "VideoBackends/Software/TextureSampler.h"
+#include "VideoCommon/BPMemory.h"
+
+// The SIMD kernels of the software renderer must give exactly the same results as the scalar
+// code they replace.
+
+class TevCombinerTest : public testing::Test
+{
+protected:
+  void SetUp() override { m_combiners.Init(); }
+
+  // Fills everything the combiners can read, for every pixel of the block. The registers hold
+  // clamped results, the other inputs are 8-bit colors.
+  void RandomizeInputs()
+  {
+    std::uniform_int_distribution<int> reg(-1024, 1023);
+    std::uniform_int_distribution<int> color(0, 255);
+    for (int index = 0; index < TevCombiners::NUM_PIXELS; ++index)
+    {
+      TevCombiners::Pixel& pixel = m_combiners.GetPixel(index);
+      for (int i = 0; i < 4; ++i)
+      {
+        for (s16& comp : pixel.Reg[i])
+          comp = static_cast<s16>(reg(m_rng));
+        pixel.TexColor[i] = static_cast<s16>(color(m_rng));
+        pixel.RasColor[i] = static_cast<s16>(color(m_rng));
+        pixel.StageKonst[i] = static_cast<s16>(color(m_rng));
+      }
+    }
+  }
+
+  void SetReg(int reg, s16 value)
+  {
+    for (int index = 0; index < TevCombiners::NUM_PIXELS; ++index)
+    {
+      for (s16& comp : m_combiners.GetPixel(index).Reg[reg])
+        comp = value;
+    }
+  }
+
+  // Runs the combiners on the whole block and on each pixel alone with the same inputs, and
+  // returns whether the registers end up the same.
+  bool CombineBoth(const TevStageCombiner::ColorCombiner& cc,
+                   const TevStageCombiner::AlphaCombiner& ac)
+  {
+    TevCombiners::Pixel inputs[TevCombiners::NUM_PIXELS];
+    for (int index = 0; index < TevCombiners::NUM_PIXELS; ++index)
+      inputs[index] = m_combiners.GetPixel(index);
+
+    m_combiners.Combine(cc, ac, 0xF);
+    s16 actual[TevCombiners::NUM_PIXELS][4][4];
+    for (int index = 0; index < TevCombiners::NUM_PIXELS; ++index)
+      std::memcpy(actual[index], m_combiners.GetPixel(index).Reg, sizeof(actual[index]));
+
+    for (int index = 0; index < TevCombiners::NUM_PIXELS; ++index)
+    {
+      m_combiners.GetPixel(index) = inputs[index];
+      m_combiners.CombineScalar(cc, ac, index);
+      if (std::memcmp(actual[index], m_combiners.GetPixel(index).Reg, sizeof(actual[index])) != 0)
+        return false;
+    }
+    return true;
+  }
+
+  TevCombiners m_combiners;
+  std::mt19937 m_rng{5678};
+};
+
+#ifdef _M_X86
+TEST_F(TevCombinerTest, CombineMatchesScalar)
+{
+  std::uniform_int_distribution<u32> hex(0, 0xFFFFFF);
+
+  for (int i = 0; i < 200000; ++i)
+  {
+    TevStageCombiner::ColorCombiner cc;
+    TevStageCombiner::AlphaCombiner ac;
+    cc.hex = hex(m_rng);
+    ac.hex = hex(m_rng);
+    // Only the regular combiners are vectorized.
+    if (cc.bias == 3)
+      cc.bias = 0;
+    if (ac.bias == 3)
+      ac.bias = 0;
+
+    RandomizeInputs();
+    ASSERT_TRUE(CombineBoth(cc, ac)) << "color combiner " << std::hex << cc.hex
+                                     << ", alpha combiner " << ac.hex;
+  }
+}
+
+TEST_F(TevCombinerTest, CombineMatchesScalarAtLimits)
+{
+  // Every combination of shift, op, bias and clamp, with the inputs at their limits, where the
+  // rounding and the clamping differ the most between color and alpha.
+  for (u32 mode = 0; mode < 0x100; ++mode)
+  {
+    TevStageCombiner::ColorCombiner cc;
+    TevStageCombiner::AlphaCombiner ac;
+    cc.hex = 0;
+    ac.hex = 0;
+    // prev.rgb, c0.rgb, c1.rgb and c2.rgb, and the matching alphas.
+    cc.a = 0;
+    cc.b = 2;
+    cc.c = 4;
+    cc.d = 6;
+    ac.a = 0;
+    ac.b = 1;
+    ac.c = 2;
+    ac.d = 3;
+    cc.shift = mode & 3;
+    ac.shift = mode & 3;
+    cc.op = (mode >> 2) & 1;
+    ac.op = (mode >> 2) & 1;
+    cc.bias = ((mode >> 3) & 3) % 3;
+    ac.bias = ((mode >> 3) & 3) % 3;
+    cc.clamp = (mode >> 5) & 1;
+    ac.clamp = (mode >> 5) & 1;
+    cc.dest = (mode >> 6) & 3;
+    ac.dest = (mode >> 6) & 3;
+
+    for (s16 a : {0, 255})
+    {
+      for (s16 b : {0, 255})
+      {
+        for (s16 c : {0, 127, 128, 255})
+        {
+          for (s16 d : {-1024, -1, 0, 255, 1023})
+          {
+            SetReg(0, a);
+            SetReg(1, b);
+            SetReg(2, c);
+            SetReg(3, d);
+            ASSERT_TRUE(CombineBoth(cc, ac)) << "mode " << mode << ", inputs " << a << " " << b
+                                             << " " << c << " " << d;
+          }
+        }
+      }
+    }
+  }
+}
+#endif
+
+TEST(TextureSampler, FilterTexelsMatchesScalar)
+{
+  std::mt19937 rng(9012);
+  std::uniform_int_distribution<int> component(0, 255);
+
+  for (int fract_s = 0; fract_s < 128; ++fract_s)
+  {
+    for (int fract_t = 0; fract_t < 128; ++fract_t)
+    {
+      // Black, white, and a few random texels.
+      for (int i = 0; i < 8; ++i)
+      {
+        u8 texels[4][4];
+        for (auto& texel : texels)
+        {
+          for (u8& value : texel)
+            value = i == 0 ? 0 : i == 1 ? 255 : static_cast<u8>(component(rng));
+        }
+
+        u8 expected[4];
+        u8 actual[4];
+        TextureSampler::FilterTexelsScalar(texels, fract_s, fract_t, expected);
+        TextureSampler::FilterTexels(texels, fract_s, fract_t, actual);
+        ASSERT_EQ(0, std::memcmp(expected, actual, sizeof(expected)))
+            << "fractions " << fract_s << " " << fract_t;
+      }
+    }
+  }
+}
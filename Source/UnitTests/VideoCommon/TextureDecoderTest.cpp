@@ -0,0 +1,153 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <array>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>  // NOLINT
+
+#include "Common/CommonTypes.h"
+#include "VideoCommon/AsyncTextureDecoder.h"
+#include "VideoCommon/TextureDecoder.h"
+
+static constexpr std::array<TextureFormat, 12> ALL_FORMATS{{
+    TextureFormat::I4,
+    TextureFormat::I8,
+    TextureFormat::IA4,
+    TextureFormat::IA8,
+    TextureFormat::RGB565,
+    TextureFormat::RGB5A3,
+    TextureFormat::RGBA8,
+    TextureFormat::C4,
+    TextureFormat::C8,
+    TextureFormat::C14X2,
+    TextureFormat::CMPR,
+    TextureFormat::XFB,
+}};
+
+static constexpr std::array<TLUTFormat, 3> ALL_TLUT_FORMATS{{
+    TLUTFormat::IA8,
+    TLUTFormat::RGB565,
+    TLUTFormat::RGB5A3,
+}};
+
+// Enough for the largest texture below in any format.
+static constexpr size_t SOURCE_SIZE = 1024 * 1024;
+// A C14X2 palette has 16384 entries of 2 bytes.
+static constexpr size_t TLUT_SIZE = 0x8000;
+
+class TextureDecoderTest : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    std::mt19937 rng(1234);
+    std::uniform_int_distribution<int> byte(0, 0xFF);
+
+    m_source.resize(SOURCE_SIZE);
+    for (u8& value : m_source)
+      value = static_cast<u8>(byte(rng));
+    m_tlut.resize(TLUT_SIZE);
+    for (u8& value : m_tlut)
+      value = static_cast<u8>(byte(rng));
+  }
+
+  // Sizes that are a whole number of blocks wide and high, as the texture cache decodes them.
+  static int AlignWidth(int width, TextureFormat format)
+  {
+    const int block_width = TexDecoder_GetBlockWidthInTexels(format);
+    return (width + block_width - 1) / block_width * block_width;
+  }
+
+  static int AlignHeight(int height, TextureFormat format)
+  {
+    const int block_height = TexDecoder_GetBlockHeightInTexels(format);
+    return (height + block_height - 1) / block_height * block_height;
+  }
+
+  std::vector<u8> DecodeWhole(int width, int height, TextureFormat format, TLUTFormat tlut_format)
+  {
+    std::vector<u8> decoded(static_cast<size_t>(width) * height * 4);
+    TexDecoder_Decode(decoded.data(), m_source.data(), width, height, format, m_tlut.data(),
+                      tlut_format);
+    return decoded;
+  }
+
+  std::vector<u8> m_source;
+  std::vector<u8> m_tlut;
+};
+
+TEST_F(TextureDecoderTest, StripesMatchWholeDecode)
+{
+  for (TextureFormat format : ALL_FORMATS)
+  {
+    const int block_height = TexDecoder_GetBlockHeightInTexels(format);
+    for (TLUTFormat tlut_format : ALL_TLUT_FORMATS)
+    {
+      // The palette format only matters for the color indexed formats.
+      if (!IsColorIndexed(format) && tlut_format != TLUTFormat::IA8)
+        continue;
+
+      for (const auto& [base_width, base_height] : {std::pair(8, 8), std::pair(100, 60)})
+      {
+        const int width = AlignWidth(base_width, format);
+        const int height = AlignHeight(base_height, format);
+        const std::vector<u8> expected = DecodeWhole(width, height, format, tlut_format);
+
+        // Stripes of one block, of several blocks, and of a size that doesn't divide the height.
+        for (int blocks_per_stripe : {1, 2, 3, 5})
+        {
+          SCOPED_TRACE(testing::Message()
+                       << "format " << static_cast<int>(format) << ", tlut format "
+                       << static_cast<int>(tlut_format) << ", " << width << "x" << height
+                       << ", " << blocks_per_stripe << " blocks per stripe");
+
+          const int rows_per_stripe = blocks_per_stripe * block_height;
+          std::vector<u8> actual(expected.size());
+          for (int row = 0; row < height; row += rows_per_stripe)
+          {
+            TexDecoder_DecodeRows(actual.data(), m_source.data(), width, row,
+                                  std::min(rows_per_stripe, height - row), format, m_tlut.data(),
+                                  tlut_format);
+          }
+          TexDecoder_FinishDecode(actual.data(), width, height, format);
+
+          EXPECT_EQ(expected, actual);
+        }
+      }
+    }
+  }
+}
+
+TEST_F(TextureDecoderTest, AsyncDecoderMatchesWholeDecode)
+{
+  for (u32 num_threads : {0u, 1u, 2u, 4u})
+  {
+    VideoCommon::AsyncTextureDecoder decoder;
+    decoder.SetThreadCount(num_threads);
+
+    for (TextureFormat format : ALL_FORMATS)
+    {
+      SCOPED_TRACE(testing::Message() << "format " << static_cast<int>(format) << ", "
+                                      << num_threads << " threads");
+
+      // Large enough to be split into several stripes.
+      const int width = AlignWidth(400, format);
+      const int height = AlignHeight(300, format);
+      const std::vector<u8> expected = DecodeWhole(width, height, format, TLUTFormat::RGB5A3);
+
+      std::vector<u8> actual(expected.size());
+      const u32 id = decoder.Decode(actual.data(), m_source.data(), width, height, format,
+                                    m_tlut.data(), TLUTFormat::RGB5A3);
+      decoder.Wait(id);
+
+      EXPECT_EQ(expected, actual);
+    }
+
+    decoder.WaitAll();
+  }
+}
@@ -0,0 +1,197 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <chrono>
+#include <cstdio>
+#include <iterator>
+#include <map>
+#include <random>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "VideoCommon/TexturePageMap.h"
+
+// include order is important
+#include <gtest/gtest.h>  // NOLINT
+
+namespace
+{
+// Like TextureCacheBase::textures_by_address, with the size of each texture as the value.
+using AddrCache = std::multimap<u32, u32>;
+using PageMap = TexturePageMap<AddrCache::iterator>;
+
+AddrCache::iterator Add(AddrCache& cache, PageMap& page_map, u32 address, u32 size)
+{
+  const AddrCache::iterator iter = cache.emplace(address, size);
+  page_map.Add(address, size, iter);
+  return iter;
+}
+
+void Remove(AddrCache& cache, PageMap& page_map, AddrCache::iterator iter)
+{
+  page_map.Remove(iter->first, iter->second, iter);
+  cache.erase(iter);
+}
+
+bool Overlaps(AddrCache::iterator iter, u32 address, u32 size)
+{
+  return iter->first < address + size && address < iter->first + iter->second;
+}
+
+// One EFB copy or texture load of a synthetic frame sequence.
+struct TraceStep
+{
+  u32 address;
+  u32 size;
+  bool is_copy;
+};
+
+constexpr u32 MEM1_SIZE = 0x01800000;
+constexpr u32 XFB_SIZE = 640 * 480 * 2;
+constexpr u32 NUM_STEPS = 20000;
+
+// Most steps are small EFB copies to a set of render target addresses that games reuse every
+// frame, mixed with XFB copies and texture loads of the copies' memory.
+std::vector<TraceStep> MakeEFBCopyTrace()
+{
+  std::mt19937 rng(0x7E5);
+  std::uniform_int_distribution<u32> slot(0, 511);
+  std::uniform_int_distribution<u32> small_size(1, 64);
+  std::uniform_int_distribution<u32> kind(0, 99);
+
+  std::vector<TraceStep> trace;
+  trace.reserve(NUM_STEPS);
+  for (u32 i = 0; i < NUM_STEPS; i++)
+  {
+    const u32 k = kind(rng);
+    if (k < 5)
+      trace.push_back({MEM1_SIZE - (1 + k % 2) * 0x00100000, XFB_SIZE, true});
+    else
+      trace.push_back({0x00400000 + slot(rng) * 0x8000, small_size(rng) * 0x200, k < 55});
+  }
+  return trace;
+}
+
+// The lookback walk textures_by_address used before textures_by_page: every texture starting less
+// than the largest texture size before the range.
+constexpr u32 MAX_TEXTURE_SIZE = 0x00400000;
+
+std::vector<AddrCache::iterator> FindByLookback(AddrCache& cache, u32 address, u32 size)
+{
+  const u32 lower_address = address > MAX_TEXTURE_SIZE ? address - MAX_TEXTURE_SIZE : 0;
+  std::vector<AddrCache::iterator> found;
+  for (auto iter = cache.lower_bound(lower_address); iter != cache.upper_bound(address + size);
+       ++iter)
+  {
+    found.push_back(iter);
+  }
+  return found;
+}
+
+// Replays the trace the way CopyRenderTargetToTexture does: textures fully covered by a copy are
+// invalidated before the copy is added. Returns the number of actual overlaps of each step.
+std::vector<u32> Replay(const std::vector<TraceStep>& trace, bool use_page_map)
+{
+  AddrCache cache;
+  PageMap page_map;
+  std::vector<u32> overlaps;
+  overlaps.reserve(trace.size());
+
+  for (const TraceStep& step : trace)
+  {
+    const std::vector<AddrCache::iterator> candidates =
+        use_page_map ? page_map.Find(step.address, step.size) :
+                       FindByLookback(cache, step.address, step.size);
+
+    u32 count = 0;
+    for (AddrCache::iterator iter : candidates)
+    {
+      if (!Overlaps(iter, step.address, step.size))
+        continue;
+
+      count++;
+      if (step.is_copy && iter->first >= step.address &&
+          iter->first + iter->second <= step.address + step.size)
+      {
+        Remove(cache, page_map, iter);
+      }
+    }
+    overlaps.push_back(count);
+
+    if (step.is_copy)
+      Add(cache, page_map, step.address, step.size);
+  }
+
+  EXPECT_EQ(page_map.Size(), cache.size());
+  return overlaps;
+}
+
+unsigned long long ElapsedNanoseconds(std::chrono::high_resolution_clock::time_point start)
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::high_resolution_clock::now() - start)
+      .count();
+}
+}  // namespace
+
+TEST(TexturePageMap, Bookkeeping)
+{
+  AddrCache cache;
+  PageMap page_map;
+
+  const auto small = Add(cache, page_map, 0x80001000, 0x100);
+  const auto spanning = Add(cache, page_map, 0x80000F00, 0x3000);
+  const auto same_address = Add(cache, page_map, 0x80001000, 0x40);
+  const auto far = Add(cache, page_map, 0x80100000, 0x1000);
+  EXPECT_EQ(page_map.Size(), 4u);
+
+  // Each value is found once, in the order of the multimap, even if it covers several pages.
+  const std::vector<AddrCache::iterator> expected{spanning, small, same_address};
+  EXPECT_EQ(page_map.Find(0x80000000, 0x4000), expected);
+  std::vector<AddrCache::iterator> in_order;
+  for (auto iter = cache.begin(); iter != std::prev(cache.end()); ++iter)
+    in_order.push_back(iter);
+  EXPECT_EQ(in_order, expected);
+
+  // Sharing a page is enough to be found, and ranges of size 0 cover their first byte.
+  EXPECT_EQ(page_map.Find(0x80001F00, 0x10).size(), 3u);
+  EXPECT_EQ(page_map.Find(0x80003000, 0).size(), 1u);
+  EXPECT_TRUE(page_map.Find(0x80004000, 0x1000).empty());
+  EXPECT_EQ(page_map.Find(0x80100FFF, 1), std::vector<AddrCache::iterator>{far});
+
+  // Ranges ending at the top of the address space don't wrap around.
+  const auto top = Add(cache, page_map, 0xFFFFF000, 0x2000);
+  EXPECT_EQ(page_map.Find(0xFFFFFFFF, 1), std::vector<AddrCache::iterator>{top});
+  EXPECT_TRUE(page_map.Find(0, 0x1000).empty());
+
+  Remove(cache, page_map, small);
+  Remove(cache, page_map, top);
+  EXPECT_EQ(page_map.Size(), 3u);
+  EXPECT_EQ(page_map.Find(0x80001000, 0x100),
+            (std::vector<AddrCache::iterator>{spanning, same_address}));
+  EXPECT_TRUE(page_map.Find(0xFFFFF000, 0x1000).empty());
+
+  page_map.Clear();
+  EXPECT_EQ(page_map.Size(), 0u);
+  EXPECT_TRUE(page_map.Find(0x80000000, 0x4000).empty());
+}
+
+TEST(TexturePageMap, EFBCopyTraceReplay)
+{
+  const std::vector<TraceStep> trace = MakeEFBCopyTrace();
+
+  auto start = std::chrono::high_resolution_clock::now();
+  const std::vector<u32> lookback_overlaps = Replay(trace, false);
+  const unsigned long long lookback_time = ElapsedNanoseconds(start);
+
+  start = std::chrono::high_resolution_clock::now();
+  const std::vector<u32> page_map_overlaps = Replay(trace, true);
+  const unsigned long long page_map_time = ElapsedNanoseconds(start);
+
+  EXPECT_EQ(lookback_overlaps, page_map_overlaps);
+
+  printf("texture overlap timing for %u copies and loads:\n", NUM_STEPS);
+  printf("lookback walk  %llu ns/step\n", lookback_time / NUM_STEPS);
+  printf("page map       %llu ns/step\n", page_map_time / NUM_STEPS);
+}